@@ -0,0 +1,269 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+/// Micro-benchmark for [File.copy] and [File.copySync], and for each of the
+/// ways the VM copies files on Linux.
+///
+/// By default the files are created in [Directory.systemTemp]. To compare
+/// file systems, pass `label=directory` arguments, e.g.
+///
+///     dart FileCopy.dart tmpfs=/dev/shm ext4=/mnt/ext4
+///
+/// which reports `FileCopy.tmpfs.*` and `FileCopy.ext4.*` results.
+///
+/// On Linux, `File::Copy` tries cloning, `copy_file_range`, `sendfile` and
+/// reading and writing in turn, and uses the first one the file system
+/// supports. The `Clone`, `CopyFileRange`, `SendFile` and `ReadWrite`
+/// benchmarks call each of these directly through `dart:ffi`, so that all of
+/// them can be compared on the same file system. Ways which a file system
+/// does not support are reported as skipped.
+
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+import 'package:ffi/ffi.dart';
+
+const sizes = {'1MB': 1024 * 1024, '64MB': 64 * 1024 * 1024};
+
+abstract class FileCopyBenchmark extends AsyncBenchmarkBase {
+  final Directory parent;
+  final int size;
+  late Directory _tempDir;
+  late File _source;
+  late String _targetPath;
+
+  FileCopyBenchmark(
+    String name,
+    String label,
+    String sizeName,
+    this.parent,
+    this.size,
+  ) : super('FileCopy.$label.$name.$sizeName');
+
+  @override
+  Future<void> setup() async {
+    _tempDir = parent.createTempSync('file_copy_benchmark');
+    final data = Uint8List(size);
+    for (int i = 0; i < size; i += 4096) {
+      data[i] = i >> 12;
+    }
+    _source = File('${_tempDir.path}/source')..writeAsBytesSync(data);
+    _targetPath = '${_tempDir.path}/target';
+  }
+
+  @override
+  Future<void> teardown() async {
+    _tempDir.deleteSync(recursive: true);
+  }
+}
+
+class CopySync extends FileCopyBenchmark {
+  CopySync(String label, String sizeName, Directory parent, int size)
+      : super('CopySync', label, sizeName, parent, size);
+
+  @override
+  Future<void> run() async {
+    _source.copySync(_targetPath);
+  }
+}
+
+class Copy extends FileCopyBenchmark {
+  Copy(String label, String sizeName, Directory parent, int size)
+      : super('Copy', label, sizeName, parent, size);
+
+  @override
+  Future<void> run() async {
+    await _source.copy(_targetPath);
+  }
+}
+
+/// The ways `File::Copy` in runtime/bin/file_linux.cc copies, in the order
+/// it tries them.
+enum CopyTier {
+  clone('Clone'),
+  copyFileRange('CopyFileRange'),
+  sendfile('SendFile'),
+  readWrite('ReadWrite');
+
+  final String benchmarkName;
+
+  const CopyTier(this.benchmarkName);
+}
+
+class TierCopy extends FileCopyBenchmark {
+  final CopyTier tier;
+
+  TierCopy(
+    this.tier,
+    String label,
+    String sizeName,
+    Directory parent,
+    int size,
+  ) : super(tier.benchmarkName, label, sizeName, parent, size);
+
+  @override
+  Future<void> run() async {
+    if (!copyWith(tier, _source.path, _targetPath)) {
+      throw StateError('$name failed');
+    }
+  }
+}
+
+// See fcntl.h and linux/fs.h.
+const _oRdOnly = 0;
+const _oWrOnly = 1;
+const _oCreat = 0x40;
+const _oTrunc = 0x200;
+const _oCloExec = 0x80000;
+const _ficlone = 0x40049409;
+
+// Largest amount copy_file_range and sendfile transfer in one call.
+const _maxTransfer = 0x7ffff000;
+
+// As the buffer File::Copy reads and writes through.
+const _bufferSize = 1024 * 1024;
+
+final _libc = DynamicLibrary.process();
+final _open = _libc.lookupFunction<
+    Int Function(Pointer<Utf8>, Int, VarArgs<(Int,)>),
+    int Function(Pointer<Utf8>, int, int)>('open');
+final _close = _libc.lookupFunction<Int Function(Int), int Function(int)>(
+  'close',
+);
+final _ioctl = _libc.lookupFunction<
+    Int Function(Int, UnsignedLong, VarArgs<(Int,)>),
+    int Function(int, int, int)>('ioctl');
+final _copyFileRange = _libc.lookupFunction<
+    IntPtr Function(
+        Int, Pointer<Int64>, Int, Pointer<Int64>, Size, UnsignedInt),
+    int Function(int, Pointer<Int64>, int, Pointer<Int64>, int, int)>(
+  'copy_file_range',
+);
+final _sendfile = _libc.lookupFunction<
+    IntPtr Function(Int, Int, Pointer<Int64>, Size),
+    int Function(int, int, Pointer<Int64>, int)>('sendfile');
+final _read = _libc.lookupFunction<
+    IntPtr Function(Int, Pointer<Uint8>, Size),
+    int Function(int, Pointer<Uint8>, int)>('read');
+final _write = _libc.lookupFunction<
+    IntPtr Function(Int, Pointer<Uint8>, Size),
+    int Function(int, Pointer<Uint8>, int)>('write');
+
+int _openPath(String path, int flags, int mode) {
+  final nativePath = path.toNativeUtf8();
+  try {
+    final fd = _open(nativePath, flags, mode);
+    if (fd < 0) {
+      throw FileSystemException('Cannot open', path);
+    }
+    return fd;
+  } finally {
+    malloc.free(nativePath);
+  }
+}
+
+/// Copies [source] to [target] the way [tier] does only. Returns false if
+/// that fails, e.g. because the file system does not support it.
+bool copyWith(CopyTier tier, String source, String target) {
+  final sourceFd = _openPath(source, _oRdOnly | _oCloExec, 0);
+  final targetFd = _openPath(
+    target,
+    _oWrOnly | _oCreat | _oTrunc | _oCloExec,
+    420, // 0644
+  );
+  try {
+    int result;
+    switch (tier) {
+      case CopyTier.clone:
+        return _ioctl(targetFd, _ficlone, sourceFd) == 0;
+      case CopyTier.copyFileRange:
+        do {
+          result = _copyFileRange(
+              sourceFd, nullptr, targetFd, nullptr, _maxTransfer, 0);
+        } while (result > 0);
+        return result == 0;
+      case CopyTier.sendfile:
+        do {
+          result = _sendfile(targetFd, sourceFd, nullptr, _maxTransfer);
+        } while (result > 0);
+        return result == 0;
+      case CopyTier.readWrite:
+        final buffer = malloc<Uint8>(_bufferSize);
+        try {
+          while ((result = _read(sourceFd, buffer, _bufferSize)) > 0) {
+            for (int written = 0; written < result;) {
+              final wrote =
+                  _write(targetFd, buffer + written, result - written);
+              if (wrote <= 0) return false;
+              written += wrote;
+            }
+          }
+          return result == 0;
+        } finally {
+          malloc.free(buffer);
+        }
+    }
+  } finally {
+    _close(sourceFd);
+    _close(targetFd);
+  }
+}
+
+/// Whether the file system of [directory] supports copying with [tier].
+bool isSupported(CopyTier tier, Directory directory) {
+  final tempDir = directory.createTempSync('file_copy_benchmark');
+  try {
+    final source = File('${tempDir.path}/source')
+      ..writeAsBytesSync(Uint8List(4096));
+    return copyWith(tier, source.path, '${tempDir.path}/target');
+  } finally {
+    tempDir.deleteSync(recursive: true);
+  }
+}
+
+void main(List<String> args) async {
+  final directories = <String, Directory>{};
+  for (final arg in args) {
+    final separator = arg.indexOf('=');
+    if (separator <= 0) {
+      stderr.writeln('Expected label=directory, got "$arg"');
+      exit(1);
+    }
+    directories[arg.substring(0, separator)] = Directory(
+      arg.substring(separator + 1),
+    );
+  }
+  if (directories.isEmpty) {
+    directories['Temp'] = Directory.systemTemp;
+  }
+
+  for (final MapEntry(key: label, value: directory) in directories.entries) {
+    final tiers = <CopyTier>[];
+    if (Platform.isLinux) {
+      for (final tier in CopyTier.values) {
+        if (isSupported(tier, directory)) {
+          tiers.add(tier);
+        } else {
+          print(
+            'FileCopy.$label.${tier.benchmarkName}: not supported by the '
+            'file system, skipped',
+          );
+        }
+      }
+    }
+    for (final MapEntry(key: sizeName, value: size) in sizes.entries) {
+      final benchmarks = [
+        CopySync(label, sizeName, directory, size),
+        Copy(label, sizeName, directory, size),
+        for (final tier in tiers)
+          TierCopy(tier, label, sizeName, directory, size),
+      ];
+      for (final benchmark in benchmarks) {
+        await benchmark.report();
+      }
+    }
+  }
+}
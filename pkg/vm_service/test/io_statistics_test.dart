@@ -0,0 +1,85 @@
+// Copyright (c) 2026, the Dart project authors. Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:io' as io;
+
+import 'package:test/test.dart';
+import 'package:vm_service/vm_service.dart';
+
+import 'common/test_helper.dart';
+
+const String kGetIOStatisticsRPC = 'ext.dart.io.getIOStatistics';
+const int kEventHandlerThreads = 2;
+
+Future<void> setup() async {
+  // Read from a socket, so that the buffer pool and the event handler have
+  // something to count.
+  final serverSocket = await io.ServerSocket.bind(
+    io.InternetAddress.loopbackIPv4,
+    0,
+  );
+  final received = serverSocket.first.then((socket) => socket.first);
+  final socket = await io.Socket.connect(
+    io.InternetAddress.loopbackIPv4,
+    serverSocket.port,
+  );
+  socket.add([1, 2, 3]);
+  await socket.flush();
+  await received;
+  socket.destroy();
+  await serverSocket.close();
+}
+
+final tests = <IsolateTest>[
+  (VmService service, IsolateRef isolateRef) async {
+    final response = await service.callServiceExtension(
+      kGetIOStatisticsRPC,
+      isolateId: isolateRef.id!,
+    );
+    final json = response.json!;
+    expect(json['type'], 'IOStatistics');
+
+    final bufferPool = json['bufferPool'] as Map<String, dynamic>;
+    final allocations =
+        (bufferPool['hits'] as int) + (bufferPool['misses'] as int);
+    expect(allocations, greaterThan(0));
+    // Every buffer which was returned or discarded was allocated first.
+    expect(
+      allocations,
+      greaterThanOrEqualTo(
+        (bufferPool['returns'] as int) + (bufferPool['discards'] as int),
+      ),
+    );
+
+    final threads = (json['eventHandlerThreads'] as List)
+        .cast<Map<String, dynamic>>();
+    if (!io.Platform.isLinux && !io.Platform.isAndroid) {
+      // Other platforms do not collect event handler statistics.
+      expect(threads, isEmpty);
+      return;
+    }
+    expect(threads.length, kEventHandlerThreads);
+    var wakeups = 0;
+    var events = 0;
+    for (final thread in threads) {
+      wakeups += thread['wakeups'] as int;
+      events += thread['events'] as int;
+      expect(
+        thread['maxLatencyMicros'] as int,
+        lessThanOrEqualTo(thread['totalLatencyMicros'] as int),
+      );
+    }
+    expect(wakeups, greaterThan(0));
+    expect(events, greaterThan(0));
+  },
+];
+
+void main([args = const <String>[]]) => runIsolateTests(
+      args,
+      tests,
+      'io_statistics_test.dart',
+      testeeBefore: setup,
+      extraArgs: ['--event_handler_threads=$kEventHandlerThreads'],
+    );
@@ -102,6 +102,14 @@ typedef void (*Dart_NotifyDestroyedType)();
 typedef void (*Dart_NotifyLowMemoryType)();
 typedef Dart_PerformanceMode (*Dart_SetPerformanceModeType)(
     Dart_PerformanceMode);
+typedef void (*Dart_SetGCPauseTargetType)(int64_t,
+                                          Dart_GCPauseTargetMissedCallback,
+                                          void*);
+typedef void (*Dart_SetIsolateGroupMemoryLimitsType)(
+    intptr_t,
+    intptr_t,
+    Dart_MemoryPressureCallback,
+    void*);
 typedef void (*Dart_StartProfilingType)();
 typedef void (*Dart_StopProfilingType)();
 typedef void (*Dart_ThreadDisableProfilingType)();
@@ -512,6 +520,9 @@ static Dart_SetHeapSamplingPeriodType Dart_SetHeapSamplingPeriodFn = NULL;
 static Dart_NotifyDestroyedType Dart_NotifyDestroyedFn = NULL;
 static Dart_NotifyLowMemoryType Dart_NotifyLowMemoryFn = NULL;
 static Dart_SetPerformanceModeType Dart_SetPerformanceModeFn = NULL;
+static Dart_SetGCPauseTargetType Dart_SetGCPauseTargetFn = NULL;
+static Dart_SetIsolateGroupMemoryLimitsType
+    Dart_SetIsolateGroupMemoryLimitsFn = NULL;
 static Dart_StartProfilingType Dart_StartProfilingFn = NULL;
 static Dart_StopProfilingType Dart_StopProfilingFn = NULL;
 static Dart_ThreadDisableProfilingType Dart_ThreadDisableProfilingFn = NULL;
@@ -870,6 +881,11 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpvReserved) {
         process, "Dart_NotifyLowMemory");
     Dart_SetPerformanceModeFn = (Dart_SetPerformanceModeType)GetProcAddress(
         process, "Dart_SetPerformanceMode");
+    Dart_SetGCPauseTargetFn = (Dart_SetGCPauseTargetType)GetProcAddress(
+        process, "Dart_SetGCPauseTarget");
+    Dart_SetIsolateGroupMemoryLimitsFn =
+        (Dart_SetIsolateGroupMemoryLimitsType)GetProcAddress(
+            process, "Dart_SetIsolateGroupMemoryLimits");
     Dart_StartProfilingFn =
         (Dart_StartProfilingType)GetProcAddress(process, "Dart_StartProfiling");
     Dart_StopProfilingFn =
@@ -1596,6 +1612,18 @@ void Dart_NotifyLowMemory() {
 Dart_PerformanceMode Dart_SetPerformanceMode(Dart_PerformanceMode mode) {
   return Dart_SetPerformanceModeFn(mode);
 }
+void Dart_SetGCPauseTarget(int64_t target_micros,
+                           Dart_GCPauseTargetMissedCallback callback,
+                           void* callback_data) {
+  Dart_SetGCPauseTargetFn(target_micros, callback, callback_data);
+}
+void Dart_SetIsolateGroupMemoryLimits(intptr_t soft_limit_bytes,
+                                      intptr_t hard_limit_bytes,
+                                      Dart_MemoryPressureCallback callback,
+                                      void* callback_data) {
+  Dart_SetIsolateGroupMemoryLimitsFn(soft_limit_bytes, hard_limit_bytes,
+                                     callback, callback_data);
+}
 
 void Dart_StartProfiling() {
   Dart_StartProfilingFn();
@@ -6,6 +6,7 @@
 
 #include "bin/dartutils.h"
 #include "bin/eventhandler.h"
+#include "bin/io_completion_engine.h"
 #include "bin/isolate_data.h"
 #include "bin/process.h"
 #include "bin/secure_socket_filter.h"
@@ -50,6 +51,7 @@ void Cleanup() {
   bin::Process::ClearAllSignalHandlers();
 
   bin::EventHandler::Stop();
+  bin::IOCompletionEngine::Cleanup();
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   bin::SSLFilter::Cleanup();
 #endif
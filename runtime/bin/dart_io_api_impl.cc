@@ -7,6 +7,7 @@
 #include "bin/crypto.h"
 #include "bin/directory.h"
 #include "bin/eventhandler.h"
+#include "bin/io_completion_engine.h"
 #include "bin/io_natives.h"
 #include "bin/platform.h"
 #include "bin/process.h"
@@ -31,6 +32,7 @@ void BootstrapDartIo() {
 
 void CleanupDartIo() {
   EventHandler::Stop();
+  IOCompletionEngine::Cleanup();
   Process::TerminateExitCodeHandler();
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLFilter::Cleanup();
@@ -15,6 +15,7 @@
 #include "include/dart_api.h"
 #include "platform/assert.h"
 #include "platform/syslog.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -328,13 +329,14 @@ CObject* Directory::ListNextRequest(const CObjectArray& request) {
   if (dir_listing->IsEmpty()) {
     return new CObjectArray(CObject::NewArray(0));
   }
-  const int kArraySize = 128;
+  // The packed paths followed by up to 512 entries.
+  const int kArraySize = 1 + 2 * 512;
   CObjectArray* response = new CObjectArray(CObject::NewArray(kArraySize));
   dir_listing->SetArray(response, kArraySize);
   Directory::List(dir_listing);
   // In case the listing ended before it hit the buffer length, we need to
   // override the array length.
-  response->AsApiCObject()->value.as_array.length = dir_listing->index();
+  response->AsApiCObject()->value.as_array.length = dir_listing->FinishArray();
   return response;
 }
 
@@ -380,20 +382,43 @@ bool AsyncDirectoryListing::AddFileSystemEntityToResponse(Response type,
                                                           const char* arg) {
   array_->SetAt(index_++, new CObjectInt32(CObject::NewInt32(type)));
   if (arg != nullptr) {
-    size_t len = strlen(arg);
-    Dart_CObject* io_buffer = CObject::NewIOBuffer(len);
-    uint8_t* data = io_buffer->value.as_external_typed_data.data;
-    memmove(reinterpret_cast<char*>(data), arg, len);
-
-    CObjectExternalUint8Array* external_array =
-        new CObjectExternalUint8Array(io_buffer);
-    array_->SetAt(index_++, external_array);
+    // A single buffer with a single finalizer is much cheaper for the
+    // receiver than an external typed data per entry.
+    const intptr_t len = strlen(arg);
+    if (paths_length_ + len > paths_capacity_) {
+      const intptr_t kInitialCapacity = 16 * KB;
+      paths_capacity_ =
+          Utils::Maximum(Utils::Maximum(paths_capacity_ * 2, kInitialCapacity),
+                         paths_length_ + len);
+      // Handed to IOBuffer::Finalizer, which frees it.
+      paths_ = reinterpret_cast<uint8_t*>(realloc(paths_, paths_capacity_));
+      if (paths_ == nullptr) {
+        FATAL("Failed to allocate directory listing buffer");
+      }
+    }
+    memmove(paths_ + paths_length_, arg, len);
+    paths_length_ += len;
+    array_->SetAt(index_++,
+                  new CObjectIntptr(CObject::NewIntptr(paths_length_)));
   } else {
     array_->SetAt(index_++, CObject::Null());
   }
   return index_ < length_;
 }
 
+intptr_t AsyncDirectoryListing::FinishArray() {
+  if (paths_ == nullptr) {
+    array_->SetAt(0, CObject::Null());
+  } else {
+    array_->SetAt(0, new CObjectExternalUint8Array(
+                         CObject::NewExternalUint8Array(paths_length_, paths_,
+                                                        paths_,
+                                                        IOBuffer::Finalizer)));
+    paths_ = nullptr;
+  }
+  return index_;
+}
+
 bool AsyncDirectoryListing::HandleDirectory(const char* dir_name) {
   return AddFileSystemEntityToResponse(kListDirectory, dir_name);
 }
@@ -172,7 +172,10 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
         DirectoryListing(namespc, dir_name, recursive, follow_links),
         array_(nullptr),
         index_(0),
-        length_(0) {}
+        length_(0),
+        paths_(nullptr),
+        paths_length_(0),
+        paths_capacity_(0) {}
 
   virtual bool HandleDirectory(const char* dir_name);
   virtual bool HandleFile(const char* file_name);
@@ -180,14 +183,24 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
   virtual bool HandleError();
   virtual void HandleDone();
 
+  // Starts a new batch of results in 'array'. The paths of all entries in a
+  // batch are packed into one buffer, which is stored in the first slot of
+  // 'array' by FinishArray(). It is followed by a pair of slots per entry,
+  // holding the entry's type and the end of its path in the buffer (or the
+  // error for kListError).
   void SetArray(CObjectArray* array, intptr_t length) {
-    ASSERT(length % 2 == 0);
+    ASSERT(length % 2 == 1);
     array_ = array;
-    index_ = 0;
+    index_ = 1;
     length_ = length;
+    paths_ = nullptr;
+    paths_length_ = 0;
+    paths_capacity_ = 0;
   }
 
-  intptr_t index() const { return index_; }
+  // Stores the packed paths in the array and returns the number of slots
+  // used.
+  intptr_t FinishArray();
 
  private:
   virtual ~AsyncDirectoryListing() {}
@@ -195,6 +208,9 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
   CObjectArray* array_;
   intptr_t index_;
   intptr_t length_;
+  uint8_t* paths_;
+  intptr_t paths_length_;
+  intptr_t paths_capacity_;
 
   friend class ReferenceCounted<AsyncDirectoryListing>;
   DISALLOW_IMPLICIT_CONSTRUCTORS(AsyncDirectoryListing);
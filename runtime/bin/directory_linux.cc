@@ -7,14 +7,16 @@
 
 #include "bin/directory.h"
 
-#include <dirent.h>     // NOLINT
-#include <errno.h>      // NOLINT
-#include <fcntl.h>      // NOLINT
-#include <stdlib.h>     // NOLINT
-#include <string.h>     // NOLINT
-#include <sys/param.h>  // NOLINT
-#include <sys/stat.h>   // NOLINT
-#include <unistd.h>     // NOLINT
+#include <dirent.h>         // NOLINT
+#include <errno.h>          // NOLINT
+#include <fcntl.h>          // NOLINT
+#include <stdlib.h>         // NOLINT
+#include <string.h>         // NOLINT
+#include <sys/param.h>      // NOLINT
+#include <sys/stat.h>       // NOLINT
+#include <sys/syscall.h>    // NOLINT
+#include <sys/sysmacros.h>  // NOLINT
+#include <unistd.h>         // NOLINT
 
 #include "bin/crypto.h"
 #include "bin/dartutils.h"
@@ -80,6 +82,99 @@ struct LinkList {
   LinkList* next;
 };
 
+// Layout of the records returned by getdents64(2), which the C library only
+// declares in recent versions.
+struct LinuxDirent64 {
+  ino64_t d_ino;
+  int64_t d_off;
+  uint16_t d_reclen;
+  uint8_t d_type;
+  char d_name[];
+};
+
+// Reads a directory with getdents64(2) into a buffer which holds many more
+// entries than the one used by readdir(3), so large directories take fewer
+// system calls.
+class DirectoryReader {
+ public:
+  explicit DirectoryReader(int fd) : fd_(fd), position_(0), length_(0) {}
+  ~DirectoryReader() { close(fd_); }
+
+  int fd() const { return fd_; }
+
+  // Returns the next entry, or nullptr at the end of the directory or on
+  // errors, which leave errno set.
+  LinuxDirent64* Next() {
+    if (position_ == length_) {
+      const intptr_t result = TEMP_FAILURE_RETRY(
+          syscall(SYS_getdents64, fd_, buffer_, sizeof(buffer_)));
+      if (result <= 0) {
+        return nullptr;
+      }
+      position_ = 0;
+      length_ = result;
+    }
+    LinuxDirent64* entry =
+        reinterpret_cast<LinuxDirent64*>(buffer_ + position_);
+    position_ += entry->d_reclen;
+    return entry;
+  }
+
+ private:
+  static constexpr intptr_t kBufferSize = 64 * KB;
+
+  int fd_;
+  intptr_t position_;
+  intptr_t length_;
+  alignas(LinuxDirent64) char buffer_[kBufferSize];
+
+  DISALLOW_COPY_AND_ASSIGN(DirectoryReader);
+};
+
+// The type and identity of a directory entry.
+struct EntryInfo {
+  mode_t mode;
+  decltype(stat64::st_dev) dev;
+  ino64_t ino;
+};
+
+// Looks up the entry 'name' in the directory 'dirfd', following a symbolic
+// link if 'follow' is true. Resolving the name relative to the directory
+// avoids walking the full path again for every entry. Where available only
+// the type and inode number are requested, which spares file systems that
+// compute the other attributes on demand.
+static bool StatEntry(int dirfd,
+                      const char* name,
+                      bool follow,
+                      EntryInfo* info) {
+  const int flags = follow ? 0 : AT_SYMLINK_NOFOLLOW;
+#if defined(DART_HOST_OS_LINUX) && defined(STATX_TYPE)
+  struct statx stx;
+  if (TEMP_FAILURE_RETRY(statx(dirfd, name, flags | AT_STATX_DONT_SYNC,
+                               STATX_TYPE | STATX_INO, &stx)) == 0) {
+    info->mode = stx.stx_mode;
+    info->dev = makedev(stx.stx_dev_major, stx.stx_dev_minor);
+    info->ino = stx.stx_ino;
+    return true;
+  }
+  if (errno != ENOSYS) {
+    return false;
+  }
+#endif
+  struct stat64 st;
+  if (TEMP_FAILURE_RETRY(fstatat64(dirfd, name, &st, flags)) != 0) {
+    return false;
+  }
+  info->mode = st.st_mode;
+  info->dev = st.st_dev;
+  info->ino = st.st_ino;
+  return true;
+}
+
+static bool IsDotOrDotDot(const char* name) {
+  return (strcmp(name, ".") == 0) || (strcmp(name, "..") == 0);
+}
+
 ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   if (done_) {
     return kListDone;
@@ -88,8 +183,8 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   if (fd_ == -1) {
     ASSERT(lister_ == 0);
     NamespaceScope ns(listing->namespc(), listing->path_buffer().AsString());
-    const int listingfd =
-        TEMP_FAILURE_RETRY(openat64(ns.fd(), ns.path(), O_DIRECTORY));
+    const int listingfd = TEMP_FAILURE_RETRY(
+        openat64(ns.fd(), ns.path(), O_DIRECTORY | O_RDONLY | O_CLOEXEC));
     if (listingfd < 0) {
       done_ = true;
       return kListError;
@@ -98,13 +193,7 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   }
 
   if (lister_ == 0) {
-    do {
-      lister_ = reinterpret_cast<intptr_t>(fdopendir(fd_));
-    } while ((lister_ == 0) && (errno == EINTR));
-    if (lister_ == 0) {
-      done_ = true;
-      return kListError;
-    }
+    lister_ = reinterpret_cast<intptr_t>(new DirectoryReader(fd_));
     if (parent_ != nullptr) {
       if (!listing->path_buffer().Add(File::PathSeparator())) {
         return kListError;
@@ -112,25 +201,29 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
     }
     path_length_ = listing->path_buffer().length();
   }
-  // Reset.
-  listing->path_buffer().Reset(path_length_);
-  ResetLink();
+  DirectoryReader* reader = reinterpret_cast<DirectoryReader*>(lister_);
 
   // Iterate the directory and post the directories and files to the
   // ports.
-  errno = 0;
-  dirent* entry = readdir(reinterpret_cast<DIR*>(lister_));
-  if (entry != nullptr) {
+  while (true) {
+    // Reset.
+    listing->path_buffer().Reset(path_length_);
+    ResetLink();
+
+    errno = 0;
+    LinuxDirent64* entry = reader->Next();
+    if (entry == nullptr) {
+      break;
+    }
+    if (IsDotOrDotDot(entry->d_name)) {
+      continue;
+    }
     if (!listing->path_buffer().Add(entry->d_name)) {
       done_ = true;
       return kListError;
     }
     switch (entry->d_type) {
       case DT_DIR:
-        if ((strcmp(entry->d_name, ".") == 0) ||
-            (strcmp(entry->d_name, "..") == 0)) {
-          return Next(listing);
-        }
         return kListDirectory;
       case DT_BLK:
       case DT_CHR:
@@ -146,21 +239,16 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
         FALL_THROUGH;
       case DT_UNKNOWN: {
         // On some file systems the entry type is not determined by
-        // readdir. For those and for links we use stat to determine
+        // getdents64. For those and for links we use stat to determine
         // the actual entry type. Notice that stat returns the type of
         // the file pointed to.
-        NamespaceScope ns(listing->namespc(),
-                          listing->path_buffer().AsString());
-        struct stat64 entry_info;
-        int stat_success;
-        stat_success = TEMP_FAILURE_RETRY(
-            fstatat64(ns.fd(), ns.path(), &entry_info, AT_SYMLINK_NOFOLLOW));
-        if (stat_success == -1) {
+        EntryInfo entry_info;
+        if (!StatEntry(reader->fd(), entry->d_name, false, &entry_info)) {
           return kListError;
         }
-        if (listing->follow_links() && S_ISLNK(entry_info.st_mode)) {
+        if (listing->follow_links() && S_ISLNK(entry_info.mode)) {
           // Check to see if we are in a loop created by a symbolic link.
-          LinkList current_link = {entry_info.st_dev, entry_info.st_ino, link_};
+          LinkList current_link = {entry_info.dev, entry_info.ino, link_};
           LinkList* previous = link_;
           while (previous != nullptr) {
             if ((previous->dev == current_link.dev) &&
@@ -170,9 +258,8 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
             }
             previous = previous->next;
           }
-          stat_success =
-              TEMP_FAILURE_RETRY(fstatat64(ns.fd(), ns.path(), &entry_info, 0));
-          if (stat_success == -1 || (S_IFMT & entry_info.st_mode) == 0) {
+          if (!StatEntry(reader->fd(), entry->d_name, true, &entry_info) ||
+              (S_IFMT & entry_info.mode) == 0) {
             // Report a broken link as a link, even if follow_links is true.
             // A symbolic link can potentially point to an anon_inode. For
             // example, an epoll file descriptor will have a symbolic link whose
@@ -180,24 +267,16 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
             // target doesn't belong to any regular file category.
             return kListLink;
           }
-          if (S_ISDIR(entry_info.st_mode)) {
+          if (S_ISDIR(entry_info.mode)) {
             // Recurse into the subdirectory with current_link added to the
             // linked list of seen file system links.
             link_ = new LinkList(current_link);
-            if ((strcmp(entry->d_name, ".") == 0) ||
-                (strcmp(entry->d_name, "..") == 0)) {
-              return Next(listing);
-            }
             return kListDirectory;
           }
         }
-        if (S_ISDIR(entry_info.st_mode)) {
-          if ((strcmp(entry->d_name, ".") == 0) ||
-              (strcmp(entry->d_name, "..") == 0)) {
-            return Next(listing);
-          }
+        if (S_ISDIR(entry_info.mode)) {
           return kListDirectory;
-        } else if (S_ISLNK(entry_info.st_mode)) {
+        } else if (S_ISLNK(entry_info.mode)) {
           return kListLink;
         } else {
           // Regular files, character devices, block devices, fifos, sockets and
@@ -225,7 +304,9 @@ DirectoryListingEntry::~DirectoryListingEntry() {
   ResetLink();
   if (lister_ != 0) {
     // This also closes fd_.
-    VOID_NO_RETRY_EXPECTED(closedir(reinterpret_cast<DIR*>(lister_)));
+    delete reinterpret_cast<DirectoryReader*>(lister_);
+  } else if (fd_ != -1) {
+    close(fd_);
   }
 }
 
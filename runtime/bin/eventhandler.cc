@@ -9,6 +9,7 @@
 #include "bin/lockers.h"
 #include "bin/socket.h"
 #include "bin/thread.h"
+#include "platform/utils.h"
 
 #include "include/dart_api.h"
 
@@ -18,6 +19,45 @@ namespace bin {
 static EventHandler* event_handler = nullptr;
 static Monitor* shutdown_monitor = nullptr;
 
+// Number of event handler threads which have not yet finished shutting down.
+static intptr_t running_shards = 0;
+// Number of event handler threads which are still polling.
+static intptr_t polling_shards = 0;
+
+bool EventHandler::use_io_uring_polling_ = false;
+intptr_t EventHandler::thread_count_ = 1;
+
+EventHandler::EventHandler() : additional_shards_(nullptr), shard_count_(1) {
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  shard_count_ = Utils::Minimum(thread_count_, kMaxThreadCount);
+  if (shard_count_ > 1) {
+    additional_shards_ = new EventHandlerImplementation[shard_count_ - 1];
+  }
+#endif
+}
+
+EventHandler::~EventHandler() {
+  delete[] additional_shards_;
+}
+
+EventHandlerImplementation* EventHandler::ShardFor(intptr_t id) {
+  if ((shard_count_ == 1) || (id == kTimerId) || (id == kShutdownId)) {
+    return &delegate_;
+  }
+  return shard(reinterpret_cast<Socket*>(id)->event_handler_shard());
+}
+
+intptr_t EventHandler::ShardForDescriptor(intptr_t fd) {
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  if (fd < 0) {
+    return 0;
+  }
+  return fd % Utils::Minimum(thread_count_, kMaxThreadCount);
+#else
+  return 0;
+#endif
+}
+
 void EventHandler::Start() {
   // Initialize global socket registry.
   ListeningSocketRegistry::Initialize();
@@ -25,16 +65,32 @@ void EventHandler::Start() {
   ASSERT(event_handler == nullptr);
   shutdown_monitor = new Monitor();
   event_handler = new EventHandler();
-  event_handler->delegate_.Start(event_handler);
+  running_shards = event_handler->shard_count_;
+  polling_shards = event_handler->shard_count_;
+  for (intptr_t i = 0; i < event_handler->shard_count_; i++) {
+    event_handler->shard(i)->Start(event_handler);
+  }
 
   if (!SocketBase::Initialize()) {
     FATAL("Failed to initialize sockets");
   }
 }
 
+void EventHandler::WaitForShardsToStop() {
+  MonitorLocker ml(shutdown_monitor);
+  polling_shards--;
+  if (polling_shards == 0) {
+    ml.NotifyAll();
+  }
+  while (polling_shards > 0) {
+    ml.Wait(Monitor::kNoTimeout);
+  }
+}
+
 void EventHandler::NotifyShutdownDone() {
   MonitorLocker ml(shutdown_monitor);
-  ml.Notify();
+  running_shards--;
+  ml.NotifyAll();
 }
 
 void EventHandler::Stop() {
@@ -47,8 +103,12 @@ void EventHandler::Stop() {
     MonitorLocker ml(shutdown_monitor);
 
     // Signal to event handler that we want it to stop.
-    event_handler->delegate_.Shutdown();
-    ml.Wait(Monitor::kNoTimeout);
+    for (intptr_t i = 0; i < event_handler->shard_count_; i++) {
+      event_handler->shard(i)->Shutdown();
+    }
+    while (running_shards > 0) {
+      ml.Wait(Monitor::kNoTimeout);
+    }
   }
 
   // Cleanup
@@ -68,6 +128,20 @@ EventHandlerImplementation* EventHandler::delegate() {
   return &event_handler->delegate_;
 }
 
+bool EventHandler::GetStatistics(intptr_t shard,
+                                 EventHandlerStatistics* stats) {
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  if ((event_handler == nullptr) || (shard < 0) ||
+      (shard >= event_handler->shard_count_)) {
+    return false;
+  }
+  event_handler->shard(shard)->GetStatistics(stats);
+  return true;
+#else
+  return false;
+#endif
+}
+
 void EventHandler::SendFromNative(intptr_t id, Dart_Port port, int64_t data) {
   event_handler->SendData(id, port, data);
 }
@@ -107,5 +181,29 @@ void FUNCTION_NAME(EventHandler_TimerMillisecondClock)(
   Dart_SetReturnValue(args, Dart_NewInteger(now));
 }
 
+// Returns the wakeups, events, total and maximum loop latency of each event
+// handler thread, four integers per thread.
+void FUNCTION_NAME(EventHandler_GetStatistics)(Dart_NativeArguments args) {
+  const intptr_t kCounters = 4;
+  EventHandlerStatistics stats[EventHandler::kMaxThreadCount];
+  intptr_t count = 0;
+  while ((count < EventHandler::kMaxThreadCount) &&
+         EventHandler::GetStatistics(count, &stats[count])) {
+    count++;
+  }
+  Dart_Handle result = Dart_NewList(count * kCounters);
+  ThrowIfError(result);
+  for (intptr_t i = 0; i < count; i++) {
+    const int64_t counters[kCounters] = {
+        stats[i].wakeups, stats[i].events, stats[i].total_latency_micros,
+        stats[i].max_latency_micros};
+    for (intptr_t j = 0; j < kCounters; j++) {
+      ThrowIfError(Dart_ListSetAt(result, i * kCounters + j,
+                                  Dart_NewInteger(counters[j])));
+    }
+  }
+  Dart_SetReturnValue(args, result);
+}
+
 }  // namespace bin
 }  // namespace dart
@@ -590,6 +590,15 @@ class DescriptorInfoMultipleMixin : public DI {
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfoMultipleMixin);
 };
 
+// Counters of a single event handler thread. The loop latency of a wakeup is
+// the time spent handling the events it returned.
+struct EventHandlerStatistics {
+  int64_t wakeups;
+  int64_t events;
+  int64_t total_latency_micros;
+  int64_t max_latency_micros;
+};
+
 }  // namespace bin
 }  // namespace dart
 
@@ -611,9 +620,13 @@ namespace bin {
 
 class EventHandler {
  public:
-  EventHandler() {}
+  EventHandler();
+  ~EventHandler();
+
+  // Sockets are handled by the thread picked for them when they were created,
+  // see ShardForDescriptor(). Timers are handled by the first thread.
   void SendData(intptr_t id, Dart_Port dart_port, int64_t data) {
-    delegate_.SendData(id, dart_port, data);
+    ShardFor(id)->SendData(id, dart_port, data);
   }
 
   /**
@@ -632,13 +645,74 @@ class EventHandler {
    */
   static void Stop();
 
+  // The first event handler thread. Platform code which needs the poller
+  // itself only runs with a single thread.
   static EventHandlerImplementation* delegate();
 
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
+  /**
+   * Whether to poll descriptors for readiness through io_uring instead of
+   * epoll. Only the polling uses io_uring: sockets are still read, written
+   * and accepted by separate system calls once they are reported ready. Only
+   * honored on Linux, where the event handler falls back to epoll if the
+   * kernel lacks io_uring support. Must be set before Start().
+   */
+  static bool use_io_uring_polling() { return use_io_uring_polling_; }
+  static void set_use_io_uring_polling(bool value) {
+    use_io_uring_polling_ = value;
+  }
+
+  /**
+   * Number of event handler threads, each polling its own share of the
+   * descriptors. Only honored on Linux and Android, other platforms always
+   * use a single thread. Must be set before Start().
+   */
+  static intptr_t thread_count() { return thread_count_; }
+  static void set_thread_count(intptr_t value) {
+    ASSERT(value >= 1);
+    thread_count_ = value;
+  }
+
+  /**
+   * Fills in the counters of the given event handler thread. Returns false
+   * if the event handler is not running, `shard` is out of range or the
+   * platform does not collect statistics.
+   */
+  static bool GetStatistics(intptr_t shard, EventHandlerStatistics* stats);
+
+  /**
+   * The event handler thread which handles the descriptor `fd`. Sockets call
+   * this once, when they are created, so that every Dart socket sharing a
+   * listening descriptor ends up on the same thread, and messages sent after
+   * the descriptor was closed go to the thread which knew it.
+   */
+  static intptr_t ShardForDescriptor(intptr_t fd);
+
+  /**
+   * Called by each event handler thread once it has stopped polling. Returns
+   * when all of them have, so that every socket has been released.
+   */
+  void WaitForShardsToStop();
+
+  static constexpr intptr_t kMaxThreadCount = 64;
+
  private:
   friend class EventHandlerImplementation;
+
+  EventHandlerImplementation* ShardFor(intptr_t id);
+  EventHandlerImplementation* shard(intptr_t index) {
+    ASSERT((index >= 0) && (index < shard_count_));
+    return (index == 0) ? &delegate_ : &additional_shards_[index - 1];
+  }
+
   EventHandlerImplementation delegate_;
+  // Threads beyond the first, shard_count_ - 1 of them.
+  EventHandlerImplementation* additional_shards_;
+  intptr_t shard_count_;
+
+  static bool use_io_uring_polling_;
+  static intptr_t thread_count_;
 
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
 };
@@ -24,12 +24,31 @@
 #include "bin/process.h"
 #include "bin/socket.h"
 #include "bin/thread.h"
+#include "bin/utils.h"
 #include "platform/syslog.h"
 #include "platform/utils.h"
 
 namespace dart {
 namespace bin {
 
+#if defined(DART_HOST_OS_LINUX)
+// With --enable-io-uring, io_uring replaces epoll for readiness polling only:
+// each descriptor has a multishot IORING_OP_POLL_ADD request armed, and the
+// completions are drained in batches. Reads, writes and accepts of sockets
+// are still separate system calls made once a descriptor is reported ready.
+//
+// Size of the io_uring submission queue. The completion queue is twice as
+// large.
+static constexpr uint32_t kIOUringEntries = 256;
+
+// user_data values with special meaning. Ids of descriptor polls start after
+// these.
+static constexpr uintptr_t kIgnoredPollId = 0;
+static constexpr uintptr_t kInterruptPollId = 1;
+static constexpr uintptr_t kTimerPollId = 2;
+static constexpr uintptr_t kFirstDescriptorPollId = 3;
+#endif
+
 intptr_t DescriptorInfo::GetPollEvents() {
   // Do not ask for EPOLLERR and EPOLLHUP explicitly as they are
   // triggered anyway.
@@ -71,7 +90,19 @@ static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
 }
 
 EventHandlerImplementation::EventHandlerImplementation()
-    : socket_map_(&SimpleHashMap::SamePointerValue, 16) {
+    :
+#if defined(DART_HOST_OS_LINUX)
+      poll_map_(&SimpleHashMap::SamePointerValue, 16),
+      next_poll_id_(kFirstDescriptorPollId),
+      uring_(nullptr),
+#endif
+      handler_(nullptr),
+      socket_map_(&SimpleHashMap::SamePointerValue, 16),
+      epoll_fd_(-1),
+      wakeups_(0),
+      events_(0),
+      total_latency_micros_(0),
+      max_latency_micros_(0) {
   intptr_t result;
   result = NO_RETRY_EXPECTED(pipe2(interrupt_fds_, O_CLOEXEC));
   if (result != 0) {
@@ -81,6 +112,15 @@ EventHandlerImplementation::EventHandlerImplementation()
     FATAL("Failed to set pipe fd non blocking\n");
   }
   shutdown_ = false;
+  timer_fd_ = NO_RETRY_EXPECTED(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC));
+  if (timer_fd_ == -1) {
+    FATAL("Failed creating timerfd file descriptor: %i", errno);
+  }
+#if defined(DART_HOST_OS_LINUX)
+  if (EventHandler::use_io_uring_polling() && InitializeIOUring()) {
+    return;
+  }
+#endif
   // The initial size passed to epoll_create is ignore on newer (>=
   // 2.6.8) Linux versions
   epoll_fd_ = NO_RETRY_EXPECTED(epoll_create1(O_CLOEXEC));
@@ -96,10 +136,6 @@ EventHandlerImplementation::EventHandlerImplementation()
   if (status == -1) {
     FATAL("Failed adding interrupt fd to epoll instance");
   }
-  timer_fd_ = NO_RETRY_EXPECTED(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC));
-  if (timer_fd_ == -1) {
-    FATAL("Failed creating timerfd file descriptor: %i", errno);
-  }
   // Register the timer_fd_ with the epoll instance.
   event.events = EPOLLIN;
   event.data.fd = timer_fd_;
@@ -118,8 +154,16 @@ static void DeleteDescriptorInfo(void* info) {
 }
 
 EventHandlerImplementation::~EventHandlerImplementation() {
+#if defined(DART_HOST_OS_LINUX)
+  // Tearing down the ring cancels all armed polls, which must happen before
+  // the descriptors are closed for the close to release the files.
+  delete uring_;
+  uring_ = nullptr;
+#endif
   socket_map_.Clear(DeleteDescriptorInfo);
-  close(epoll_fd_);
+  if (epoll_fd_ != -1) {
+    close(epoll_fd_);
+  }
   close(timer_fd_);
   close(interrupt_fds_[0]);
   close(interrupt_fds_[1]);
@@ -129,16 +173,140 @@ void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
                                                      DescriptorInfo* di) {
   intptr_t new_mask = di->Mask();
   if ((old_mask != 0) && (new_mask == 0)) {
-    RemoveFromEpollInstance(epoll_fd_, di);
+    RemoveFromPoller(di);
   } else if ((old_mask == 0) && (new_mask != 0)) {
-    AddToEpollInstance(epoll_fd_, di);
+    AddToPoller(di);
   } else if ((old_mask != 0) && (new_mask != 0) && (old_mask != new_mask)) {
     ASSERT(!di->IsListeningSocket());
-    RemoveFromEpollInstance(epoll_fd_, di);
-    AddToEpollInstance(epoll_fd_, di);
+    RemoveFromPoller(di);
+    AddToPoller(di);
+  }
+}
+
+void EventHandlerImplementation::AddToPoller(DescriptorInfo* di) {
+#if defined(DART_HOST_OS_LINUX)
+  if (uring_ != nullptr) {
+    AddToIOUring(di);
+    return;
   }
+#endif
+  AddToEpollInstance(epoll_fd_, di);
+}
+
+void EventHandlerImplementation::RemoveFromPoller(DescriptorInfo* di) {
+#if defined(DART_HOST_OS_LINUX)
+  if (uring_ != nullptr) {
+    RemoveFromIOUring(di);
+    return;
+  }
+#endif
+  RemoveFromEpollInstance(epoll_fd_, di);
 }
 
+#if defined(DART_HOST_OS_LINUX)
+static void* GetHashmapKeyFromPollId(uintptr_t poll_id) {
+  return reinterpret_cast<void*>(poll_id);
+}
+
+static uint32_t GetHashmapHashFromPollId(uintptr_t poll_id) {
+  return dart::Utils::WordHash(poll_id);
+}
+
+bool EventHandlerImplementation::InitializeIOUring() {
+  // Multishot polls (and with them IORING_FEAT_RSRC_TAGS) arrived in 5.13.
+  // IORING_FEAT_NODROP guarantees completions are not lost when the
+  // completion queue overflows.
+  uring_ = IOUring::Create(kIOUringEntries,
+                           IORING_FEAT_RSRC_TAGS | IORING_FEAT_NODROP);
+  if (uring_ == nullptr) {
+    return false;
+  }
+  if (!ArmIOUringPoll(interrupt_fds_[0], kInterruptPollId, EPOLLIN) ||
+      !ArmIOUringPoll(timer_fd_, kTimerPollId, EPOLLIN) ||
+      (uring_->Submit() < 0)) {
+    delete uring_;
+    uring_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool EventHandlerImplementation::ArmIOUringPoll(intptr_t fd,
+                                                uintptr_t poll_id,
+                                                uint32_t events,
+                                                bool multishot) {
+  struct io_uring_sqe* sqe = uring_->GetSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll32_events = events;
+  sqe->len = multishot ? IORING_POLL_ADD_MULTI : 0;
+  sqe->user_data = poll_id;
+  return true;
+}
+
+void EventHandlerImplementation::AddToIOUring(DescriptorInfo* di) {
+  ASSERT(di->poll_id() == kIgnoredPollId);
+  // A multishot poll posts a completion for every new wakeup of the
+  // descriptor, matching the edge triggered epoll registration of regular
+  // sockets. It does not report readiness which is left over after a
+  // dispatch, like several pending connections, so listening sockets get a
+  // single shot poll instead. HandleCompletions() re-arms it after every
+  // completion while the descriptor has ports with tokens, and arming checks
+  // the current readiness, like their level triggered epoll registration.
+  uint32_t events = EPOLLRDHUP | di->GetPollEvents();
+  const bool multishot = !di->IsListeningSocket();
+  if (multishot) {
+    events |= EPOLLET;
+  }
+  const uintptr_t poll_id = next_poll_id_++;
+  if (next_poll_id_ < kFirstDescriptorPollId) {
+    next_poll_id_ = kFirstDescriptorPollId;
+  }
+  if (!ArmIOUringPoll(di->fd(), poll_id, events, multishot)) {
+    // Same handling as a descriptor epoll refuses to accept.
+    di->NotifyAllDartPorts(1 << kCloseEvent);
+    return;
+  }
+  di->set_poll_id(poll_id);
+  SimpleHashMap::Entry* entry =
+      poll_map_.Lookup(GetHashmapKeyFromPollId(poll_id),
+                       GetHashmapHashFromPollId(poll_id), true);
+  ASSERT(entry->value == nullptr);
+  entry->value = di;
+}
+
+void EventHandlerImplementation::ForgetIOUringPoll(DescriptorInfo* di) {
+  const uintptr_t poll_id = di->poll_id();
+  ASSERT(poll_id != kIgnoredPollId);
+  poll_map_.Remove(GetHashmapKeyFromPollId(poll_id),
+                   GetHashmapHashFromPollId(poll_id));
+  di->set_poll_id(kIgnoredPollId);
+}
+
+void EventHandlerImplementation::RemoveFromIOUring(DescriptorInfo* di) {
+  const uintptr_t poll_id = di->poll_id();
+  if (poll_id == kIgnoredPollId) {
+    return;
+  }
+  ForgetIOUringPoll(di);
+  // The removal is submitted together with everything else queued during
+  // this loop iteration, before the handler blocks again. The armed poll
+  // holds a reference to the file, so the descriptor may already be closed
+  // by then.
+  struct io_uring_sqe* sqe = uring_->GetSqe();
+  if (sqe == nullptr) {
+    FATAL("Failed to queue io_uring poll removal: %s", strerror(errno));
+  }
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = poll_id;
+  sqe->user_data = kIgnoredPollId;
+}
+#endif  // defined(DART_HOST_OS_LINUX)
+
 DescriptorInfo* EventHandlerImplementation::GetDescriptorInfo(
     intptr_t fd,
     bool is_listening) {
@@ -188,9 +356,20 @@ void EventHandlerImplementation::WakeupHandler(intptr_t id,
 void EventHandlerImplementation::HandleInterruptFd() {
   const intptr_t MAX_MESSAGES = kInterruptMessageSize;
   InterruptMessage msg[MAX_MESSAGES];
-  ssize_t bytes = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
-      read(interrupt_fds_[0], msg, MAX_MESSAGES * kInterruptMessageSize));
-  for (ssize_t i = 0; i < bytes / kInterruptMessageSize; i++) {
+  // Read until the pipe is empty: unlike the level triggered epoll
+  // registration, the multishot io_uring poll of the pipe does not report
+  // messages which are left after a full batch.
+  ssize_t bytes;
+  do {
+    bytes = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
+        read(interrupt_fds_[0], msg, MAX_MESSAGES * kInterruptMessageSize));
+    HandleInterruptMessages(msg, bytes / kInterruptMessageSize);
+  } while (bytes == MAX_MESSAGES * kInterruptMessageSize);
+}
+
+void EventHandlerImplementation::HandleInterruptMessages(InterruptMessage* msg,
+                                                         intptr_t count) {
+  for (intptr_t i = 0; i < count; i++) {
     if (msg[i].id == kTimerId) {
       timeout_queue_.UpdateTimeout(msg[i].dart_port, msg[i].data);
       UpdateTimerFd();
@@ -340,6 +519,31 @@ intptr_t EventHandlerImplementation::GetPollEvents(intptr_t events,
   return event_mask;
 }
 
+void EventHandlerImplementation::HandleTimerFd() {
+  int64_t val;
+  VOID_TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(read(timer_fd_, &val, sizeof(val)));
+  if (timeout_queue_.HasTimeout()) {
+    DartUtils::PostNull(timeout_queue_.CurrentPort());
+    timeout_queue_.RemoveCurrent();
+  }
+  UpdateTimerFd();
+}
+
+void EventHandlerImplementation::DispatchPollEvents(DescriptorInfo* di,
+                                                    intptr_t events) {
+  const intptr_t old_mask = di->Mask();
+  const intptr_t event_mask = GetPollEvents(events, di);
+  if ((event_mask & (1 << kErrorEvent)) != 0) {
+    di->NotifyAllDartPorts(event_mask);
+    UpdateEpollInstance(old_mask, di);
+  } else if (event_mask != 0) {
+    Dart_Port port = di->NextNotifyDartPort(event_mask);
+    ASSERT(port != 0);
+    UpdateEpollInstance(old_mask, di);
+    DartUtils::PostInt32(port, event_mask);
+  }
+}
+
 void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
                                               int size) {
   bool interrupt_seen = false;
@@ -347,27 +551,66 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
     if (events[i].data.ptr == nullptr) {
       interrupt_seen = true;
     } else if (events[i].data.fd == timer_fd_) {
-      int64_t val;
-      VOID_TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
-          read(timer_fd_, &val, sizeof(val)));
-      if (timeout_queue_.HasTimeout()) {
-        DartUtils::PostNull(timeout_queue_.CurrentPort());
-        timeout_queue_.RemoveCurrent();
-      }
-      UpdateTimerFd();
+      HandleTimerFd();
     } else {
       DescriptorInfo* di =
           reinterpret_cast<DescriptorInfo*>(events[i].data.ptr);
-      const intptr_t old_mask = di->Mask();
-      const intptr_t event_mask = GetPollEvents(events[i].events, di);
-      if ((event_mask & (1 << kErrorEvent)) != 0) {
-        di->NotifyAllDartPorts(event_mask);
-        UpdateEpollInstance(old_mask, di);
-      } else if (event_mask != 0) {
-        Dart_Port port = di->NextNotifyDartPort(event_mask);
-        ASSERT(port != 0);
-        UpdateEpollInstance(old_mask, di);
-        DartUtils::PostInt32(port, event_mask);
+      DispatchPollEvents(di, events[i].events);
+    }
+  }
+  if (interrupt_seen) {
+    // Handle after socket events, so we avoid closing a socket before we handle
+    // the current events.
+    HandleInterruptFd();
+  }
+}
+
+#if defined(DART_HOST_OS_LINUX)
+void EventHandlerImplementation::HandleCompletions(struct io_uring_cqe* cqes,
+                                                   intptr_t size) {
+  bool interrupt_seen = false;
+  for (intptr_t i = 0; i < size; i++) {
+    const uintptr_t poll_id = static_cast<uintptr_t>(cqes[i].user_data);
+    // Without IORING_CQE_F_MORE the poll is done: it was a single shot poll,
+    // or the kernel has terminated the multishot poll (e.g. because it was
+    // removed or ran out of memory). It must be re-armed if still wanted.
+    const bool terminated = (cqes[i].flags & IORING_CQE_F_MORE) == 0;
+    if (poll_id == kIgnoredPollId) {
+      continue;
+    } else if (poll_id == kInterruptPollId) {
+      interrupt_seen = interrupt_seen || (cqes[i].res > 0);
+      if (terminated &&
+          !ArmIOUringPoll(interrupt_fds_[0], kInterruptPollId, EPOLLIN)) {
+        FATAL("Failed re-arming io_uring poll for interrupt fd");
+      }
+    } else if (poll_id == kTimerPollId) {
+      if (cqes[i].res > 0) {
+        HandleTimerFd();
+      }
+      if (terminated && !ArmIOUringPoll(timer_fd_, kTimerPollId, EPOLLIN)) {
+        FATAL("Failed re-arming io_uring poll for timerfd");
+      }
+    } else {
+      SimpleHashMap::Entry* entry =
+          poll_map_.Lookup(GetHashmapKeyFromPollId(poll_id),
+                           GetHashmapHashFromPollId(poll_id), false);
+      if (entry == nullptr) {
+        // The poll was removed after this completion was posted.
+        continue;
+      }
+      DescriptorInfo* di = reinterpret_cast<DescriptorInfo*>(entry->value);
+      if (cqes[i].res > 0) {
+        DispatchPollEvents(di, cqes[i].res);
+      }
+      if (terminated && (di->poll_id() == poll_id)) {
+        ForgetIOUringPoll(di);
+        const int32_t res = cqes[i].res;
+        if ((res < 0) && (res != -ECANCELED) && (res != -ENOMEM)) {
+          // The kernel refuses to poll the descriptor.
+          di->NotifyAllDartPorts(1 << kCloseEvent);
+        } else if (di->Mask() != 0) {
+          AddToIOUring(di);
+        }
       }
     }
   }
@@ -378,13 +621,48 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
   }
 }
 
+void EventHandlerImplementation::PollIOUring() {
+  const intptr_t kMaxCompletions = 64;
+  struct io_uring_cqe cqes[kMaxCompletions];
+  while (!shutdown_) {
+    // Registration changes queued while handling the previous batch are
+    // submitted with the same system call which waits for the next batch.
+    intptr_t result = uring_->SubmitAndWait(1);
+    if ((result < 0) && (errno != EINTR) && (errno != EAGAIN) &&
+        (errno != EBUSY)) {
+      perror("Poll failed");
+    }
+    const int64_t start = TimerUtils::GetCurrentMonotonicMicros();
+    intptr_t total = 0;
+    intptr_t count;
+    while (!shutdown_ &&
+           (count = uring_->DrainCompletions(cqes, kMaxCompletions)) > 0) {
+      HandleCompletions(cqes, count);
+      total += count;
+    }
+    RecordWakeup(total, start);
+  }
+}
+#endif  // defined(DART_HOST_OS_LINUX)
+
 void EventHandlerImplementation::Poll(uword args) {
   ThreadSignalBlocker signal_blocker(SIGPROF);
   const intptr_t kMaxEvents = 16;
   struct epoll_event events[kMaxEvents];
-  EventHandler* handler = reinterpret_cast<EventHandler*>(args);
-  EventHandlerImplementation* handler_impl = &handler->delegate_;
+  EventHandlerImplementation* handler_impl =
+      reinterpret_cast<EventHandlerImplementation*>(args);
   ASSERT(handler_impl != nullptr);
+  EventHandler* handler = handler_impl->handler_;
+
+#if defined(DART_HOST_OS_LINUX)
+  if (handler_impl->uring_ != nullptr) {
+    handler_impl->PollIOUring();
+    handler->WaitForShardsToStop();
+    DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
+    handler->NotifyShutdownDone();
+    return;
+  }
+#endif
 
   while (!handler_impl->shutdown_) {
     intptr_t result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
@@ -395,16 +673,42 @@ void EventHandlerImplementation::Poll(uword args) {
         perror("Poll failed");
       }
     } else {
+      const int64_t start = TimerUtils::GetCurrentMonotonicMicros();
       handler_impl->HandleEvents(events, result);
+      handler_impl->RecordWakeup(result, start);
     }
   }
+  handler->WaitForShardsToStop();
   DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
   handler->NotifyShutdownDone();
 }
 
 void EventHandlerImplementation::Start(EventHandler* handler) {
+  handler_ = handler;
   Thread::Start("dart:io EventHandler", &EventHandlerImplementation::Poll,
-                reinterpret_cast<uword>(handler));
+                reinterpret_cast<uword>(this));
+}
+
+void EventHandlerImplementation::RecordWakeup(intptr_t events,
+                                              int64_t start_micros) {
+  const int64_t latency =
+      TimerUtils::GetCurrentMonotonicMicros() - start_micros;
+  // Only this thread updates the counters, readers may see them torn
+  // between each other.
+  wakeups_.store(wakeups_.load() + 1);
+  events_.store(events_.load() + events);
+  total_latency_micros_.store(total_latency_micros_.load() + latency);
+  if (latency > max_latency_micros_.load()) {
+    max_latency_micros_.store(latency);
+  }
+}
+
+void EventHandlerImplementation::GetStatistics(
+    EventHandlerStatistics* stats) const {
+  stats->wakeups = wakeups_.load();
+  stats->events = events_.load();
+  stats->total_latency_micros = total_latency_micros_.load();
+  stats->max_latency_micros = max_latency_micros_.load();
 }
 
 void EventHandlerImplementation::Shutdown() {
@@ -14,26 +14,38 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include "platform/atomic.h"
 #include "platform/hashmap.h"
 #include "platform/signal_blocker.h"
 
+#if defined(DART_HOST_OS_LINUX)
+#include "bin/io_uring_linux.h"
+#endif
+
 namespace dart {
 namespace bin {
 
 class DescriptorInfo : public DescriptorInfoBase {
  public:
-  explicit DescriptorInfo(intptr_t fd) : DescriptorInfoBase(fd) {}
+  explicit DescriptorInfo(intptr_t fd) : DescriptorInfoBase(fd), poll_id_(0) {}
 
   virtual ~DescriptorInfo() {}
 
   intptr_t GetPollEvents();
 
+  // Identifies the multishot poll request armed for this descriptor when the
+  // io_uring backend is used. 0 if no request is armed.
+  uintptr_t poll_id() const { return poll_id_; }
+  void set_poll_id(uintptr_t poll_id) { poll_id_ = poll_id; }
+
   virtual void Close() {
     close(fd_);
     fd_ = -1;
   }
 
  private:
+  uintptr_t poll_id_;
+
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfo);
 };
 
@@ -71,17 +83,46 @@ class EventHandlerImplementation {
   void Start(EventHandler* handler);
   void Shutdown();
 
+  // May be called from any thread.
+  void GetStatistics(EventHandlerStatistics* stats) const;
+
  private:
+  void RecordWakeup(intptr_t events, int64_t start_micros);
+  void AddToPoller(DescriptorInfo* di);
+  void RemoveFromPoller(DescriptorInfo* di);
   void HandleEvents(struct epoll_event* events, int size);
+  void DispatchPollEvents(DescriptorInfo* di, intptr_t events);
+  void HandleTimerFd();
   static void Poll(uword args);
   void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
   void HandleInterruptFd();
+  void HandleInterruptMessages(InterruptMessage* msg, intptr_t count);
   void UpdateTimerFd();
   void SetPort(intptr_t fd, Dart_Port dart_port, intptr_t mask);
   intptr_t GetPollEvents(intptr_t events, DescriptorInfo* di);
   static void* GetHashmapKeyFromFd(intptr_t fd);
   static uint32_t GetHashmapHashFromFd(intptr_t fd);
 
+#if defined(DART_HOST_OS_LINUX)
+  bool InitializeIOUring();
+  bool ArmIOUringPoll(intptr_t fd,
+                      uintptr_t poll_id,
+                      uint32_t events,
+                      bool multishot = true);
+  void AddToIOUring(DescriptorInfo* di);
+  void RemoveFromIOUring(DescriptorInfo* di);
+  void ForgetIOUringPoll(DescriptorInfo* di);
+  void HandleCompletions(struct io_uring_cqe* cqes, intptr_t size);
+  void PollIOUring();
+
+  // Maps armed poll ids to their DescriptorInfo. Completions whose id is not
+  // in the map belong to requests that were already removed and are dropped.
+  SimpleHashMap poll_map_;
+  uintptr_t next_poll_id_;
+  IOUring* uring_;
+#endif
+
+  EventHandler* handler_;
   SimpleHashMap socket_map_;
   TimeoutQueue timeout_queue_;
   bool shutdown_;
@@ -89,6 +130,11 @@ class EventHandlerImplementation {
   int epoll_fd_;
   int timer_fd_;
 
+  RelaxedAtomic<int64_t> wakeups_;
+  RelaxedAtomic<int64_t> events_;
+  RelaxedAtomic<int64_t> total_latency_micros_;
+  RelaxedAtomic<int64_t> max_latency_micros_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandlerImplementation);
 };
 
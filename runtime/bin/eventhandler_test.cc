@@ -3,7 +3,9 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "bin/eventhandler.h"
+#include "bin/utils.h"
 #include "platform/assert.h"
+#include "platform/utils.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -79,5 +81,41 @@ VM_UNIT_TEST_CASE(CircularLinkedList) {
   list.Remove(4242);
 }
 
+VM_UNIT_TEST_CASE(EventHandlerStatistics) {
+  EventHandlerStatistics stats;
+  EXPECT(!EventHandler::GetStatistics(-1, &stats));
+  EXPECT(!EventHandler::GetStatistics(EventHandler::kMaxThreadCount, &stats));
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  const intptr_t shards = Utils::Minimum(EventHandler::thread_count(),
+                                         EventHandler::kMaxThreadCount);
+  EventHandlerStatistics before[EventHandler::kMaxThreadCount];
+  for (intptr_t i = 0; i < shards; i++) {
+    EXPECT(EventHandler::GetStatistics(i, &before[i]));
+  }
+  EXPECT(!EventHandler::GetStatistics(shards, &stats));
+
+  // Timer messages wake up the first thread. Cancelling the timer of a port
+  // which has none does nothing else.
+  EventHandler::SendFromNative(kTimerId, ILLEGAL_PORT, -1);
+  const int64_t deadline =
+      TimerUtils::GetCurrentMonotonicMicros() + 10 * kMicrosecondsPerSecond;
+  while (EventHandler::GetStatistics(0, &stats) &&
+         (stats.wakeups == before[0].wakeups) &&
+         (TimerUtils::GetCurrentMonotonicMicros() < deadline)) {
+    TimerUtils::Sleep(1);
+  }
+  EXPECT_LT(before[0].wakeups, stats.wakeups);
+  EXPECT_LT(before[0].events, stats.events);
+  EXPECT_LE(before[0].total_latency_micros, stats.total_latency_micros);
+  EXPECT_LE(stats.max_latency_micros, stats.total_latency_micros);
+
+  // The other threads were not woken up.
+  for (intptr_t i = 1; i < shards; i++) {
+    EXPECT(EventHandler::GetStatistics(i, &stats));
+    EXPECT_EQ(before[i].wakeups, stats.wakeups);
+  }
+#endif
+}
+
 }  // namespace bin
 }  // namespace dart
@@ -5,6 +5,9 @@
 #include "bin/file.h"
 
 #include <stdio.h>
+#if !defined(DART_HOST_OS_WINDOWS)
+#include <sys/mman.h>
+#endif
 
 #include "bin/builtin.h"
 #include "bin/dartutils.h"
@@ -15,6 +18,8 @@
 #include "include/dart_api.h"
 #include "include/dart_tools_api.h"
 #include "platform/globals.h"
+#include "platform/signal_blocker.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -171,6 +176,52 @@ void FUNCTION_NAME(File_WriteByte)(Dart_NativeArguments args) {
   }
 }
 
+bool File::map_reads_ = false;
+
+// File::Map() needs page aligned positions. This covers every supported page
+// size.
+static constexpr int64_t kMapAlignment = 64 * KB;
+
+MappedMemory* File::MapForRead(int64_t length,
+                               uint8_t** data,
+                               int64_t* bytes_mapped) {
+  if (!map_reads() || (length < kMinMappedReadSize)) {
+    return nullptr;
+  }
+  // Pipes, sockets and devices either have no position or report a length
+  // of 0 and are read instead.
+  const int64_t position = Position();
+  const int64_t file_length = Length();
+  if ((position < 0) || (file_length <= position)) {
+    return nullptr;
+  }
+  const int64_t available = Utils::Minimum(length, file_length - position);
+  const int64_t offset = position & ~(kMapAlignment - 1);
+  const int64_t map_length = available + (position - offset);
+  if ((available < kMinMappedReadSize) || (map_length > kIntptrMax)) {
+    return nullptr;
+  }
+  MappedMemory* mapping = Map(kReadWrite, offset, map_length);
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+  if (!SetPosition(position + available)) {
+    delete mapping;
+    return nullptr;
+  }
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID) ||           \
+    defined(DART_HOST_OS_MACOS)
+  // Whole file reads are typically consumed front to back, so ask for
+  // aggressive read-ahead and early reclaim of pages already read. This is
+  // only a hint.
+  VOID_NO_RETRY_EXPECTED(
+      madvise(mapping->address(), map_length, MADV_SEQUENTIAL));
+#endif
+  *data = reinterpret_cast<uint8_t*>(mapping->address()) + (position - offset);
+  *bytes_mapped = available;
+  return mapping;
+}
+
 void FUNCTION_NAME(File_Read)(Dart_NativeArguments args) {
   File* file = GetFile(args);
   ASSERT(file != nullptr);
@@ -181,6 +232,20 @@ void FUNCTION_NAME(File_Read)(Dart_NativeArguments args) {
     Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
     return;
   }
+  uint8_t* mapped_data = nullptr;
+  int64_t bytes_mapped = 0;
+  MappedMemory* mapping = file->MapForRead(length, &mapped_data, &bytes_mapped);
+  if (mapping != nullptr) {
+    Dart_Handle mapped_array = Dart_NewExternalTypedDataWithFinalizer(
+        Dart_TypedData_kUint8, mapped_data, bytes_mapped, mapping,
+        mapping->size(), File::MappedMemoryFinalizer);
+    if (Dart_IsError(mapped_array)) {
+      delete mapping;
+      Dart_PropagateError(mapped_array);
+    }
+    Dart_SetReturnValue(args, mapped_array);
+    return;
+  }
   uint8_t* buffer = nullptr;
   Dart_Handle external_array = IOBuffer::Allocate(length, &buffer);
   if (Dart_IsNull(external_array)) {
@@ -470,6 +535,14 @@ void FUNCTION_NAME(File_Lock)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
 }
 
+void FUNCTION_NAME(File_MinMappedReadSize)(Dart_NativeArguments args) {
+  if (File::map_reads()) {
+    Dart_SetIntegerReturnValue(args, File::kMinMappedReadSize);
+  } else {
+    Dart_SetReturnValue(args, Dart_Null());
+  }
+}
+
 void FUNCTION_NAME(File_Create)(Dart_NativeArguments args) {
   Namespace* namespc = Namespace::GetNamespace(args, 0);
   Dart_Handle exclusive_handle = Dart_GetNativeArgument(args, 2);
@@ -1153,6 +1226,18 @@ CObject* File::ReadRequest(const CObjectArray& request) {
     return CObject::FileClosedError();
   }
   const int64_t length = CObjectInt32OrInt64ToInt64(request[1]);
+  uint8_t* mapped_data = nullptr;
+  int64_t bytes_mapped = 0;
+  MappedMemory* mapping = file->MapForRead(length, &mapped_data, &bytes_mapped);
+  if (mapping != nullptr) {
+    auto external_array =
+        new CObjectExternalUint8Array(CObject::NewExternalUint8Array(
+            bytes_mapped, mapped_data, mapping, File::MappedMemoryFinalizer));
+    CObjectArray* result = new CObjectArray(CObject::NewArray(2));
+    result->SetAt(0, new CObjectIntptr(CObject::NewInt32(0)));
+    result->SetAt(1, external_array);
+    return result;
+  }
   Dart_CObject* io_buffer = CObject::NewIOBuffer(length);
   if (io_buffer == nullptr) {
     return CObject::NewOSError();
@@ -145,6 +145,43 @@ class File : public ReferenceCounted<File> {
                     int64_t length,
                     void* start = nullptr);
 
+  /// Maps up to 'length' bytes from the current position of a regular file
+  /// for reading and advances the position past them.
+  ///
+  /// The mapping is private and writable, so writes through '*data' are not
+  /// copied back to the file. '*data' and '*bytes_mapped' describe the mapped
+  /// bytes, which may be fewer than 'length' at the end of the file.
+  ///
+  /// Returns nullptr, without changing the position, if mapped reads are
+  /// disabled, fewer than kMinMappedReadSize bytes would be mapped or the file
+  /// cannot be mapped. The caller should then read the bytes instead.
+  MappedMemory* MapForRead(int64_t length,
+                           uint8_t** data,
+                           int64_t* bytes_mapped);
+
+  // Finalizer for external typed data backed by the result of MapForRead().
+  static void MappedMemoryFinalizer(void* isolate_callback_data, void* peer) {
+    delete reinterpret_cast<MappedMemory*>(peer);
+  }
+
+  // Smallest read which MapForRead() serves from a mapping. Smaller reads are
+  // cheaper to copy than to map.
+  static constexpr int64_t kMinMappedReadSize = 4 * MB;
+
+  // Whether large reads are served by mapping the file instead of copying
+  // it. A mapped file which is truncated while the result of the read is
+  // still alive makes accesses to the truncated part fault, so this is off by
+  // default. File::Map() copies the file on Windows, so reads are never
+  // mapped there.
+  static bool map_reads() {
+#if defined(DART_HOST_OS_WINDOWS)
+    return false;
+#else
+    return map_reads_;
+#endif
+  }
+  static void set_map_reads(bool value) { map_reads_ = value; }
+
   // Read at most 'num_bytes' from the file. It may read less than 'num_bytes'
   // even when EOF is not encountered. If no data is available then `Read`
   // will block waiting for input (e.g. if the file represents a pipe that
@@ -361,6 +398,8 @@ class File : public ReferenceCounted<File> {
   // handle so that the finalizer doesn't run.
   Dart_FinalizableHandle finalizable_handle_;
 
+  static bool map_reads_;
+
   friend class ReferenceCounted<File>;
   DISALLOW_COPY_AND_ASSIGN(File);
 };
@@ -10,9 +10,11 @@
 #include <errno.h>         // NOLINT
 #include <fcntl.h>         // NOLINT
 #include <libgen.h>        // NOLINT
+#include <sys/ioctl.h>     // NOLINT
 #include <sys/mman.h>      // NOLINT
 #include <sys/sendfile.h>  // NOLINT
 #include <sys/stat.h>      // NOLINT
+#include <sys/syscall.h>   // NOLINT
 #include <sys/types.h>     // NOLINT
 #include <unistd.h>        // NOLINT
 #include <utime.h>         // NOLINT
@@ -459,6 +461,84 @@ bool File::RenameLink(Namespace* namespc,
                                      newns.path())) == 0);
 }
 
+// Not defined by older C library headers. See linux/fs.h.
+#if !defined(FICLONE)
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+
+// Whether a failed copy_file_range(2) only means that it cannot copy between
+// the two files, which may still be copied some other way.
+static bool IsCopyFileRangeUnsupported(int error) {
+  // EXDEV: Files on different file systems (before Linux 5.3).
+  // EBADF: Emulation in older C libraries for some file types.
+  return (error == ENOSYS) || (error == EXDEV) || (error == EINVAL) ||
+         (error == EOPNOTSUPP) || (error == EBADF);
+}
+
+// Copies 'old_fd' from '*offset' on to the current position of 'new_fd'
+// without the data passing through user space. The file system may share
+// the data or copy it on the server. Returns 0 when the end of 'old_fd' is
+// reached and -1 on errors, with '*offset' advanced past the bytes copied.
+static intptr_t CopyFileRange(int old_fd, int new_fd, int64_t* offset) {
+#if defined(__NR_copy_file_range)
+  intptr_t result;
+  do {
+    loff_t old_offset = *offset;
+    result = TEMP_FAILURE_RETRY(syscall(__NR_copy_file_range, old_fd,
+                                        &old_offset, new_fd, nullptr,
+                                        static_cast<size_t>(kMaxInt32), 0));
+    *offset = old_offset;
+  } while (result > 0);
+  return result;
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
+// As CopyFileRange() but through a pipe in the kernel.
+static intptr_t SendFile(int old_fd, int new_fd, int64_t* offset) {
+  intptr_t result;
+  do {
+    // Loop to ensure we copy everything, and not only up to 2GB.
+    result = NO_RETRY_EXPECTED(sendfile64(new_fd, old_fd, offset, kMaxUint32));
+  } while (result > 0);
+  return result;
+}
+
+// Copies 'old_fd' from 'offset' on to the current position of 'new_fd' by
+// reading and writing. Returns 0 on success and -1 on errors.
+static intptr_t CopyByReading(int old_fd, int new_fd, int64_t offset) {
+  // Pipes cannot seek, but nothing has been copied from them at this point.
+  if ((offset > 0) &&
+      (NO_RETRY_EXPECTED(lseek64(old_fd, offset, SEEK_SET)) < 0)) {
+    return -1;
+  }
+  // Large enough to amortize the system calls for big files.
+  const intptr_t kBufferSize = 1 * MB;
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(malloc(kBufferSize));
+  if (buffer == nullptr) {
+    errno = ENOMEM;
+    return -1;
+  }
+  intptr_t result;
+  while ((result = TEMP_FAILURE_RETRY(read(old_fd, buffer, kBufferSize))) >
+         0) {
+    intptr_t written = 0;
+    while (written < result) {
+      const intptr_t wrote = TEMP_FAILURE_RETRY(
+          write(new_fd, buffer + written, result - written));
+      if (wrote <= 0) {
+        free(buffer);
+        return -1;
+      }
+      written += wrote;
+    }
+  }
+  free(buffer);
+  return result;
+}
+
 bool File::Copy(Namespace* namespc,
                 const char* old_path,
                 const char* new_path) {
@@ -485,27 +565,35 @@ bool File::Copy(Namespace* namespc,
     close(old_fd);
     return false;
   }
+  // Each method copies from 'offset' on to the current position of 'new_fd',
+  // so a method can take over where the previous one gave up. A positive
+  // result means that the file is not copied yet.
   int64_t offset = 0;
   intptr_t result = 1;
-  while (result > 0) {
-    // Loop to ensure we copy everything, and not only up to 2GB.
-    result = NO_RETRY_EXPECTED(sendfile64(new_fd, old_fd, &offset, kMaxUint32));
-  }
-  // From sendfile man pages:
-  //   Applications may wish to fall back to read(2)/write(2) in the case
-  //   where sendfile() fails with EINVAL or ENOSYS.
-  if ((result < 0) && ((errno == EINVAL) || (errno == ENOSYS))) {
-    const intptr_t kBufferSize = 8 * KB;
-    uint8_t* buffer = reinterpret_cast<uint8_t*>(malloc(kBufferSize));
-    while ((result = TEMP_FAILURE_RETRY(read(old_fd, buffer, kBufferSize))) >
-           0) {
-      int wrote = TEMP_FAILURE_RETRY(write(new_fd, buffer, result));
-      if (wrote != result) {
-        result = -1;
-        break;
+  if (S_ISREG(st.st_mode) && (st.st_size > 0)) {
+    // Copy on write clones share the data until either file is modified.
+    // This fails unless both files are on the same file system and it
+    // supports cloning (e.g. btrfs or XFS).
+    if (NO_RETRY_EXPECTED(ioctl(new_fd, FICLONE, old_fd)) == 0) {
+      result = 0;
+    } else {
+      result = CopyFileRange(old_fd, new_fd, &offset);
+      if ((result == 0) && (offset == 0)) {
+        // Pseudo file systems (e.g. procfs) report a size but copy nothing.
+        result = 1;
+      } else if ((result < 0) && IsCopyFileRangeUnsupported(errno)) {
+        result = 1;
       }
     }
-    free(buffer);
+  }
+  if (result > 0) {
+    result = SendFile(old_fd, new_fd, &offset);
+    // From sendfile man pages:
+    //   Applications may wish to fall back to read(2)/write(2) in the case
+    //   where sendfile() fails with EINVAL or ENOSYS.
+    if ((result < 0) && ((errno == EINVAL) || (errno == ENOSYS))) {
+      result = CopyByReading(old_fd, new_fd, offset);
+    }
   }
   int e = errno;
   close(old_fd);
@@ -4,7 +4,12 @@
 
 #include "bin/io_buffer.h"
 
+#include "bin/builtin.h"
+#include "bin/dartutils.h"
+#include "bin/lockers.h"
+#include "platform/atomic.h"
 #include "platform/memory_sanitizer.h"
+#include "platform/synchronization.h"
 
 namespace dart {
 namespace bin {
@@ -46,5 +51,169 @@ uint8_t* IOBuffer::Reallocate(uint8_t* buffer, intptr_t new_size) {
   return static_cast<uint8_t*>(realloc(buffer, new_size));
 }
 
+// Pooled storage is prefixed with a header recording its size class. The
+// header keeps the data 16 byte aligned, like malloc().
+struct PooledBufferHeader {
+  intptr_t size_class;
+  union {
+    // The next block of a free list.
+    PooledBufferHeader* next;
+    // The size of the data of an unpooled block, which is never on a free
+    // list.
+    intptr_t unpooled_capacity;
+  };
+};
+static_assert(sizeof(PooledBufferHeader) <= 16,
+              "Pooled buffer header must not exceed its reserved space");
+static constexpr intptr_t kPooledHeaderSize = 16;
+static constexpr intptr_t kUnpooledSizeClass = -1;
+
+// Size classes are powers of two from 1KB up to IOBuffer::kMaxPooledSize.
+static constexpr intptr_t kMinPooledSizeLog2 = 10;
+static constexpr intptr_t kNumSizeClasses = 7;
+static_assert((1 << (kMinPooledSizeLog2 + kNumSizeClasses - 1)) ==
+                  IOBuffer::kMaxPooledSize,
+              "Size classes must end at kMaxPooledSize");
+// Upper bound on the memory retained by each free list.
+static constexpr intptr_t kMaxRetainedBytesPerClass = 1 * MB;
+
+class IOBufferPool {
+ public:
+  static intptr_t SizeClassFor(intptr_t size) {
+    if (size > IOBuffer::kMaxPooledSize) {
+      return kUnpooledSizeClass;
+    }
+    intptr_t size_class = 0;
+    while ((static_cast<intptr_t>(1) << (kMinPooledSizeLog2 + size_class)) <
+           size) {
+      size_class++;
+    }
+    return size_class;
+  }
+
+  static intptr_t ClassSize(intptr_t size_class) {
+    return static_cast<intptr_t>(1) << (kMinPooledSizeLog2 + size_class);
+  }
+
+  // The size of the data of the block of [header].
+  static intptr_t Capacity(PooledBufferHeader* header) {
+    return header->size_class == kUnpooledSizeClass
+               ? header->unpooled_capacity
+               : ClassSize(header->size_class);
+  }
+
+  static PooledBufferHeader* Allocate(intptr_t size) {
+    const intptr_t size_class = SizeClassFor(size);
+    if (size_class != kUnpooledSizeClass) {
+      FreeList* list = &free_lists_[size_class];
+      MutexLocker ml(list->mutex);
+      PooledBufferHeader* header = list->head;
+      if (header != nullptr) {
+        list->head = header->next;
+        list->count--;
+        hits_.fetch_add(1);
+        return header;
+      }
+    }
+    misses_.fetch_add(1);
+    const intptr_t capacity =
+        size_class == kUnpooledSizeClass ? size : ClassSize(size_class);
+    PooledBufferHeader* header = reinterpret_cast<PooledBufferHeader*>(
+        malloc(kPooledHeaderSize + capacity));
+    if (header != nullptr) {
+      header->size_class = size_class;
+      if (size_class == kUnpooledSizeClass) {
+        header->unpooled_capacity = capacity;
+      } else {
+        header->next = nullptr;
+      }
+    }
+    return header;
+  }
+
+  static void Free(PooledBufferHeader* header) {
+    const intptr_t size_class = header->size_class;
+    if (size_class != kUnpooledSizeClass) {
+      FreeList* list = &free_lists_[size_class];
+      MutexLocker ml(list->mutex);
+      if (list->count * ClassSize(size_class) < kMaxRetainedBytesPerClass) {
+        header->next = list->head;
+        list->head = header;
+        list->count++;
+        returns_.fetch_add(1);
+        return;
+      }
+    }
+    discards_.fetch_add(1);
+    free(header);
+  }
+
+  static void GetStatistics(IOBuffer::PoolStatistics* statistics) {
+    statistics->hits = hits_.load();
+    statistics->misses = misses_.load();
+    statistics->returns = returns_.load();
+    statistics->discards = discards_.load();
+  }
+
+ private:
+  struct FreeList {
+    // Never destroyed, as finalizers may run while the process exits.
+    Mutex* mutex = new Mutex();
+    PooledBufferHeader* head = nullptr;
+    intptr_t count = 0;
+  };
+
+  static FreeList free_lists_[kNumSizeClasses];
+  static RelaxedAtomic<intptr_t> hits_;
+  static RelaxedAtomic<intptr_t> misses_;
+  static RelaxedAtomic<intptr_t> returns_;
+  static RelaxedAtomic<intptr_t> discards_;
+};
+
+IOBufferPool::FreeList IOBufferPool::free_lists_[kNumSizeClasses];
+RelaxedAtomic<intptr_t> IOBufferPool::hits_ = {0};
+RelaxedAtomic<intptr_t> IOBufferPool::misses_ = {0};
+RelaxedAtomic<intptr_t> IOBufferPool::returns_ = {0};
+RelaxedAtomic<intptr_t> IOBufferPool::discards_ = {0};
+
+uint8_t* IOBuffer::AllocatePooled(intptr_t size, void** peer) {
+  PooledBufferHeader* header = IOBufferPool::Allocate(size);
+  if (header == nullptr) {
+    return nullptr;
+  }
+  *peer = header;
+  return reinterpret_cast<uint8_t*>(header) + kPooledHeaderSize;
+}
+
+Dart_Handle IOBuffer::WrapPooled(uint8_t* data, intptr_t length, void* peer) {
+  PooledBufferHeader* header = reinterpret_cast<PooledBufferHeader*>(peer);
+  ASSERT(data == reinterpret_cast<uint8_t*>(header) + kPooledHeaderSize);
+  // Account for the whole block so the GC sees the retained memory.
+  return Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8, data, length, peer,
+      IOBufferPool::Capacity(header), IOBuffer::PooledFinalizer);
+}
+
+void IOBuffer::FreePooled(void* peer) {
+  IOBufferPool::Free(reinterpret_cast<PooledBufferHeader*>(peer));
+}
+
+void IOBuffer::GetPoolStatistics(PoolStatistics* statistics) {
+  IOBufferPool::GetStatistics(statistics);
+}
+
+void FUNCTION_NAME(IOBuffer_GetPoolStatistics)(Dart_NativeArguments args) {
+  IOBuffer::PoolStatistics statistics;
+  IOBuffer::GetPoolStatistics(&statistics);
+  const int64_t counters[] = {statistics.hits, statistics.misses,
+                              statistics.returns, statistics.discards};
+  Dart_Handle result = Dart_NewList(ARRAY_SIZE(counters));
+  ThrowIfError(result);
+  for (size_t i = 0; i < ARRAY_SIZE(counters); i++) {
+    ThrowIfError(Dart_ListSetAt(result, i, Dart_NewInteger(counters[i])));
+  }
+  Dart_SetReturnValue(args, result);
+}
+
 }  // namespace bin
 }  // namespace dart
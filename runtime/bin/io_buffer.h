@@ -32,6 +32,41 @@ class IOBuffer {
     Free(buffer);
   }
 
+  // Allocate pooled IO buffer storage with room for at least `size` bytes.
+  // Requests up to kMaxPooledSize bytes are served from per size class free
+  // lists, larger ones fall back to malloc(). `peer` receives the handle
+  // which must be passed to WrapPooled() or FreePooled().
+  static uint8_t* AllocatePooled(intptr_t size, void** peer);
+
+  // Wrap the first `length` bytes of pooled storage in an IO buffer dart
+  // object. The storage is returned to its pool when the object is finalized,
+  // so a short read needs neither a second allocation nor a copy.
+  static Dart_Handle WrapPooled(uint8_t* data, intptr_t length, void* peer);
+
+  // Return pooled storage which was not handed to Dart.
+  static void FreePooled(void* peer);
+
+  static void PooledFinalizer(void* isolate_callback_data, void* peer) {
+    FreePooled(peer);
+  }
+
+  struct PoolStatistics {
+    // Allocations served from a free list.
+    intptr_t hits;
+    // Allocations which had to call malloc(), including oversized ones.
+    intptr_t misses;
+    // Storage put back on a free list.
+    intptr_t returns;
+    // Storage freed because its free list was full or it was oversized.
+    intptr_t discards;
+  };
+
+  // The counters are process wide and never reset. They are reported by the
+  // ext.dart.io.getIOStatistics service extension.
+  static void GetPoolStatistics(PoolStatistics* statistics);
+
+  static constexpr intptr_t kMaxPooledSize = 64 * KB;
+
  private:
   DISALLOW_ALLOCATION();
   DISALLOW_IMPLICIT_CONSTRUCTORS(IOBuffer);
@@ -0,0 +1,76 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/io_buffer.h"
+#include "platform/assert.h"
+#include "vm/heap/heap.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+namespace bin {
+
+VM_UNIT_TEST_CASE(IOBuffer_PooledReuse) {
+  IOBuffer::PoolStatistics before;
+  IOBuffer::GetPoolStatistics(&before);
+
+  void* peer = nullptr;
+  uint8_t* data = IOBuffer::AllocatePooled(3000, &peer);
+  EXPECT(data != nullptr);
+  EXPECT(peer != nullptr);
+  // The storage is rounded up to its size class.
+  memset(data, 0xAB, 4 * KB);
+  IOBuffer::FreePooled(peer);
+
+  // A request of the same size class gets the same storage back.
+  void* peer2 = nullptr;
+  uint8_t* data2 = IOBuffer::AllocatePooled(2500, &peer2);
+  EXPECT_EQ(data, data2);
+  EXPECT_EQ(peer, peer2);
+  IOBuffer::FreePooled(peer2);
+
+  IOBuffer::PoolStatistics after;
+  IOBuffer::GetPoolStatistics(&after);
+  EXPECT(after.hits >= before.hits + 1);
+  EXPECT(after.returns >= before.returns + 2);
+}
+
+VM_UNIT_TEST_CASE(IOBuffer_PooledOversized) {
+  IOBuffer::PoolStatistics before;
+  IOBuffer::GetPoolStatistics(&before);
+
+  void* peer = nullptr;
+  uint8_t* data =
+      IOBuffer::AllocatePooled(IOBuffer::kMaxPooledSize + 1, &peer);
+  EXPECT(data != nullptr);
+  data[IOBuffer::kMaxPooledSize] = 1;
+  IOBuffer::FreePooled(peer);
+
+  IOBuffer::PoolStatistics after;
+  IOBuffer::GetPoolStatistics(&after);
+  EXPECT(after.misses >= before.misses + 1);
+  EXPECT(after.discards >= before.discards + 1);
+}
+
+static intptr_t ExternalSizeOfPooled(Heap* heap,
+                                     intptr_t size,
+                                     intptr_t length) {
+  void* peer = nullptr;
+  uint8_t* data = IOBuffer::AllocatePooled(size, &peer);
+  EXPECT(data != nullptr);
+  const intptr_t before = heap->TotalExternalInWords();
+  Dart_Handle buffer = IOBuffer::WrapPooled(data, length, peer);
+  EXPECT_VALID(buffer);
+  return (heap->TotalExternalInWords() - before) * kWordSize;
+}
+
+// The memory retained by a short read is its whole block.
+TEST_CASE(IOBuffer_PooledExternalSize) {
+  Heap* heap = thread->heap();
+  EXPECT_EQ(4 * KB, ExternalSizeOfPooled(heap, 3000, 100));
+  const intptr_t oversized = IOBuffer::kMaxPooledSize + kWordSize;
+  EXPECT_EQ(oversized, ExternalSizeOfPooled(heap, oversized, 100));
+}
+
+}  // namespace bin
+}  // namespace dart
@@ -0,0 +1,24 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/io_completion_engine.h"
+
+namespace dart {
+namespace bin {
+
+bool IOCompletionEngine::enabled_ = false;
+
+#if !defined(DART_HOST_OS_LINUX)
+bool IOCompletionEngine::TrySubmit(intptr_t request_id,
+                                   Dart_Port reply_port,
+                                   int32_t message_id,
+                                   const CObjectArray& data) {
+  return false;
+}
+
+void IOCompletionEngine::Cleanup() {}
+#endif  // !defined(DART_HOST_OS_LINUX)
+
+}  // namespace bin
+}  // namespace dart
@@ -0,0 +1,51 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_IO_COMPLETION_ENGINE_H_
+#define RUNTIME_BIN_IO_COMPLETION_ENGINE_H_
+
+#include "bin/builtin.h"
+#include "bin/dartutils.h"
+#include "platform/globals.h"
+
+namespace dart {
+namespace bin {
+
+// Executes file requests of the IOService asynchronously on a completion
+// based kernel interface (io_uring on Linux) instead of blocking one of the
+// IOService worker threads for the duration of the system call.
+//
+// Requests handed to the engine are queued and submitted to the kernel in
+// batches by a single engine thread, which also posts the replies. On
+// platforms without such an interface TrySubmit() always declines.
+class IOCompletionEngine {
+ public:
+  // Must be set before the first IOService request is dispatched.
+  static bool enabled() { return enabled_; }
+  static void set_enabled(bool value) { enabled_ = value; }
+
+  // Tries to take over the IOService request `request_id` with arguments
+  // `data`. Returns true if the engine accepted the request, in which case it
+  // will post the reply [message_id, response] to `reply_port` itself and
+  // release the reference to the File the request holds. Returns false if
+  // the caller must execute the request synchronously.
+  static bool TrySubmit(intptr_t request_id,
+                        Dart_Port reply_port,
+                        int32_t message_id,
+                        const CObjectArray& data);
+
+  // Waits for in-flight requests and stops the engine thread.
+  static void Cleanup();
+
+ private:
+  static bool enabled_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(IOCompletionEngine);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // RUNTIME_BIN_IO_COMPLETION_ENGINE_H_
@@ -0,0 +1,519 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+#if defined(DART_HOST_OS_LINUX)
+
+#include "bin/io_completion_engine.h"
+
+#include <errno.h>        // NOLINT
+#include <poll.h>         // NOLINT
+#include <string.h>       // NOLINT
+#include <sys/eventfd.h>  // NOLINT
+#include <unistd.h>       // NOLINT
+
+#include "bin/file.h"
+#include "bin/io_buffer.h"
+#if defined(DART_IO_SECURE_SOCKET_DISABLED)
+#include "bin/io_service_no_ssl.h"
+#else  // defined(DART_IO_SECURE_SOCKET_DISABLED)
+#include "bin/io_service.h"
+#endif  // defined(DART_IO_SECURE_SOCKET_DISABLED)
+#include "bin/io_uring_linux.h"
+#include "bin/lockers.h"
+#include "bin/thread.h"
+#include "platform/signal_blocker.h"
+#include "platform/utils.h"
+
+namespace dart {
+namespace bin {
+
+// A file request which has been accepted by the engine. The engine owns the
+// buffer and a reference to the file until the reply has been posted.
+struct IOCompletionOperation {
+  intptr_t request_id;
+  Dart_Port reply_port;
+  int32_t message_id;
+  File* file;
+  uint8_t* buffer;
+  // Number of bytes requested and number of bytes transferred so far. Writes
+  // are resubmitted until all bytes are written.
+  int64_t length;
+  int64_t transferred;
+  IOCompletionOperation* next;
+};
+
+class IOCompletionQueue {
+ public:
+  // Queues `operation` for the engine thread, starting it if necessary.
+  // Returns false if the engine is not available.
+  static bool Enqueue(IOCompletionOperation* operation);
+
+  static void Cleanup();
+
+ private:
+  static bool EnsureStartedLocked();
+  static void EngineEntry(uword param);
+  static void SubmitPending();
+  static bool SubmitOperation(IOCompletionOperation* operation);
+  static void HandleCompletion(IOCompletionOperation* operation, int32_t res);
+  static void PostResponse(IOCompletionOperation* operation, int32_t res);
+  static void ArmWakeupPoll();
+
+  // Size of the submission queue. Operations beyond this stay in the pending
+  // list until slots are freed.
+  static constexpr uint32_t kRingEntries = 128;
+  static constexpr uint64_t kWakeupId = 0;
+
+  static Monitor* monitor_;
+  // Operations waiting to be submitted, in FIFO order.
+  static IOCompletionOperation* pending_head_;
+  static IOCompletionOperation* pending_tail_;
+  // Whether a wakeup was signaled and not yet consumed by the engine thread,
+  // so concurrent submitters share a single eventfd write.
+  static bool wakeup_pending_;
+  static bool started_;
+  static bool running_;
+  static bool shutdown_;
+  static bool terminate_done_;
+  static int wakeup_fd_;
+  static IOUring* ring_;
+  // Only accessed by the engine thread.
+  static intptr_t in_flight_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(IOCompletionQueue);
+};
+
+Monitor* IOCompletionQueue::monitor_ = new Monitor();
+IOCompletionOperation* IOCompletionQueue::pending_head_ = nullptr;
+IOCompletionOperation* IOCompletionQueue::pending_tail_ = nullptr;
+bool IOCompletionQueue::wakeup_pending_ = false;
+bool IOCompletionQueue::started_ = false;
+bool IOCompletionQueue::running_ = false;
+bool IOCompletionQueue::shutdown_ = false;
+bool IOCompletionQueue::terminate_done_ = false;
+int IOCompletionQueue::wakeup_fd_ = -1;
+IOUring* IOCompletionQueue::ring_ = nullptr;
+intptr_t IOCompletionQueue::in_flight_ = 0;
+
+bool IOCompletionQueue::EnsureStartedLocked() {
+  if (started_) {
+    return running_;
+  }
+  started_ = true;
+  // IORING_FEAT_RW_CUR_POS lets reads and writes use and update the file
+  // position like read(2)/write(2), IORING_FEAT_RSRC_TAGS implies multishot
+  // polls (5.13) and IORING_FEAT_NODROP guarantees no completion is lost.
+  ring_ = IOUring::Create(
+      kRingEntries,
+      IORING_FEAT_RW_CUR_POS | IORING_FEAT_RSRC_TAGS | IORING_FEAT_NODROP);
+  if (ring_ == nullptr) {
+    return false;
+  }
+  wakeup_fd_ = NO_RETRY_EXPECTED(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+  if (wakeup_fd_ == -1) {
+    delete ring_;
+    ring_ = nullptr;
+    return false;
+  }
+  ArmWakeupPoll();
+  if (Thread::TryStart("dart:io IOCompletionEngine", EngineEntry, 0) != 0) {
+    close(wakeup_fd_);
+    wakeup_fd_ = -1;
+    delete ring_;
+    ring_ = nullptr;
+    return false;
+  }
+  running_ = true;
+  return true;
+}
+
+void IOCompletionQueue::ArmWakeupPoll() {
+  struct io_uring_sqe* sqe = ring_->GetSqe();
+  if (sqe == nullptr) {
+    FATAL("Failed arming the IOCompletionEngine wakeup poll");
+  }
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = wakeup_fd_;
+  sqe->poll32_events = POLLIN;
+  sqe->len = IORING_POLL_ADD_MULTI;
+  sqe->user_data = kWakeupId;
+}
+
+bool IOCompletionQueue::Enqueue(IOCompletionOperation* operation) {
+  bool signal_wakeup = false;
+  {
+    MonitorLocker locker(monitor_);
+    if (shutdown_ || !EnsureStartedLocked()) {
+      return false;
+    }
+    operation->next = nullptr;
+    if (pending_tail_ == nullptr) {
+      pending_head_ = operation;
+    } else {
+      pending_tail_->next = operation;
+    }
+    pending_tail_ = operation;
+    if (!wakeup_pending_) {
+      wakeup_pending_ = true;
+      signal_wakeup = true;
+    }
+  }
+  if (signal_wakeup) {
+    const uint64_t value = 1;
+    VOID_TEMP_FAILURE_RETRY(write(wakeup_fd_, &value, sizeof(value)));
+  }
+  return true;
+}
+
+bool IOCompletionQueue::SubmitOperation(IOCompletionOperation* operation) {
+  struct io_uring_sqe* sqe = ring_->GetSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  const int64_t remaining = operation->length - operation->transferred;
+  // Like File::WriteFully, never transfer more than kMaxInt32 bytes at once.
+  const uint32_t chunk = static_cast<uint32_t>(
+      remaining > kMaxInt32 ? kMaxInt32 : remaining);
+  sqe->opcode =
+      (operation->request_id == IOService::kFileWriteFromRequest)
+          ? IORING_OP_WRITE
+          : IORING_OP_READ;
+  sqe->fd = operation->file->GetFD();
+  // An offset of -1 uses and advances the current file position.
+  sqe->off = static_cast<uint64_t>(-1);
+  sqe->addr = reinterpret_cast<uint64_t>(operation->buffer +
+                                         operation->transferred);
+  sqe->len = chunk;
+  sqe->user_data = reinterpret_cast<uint64_t>(operation);
+  return true;
+}
+
+void IOCompletionQueue::SubmitPending() {
+  IOCompletionOperation* operations;
+  {
+    MonitorLocker locker(monitor_);
+    operations = pending_head_;
+    pending_head_ = pending_tail_ = nullptr;
+    wakeup_pending_ = false;
+  }
+  while (operations != nullptr) {
+    IOCompletionOperation* next = operations->next;
+    if (!SubmitOperation(operations)) {
+      // The ring is full. Put the remaining operations back in front of the
+      // pending list; they are retried once completions free up slots.
+      MonitorLocker locker(monitor_);
+      IOCompletionOperation* last = operations;
+      while (last->next != nullptr) {
+        last = last->next;
+      }
+      last->next = pending_head_;
+      if (pending_head_ == nullptr) {
+        pending_tail_ = last;
+      }
+      pending_head_ = operations;
+      return;
+    }
+    in_flight_++;
+    operations = next;
+  }
+}
+
+static void PostReply(Dart_Port reply_port,
+                      int32_t message_id,
+                      Dart_CObject* response) {
+  Dart_CObject id;
+  id.type = Dart_CObject_kInt32;
+  id.value.as_int32 = message_id;
+  Dart_CObject* values[2] = {&id, response};
+  Dart_CObject reply;
+  reply.type = Dart_CObject_kArray;
+  reply.value.as_array.length = 2;
+  reply.value.as_array.values = values;
+  if (!Dart_PostCObject(reply_port, &reply)) {
+    // The finalizer of an external typed data is only run if the message was
+    // delivered.
+    if ((response->type == Dart_CObject_kArray) &&
+        (response->value.as_array.length > 0)) {
+      Dart_CObject* last =
+          response->value.as_array
+              .values[response->value.as_array.length - 1];
+      if (last->type == Dart_CObject_kExternalTypedData) {
+        IOBuffer::Free(last->value.as_external_typed_data.peer);
+      }
+    }
+  }
+}
+
+void IOCompletionQueue::PostResponse(IOCompletionOperation* operation,
+                                     int32_t res) {
+  Dart_CObject status;
+  status.type = Dart_CObject_kInt32;
+  if (res < 0) {
+    // Same shape as CObject::NewOSError().
+    const int kBufferSize = 1024;
+    char message[kBufferSize];
+    Dart_CObject code;
+    code.type = Dart_CObject_kInt32;
+    code.value.as_int32 = -res;
+    Dart_CObject text;
+    text.type = Dart_CObject_kString;
+    text.value.as_string =
+        const_cast<char*>(Utils::StrError(-res, message, kBufferSize));
+    status.value.as_int32 = CObject::kOSError;
+    Dart_CObject* values[3] = {&status, &code, &text};
+    Dart_CObject error;
+    error.type = Dart_CObject_kArray;
+    error.value.as_array.length = 3;
+    error.value.as_array.values = values;
+    PostReply(operation->reply_port, operation->message_id, &error);
+    IOBuffer::Free(operation->buffer);
+    return;
+  }
+
+  if (operation->request_id == IOService::kFileWriteFromRequest) {
+    Dart_CObject written;
+    written.type = Dart_CObject_kInt64;
+    written.value.as_int64 = operation->transferred;
+    PostReply(operation->reply_port, operation->message_id, &written);
+    IOBuffer::Free(operation->buffer);
+    return;
+  }
+
+  // Reads hand the buffer over to Dart as an external typed data.
+  Dart_CObject data;
+  data.type = Dart_CObject_kExternalTypedData;
+  data.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+  data.value.as_external_typed_data.length = operation->length;
+  data.value.as_external_typed_data.data = operation->buffer;
+  data.value.as_external_typed_data.peer = operation->buffer;
+  data.value.as_external_typed_data.callback = IOBuffer::Finalizer;
+  CObject::ShrinkIOBuffer(&data, operation->transferred);
+  status.value.as_int32 = CObject::kSuccess;
+  if (operation->request_id == IOService::kFileReadRequest) {
+    Dart_CObject* values[2] = {&status, &data};
+    Dart_CObject result;
+    result.type = Dart_CObject_kArray;
+    result.value.as_array.length = 2;
+    result.value.as_array.values = values;
+    PostReply(operation->reply_port, operation->message_id, &result);
+  } else {
+    ASSERT(operation->request_id == IOService::kFileReadIntoRequest);
+    Dart_CObject bytes_read;
+    bytes_read.type = Dart_CObject_kInt64;
+    bytes_read.value.as_int64 = operation->transferred;
+    Dart_CObject* values[3] = {&status, &bytes_read, &data};
+    Dart_CObject result;
+    result.type = Dart_CObject_kArray;
+    result.value.as_array.length = 3;
+    result.value.as_array.values = values;
+    PostReply(operation->reply_port, operation->message_id, &result);
+  }
+}
+
+void IOCompletionQueue::HandleCompletion(IOCompletionOperation* operation,
+                                         int32_t res) {
+  in_flight_--;
+  if ((res == -EAGAIN) || (res == -EINTR)) {
+    if (SubmitOperation(operation)) {
+      in_flight_++;
+      return;
+    }
+    res = -EBUSY;
+  } else if (res >= 0) {
+    operation->transferred += res;
+    if ((operation->request_id == IOService::kFileWriteFromRequest) &&
+        (res > 0) && (operation->transferred < operation->length)) {
+      // Short write: submit the remainder.
+      if (SubmitOperation(operation)) {
+        in_flight_++;
+        return;
+      }
+      res = -EBUSY;
+    }
+  }
+  PostResponse(operation, res);
+  operation->file->Release();
+  delete operation;
+}
+
+void IOCompletionQueue::EngineEntry(uword param) {
+  ThreadSignalBlocker signal_blocker(SIGPROF);
+  const intptr_t kMaxCompletions = 64;
+  struct io_uring_cqe cqes[kMaxCompletions];
+  while (true) {
+    SubmitPending();
+    {
+      MonitorLocker locker(monitor_);
+      if (shutdown_ && (in_flight_ == 0) && (pending_head_ == nullptr)) {
+        terminate_done_ = true;
+        locker.Notify();
+        return;
+      }
+    }
+    // Everything queued since the last iteration is submitted with the same
+    // system call which waits for the next completion.
+    intptr_t result = ring_->SubmitAndWait(1);
+    if ((result < 0) && (errno != EINTR) && (errno != EAGAIN) &&
+        (errno != EBUSY)) {
+      FATAL("IOCompletionEngine failed: %d", errno);
+    }
+    intptr_t count;
+    while ((count = ring_->DrainCompletions(cqes, kMaxCompletions)) > 0) {
+      for (intptr_t i = 0; i < count; i++) {
+        if (cqes[i].user_data == kWakeupId) {
+          uint64_t value;
+          VOID_TEMP_FAILURE_RETRY(read(wakeup_fd_, &value, sizeof(value)));
+          if ((cqes[i].flags & IORING_CQE_F_MORE) == 0) {
+            ArmWakeupPoll();
+          }
+          continue;
+        }
+        HandleCompletion(
+            reinterpret_cast<IOCompletionOperation*>(cqes[i].user_data),
+            cqes[i].res);
+      }
+    }
+  }
+}
+
+void IOCompletionQueue::Cleanup() {
+  {
+    MonitorLocker locker(monitor_);
+    if (!running_) {
+      return;
+    }
+    shutdown_ = true;
+  }
+  const uint64_t value = 1;
+  VOID_TEMP_FAILURE_RETRY(write(wakeup_fd_, &value, sizeof(value)));
+  {
+    MonitorLocker locker(monitor_);
+    while (!terminate_done_) {
+      locker.Wait(Monitor::kNoTimeout);
+    }
+    running_ = false;
+  }
+  delete ring_;
+  ring_ = nullptr;
+  close(wakeup_fd_);
+  wakeup_fd_ = -1;
+}
+
+static int64_t CObjectInt32OrInt64ToInt64(CObject* cobject) {
+  ASSERT(cobject->IsInt32OrInt64());
+  int64_t result;
+  if (cobject->IsInt32()) {
+    CObjectInt32 value(cobject);
+    result = value.Value();
+  } else {
+    CObjectInt64 value(cobject);
+    result = value.Value();
+  }
+  return result;
+}
+
+bool IOCompletionEngine::TrySubmit(intptr_t request_id,
+                                   Dart_Port reply_port,
+                                   int32_t message_id,
+                                   const CObjectArray& data) {
+  if (!enabled_) {
+    return false;
+  }
+  int64_t length;
+  const uint8_t* source = nullptr;
+  switch (request_id) {
+    case IOService::kFileReadRequest:
+    case IOService::kFileReadIntoRequest: {
+      if ((data.Length() != 2) || !data[0]->IsIntptr() ||
+          !data[1]->IsInt32OrInt64()) {
+        return false;
+      }
+      length = CObjectInt32OrInt64ToInt64(data[1]);
+      // Large reads may be served from a mapping of the file instead, see
+      // File::MapForRead().
+      if ((request_id == IOService::kFileReadRequest) && File::map_reads() &&
+          (length >= File::kMinMappedReadSize)) {
+        return false;
+      }
+      break;
+    }
+    case IOService::kFileWriteFromRequest: {
+      // Only byte typed data is handled here. Other element types and lists
+      // are converted by the synchronous path.
+      if ((data.Length() != 4) || !data[0]->IsIntptr() ||
+          !data[1]->IsTypedData() || !data[2]->IsInt32OrInt64() ||
+          !data[3]->IsInt32OrInt64()) {
+        return false;
+      }
+      CObjectTypedData typed_data(data[1]);
+      if ((typed_data.Type() != Dart_TypedData_kUint8) &&
+          (typed_data.Type() != Dart_TypedData_kInt8)) {
+        return false;
+      }
+      const int64_t start = CObjectInt32OrInt64ToInt64(data[2]);
+      const int64_t end = CObjectInt32OrInt64ToInt64(data[3]);
+      if ((start < 0) || (end > typed_data.Length()) || (start > end)) {
+        return false;
+      }
+      length = end - start;
+      source = typed_data.Buffer() + start;
+      break;
+    }
+    default:
+      return false;
+  }
+  if ((length <= 0) || (length > kIntptrMax)) {
+    return false;
+  }
+
+  CObjectIntptr file_pointer(data[0]);
+  File* file = reinterpret_cast<File*>(file_pointer.Value());
+  if (file->IsClosed()) {
+    return false;
+  }
+  // Writes to stdout and stderr may be captured, see File::WriteFully.
+  if ((request_id == IOService::kFileWriteFromRequest) &&
+      ((file->GetFD() == STDOUT_FILENO) || (file->GetFD() == STDERR_FILENO))) {
+    return false;
+  }
+
+  uint8_t* buffer = IOBuffer::Allocate(static_cast<intptr_t>(length));
+  if (buffer == nullptr) {
+    return false;
+  }
+  if (source != nullptr) {
+    // The request message does not outlive the IOService callback.
+    memmove(buffer, source, length);
+  }
+
+  IOCompletionOperation* operation = new IOCompletionOperation();
+  operation->request_id = request_id;
+  operation->reply_port = reply_port;
+  operation->message_id = message_id;
+  operation->file = file;
+  operation->buffer = buffer;
+  operation->length = length;
+  operation->transferred = 0;
+  operation->next = nullptr;
+  // The operation adopts the reference the request holds (see
+  // File_GetPointer) and releases it once the reply has been posted. A
+  // declined request keeps it for the synchronous path.
+  if (!IOCompletionQueue::Enqueue(operation)) {
+    IOBuffer::Free(buffer);
+    delete operation;
+    return false;
+  }
+  return true;
+}
+
+void IOCompletionEngine::Cleanup() {
+  IOCompletionQueue::Cleanup();
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(DART_HOST_OS_LINUX)
@@ -0,0 +1,93 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+
+#if defined(DART_HOST_OS_LINUX)
+
+#include "bin/dartutils.h"
+#include "bin/file.h"
+#include "bin/io_completion_engine.h"
+#include "bin/io_service.h"
+#include "bin/test_utils.h"
+#include "include/dart_native_api.h"
+#include "platform/assert.h"
+#include "platform/synchronization.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+namespace bin {
+
+static Monitor* reply_monitor = nullptr;
+static bool reply_received = false;
+static int32_t reply_message_id = -1;
+static int32_t reply_status = -1;
+static char reply_prefix[16];
+
+static void CompletionReplyHandler(Dart_Port dest_port_id,
+                                   Dart_CObject* message) {
+  MonitorLocker ml(reply_monitor);
+  ASSERT(message->type == Dart_CObject_kArray);
+  ASSERT(message->value.as_array.length == 2);
+  reply_message_id = message->value.as_array.values[0]->value.as_int32;
+  Dart_CObject* response = message->value.as_array.values[1];
+  ASSERT(response->type == Dart_CObject_kArray);
+  reply_status = response->value.as_array.values[0]->value.as_int32;
+  Dart_CObject* data = response->value.as_array.values[1];
+  const uint8_t* bytes = (data->type == Dart_CObject_kExternalTypedData)
+                             ? data->value.as_external_typed_data.data
+                             : data->value.as_typed_data.values;
+  memmove(reply_prefix, bytes, 13);
+  reply_prefix[13] = '\0';
+  reply_received = true;
+  ml.Notify();
+}
+
+TEST_CASE(IOCompletionEngine_Read) {
+  const char* kFilename =
+      bin::test::GetFileName("runtime/bin/io_completion_engine_test.cc");
+  File* file = File::Open(nullptr, kFilename, File::kRead);
+  EXPECT(file != nullptr);
+
+  reply_monitor = new Monitor();
+  Dart_Port reply_port =
+      Dart_NewNativePort("CompletionReply", CompletionReplyHandler, false);
+  EXPECT(reply_port != ILLEGAL_PORT);
+
+  // The request owns a reference to the file, as after File_GetPointer.
+  file->Retain();
+  CObjectArray data(CObject::NewArray(2));
+  data.SetAt(0, new CObjectIntptr(
+                    CObject::NewIntptr(reinterpret_cast<intptr_t>(file))));
+  data.SetAt(1, new CObjectInt64(CObject::NewInt64(64)));
+
+  IOCompletionEngine::set_enabled(true);
+  const bool accepted = IOCompletionEngine::TrySubmit(
+      IOService::kFileReadRequest, reply_port, 42, data);
+  if (accepted) {
+    MonitorLocker ml(reply_monitor);
+    while (!reply_received) {
+      ml.Wait(Monitor::kNoTimeout);
+    }
+    EXPECT_EQ(42, reply_message_id);
+    EXPECT_EQ(CObject::kSuccess, reply_status);
+    EXPECT_STREQ("// Copyright ", reply_prefix);
+    // The read advanced the file position.
+    EXPECT_EQ(64, file->Position());
+  } else {
+    file->Release();
+  }
+  IOCompletionEngine::Cleanup();
+  IOCompletionEngine::set_enabled(false);
+
+  Dart_CloseNativePort(reply_port);
+  delete reply_monitor;
+  reply_monitor = nullptr;
+  file->Release();
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(DART_HOST_OS_LINUX)
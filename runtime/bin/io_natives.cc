@@ -32,6 +32,7 @@ namespace bin {
   V(Directory_SetAsyncDirectoryListerPointer, 2)                               \
   V(Directory_SetCurrent, 2)                                                   \
   V(Directory_SystemTemp, 1)                                                   \
+  V(EventHandler_GetStatistics, 0)                                             \
   V(EventHandler_SendData, 3)                                                  \
   V(EventHandler_TimerMillisecondClock, 0)                                     \
   V(File_AreIdentical, 3)                                                      \
@@ -54,6 +55,7 @@ namespace bin {
   V(File_LengthFromPath, 2)                                                    \
   V(File_LinkTarget, 2)                                                        \
   V(File_Lock, 4)                                                              \
+  V(File_MinMappedReadSize, 1)                                                 \
   V(File_Open, 3)                                                              \
   V(File_OpenStdio, 1)                                                         \
   V(File_Position, 1)                                                          \
@@ -89,6 +91,7 @@ namespace bin {
   V(InternetAddress_Parse, 1)                                                  \
   V(InternetAddress_ParseScopedLinkLocalAddress, 1)                            \
   V(InternetAddress_RawAddrToString, 1)                                        \
+  V(IOBuffer_GetPoolStatistics, 0)                                             \
   V(IOService_NewServicePort, 0)                                               \
   V(Namespace_Create, 2)                                                       \
   V(Namespace_GetDefault, 0)                                                   \
@@ -164,7 +167,7 @@ namespace bin {
   V(Socket_JoinMulticast, 4)                                                   \
   V(Socket_LeaveMulticast, 4)                                                  \
   V(Socket_Read, 2)                                                            \
-  V(Socket_RecvFrom, 1)                                                        \
+  V(Socket_RecvFromBatch, 2)                                                   \
   V(Socket_ReceiveMessage, 2)                                                  \
   V(Socket_SendMessage, 5)                                                     \
   V(Socket_SendTo, 6)                                                          \
@@ -172,6 +175,7 @@ namespace bin {
   V(Socket_SetRawOption, 4)                                                    \
   V(Socket_SetSocketId, 3)                                                     \
   V(Socket_WriteList, 4)                                                       \
+  V(Socket_WriteVectored, 2)                                                   \
   V(Socket_HasPendingWrite, 1)                                                 \
   V(SocketControlMessage_fromHandles, 2)                                       \
   V(SocketControlMessageImpl_extractHandles, 1)                                \
@@ -10,6 +10,7 @@
 #include "bin/directory.h"
 #include "bin/file.h"
 #include "bin/io_buffer.h"
+#include "bin/io_completion_engine.h"
 #include "bin/socket.h"
 #include "bin/utils.h"
 
@@ -38,6 +39,11 @@ void IOServiceCallback(Dart_Port dest_port_id, Dart_CObject* message) {
     CObjectInt32 request_id(request[2]);
     CObjectArray data(request[3]);
     reply_port_id = reply_port.Value();
+    if (IOCompletionEngine::TrySubmit(request_id.Value(), reply_port_id,
+                                      message_id.Value(), data)) {
+      // The engine posts the reply once the request completes.
+      return;
+    }
     switch (request_id.Value()) {
       IO_SERVICE_REQUEST_LIST(CASE_REQUEST);
       default:
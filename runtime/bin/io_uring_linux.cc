@@ -0,0 +1,185 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+#if defined(DART_HOST_OS_LINUX)
+
+#include "bin/io_uring_linux.h"
+
+#include <errno.h>        // NOLINT
+#include <string.h>       // NOLINT
+#include <sys/mman.h>     // NOLINT
+#include <sys/syscall.h>  // NOLINT
+#include <unistd.h>       // NOLINT
+
+#include "platform/assert.h"
+#include "platform/signal_blocker.h"
+#include "platform/utils.h"
+
+namespace dart {
+namespace bin {
+
+static int IOUringSetup(uint32_t entries, struct io_uring_params* params) {
+#if defined(__NR_io_uring_setup)
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
+static int IOUringEnter(int fd,
+                        uint32_t to_submit,
+                        uint32_t min_complete,
+                        uint32_t flags) {
+#if defined(__NR_io_uring_enter)
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, nullptr, 0));
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
+IOUring* IOUring::Create(uint32_t entries, uint32_t required_features) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  const int fd = NO_RETRY_EXPECTED(IOUringSetup(entries, &params));
+  if (fd < 0) {
+    return nullptr;
+  }
+  if ((params.features & required_features) != required_features) {
+    close(fd);
+    return nullptr;
+  }
+  IOUring* ring = new IOUring();
+  if (!ring->Map(fd, params)) {
+    delete ring;
+    return nullptr;
+  }
+  return ring;
+}
+
+bool IOUring::Map(int fd, const struct io_uring_params& params) {
+  fd_ = fd;
+  features_ = params.features;
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = Utils::Maximum(sq_ring_size_, cq_ring_size_);
+    cq_ring_size_ = sq_ring_size_;
+  }
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+    return false;
+  }
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      cq_ring_ = nullptr;
+      return false;
+    }
+  }
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    return false;
+  }
+  sqes_ = reinterpret_cast<struct io_uring_sqe*>(sqes);
+
+  uint8_t* sq = reinterpret_cast<uint8_t*>(sq_ring_);
+  sq_head_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+  sq_entries_ = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_entries);
+  sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+  sqe_head_ = sqe_tail_ = *sq_tail_;
+
+  uint8_t* cq = reinterpret_cast<uint8_t*>(cq_ring_);
+  cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+  return true;
+}
+
+IOUring::~IOUring() {
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+  }
+  if ((cq_ring_ != nullptr) && (cq_ring_ != sq_ring_)) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_ != nullptr) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+struct io_uring_sqe* IOUring::GetSqe() {
+  const uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  if (sqe_tail_ - head >= sq_entries_) {
+    // The ring is full: let the kernel consume what we have so far.
+    if (Submit() < 0) {
+      return nullptr;
+    }
+    if (sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >=
+        sq_entries_) {
+      return nullptr;
+    }
+  }
+  struct io_uring_sqe* sqe = &sqes_[sqe_tail_ & sq_mask_];
+  sqe_tail_++;
+  memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+intptr_t IOUring::SubmitAndWait(uint32_t wait_nr) {
+  // Publish all entries handed out since the last submission with a single
+  // release store of the tail.
+  uint32_t tail = *sq_tail_;
+  while (sqe_head_ != sqe_tail_) {
+    sq_array_[tail & sq_mask_] = sqe_head_ & sq_mask_;
+    tail++;
+    sqe_head_++;
+  }
+  __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+  // Also covers entries left unconsumed by a previously failed enter.
+  const uint32_t to_submit = tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  if ((to_submit == 0) && (wait_nr == 0)) {
+    return 0;
+  }
+  const uint32_t flags = (wait_nr > 0) ? IORING_ENTER_GETEVENTS : 0;
+  // Interruptions by signals are retried by the caller's loop, which is why
+  // the signal blocker variant is not used here.
+  return IOUringEnter(fd_, to_submit, wait_nr, flags);
+}
+
+intptr_t IOUring::DrainCompletions(struct io_uring_cqe* cqes, intptr_t max) {
+  uint32_t head = *cq_head_;
+  const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  intptr_t count = 0;
+  while ((head != tail) && (count < max)) {
+    cqes[count++] = cqes_[head & cq_mask_];
+    head++;
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  return count;
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(DART_HOST_OS_LINUX)
@@ -0,0 +1,109 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_IO_URING_LINUX_H_
+#define RUNTIME_BIN_IO_URING_LINUX_H_
+
+#include "platform/globals.h"
+
+#if defined(DART_HOST_OS_LINUX)
+
+#include <linux/io_uring.h>  // NOLINT
+
+// Older kernel headers may lack some of the definitions we rely on. The values
+// are part of the stable kernel ABI.
+#if !defined(IORING_POLL_ADD_MULTI)
+#define IORING_POLL_ADD_MULTI (1U << 0)
+#endif
+#if !defined(IORING_CQE_F_MORE)
+#define IORING_CQE_F_MORE (1U << 1)
+#endif
+#if !defined(IORING_FEAT_RSRC_TAGS)
+#define IORING_FEAT_RSRC_TAGS (1U << 10)
+#endif
+
+namespace dart {
+namespace bin {
+
+// A minimal wrapper around a single io_uring instance: the submission and
+// completion rings are mapped into the process and driven with raw
+// io_uring_setup/io_uring_enter system calls, so no liburing is required.
+//
+// An IOUring is not thread safe. It must only be used by the thread which
+// owns it.
+class IOUring {
+ public:
+  // Creates a ring with room for at least `entries` submissions. Returns
+  // nullptr if the kernel does not support io_uring (or it is disabled by a
+  // seccomp policy) or if the kernel lacks any of `required_features`
+  // (IORING_FEAT_* bits).
+  static IOUring* Create(uint32_t entries, uint32_t required_features);
+
+  ~IOUring();
+
+  // Returns a cleared submission queue entry to be filled in by the caller.
+  // If the submission queue is full, pending entries are handed to the kernel
+  // first. Returns nullptr if no entry could be made available.
+  struct io_uring_sqe* GetSqe();
+
+  // Hands all pending submissions to the kernel and blocks until at least
+  // `wait_nr` completions are available. Returns the number of submitted
+  // entries or -1 with errno set.
+  intptr_t SubmitAndWait(uint32_t wait_nr);
+
+  // Hands all pending submissions to the kernel without waiting.
+  intptr_t Submit() { return SubmitAndWait(0); }
+
+  // Copies up to `max` available completions into `cqes` and releases their
+  // slots in the completion ring with a single store. Returns the number of
+  // completions copied.
+  intptr_t DrainCompletions(struct io_uring_cqe* cqes, intptr_t max);
+
+  // Number of entries obtained through GetSqe() which have not yet been handed
+  // to the kernel.
+  uint32_t pending() const { return sqe_tail_ - sqe_head_; }
+
+  uint32_t features() const { return features_; }
+
+ private:
+  IOUring() {}
+
+  bool Map(int fd, const struct io_uring_params& params);
+
+  int fd_ = -1;
+  uint32_t features_ = 0;
+
+  // Submission ring.
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* sq_array_ = nullptr;
+  struct io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  // Entries handed out by GetSqe() live in [sqe_head_, sqe_tail_) until they
+  // are published to the kernel.
+  uint32_t sqe_head_ = 0;
+  uint32_t sqe_tail_ = 0;
+
+  // Completion ring. Shares the mapping with the submission ring when the
+  // kernel supports IORING_FEAT_SINGLE_MMAP.
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  struct io_uring_cqe* cqes_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(IOUring);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(DART_HOST_OS_LINUX)
+
+#endif  // RUNTIME_BIN_IO_URING_LINUX_H_
@@ -0,0 +1,83 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+
+#if defined(DART_HOST_OS_LINUX)
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "bin/io_uring_linux.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+namespace bin {
+
+VM_UNIT_TEST_CASE(IOUring_Nop) {
+  IOUring* ring = IOUring::Create(8, 0);
+  if (ring == nullptr) {
+    // io_uring is not available in this environment.
+    return;
+  }
+  for (intptr_t i = 0; i < 4; i++) {
+    struct io_uring_sqe* sqe = ring->GetSqe();
+    EXPECT(sqe != nullptr);
+    sqe->opcode = IORING_OP_NOP;
+    sqe->user_data = i + 1;
+  }
+  EXPECT_EQ(4, static_cast<intptr_t>(ring->pending()));
+  EXPECT_EQ(4, ring->SubmitAndWait(4));
+  EXPECT_EQ(0, static_cast<intptr_t>(ring->pending()));
+
+  struct io_uring_cqe cqes[8];
+  EXPECT_EQ(4, ring->DrainCompletions(cqes, 8));
+  for (intptr_t i = 0; i < 4; i++) {
+    EXPECT_EQ(i + 1, static_cast<intptr_t>(cqes[i].user_data));
+    EXPECT_EQ(0, cqes[i].res);
+  }
+  EXPECT_EQ(0, ring->DrainCompletions(cqes, 8));
+  delete ring;
+}
+
+VM_UNIT_TEST_CASE(IOUring_MultishotPoll) {
+  IOUring* ring = IOUring::Create(8, IORING_FEAT_RSRC_TAGS);
+  if (ring == nullptr) {
+    return;
+  }
+  int fds[2];
+  EXPECT_EQ(0, pipe2(fds, O_CLOEXEC | O_NONBLOCK));
+
+  struct io_uring_sqe* sqe = ring->GetSqe();
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fds[0];
+  sqe->poll32_events = POLLIN;
+  sqe->len = IORING_POLL_ADD_MULTI;
+  sqe->user_data = 42;
+  EXPECT(ring->Submit() >= 0);
+
+  struct io_uring_cqe cqes[8];
+  for (intptr_t i = 0; i < 2; i++) {
+    char c = 'x';
+    EXPECT_EQ(1, write(fds[1], &c, 1));
+    EXPECT(ring->SubmitAndWait(1) >= 0);
+    EXPECT_EQ(1, ring->DrainCompletions(cqes, 8));
+    EXPECT_EQ(42, static_cast<intptr_t>(cqes[0].user_data));
+    EXPECT((cqes[0].res & POLLIN) != 0);
+    // The poll stays armed.
+    EXPECT((cqes[0].flags & IORING_CQE_F_MORE) != 0);
+    EXPECT_EQ(1, read(fds[0], &c, 1));
+  }
+
+  close(fds[0]);
+  close(fds[1]);
+  delete ring;
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(DART_HOST_OS_LINUX)
@@ -10,7 +10,10 @@
 
 #include "bin/dartdev_isolate.h"
 #include "bin/error_exit.h"
+#include "bin/eventhandler.h"
+#include "bin/file.h"
 #include "bin/file_system_watcher.h"
+#include "bin/io_completion_engine.h"
 #if defined(DART_IO_SECURE_SOCKET_DISABLED)
 #include "bin/io_service_no_ssl.h"
 #else  // defined(DART_IO_SECURE_SOCKET_DISABLED)
@@ -85,6 +88,18 @@ ENUM_OPTIONS_LIST(ENUM_OPTION_DEFINITION)
 CB_OPTIONS_LIST(CB_OPTION_DEFINITION)
 #undef CB_OPTION_DEFINITION
 
+DEFINE_STRING_OPTION_CB(event_handler_threads, {
+  char* end;
+  const intptr_t count = strtol(value, &end, 10);
+  if ((*end != '\0') || (count < 1) ||
+      (count > EventHandler::kMaxThreadCount)) {
+    Syslog::PrintErr("Invalid value for option event_handler_threads: %s\n",
+                     value);
+    return false;
+  }
+  EventHandler::set_thread_count(count);
+});
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
 DFE* Options::dfe_ = nullptr;
 
@@ -252,6 +267,13 @@ void Options::PrintUsage() {
 "  The path to a directory that dart:io calls will treat as the root of the\n"
 "  filesystem.\n"
 #endif  // defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+#if defined(DART_HOST_OS_LINUX)
+"--enable-io-uring\n"
+"  Poll sockets and other descriptors for readiness through io_uring\n"
+"  instead of epoll, and run file reads and writes on io_uring. Sockets are\n"
+"  still read and written by separate system calls. Falls back to epoll and\n"
+"  blocking file operations if the kernel lacks io_uring support.\n"
+#endif  // defined(DART_HOST_OS_LINUX)
 "\n"
 "The following options are only used for VM development and may\n"
 "be changed in any future version:\n");
@@ -620,6 +642,11 @@ bool Options::ParseArguments(int argc,
 
   Socket::set_short_socket_read(Options::short_socket_read());
   Socket::set_short_socket_write(Options::short_socket_write());
+  EventHandler::set_use_io_uring_polling(Options::enable_io_uring());
+  ListeningSocketRegistry::set_reuse_port(Options::shared_socket_reuse_port());
+  File::set_map_reads(Options::map_file_reads());
+  IOCompletionEngine::set_enabled(Options::enable_io_uring() &&
+                                  !Options::deterministic());
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLCertContext::set_root_certs_file(Options::root_certs_file());
   SSLCertContext::set_root_certs_cache(Options::root_certs_cache());
@@ -43,6 +43,9 @@ namespace bin {
   V(trace_loading, trace_loading)                                              \
   V(short_socket_read, short_socket_read)                                      \
   V(short_socket_write, short_socket_write)                                    \
+  V(enable_io_uring, enable_io_uring)                                          \
+  V(shared_socket_reuse_port, shared_socket_reuse_port)                        \
+  V(map_file_reads, map_file_reads)                                            \
   V(disable_exit, exit_disabled)                                               \
   V(preview_dart_2, nop_option)                                                \
   V(suppress_core_dump, suppress_core_dump)                                    \
@@ -29,6 +29,7 @@ ListeningSocketRegistry* globalTcpListeningSocketRegistry = nullptr;
 
 bool Socket::short_socket_read_ = false;
 bool Socket::short_socket_write_ = false;
+bool ListeningSocketRegistry::reuse_port_ = false;
 
 void ListeningSocketRegistry::Initialize() {
   ASSERT(globalTcpListeningSocketRegistry == nullptr);
@@ -127,24 +128,31 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
           return DartUtils::NewDartOSError(&os_error);
         }
 
-        // This socket creation is the exact same as the one which originally
-        // created the socket. Feed same fd and store it into native field
-        // of dart socket_object. Sockets here will share same fd but contain a
-        // different port() through EventHandler_SendData.
-        Socket* socketfd = new Socket(os_socket_same_addr->fd);
-        os_socket_same_addr->ref_count++;
-        // We set as a side-effect the file descriptor on the dart
-        // socket_object.
-        Socket::ReuseSocketIdNativeField(socket_object, socketfd,
-                                         Socket::kFinalizerListening);
-        InsertByFd(socketfd, os_socket_same_addr);
-        return Dart_True();
+        if (!os_socket_same_addr->reuse_port) {
+          // This socket creation is the exact same as the one which
+          // originally created the socket. Feed same fd and store it into
+          // native field of dart socket_object. Sockets here will share same
+          // fd but contain a different port() through EventHandler_SendData.
+          Socket* socketfd = new Socket(os_socket_same_addr->fd);
+          os_socket_same_addr->ref_count++;
+          // We set as a side-effect the file descriptor on the dart
+          // socket_object.
+          Socket::ReuseSocketIdNativeField(socket_object, socketfd,
+                                           Socket::kFinalizerListening);
+          InsertByFd(socketfd, os_socket_same_addr);
+          return Dart_True();
+        }
+        // Otherwise bind another socket to the same (address, port) below,
+        // the kernel balances incoming connections between them.
       }
     }
   }
 
-  // There is no socket listening on that (address, port), so we create new one.
-  intptr_t fd = ServerSocket::CreateBindListen(addr, backlog, v6_only);
+  // There is no socket listening on that (address, port) which can be
+  // shared, so we create new one.
+  const bool reuse_port = shared && reuse_port_;
+  intptr_t fd =
+      ServerSocket::CreateBindListen(addr, backlog, v6_only, reuse_port);
   if (fd == -5) {
     OSError os_error(-1, "Invalid host", OSError::kUnknown);
     return DartUtils::NewDartOSError(&os_error);
@@ -180,7 +188,8 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
 
   Socket* socketfd = new Socket(fd);
   OSSocket* os_socket =
-      new OSSocket(addr, allocated_port, v6_only, shared, socketfd, nullptr);
+      new OSSocket(addr, allocated_port, v6_only, shared, reuse_port, socketfd,
+                   nullptr);
   os_socket->ref_count = 1;
   os_socket->next = first_os_socket;
 
@@ -262,7 +271,7 @@ Dart_Handle ListeningSocketRegistry::CreateUnixDomainBindListen(
 
   Socket* socketfd = new Socket(fd);
   OSSocket* os_socket =
-      new OSSocket(addr, -1, false, shared, socketfd, namespc);
+      new OSSocket(addr, -1, false, shared, false, socketfd, namespc);
   os_socket->ref_count = 1;
   os_socket->next = unix_domain_sockets_;
   unix_domain_sockets_ = os_socket;
@@ -538,38 +547,33 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
-    uint8_t* buffer = nullptr;
-    Dart_Handle result = IOBuffer::Allocate(length, &buffer);
-    if (Dart_IsNull(result)) {
+    // Pooled storage is wrapped with the number of bytes actually read, so a
+    // short read does not need another allocation and copy.
+    void* peer = nullptr;
+    uint8_t* buffer = IOBuffer::AllocatePooled(length, &peer);
+    if (buffer == nullptr) {
       Dart_ThrowException(DartUtils::NewDartOSError());
     }
-    if (Dart_IsError(result)) {
-      Dart_PropagateError(result);
-    }
-    ASSERT(buffer != nullptr);
     intptr_t bytes_read =
         SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
-    if (bytes_read == length) {
-      Dart_SetReturnValue(args, result);
-    } else if (bytes_read > 0) {
-      uint8_t* new_buffer = nullptr;
-      Dart_Handle new_result = IOBuffer::Allocate(bytes_read, &new_buffer);
-      if (Dart_IsNull(new_result)) {
-        Dart_ThrowException(DartUtils::NewDartOSError());
-      }
-      if (Dart_IsError(new_result)) {
-        Dart_PropagateError(new_result);
+    if ((bytes_read > 0) || ((bytes_read == 0) && (length == 0))) {
+      Dart_Handle result = IOBuffer::WrapPooled(buffer, bytes_read, peer);
+      if (Dart_IsError(result)) {
+        IOBuffer::FreePooled(peer);
+        Dart_PropagateError(result);
       }
-      ASSERT(new_buffer != nullptr);
-      memmove(new_buffer, buffer, bytes_read);
-      Dart_SetReturnValue(args, new_result);
+      Dart_SetReturnValue(args, result);
     } else if (bytes_read == 0) {
+      IOBuffer::FreePooled(peer);
       // On MacOS when reading from a tty Ctrl-D will result in reading one
       // less byte then reported as available.
       Dart_SetReturnValue(args, Dart_Null());
     } else {
       ASSERT(bytes_read == -1);
-      Dart_ThrowException(DartUtils::NewDartOSError());
+      // Make sure the error is captured before freeing the buffer.
+      Dart_Handle exception = DartUtils::NewDartOSError();
+      IOBuffer::FreePooled(peer);
+      Dart_ThrowException(exception);
     }
   } else {
     Dart_Handle exception;
@@ -582,86 +586,118 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
   }
 }
 
-void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
-  // TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
-  // handle 64k datagrams.
-  const int kReceiveBufferLen = 65536;
-  Socket* socket =
-      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
-
-  // Ensure that a receive buffer for the UDP socket exists.
+// TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
+// handle 64k datagrams.
+static constexpr intptr_t kMaxDatagramSize = 65536;
+// Maximum number of datagrams received by one Socket_RecvFromBatch call.
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+static constexpr intptr_t kMaxDatagramBatch = 16;
+#else
+// Without recvmmsg, SocketBase::RecvFromBatch receives a single datagram.
+static constexpr intptr_t kMaxDatagramBatch = 1;
+#endif
+
+// Returns a receive buffer with room for the given number of maximum size
+// datagrams. The buffer only grows when a larger batch is requested, and its
+// pages are only committed once they are written by a receive.
+static uint8_t* GetUdpReceiveBuffer(Socket* socket, intptr_t slots) {
   ASSERT(socket != nullptr);
+  ASSERT((slots > 0) && (slots <= kMaxDatagramBatch));
   uint8_t* recv_buffer = socket->udp_receive_buffer();
-  if (recv_buffer == nullptr) {
-    recv_buffer = reinterpret_cast<uint8_t*>(malloc(kReceiveBufferLen));
-    socket->set_udp_receive_buffer(recv_buffer);
+  if ((recv_buffer == nullptr) ||
+      (socket->udp_receive_buffer_slots() < slots)) {
+    free(recv_buffer);
+    recv_buffer = reinterpret_cast<uint8_t*>(malloc(kMaxDatagramSize * slots));
+    socket->set_udp_receive_buffer(recv_buffer, slots);
   }
+  return recv_buffer;
+}
 
-  // Read data into the buffer.
-  RawAddr addr;
-  const intptr_t bytes_read = SocketBase::RecvFrom(
-      socket->fd(), recv_buffer, kReceiveBufferLen, &addr, SocketBase::kAsync);
-  if (bytes_read == 0) {
+// Receives up to the given number of datagrams with a single native call.
+// Returns null if no datagram is available. Otherwise returns the list
+// [table, data_0, address_0, in_addr_0, ..., data_n, address_n, in_addr_n]
+// where table holds <port, type> for every datagram and data_i is a list of
+// exactly the payload of datagram i. The sender address strings and in_addr
+// bytes are null if the sender is the same as the one of the previous
+// datagram.
+void FUNCTION_NAME(Socket_RecvFromBatch)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  const intptr_t max_datagrams = Utils::Minimum(
+      Utils::Maximum<intptr_t>(DartUtils::GetNativeIntptrArgument(args, 1), 1),
+      kMaxDatagramBatch);
+
+  uint8_t* recv_buffer = GetUdpReceiveBuffer(socket, max_datagrams);
+  intptr_t lengths[kMaxDatagramBatch];
+  RawAddr addrs[kMaxDatagramBatch];
+  const intptr_t count =
+      SocketBase::RecvFromBatch(socket->fd(), recv_buffer, kMaxDatagramSize,
+                                max_datagrams, lengths, addrs,
+                                SocketBase::kAsync);
+  if (count == 0) {
     Dart_SetReturnValue(args, Dart_Null());
     return;
   }
-  if (bytes_read < 0) {
-    ASSERT(bytes_read == -1);
+  if (count < 0) {
+    ASSERT(count == -1);
     Dart_ThrowException(DartUtils::NewDartOSError());
   }
 
-  // Datagram data read. Copy into buffer of the exact size,
-  ASSERT(bytes_read >= 0);
-  uint8_t* data_buffer = nullptr;
-  Dart_Handle data = IOBuffer::Allocate(bytes_read, &data_buffer);
-  if (Dart_IsNull(data)) {
-    Dart_ThrowException(DartUtils::NewDartOSError());
+  Dart_Handle result = ThrowIfError(Dart_NewList(1 + 3 * count));
+  int32_t table[kMaxDatagramBatch * 2];
+  for (intptr_t i = 0; i < count; i++) {
+    // Copy the payload into a list of its exact size, which becomes the data
+    // of the Datagram.
+    uint8_t* data_buffer = nullptr;
+    Dart_Handle data = IOBuffer::Allocate(lengths[i], &data_buffer);
+    if (Dart_IsNull(data)) {
+      Dart_ThrowException(DartUtils::NewDartOSError());
+    }
+    ASSERT(data_buffer != nullptr);
+    memmove(data_buffer, recv_buffer + i * kMaxDatagramSize, lengths[i]);
+    ThrowIfError(Dart_ListSetAt(result, 1 + 3 * i, data));
+
+    table[i * 2] = SocketAddress::GetAddrPort(addrs[i]);
+    // TODO(21403): Add checks for AF_UNIX, if unix domain sockets
+    // are used in SOCK_DGRAM.
+    if (addrs[i].addr.sa_family == AF_INET) {
+      addrs[i].in.sin_port = 0;
+      table[i * 2 + 1] = 0;  // IPv4
+    } else {
+      ASSERT(addrs[i].addr.sa_family == AF_INET6);
+      addrs[i].in6.sin6_port = 0;
+      table[i * 2 + 1] = 1;  // IPv6
+    }
+
+    const intptr_t addr_length = SocketAddress::GetAddrLength(addrs[i]);
+    if ((i > 0) &&
+        (SocketAddress::GetAddrLength(addrs[i - 1]) == addr_length) &&
+        (memcmp(&addrs[i - 1], &addrs[i], addr_length) == 0)) {
+      continue;
+    }
+    // Format the address to a string using the numeric format.
+    char numeric_address[INET6_ADDRSTRLEN];
+    SocketBase::FormatNumericAddress(addrs[i], numeric_address,
+                                     INET6_ADDRSTRLEN);
+    ThrowIfError(Dart_ListSetAt(
+        result, 2 + 3 * i,
+        ThrowIfError(Dart_NewStringFromCString(numeric_address))));
+    ThrowIfError(Dart_ListSetAt(result, 3 + 3 * i,
+                                SocketAddress::ToTypedData(addrs[i])));
   }
-  if (Dart_IsError(data)) {
-    Dart_PropagateError(data);
-  }
-  ASSERT(data_buffer != nullptr);
-  memmove(data_buffer, recv_buffer, bytes_read);
-
-  // Get the port and clear it in the sockaddr structure.
-  int port = SocketAddress::GetAddrPort(addr);
-  // TODO(21403): Add checks for AF_UNIX, if unix domain sockets
-  // are used in SOCK_DGRAM.
-  enum internet_type { IPv4, IPv6 };
-  internet_type type;
-  if (addr.addr.sa_family == AF_INET) {
-    addr.in.sin_port = 0;
-    type = IPv4;
-  } else {
-    ASSERT(addr.addr.sa_family == AF_INET6);
-    addr.in6.sin6_port = 0;
-    type = IPv6;
-  }
-  // Format the address to a string using the numeric format.
-  char numeric_address[INET6_ADDRSTRLEN];
-  SocketBase::FormatNumericAddress(addr, numeric_address, INET6_ADDRSTRLEN);
-
-  // Create a Datagram object with the data and sender address and port.
-  const int kNumArgs = 5;
-  Dart_Handle dart_args[kNumArgs];
-  dart_args[0] = data;
-  dart_args[1] = Dart_NewStringFromCString(numeric_address);
-  if (Dart_IsError(dart_args[1])) {
-    Dart_PropagateError(dart_args[1]);
-  }
-  dart_args[2] = SocketAddress::ToTypedData(addr);
-  dart_args[3] = Dart_NewInteger(port);
-  dart_args[4] = Dart_NewInteger(type);
-  if (Dart_IsError(dart_args[3])) {
-    Dart_PropagateError(dart_args[3]);
-  }
-  // TODO(sgjesse): Cache the _makeDatagram function somewhere.
-  Dart_Handle io_lib = Dart_LookupLibrary(DartUtils::NewString("dart:io"));
-  if (Dart_IsError(io_lib)) {
-    Dart_PropagateError(io_lib);
-  }
-  Dart_Handle result = Dart_Invoke(
-      io_lib, DartUtils::NewString("_makeDatagram"), kNumArgs, dart_args);
+
+  Dart_Handle table_data =
+      ThrowIfError(Dart_NewTypedData(Dart_TypedData_kInt32, count * 2));
+  {
+    Dart_TypedData_Type type;
+    void* table_buffer;
+    intptr_t table_length;
+    ThrowIfError(Dart_TypedDataAcquireData(table_data, &type, &table_buffer,
+                                           &table_length));
+    memmove(table_buffer, table, count * 2 * sizeof(int32_t));
+    ThrowIfError(Dart_TypedDataReleaseData(table_data));
+  }
+  ThrowIfError(Dart_ListSetAt(result, 0, table_data));
   Dart_SetReturnValue(args, result);
 }
 
@@ -782,6 +818,107 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(Socket_WriteVectored)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  // List of triples <buffer, offset, length> arranged to minimize dart api use
+  // in native methods.
+  Dart_Handle buffer_list = ThrowIfError(Dart_GetNativeArgument(args, 1));
+  ASSERT(Dart_IsList(buffer_list));
+  intptr_t num_pieces;
+  ThrowIfError(Dart_ListLength(buffer_list, &num_pieces));
+  intptr_t num_buffers = num_pieces / 3;
+  ASSERT((num_buffers * 3) == num_pieces);
+
+  Dart_Handle* buffer_objs = reinterpret_cast<Dart_Handle*>(
+      Dart_ScopeAllocate(sizeof(Dart_Handle) * num_buffers));
+  intptr_t* offsets = reinterpret_cast<intptr_t*>(
+      Dart_ScopeAllocate(sizeof(intptr_t) * num_buffers));
+  // Index of the first occurrence of the same typed data in the list. The
+  // data of an object can only be acquired once.
+  intptr_t* owners = reinterpret_cast<intptr_t*>(
+      Dart_ScopeAllocate(sizeof(intptr_t) * num_buffers));
+  SocketWriteBuffer* buffers = reinterpret_cast<SocketWriteBuffer*>(
+      Dart_ScopeAllocate(sizeof(SocketWriteBuffer) * num_buffers));
+  intptr_t length = 0;
+  intptr_t j = 0;
+  for (intptr_t i = 0; i < num_buffers; i++) {
+    buffer_objs[i] = ThrowIfError(Dart_ListGetAt(buffer_list, j++));
+    offsets[i] = DartUtils::GetIntptrValue(
+        ThrowIfError(Dart_ListGetAt(buffer_list, j++)));
+    buffers[i].data = nullptr;
+    buffers[i].length = DartUtils::GetIntptrValue(
+        ThrowIfError(Dart_ListGetAt(buffer_list, j++)));
+    length += buffers[i].length;
+    owners[i] = i;
+    for (intptr_t k = 0; k < i; k++) {
+      if (Dart_IdentityEquals(buffer_objs[k], buffer_objs[i])) {
+        owners[i] = k;
+        break;
+      }
+    }
+  }
+
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    if (length > 1) {
+      short_write = true;
+    }
+    // Drop everything after the first half of the bytes.
+    intptr_t remaining = (length + 1) / 2;
+    for (intptr_t i = 0; i < num_buffers; i++) {
+      buffers[i].length = Utils::Minimum(buffers[i].length, remaining);
+      remaining -= buffers[i].length;
+    }
+  }
+
+  // Acquire the data of all buffers so that they can be written with a
+  // single system call.
+  void** acquired = reinterpret_cast<void**>(
+      Dart_ScopeAllocate(sizeof(void*) * num_buffers));
+  for (intptr_t i = 0; i < num_buffers; i++) {
+    if (owners[i] == i) {
+      Dart_TypedData_Type type;
+      intptr_t len;
+      Dart_Handle result =
+          Dart_TypedDataAcquireData(buffer_objs[i], &type, &acquired[i], &len);
+      if (Dart_IsError(result)) {
+        for (intptr_t k = 0; k < i; k++) {
+          if (owners[k] == k) {
+            Dart_TypedDataReleaseData(buffer_objs[k]);
+          }
+        }
+        Dart_PropagateError(result);
+      }
+      ASSERT((offsets[i] + buffers[i].length) <= len);
+    }
+    buffers[i].data = reinterpret_cast<uint8_t*>(acquired[owners[i]]) +
+                      offsets[i];
+  }
+
+  intptr_t bytes_written = SocketBase::WriteVectored(
+      socket->fd(), buffers, num_buffers, SocketBase::kAsync);
+  // Extract OSError before we release data, as it may override the error.
+  OSError* os_error = (bytes_written < 0) ? new OSError() : nullptr;
+  for (intptr_t i = 0; i < num_buffers; i++) {
+    if (owners[i] == i) {
+      Dart_TypedDataReleaseData(buffer_objs[i]);
+    }
+  }
+  if (os_error != nullptr) {
+    Dart_Handle error = DartUtils::NewDartOSError(os_error);
+    delete os_error;
+    Dart_ThrowException(error);
+  }
+  if (short_write) {
+    // If the write was forced 'short', indicate by returning the negative
+    // number of bytes. A forced short write may not trigger a write event.
+    Dart_SetIntegerReturnValue(args, -bytes_written);
+  } else {
+    Dart_SetIntegerReturnValue(args, bytes_written);
+  }
+}
+
 void FUNCTION_NAME(Socket_SendMessage)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
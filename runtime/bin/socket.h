@@ -51,6 +51,11 @@ class Socket : public ReferenceCounted<Socket> {
 
   intptr_t fd() const { return fd_; }
 
+  // The event handler thread which handles this socket. It is picked from
+  // the descriptor when the socket is created and does not change when the
+  // descriptor is closed.
+  intptr_t event_handler_shard() const { return event_handler_shard_; }
+
   // Close fd and may need to decrement the count of handle by calling
   // release().
   void CloseFd();
@@ -64,7 +69,14 @@ class Socket : public ReferenceCounted<Socket> {
   void set_port(Dart_Port port) { port_ = port; }
 
   uint8_t* udp_receive_buffer() const { return udp_receive_buffer_; }
-  void set_udp_receive_buffer(uint8_t* buffer) { udp_receive_buffer_ = buffer; }
+  // The number of maximum size datagrams the receive buffer has room for.
+  intptr_t udp_receive_buffer_slots() const {
+    return udp_receive_buffer_slots_;
+  }
+  void set_udp_receive_buffer(uint8_t* buffer, intptr_t slots) {
+    udp_receive_buffer_ = buffer;
+    udp_receive_buffer_slots_ = slots;
+  }
 
   static bool Initialize();
 
@@ -128,6 +140,8 @@ class Socket : public ReferenceCounted<Socket> {
   Dart_Port isolate_port_;
   Dart_Port port_;
   uint8_t* udp_receive_buffer_;
+  intptr_t udp_receive_buffer_slots_ = 0;
+  intptr_t event_handler_shard_ = 0;
 
   friend class ReferenceCounted<Socket>;
   DISALLOW_COPY_AND_ASSIGN(Socket);
@@ -147,9 +161,13 @@ class ServerSocket {
   //
   //   -1: system error (errno set)
   //   -5: invalid bindAddress
+  //
+  // If `reuse_port` is true the socket is bound with SO_REUSEPORT, which is
+  // only supported if ListeningSocketRegistry::SupportsReusePort().
   static intptr_t CreateBindListen(const RawAddr& addr,
                                    intptr_t backlog,
-                                   bool v6_only = false);
+                                   bool v6_only = false,
+                                   bool reuse_port = false);
   static intptr_t CreateUnixDomainBindListen(const RawAddr& addr,
                                              intptr_t backlog);
 
@@ -178,6 +196,26 @@ class ListeningSocketRegistry {
 
   static void Cleanup();
 
+  // Whether shared listening sockets can be bound with SO_REUSEPORT, letting
+  // the kernel distribute incoming connections between the sockets.
+  static bool SupportsReusePort() {
+#if defined(DART_HOST_OS_LINUX) && defined(SO_REUSEPORT)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // When enabled, every `shared` bind of an (address, port) creates its own
+  // listening socket bound with SO_REUSEPORT instead of sharing a single file
+  // descriptor. Each isolate then accepts from its own socket and only the
+  // isolate whose socket received the connection is woken up. Connections
+  // still queued on a socket when it is closed are reset.
+  static bool reuse_port() { return reuse_port_; }
+  static void set_reuse_port(bool reuse_port) {
+    reuse_port_ = reuse_port && SupportsReusePort();
+  }
+
   // Bind `socket_object` to `addr`.
   // Return Dart_True() if succeed.
   // This function should be called from a dart runtime call in order to create
@@ -215,6 +253,10 @@ class ListeningSocketRegistry {
     int port;
     bool v6_only;
     bool shared;
+    // Whether the socket was bound with SO_REUSEPORT. Further shared binds of
+    // the same address then create additional sockets instead of sharing
+    // this one.
+    bool reuse_port;
     int ref_count;
     intptr_t fd;
 
@@ -230,12 +272,14 @@ class ListeningSocketRegistry {
              int port,
              bool v6_only,
              bool shared,
+             bool reuse_port,
              Socket* socketfd,
              Namespace* namespc)
         : address(address),
           port(port),
           v6_only(v6_only),
           shared(shared),
+          reuse_port(reuse_port),
           ref_count(0),
           namespc(namespc),
           next(nullptr) {
@@ -314,6 +358,8 @@ class ListeningSocketRegistry {
 
   Mutex mutex_;
 
+  static bool reuse_port_;
+
   DISALLOW_COPY_AND_ASSIGN(ListeningSocketRegistry);
 };
 
@@ -318,6 +318,27 @@ bool SocketBase::IsValidAddress(const char* address) {
   return SocketBase::ParseAddress(type, address, &raw);
 }
 
+#if !defined(DART_HOST_OS_LINUX) && !defined(DART_HOST_OS_ANDROID)
+intptr_t SocketBase::RecvFromBatch(intptr_t fd,
+                                   void* buffer,
+                                   intptr_t buffer_num_bytes,
+                                   intptr_t num_datagrams,
+                                   intptr_t* lengths,
+                                   RawAddr* addrs,
+                                   SocketOpKind sync) {
+  // No batched receive on this platform, receive a single datagram. Like
+  // RecvFrom, an empty datagram can not be told apart from no datagram.
+  ASSERT(num_datagrams > 0);
+  const intptr_t read_bytes =
+      RecvFrom(fd, buffer, buffer_num_bytes, &addrs[0], sync);
+  if (read_bytes <= 0) {
+    return read_bytes;
+  }
+  lengths[0] = read_bytes;
+  return 1;
+}
+#endif  // !defined(DART_HOST_OS_LINUX) && !defined(DART_HOST_OS_ANDROID)
+
 #if !defined(DART_HOST_OS_WINDOWS)
 intptr_t SocketBase::Write(intptr_t fd,
                            const void* buffer,
@@ -345,6 +366,48 @@ intptr_t SocketBase::Write(intptr_t fd,
 
   return num_bytes - num_bytes_left;
 }
+
+intptr_t SocketBase::WriteVectored(intptr_t fd,
+                                   const SocketWriteBuffer* buffers,
+                                   intptr_t num_buffers,
+                                   SocketOpKind sync) {
+  // As in Write, keep writing until EAGAIN so that an edge-triggered write
+  // event is guaranteed.
+  intptr_t total_written = 0;
+  // Position of the first byte not yet written.
+  intptr_t index = 0;
+  intptr_t offset = 0;
+  while (index < num_buffers) {
+    if (offset == buffers[index].length) {
+      index++;
+      offset = 0;
+      continue;
+    }
+    ssize_t written_bytes = WriteVectoredImpl(
+        fd, buffers + index, num_buffers - index, offset, sync);
+    static_assert(EAGAIN == EWOULDBLOCK);
+    if (written_bytes == -1) {
+      if ((sync == kAsync) && (errno == EWOULDBLOCK)) {
+        break;
+      }
+
+      return -1;  // Error occurred.
+    }
+
+    total_written += written_bytes;
+    // Skip the buffers which were written completely. A partially written
+    // buffer is continued at the right offset by the next write.
+    while ((index < num_buffers) &&
+           (written_bytes >= buffers[index].length - offset)) {
+      written_bytes -= buffers[index].length - offset;
+      index++;
+      offset = 0;
+    }
+    offset += written_bytes;
+  }
+
+  return total_written;
+}
 #endif
 
 }  // namespace bin
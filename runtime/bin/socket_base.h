@@ -148,6 +148,12 @@ class AddressList {
   DISALLOW_COPY_AND_ASSIGN(AddressList);
 };
 
+// A single buffer of a vectored write, see SocketBase::WriteVectored.
+struct SocketWriteBuffer {
+  const void* data;
+  intptr_t length;
+};
+
 class SocketControlMessage {
  public:
   SocketControlMessage(intptr_t level,
@@ -196,6 +202,14 @@ class SocketBase : public AllStatic {
                         const void* buffer,
                         intptr_t num_bytes,
                         SocketOpKind sync);
+  // Writes the `num_buffers` buffers in order, like Write would write their
+  // concatenation, but without copying them and with as few system calls as
+  // possible. Returns the total number of bytes written, which is less than
+  // the total length if the socket would block, or -1 on error.
+  static intptr_t WriteVectored(intptr_t fd,
+                                const SocketWriteBuffer* buffers,
+                                intptr_t num_buffers,
+                                SocketOpKind sync);
 
   // Send data on a socket. The port to send to is specified in the port
   // component of the passed RawAddr structure. The RawAddr structure is only
@@ -217,6 +231,18 @@ class SocketBase : public AllStatic {
                            intptr_t num_bytes,
                            RawAddr* addr,
                            SocketOpKind sync);
+  // Receives up to `num_datagrams` datagrams, with a single system call where
+  // the platform supports it. Datagram i is received into the
+  // `buffer_num_bytes` bytes at `buffer + i * buffer_num_bytes`, its length is
+  // stored in `lengths[i]` and its sender in `addrs[i]`. Returns the number of
+  // datagrams received, 0 if none is available, or -1 on error.
+  static intptr_t RecvFromBatch(intptr_t fd,
+                                void* buffer,
+                                intptr_t buffer_num_bytes,
+                                intptr_t num_datagrams,
+                                intptr_t* lengths,
+                                RawAddr* addrs,
+                                SocketOpKind sync);
   static intptr_t ReceiveMessage(intptr_t fd,
                                  void* buffer,
                                  int64_t* p_buffer_num_bytes,
@@ -294,6 +320,13 @@ class SocketBase : public AllStatic {
                             const void* buffer,
                             intptr_t num_bytes,
                             SocketOpKind sync);
+  // Issues a single vectored write of (a prefix of) `buffers`, skipping the
+  // first `first_offset` bytes of the first buffer.
+  static intptr_t WriteVectoredImpl(intptr_t fd,
+                                    const SocketWriteBuffer* buffers,
+                                    intptr_t num_buffers,
+                                    intptr_t first_offset,
+                                    SocketOpKind sync);
 #endif
 
   DISALLOW_ALLOCATION();
@@ -162,6 +162,20 @@ intptr_t SocketBase::WriteImpl(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteVectoredImpl(intptr_t fd,
+                                       const SocketWriteBuffer* buffers,
+                                       intptr_t num_buffers,
+                                       intptr_t first_offset,
+                                       SocketOpKind sync) {
+  // IOHandle has no vectored write. Write the first buffer, WriteVectored
+  // continues with the following ones.
+  ASSERT(num_buffers > 0);
+  return WriteImpl(fd,
+                   reinterpret_cast<const uint8_t*>(buffers[0].data) +
+                       first_offset,
+                   buffers[0].length - first_offset, sync);
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
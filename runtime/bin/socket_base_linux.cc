@@ -35,6 +35,40 @@ void SocketBase::GetError(intptr_t fd, OSError* os_error) {
   os_error->SetCodeAndMessage(OSError::kSystem, errno);
 }
 
+intptr_t SocketBase::RecvFromBatch(intptr_t fd,
+                                   void* buffer,
+                                   intptr_t buffer_num_bytes,
+                                   intptr_t num_datagrams,
+                                   intptr_t* lengths,
+                                   RawAddr* addrs,
+                                   SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  const intptr_t kMaxDatagrams = 64;
+  ASSERT((num_datagrams > 0) && (num_datagrams <= kMaxDatagrams));
+  struct mmsghdr messages[kMaxDatagrams];
+  struct iovec iov[kMaxDatagrams];
+  memset(messages, 0, num_datagrams * sizeof(messages[0]));
+  for (intptr_t i = 0; i < num_datagrams; i++) {
+    iov[i].iov_base = reinterpret_cast<uint8_t*>(buffer) + i * buffer_num_bytes;
+    iov[i].iov_len = buffer_num_bytes;
+    messages[i].msg_hdr.msg_iov = &iov[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    messages[i].msg_hdr.msg_name = &addrs[i].addr;
+    messages[i].msg_hdr.msg_namelen = sizeof(addrs[i].ss);
+  }
+  // Returns as soon as no more datagrams are queued, as the socket is
+  // non-blocking.
+  intptr_t received = TEMP_FAILURE_RETRY(
+      recvmmsg(fd, messages, num_datagrams, 0, /*timeout=*/nullptr));
+  if ((sync == kAsync) && (received == -1) && (errno == EWOULDBLOCK)) {
+    return 0;
+  }
+  for (intptr_t i = 0; i < received; i++) {
+    lengths[i] = messages[i].msg_len;
+  }
+  return received;
+}
+
 int SocketBase::GetType(intptr_t fd) {
   struct stat64 buf;
   int result = TEMP_FAILURE_RETRY(fstat64(fd, &buf));
@@ -14,6 +14,7 @@
 #include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/stat.h>     // NOLINT
+#include <sys/uio.h>      // NOLINT
 #include <unistd.h>       // NOLINT
 
 #include "bin/fdutils.h"
@@ -21,6 +22,7 @@
 #include "bin/ifaddrs.h"
 #include "bin/socket_base_macos.h"
 #include "platform/signal_blocker.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -200,6 +202,25 @@ intptr_t SocketBase::WriteImpl(intptr_t fd,
   return TEMP_FAILURE_RETRY(write(fd, buffer, num_bytes));
 }
 
+intptr_t SocketBase::WriteVectoredImpl(intptr_t fd,
+                                       const SocketWriteBuffer* buffers,
+                                       intptr_t num_buffers,
+                                       intptr_t first_offset,
+                                       SocketOpKind sync) {
+  // IOV_MAX is at least 1024 on all supported platforms. Larger lists are
+  // written by further calls from WriteVectored.
+  const intptr_t kMaxVectors = 64;
+  struct iovec iov[kMaxVectors];
+  const intptr_t count = Utils::Minimum(num_buffers, kMaxVectors);
+  for (intptr_t i = 0; i < count; i++) {
+    const intptr_t skip = (i == 0) ? first_offset : 0;
+    iov[i].iov_base = const_cast<uint8_t*>(
+        reinterpret_cast<const uint8_t*>(buffers[i].data) + skip);
+    iov[i].iov_len = buffers[i].length - skip;
+  }
+  return TEMP_FAILURE_RETRY(writev(fd, iov, count));
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
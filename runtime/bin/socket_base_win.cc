@@ -134,6 +134,21 @@ intptr_t SocketBase::Write(intptr_t fd,
   return handle->Write(buffer, num_bytes);
 }
 
+intptr_t SocketBase::WriteVectored(intptr_t fd,
+                                   const SocketWriteBuffer* buffers,
+                                   intptr_t num_buffers,
+                                   SocketOpKind sync) {
+  // Writes are overlapped and only one can be pending at a time. Start the
+  // write of the first non-empty buffer; the caller continues with the rest
+  // once the write event signals its completion.
+  for (intptr_t i = 0; i < num_buffers; i++) {
+    if (buffers[i].length > 0) {
+      return Write(fd, buffers[i].data, buffers[i].length, sync);
+    }
+  }
+  return 0;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -138,7 +138,10 @@ intptr_t Socket::CreateBindDatagram(const RawAddr& addr,
 
 intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
                                         intptr_t backlog,
-                                        bool v6_only) {
+                                        bool v6_only,
+                                        bool reuse_port) {
+  // See ListeningSocketRegistry::SupportsReusePort().
+  ASSERT(!reuse_port);
   LOG_INFO("ServerSocket::CreateBindListen: calling socket(SOCK_STREAM)\n");
   intptr_t fd = NO_RETRY_EXPECTED(socket(addr.ss.ss_family, SOCK_STREAM, 0));
   if (fd < 0) {
@@ -9,6 +9,7 @@
 
 #include <errno.h>  // NOLINT
 
+#include "bin/eventhandler.h"
 #include "bin/fdutils.h"
 #include "platform/signal_blocker.h"
 #include "platform/syslog.h"
@@ -22,7 +23,8 @@ Socket::Socket(intptr_t fd)
       fd_(fd),
       isolate_port_(Dart_GetMainPortId()),
       port_(ILLEGAL_PORT),
-      udp_receive_buffer_(nullptr) {}
+      udp_receive_buffer_(nullptr),
+      event_handler_shard_(EventHandler::ShardForDescriptor(fd)) {}
 
 void Socket::CloseFd() {
   SetClosedFd();
@@ -176,7 +178,8 @@ intptr_t Socket::CreateBindDatagram(const RawAddr& addr,
 
 intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
                                         intptr_t backlog,
-                                        bool v6_only) {
+                                        bool v6_only,
+                                        bool reuse_port) {
   intptr_t fd;
 
   fd = NO_RETRY_EXPECTED(
@@ -189,6 +192,19 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
   VOID_NO_RETRY_EXPECTED(
       setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval)));
 
+  if (reuse_port) {
+#if defined(SO_REUSEPORT)
+    ASSERT(ListeningSocketRegistry::SupportsReusePort());
+    if (NO_RETRY_EXPECTED(setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &optval,
+                                     sizeof(optval))) != 0) {
+      FDUtils::SaveErrorAndClose(fd);
+      return -1;
+    }
+#else
+    UNREACHABLE();
+#endif  // defined(SO_REUSEPORT)
+  }
+
   if (addr.ss.ss_family == AF_INET6) {
     optval = v6_only ? 1 : 0;
     VOID_NO_RETRY_EXPECTED(
@@ -206,7 +222,7 @@ intptr_t ServerSocket::CreateBindListen(const RawAddr& addr,
       (SocketBase::GetPort(fd) == 65535)) {
     // Don't close the socket until we have created a new socket, ensuring
     // that we do not get the bad port number again.
-    intptr_t new_fd = CreateBindListen(addr, backlog, v6_only);
+    intptr_t new_fd = CreateBindListen(addr, backlog, v6_only, reuse_port);
     FDUtils::SaveErrorAndClose(fd);
     return new_fd;
   }
@@ -1361,6 +1361,93 @@ typedef enum {
 DART_EXPORT Dart_PerformanceMode
 Dart_SetPerformanceMode(Dart_PerformanceMode mode);
 
+/**
+ * A callback invoked when a garbage collection pause exceeds the target set
+ * with Dart_SetGCPauseTarget.
+ *
+ * The callback is invoked on the thread that performed the collection while
+ * the isolate group is still paused. It must not call into the VM.
+ *
+ * \param callback_data The data passed to Dart_SetGCPauseTarget.
+ * \param gc_type The kind of pause, e.g. "Scavenge" or "MarkSweep".
+ * \param pause_micros The duration of the pause in microseconds.
+ * \param target_micros The pause target in microseconds.
+ */
+typedef void (*Dart_GCPauseTargetMissedCallback)(void* callback_data,
+                                                 const char* gc_type,
+                                                 int64_t pause_micros,
+                                                 int64_t target_micros);
+
+/**
+ * Sets a target for the duration of the garbage collection pauses of the
+ * current isolate group.
+ *
+ * The heap adapts to the target by shrinking new-space, starting concurrent
+ * marking earlier, using more marker threads and evacuating less per
+ * incremental compaction, at the expense of throughput and memory overhead.
+ * Pauses may still exceed the target, for instance when the heap contains
+ * large amounts of live data; each such pause is reported to |callback|, if
+ * given, and to the timeline.
+ *
+ * Requires a current isolate.
+ *
+ * \param target_micros The target in microseconds, or 0 to remove the target.
+ * \param callback A callback invoked after pauses that missed the target, or
+ *   NULL.
+ * \param callback_data Data passed to the callback.
+ */
+DART_EXPORT void Dart_SetGCPauseTarget(
+    int64_t target_micros,
+    Dart_GCPauseTargetMissedCallback callback,
+    void* callback_data);
+
+/**
+ * A callback invoked when the memory usage of an isolate group crosses the
+ * soft limit set with Dart_SetIsolateGroupMemoryLimits.
+ *
+ * The callback is invoked on the mutator thread that crossed the limit, after
+ * the collection that was triggered by crossing it. It must not call into the
+ * VM.
+ *
+ * \param callback_data The data passed to Dart_SetIsolateGroupMemoryLimits.
+ * \param usage_before_bytes The usage when the limit was crossed.
+ * \param usage_after_bytes The usage after the collection.
+ */
+typedef void (*Dart_MemoryPressureCallback)(void* callback_data,
+                                            intptr_t usage_before_bytes,
+                                            intptr_t usage_after_bytes);
+
+/**
+ * Sets memory limits for the current isolate group.
+ *
+ * The limits apply to the capacity of the new and old generations plus the
+ * external sizes of finalizable handles and external typed data.
+ *
+ * When the usage crosses the soft limit, the isolate group collects and
+ * compacts its heap and then invokes |callback|, if given. This happens once
+ * per crossing: only after a collection finds the usage back under the soft
+ * limit is the next crossing acted upon.
+ *
+ * Allocations that would take the usage over the hard limit fail, after a
+ * collection, as if the heap were exhausted: Dart allocations throw an
+ * OutOfMemoryError in the isolate that attempted them, and external
+ * allocations fail. Other isolate groups are not affected. The new
+ * generation may still grow past the hard limit when it is resized after a
+ * scavenge.
+ *
+ * Requires a current isolate.
+ *
+ * \param soft_limit_bytes The soft limit in bytes, or 0 for no soft limit.
+ * \param hard_limit_bytes The hard limit in bytes, or 0 for no hard limit.
+ * \param callback A callback invoked when the soft limit is crossed, or NULL.
+ * \param callback_data Data passed to the callback.
+ */
+DART_EXPORT void Dart_SetIsolateGroupMemoryLimits(
+    intptr_t soft_limit_bytes,
+    intptr_t hard_limit_bytes,
+    Dart_MemoryPressureCallback callback,
+    void* callback_data);
+
 /**
  * Starts the CPU sampling profiler.
  */
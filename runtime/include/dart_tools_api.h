@@ -625,4 +625,35 @@ DART_EXPORT char* Dart_WriteHeapSnapshot(
     Dart_HeapSnapshotWriteChunkCallback write,
     void* context);
 
+/**
+ * Like `Dart_WriteHeapSnapshot`, but the chunks passed to `callback` together
+ * form a gzip stream of the heap snapshot, which is typically a fraction of
+ * its size.
+ *
+ * If `child_pid` is not `nullptr`, the isolate group is only paused to fork
+ * a child process, which takes, compresses and writes the snapshot from its
+ * copy of the heap, and this function returns right after the fork. The
+ * `write` callback is invoked in the child process, which exits after writing
+ * the last chunk. The child runs no other thread, so `write` must not wait
+ * for other threads, and should only call functions which are safe to call
+ * after a fork, such as `write(2)` and `free`. Identity hashes which the
+ * snapshot assigns to objects are not assigned in the parent process.
+ * Forking is supported on Linux, Android and macOS.
+ *
+ * \param write Callback used to write chunks of the compressed heap snapshot.
+ *
+ * \param context Opaque context which would be passed on each invocation of
+ *   `write` callback.
+ *
+ * \param child_pid If not `nullptr`, receives the process id of the child
+ *   process, which the caller is responsible for waiting for.
+ *
+ * \returns `nullptr` if the operation is successful otherwise error message.
+ *   Caller owns error message string and needs to `free` it.
+ */
+DART_EXPORT char* Dart_WriteCompressedHeapSnapshot(
+    Dart_HeapSnapshotWriteChunkCallback write,
+    void* context,
+    int64_t* child_pid);
+
 #endif  // RUNTIME_INCLUDE_DART_TOOLS_API_H_
@@ -298,8 +298,10 @@ main() {
     "Dart_SetFfiNativeResolver",
     "Dart_SetField",
     "Dart_SetFileModifiedCallback",
+    "Dart_SetGCPauseTarget",
     "Dart_SetHeapSamplingPeriod",
     "Dart_SetIntegerReturnValue",
+    "Dart_SetIsolateGroupMemoryLimits",
     "Dart_SetLibraryTagHandler",
     "Dart_SetMessageNotifyCallback",
     "Dart_SetNativeInstanceField",
@@ -350,6 +352,7 @@ main() {
     "Dart_TypeToNullableType",
     "Dart_TypeVoid",
     "Dart_VersionString",
+    "Dart_WriteCompressedHeapSnapshot",
     "Dart_WriteHeapSnapshot",
     "Dart_WriteProfileToTimeline",
   ];
@@ -0,0 +1,82 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests that compiling functions in parallel (--precompiler-threads) compiles
+// the same functions as compiling them serially, into a program which
+// behaves the same.
+
+import "dart:convert";
+import "dart:io";
+
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+main(List<String> args) async {
+  if (!isAOTRuntime) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and gen_snapshot not available on the test device.
+  }
+
+  await withTempDir('precompiler-threads-test', (String tempDir) async {
+    // A program with enough functions for the threads to compete for them.
+    final script = path.join(sdkDir, 'pkg/kernel/bin/dump.dart');
+    final scriptDill = path.join(tempDir, 'kernel_dump.dill');
+
+    // Compile script to Kernel IR.
+    await run(genKernel, <String>[
+      '--aot',
+      '--platform=$platformDill',
+      '-o',
+      scriptDill,
+      script,
+    ]);
+
+    final serial = await precompile(tempDir, scriptDill, 1);
+    final parallel = await precompile(tempDir, scriptDill, 4);
+
+    // The global object pool is filled in the order in which functions are
+    // compiled, so the instructions may differ but not the functions.
+    Expect.listEquals(serial.functions, parallel.functions);
+    Expect.equals(serial.output, parallel.output);
+  });
+}
+
+class PrecompiledProgram {
+  // The compiled functions, sorted, with their library and class.
+  final List<String> functions;
+  // What the program wrote when run on its own kernel.
+  final String output;
+
+  PrecompiledProgram(this.functions, this.output);
+}
+
+Future<PrecompiledProgram> precompile(
+  String tempDir,
+  String scriptDill,
+  int threads,
+) async {
+  final snapshot = path.join(tempDir, 'threads_$threads.so');
+  final sizesJson = path.join(tempDir, 'threads_$threads-sizes.json');
+  await run(genSnapshot, <String>[
+    '--precompiler-threads=$threads',
+    '--snapshot-kind=app-aot-elf',
+    '--print-instructions-sizes-to=$sizesJson',
+    '--elf=$snapshot',
+    scriptDill,
+  ]);
+
+  final sizes = json.decode(await File(sizesJson).readAsString()) as List;
+  final functions = <String>[
+    for (final entry in sizes) '${entry['l']} ${entry['c']} ${entry['n']}',
+  ]..sort();
+
+  final outputFile = path.join(tempDir, 'threads_$threads.txt');
+  await run(dartPrecompiledRuntime, <String>[snapshot, scriptDill, outputFile]);
+  return PrecompiledProgram(functions, await File(outputFile).readAsString());
+}
@@ -398,12 +398,14 @@ class ClassTable : public MallocAllocated {
 #if !defined(PRODUCT)
   bool ShouldTraceAllocationFor(intptr_t cid) {
     return !IsTopLevelCid(cid) &&
-           (classes_.At<kAllocationTracingStateIndex>(cid) != kTracingDisabled);
+           ((classes_.At<kAllocationTracingStateIndex>(cid) & ~kPretenureBit) !=
+            kTracingDisabled);
   }
 
   void SetTraceAllocationFor(intptr_t cid, bool trace) {
-    classes_.At<kAllocationTracingStateIndex>(cid) =
-        trace ? kTraceAllocationBit : kTracingDisabled;
+    auto& slot = classes_.At<kAllocationTracingStateIndex>(cid);
+    slot = (slot & kPretenureBit) |
+           (trace ? kTraceAllocationBit : kTracingDisabled);
   }
 
   void SetCollectInstancesFor(intptr_t cid, bool trace) {
@@ -419,14 +421,25 @@ class ClassTable : public MallocAllocated {
     auto& slot = classes_.At<kAllocationTracingStateIndex>(cid);
     return (slot & kCollectInstancesBit) != 0;
   }
+#endif  // !defined(PRODUCT)
+
+  // Compiled code leaves allocations of classes with a non-zero tracing state
+  // to the runtime, which allocates instances of pretenured classes in old
+  // space. See Scavenger::ShouldPretenure. Unlike the other bits, this one is
+  // also kept in PRODUCT mode.
+  void SetPretenureFor(intptr_t cid, bool pretenure) {
+    auto& slot = classes_.At<kAllocationTracingStateIndex>(cid);
+    if (pretenure) {
+      slot |= kPretenureBit;
+    } else {
+      slot &= ~kPretenureBit;
+    }
+  }
 
   void UpdateCachedAllocationTracingStateTablePointer() {
     cached_allocation_tracing_state_table_.store(
         classes_.GetColumn<kAllocationTracingStateIndex>());
   }
-#else
-  void UpdateCachedAllocationTracingStateTablePointer() {}
-#endif  // !defined(PRODUCT)
 
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
   void PopulateUserVisibleNames();
@@ -472,7 +485,6 @@ class ClassTable : public MallocAllocated {
   void PrintObjectLayout(const char* filename);
 #endif
 
-#ifndef PRODUCT
   // Describes layout of heap stats for code generation. See offset_extractor.cc
   struct ArrayTraits {
     static intptr_t elements_start_offset() { return 0; }
@@ -485,6 +497,8 @@ class ClassTable : public MallocAllocated {
     return OFFSET_OF(ClassTable, cached_allocation_tracing_state_table_);
   }
 
+#ifndef PRODUCT
+
   void AllocationProfilePrintJSON(JSONStream* stream, bool internal);
 
   void PrintToJSONObject(JSONObject* object);
@@ -552,22 +566,19 @@ class ClassTable : public MallocAllocated {
 
   // Unfortunately std::tuple used by CidIndexedTable does not have a stable
   // layout so we can't refer to its elements from generated code.
-  NOT_IN_PRODUCT(AcqRelAtomic<uint8_t*> cached_allocation_tracing_state_table_ =
-                     {nullptr});
+  AcqRelAtomic<uint8_t*> cached_allocation_tracing_state_table_ = {nullptr};
 
   enum {
     kClassIndex = 0,
     kSizeIndex,
     kUnboxedFieldBitmapIndex,
-#if !defined(PRODUCT)
     kAllocationTracingStateIndex,
-#endif
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
     kClassNameIndex,
 #endif
   };
 
-#if !defined(PRODUCT)
+#if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
   CidIndexedTable<ClassIdTagType,
                   ClassPtr,
                   uint32_t,
@@ -575,25 +586,21 @@ class ClassTable : public MallocAllocated {
                   uint8_t,
                   const char*>
       classes_;
-#elif defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
+#else
   CidIndexedTable<ClassIdTagType,
                   ClassPtr,
                   uint32_t,
                   UnboxedFieldBitmap,
-                  const char*>
-      classes_;
-#else
-  CidIndexedTable<ClassIdTagType, ClassPtr, uint32_t, UnboxedFieldBitmap>
+                  uint8_t>
       classes_;
 #endif
 
-#ifndef PRODUCT
   enum {
     kTracingDisabled = 0,
     kTraceAllocationBit = (1 << 0),
     kCollectInstancesBit = (1 << 1),
+    kPretenureBit = (1 << 2),
   };
-#endif  // !PRODUCT
 
   CidIndexedTable<classid_t, ClassPtr> top_level_classes_;
 };
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "vm/bit_vector.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
@@ -976,6 +977,61 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
     instr->ReplaceWith(call, current_iterator());
     return;
   }
+
+  if (TryReplaceWithProfiledPolymorphicCall(instr)) {
+    return;
+  }
+}
+
+bool AotCallSpecializer::TryReplaceWithProfiledPolymorphicCall(
+    InstanceCallInstr* instr) {
+  const AotProfile* profile = AotProfile::Current();
+  if (profile == nullptr) {
+    return false;
+  }
+  const AotProfile::CallSite* site = profile->LookupCallSite(
+      AotProfile::FunctionOf(flow_graph(), instr), instr);
+  if (site == nullptr || site->receivers.is_empty() ||
+      site->receivers.length() > FLAG_max_polymorphic_checks) {
+    return false;
+  }
+
+  // Speculate on the receiver classes seen by the training run. Classes which
+  // are never allocated in this program cannot be receivers, and all other
+  // classes are still handled by the call, so the targets are not complete.
+  const Array& args_desc_array =
+      Array::Handle(Z, instr->GetArgumentsDescriptor());
+  const ICData& ic_data = ICData::ZoneHandle(
+      Z, ICData::New(flow_graph()->function(), instr->function_name(),
+                     args_desc_array, DeoptId::kNone,
+                     /* args_tested = */ 1, ICData::kOptimized));
+  ClassTable* class_table = isolate_group()->class_table();
+  Class& cls = Class::Handle(Z);
+  Function& target = Function::Handle(Z);
+  for (const AotProfile::Receiver& receiver : site->receivers) {
+    cls = class_table->At(receiver.cid);
+    if (cls.IsNull() ||
+        (receiver.cid >= kNumPredefinedCids && !cls.is_allocated())) {
+      continue;
+    }
+    target = instr->ResolveForReceiverClass(cls);
+    if (target.IsNull()) {
+      continue;
+    }
+    ic_data.AddReceiverCheck(receiver.cid, target, receiver.count);
+  }
+  if (ic_data.NumberOfChecksIs(0)) {
+    return false;
+  }
+
+  instr->set_ic_data(&ic_data);
+  const CallTargets* targets = CallTargets::Create(Z, ic_data);
+  ASSERT(!targets->is_empty());
+  PolymorphicInstanceCallInstr* call =
+      PolymorphicInstanceCallInstr::FromCall(Z, instr, *targets,
+                                             /* complete = */ false);
+  instr->ReplaceWith(call, current_iterator());
+  return true;
 }
 
 void AotCallSpecializer::VisitStaticCall(StaticCallInstr* instr) {
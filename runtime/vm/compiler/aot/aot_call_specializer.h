@@ -35,6 +35,10 @@ class AotCallSpecializer : public CallSpecializer {
 
   bool TryCreateICDataForUniqueTarget(InstanceCallInstr* call);
 
+  // Replace a call which the AOT profile recorded few receiver classes for
+  // by a polymorphic call testing for them first.
+  bool TryReplaceWithProfiledPolymorphicCall(InstanceCallInstr* call);
+
   bool RecognizeRuntimeTypeGetter(InstanceCallInstr* call);
   bool TryReplaceWithHaveSameRuntimeType(TemplateDartCall<0>* call);
 
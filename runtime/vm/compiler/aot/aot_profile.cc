@@ -0,0 +1,505 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/aot_profile.h"
+
+#include "platform/text_buffer.h"
+#include "vm/compiler/aot/precompiler.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/hash_table.h"
+#include "vm/lockers.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/program_visitor.h"
+#include "vm/symbols.h"
+
+namespace dart {
+
+// A profile is a text file. After the header line, it has a line for each
+// function
+//
+//   F <count> <optimized> <fingerprint> <library url> <class> <name> <position>
+//
+// followed by a line for each of its call sites
+//
+//   C <position> <count> <selector>
+//
+// each followed by a line for each receiver class the call site saw
+//
+//   R <count> <library url> <class>
+//
+// with the fields separated by tabs. <optimized> is 1 if the function was
+// optimized during the run and 0 otherwise. Names do not include private
+// keys, which differ between runs.
+static constexpr const char* kHeader = "dart-aot-profile 2";
+
+class AotProfile::FunctionProfile : public ZoneAllocated {
+ public:
+  FunctionProfile(Zone* zone,
+                  intptr_t count,
+                  bool optimized,
+                  int32_t fingerprint)
+      : count(count),
+        optimized(optimized),
+        fingerprint(fingerprint),
+        call_sites(zone, 4) {}
+
+  const intptr_t count;
+  // Whether the counts of the function's call sites miss the calls made by
+  // its optimized code.
+  const bool optimized;
+  const int32_t fingerprint;
+  GrowableArray<CallSite*> call_sites;
+};
+
+static const char* NameWithoutPrivateKey(Zone* zone, const String& name) {
+  return String::Handle(zone, String::RemovePrivateKey(name)).ToCString();
+}
+
+static const char* ClassKey(Zone* zone, const Class& cls) {
+  const auto& library = Library::Handle(zone, cls.library());
+  const char* url =
+      library.IsNull() ? "" : String::Handle(zone, library.url()).ToCString();
+  const auto& name = String::Handle(zone, cls.Name());
+  return OS::SCreate(zone, "%s\t%s", url, NameWithoutPrivateKey(zone, name));
+}
+
+static const char* FunctionKey(Zone* zone, const Function& function) {
+  const auto& cls = Class::Handle(zone, function.Owner());
+  return OS::SCreate(
+      zone, "%s\t%s\t%" Pd32, ClassKey(zone, cls),
+      NameWithoutPrivateKey(zone, String::Handle(zone, function.name())),
+      function.token_pos().Serialize());
+}
+
+// Writes the profile of each function which has unoptimized code, and thus
+// ICData.
+class ProfileWriter : public FunctionVisitor {
+ public:
+  ProfileWriter(Zone* zone, BaseTextBuffer* buffer)
+      : zone_(zone),
+        buffer_(buffer),
+        class_table_(IsolateGroup::Current()->class_table()),
+        code_(Code::Handle(zone)),
+        descriptors_(PcDescriptors::Handle(zone)),
+        ic_data_array_(Array::Handle(zone)),
+        ic_data_(ICData::Handle(zone)),
+        cls_(Class::Handle(zone)),
+        selector_(String::Handle(zone)),
+        token_positions_(zone, 0) {}
+
+  void VisitFunction(const Function& function) {
+    code_ = function.unoptimized_code();
+    ic_data_array_ = function.ic_data_array();
+    if (code_.IsNull() || ic_data_array_.IsNull()) {
+      return;
+    }
+
+    // The usage counter is reset when a function is optimized.
+    intptr_t count = function.usage_counter();
+    const bool optimized = (count < 0) || function.HasOptimizedCode() ||
+                           (function.deoptimization_counter() > 0);
+    if (optimized) {
+      count = Utils::Maximum<intptr_t>(count,
+                                       FLAG_optimization_counter_threshold);
+    }
+    buffer_->Printf("F\t%" Pd "\t%d\t%" Pd32 "\t%s\n", count,
+                    optimized ? 1 : 0, function.SourceFingerprint(),
+                    FunctionKey(zone_, function));
+
+    // ICData only records the deopt id of its call, so map deopt ids to
+    // positions using the descriptors of the unoptimized code.
+    token_positions_.Clear();
+    descriptors_ = code_.pc_descriptors();
+    PcDescriptors::Iterator iter(descriptors_,
+                                 UntaggedPcDescriptors::kIcCall |
+                                     UntaggedPcDescriptors::kUnoptStaticCall);
+    while (iter.MoveNext()) {
+      const intptr_t deopt_id = iter.DeoptId();
+      if (deopt_id < 0) continue;
+      while (token_positions_.length() <= deopt_id) {
+        token_positions_.Add(TokenPosition::kNoSource);
+      }
+      token_positions_[deopt_id] = iter.TokenPos();
+    }
+
+    for (intptr_t i = Function::ICDataArrayIndices::kFirstICData;
+         i < ic_data_array_.Length(); i++) {
+      ic_data_ ^= ic_data_array_.At(i);
+      const intptr_t deopt_id = ic_data_.deopt_id();
+      if ((deopt_id >= token_positions_.length()) ||
+          !token_positions_[deopt_id].IsReal()) {
+        continue;
+      }
+      selector_ = ic_data_.target_name();
+      buffer_->Printf("C\t%" Pd32 "\t%" Pd "\t%s\n",
+                      token_positions_[deopt_id].Serialize(),
+                      ic_data_.AggregateCount(),
+                      NameWithoutPrivateKey(zone_, selector_));
+      if (ic_data_.NumArgsTested() == 0) continue;
+      for (intptr_t j = 0; j < ic_data_.NumberOfChecks(); j++) {
+        const intptr_t receiver_count = ic_data_.GetCountAt(j);
+        if (receiver_count == 0) continue;
+        cls_ = class_table_->At(ic_data_.GetReceiverClassIdAt(j));
+        buffer_->Printf("R\t%" Pd "\t%s\n", receiver_count,
+                        ClassKey(zone_, cls_));
+      }
+    }
+  }
+
+ private:
+  Zone* const zone_;
+  BaseTextBuffer* const buffer_;
+  ClassTable* const class_table_;
+  Code& code_;
+  PcDescriptors& descriptors_;
+  Array& ic_data_array_;
+  ICData& ic_data_;
+  Class& cls_;
+  String& selector_;
+  GrowableArray<TokenPosition> token_positions_;
+};
+
+void AotProfile::WriteTo(Thread* thread, BaseTextBuffer* buffer) {
+  buffer->Printf("%s\n", kHeader);
+  thread->isolate_group()->RunWithStoppedMutators([&]() {
+    ProfileWriter writer(thread->zone(), buffer);
+    ProgramVisitor::WalkProgram(thread->zone(), thread->isolate_group(),
+                                &writer);
+  });
+}
+
+void AotProfile::Write(Thread* thread, const char* filename) {
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_write == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.\n");
+    return;
+  }
+
+  TextBuffer buffer(64 * KB);
+  WriteTo(thread, &buffer);
+
+  void* file = file_open(filename, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write AOT profile: %s\n", filename);
+    return;
+  }
+  file_write(buffer.buffer(), buffer.length(), file);
+  file_close(file);
+}
+
+AotProfile::AotProfile(Zone* zone)
+    : zone_(zone),
+      functions_(zone, 1024),
+      function_indices_(zone),
+      function_cache_(Array::Handle(
+          zone,
+          HashTables::New<FunctionMap>(/*initial_capacity=*/1024))) {}
+
+AotProfile* AotProfile::Read(Thread* thread, const char* filename) {
+  auto file_open = Dart::file_open_callback();
+  auto file_read = Dart::file_read_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_read == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.\n");
+    return nullptr;
+  }
+
+  void* file = file_open(filename, /*write=*/false);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", filename);
+    return nullptr;
+  }
+  uint8_t* contents = nullptr;
+  intptr_t length = -1;
+  file_read(&contents, &length, file);
+  file_close(file);
+  if (contents == nullptr) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", filename);
+    return nullptr;
+  }
+
+  // Copy the contents to terminate them.
+  char* text = thread->zone()->MakeCopyOfStringN(
+      reinterpret_cast<const char*>(contents), length);
+  free(contents);
+
+  AotProfile* profile = FromText(thread, text);
+  if (profile == nullptr) {
+    OS::PrintErr("warning: Malformed AOT profile: %s\n", filename);
+  }
+  return profile;
+}
+
+AotProfile* AotProfile::FromText(Thread* thread, const char* text) {
+  // Parsing splits a copy of the text in place.
+  char* contents = thread->zone()->MakeCopyOfString(text);
+  AotProfile* profile = new (thread->zone()) AotProfile(thread->zone());
+  return profile->Parse(thread, contents) ? profile : nullptr;
+}
+
+// Splits [line] in place into at most [max_fields] tab-separated fields.
+static intptr_t SplitFields(char* line, char** fields, intptr_t max_fields) {
+  intptr_t count = 0;
+  while (count < max_fields) {
+    fields[count++] = line;
+    char* tab = strchr(line, '\t');
+    if (tab == nullptr) break;
+    *tab = '\0';
+    line = tab + 1;
+  }
+  return count;
+}
+
+static bool ParseCount(const char* str, intptr_t* value) {
+  int64_t result;
+  if (!OS::StringToInt64(str, &result) || (result < 0)) {
+    return false;
+  }
+  *value = static_cast<intptr_t>(Utils::Minimum<int64_t>(result, kMaxInt32));
+  return true;
+}
+
+static int MostFrequentFirst(const AotProfile::Receiver* a,
+                             const AotProfile::Receiver* b) {
+  if (a->count != b->count) {
+    return a->count > b->count ? -1 : 1;
+  }
+  return 0;
+}
+
+bool AotProfile::Parse(Thread* thread, char* contents) {
+  Zone* zone = thread->zone();
+  auto& name = String::Handle(zone);
+  auto& library = Library::Handle(zone);
+  auto& cls = Class::Handle(zone);
+  // Maps the keys of receiver classes to their class ids, or -1.
+  CStringIntMap class_ids(zone);
+
+  FunctionProfile* function = nullptr;
+  CallSite* call_site = nullptr;
+  constexpr intptr_t kMaxFields = 8;
+  char* fields[kMaxFields];
+  char* line = contents;
+  char* end = strchr(line, '\n');
+  if ((end == nullptr) || (strncmp(line, kHeader, end - line) != 0)) {
+    return false;
+  }
+  while (end != nullptr) {
+    line = end + 1;
+    end = strchr(line, '\n');
+    if (end != nullptr) {
+      *end = '\0';
+    }
+    if (*line == '\0') continue;
+
+    const intptr_t field_count = SplitFields(line, fields, kMaxFields);
+    intptr_t count;
+    int64_t number;
+    if (strcmp(fields[0], "F") == 0) {
+      if ((field_count != 8) || !ParseCount(fields[1], &count) ||
+          ((strcmp(fields[2], "0") != 0) && (strcmp(fields[2], "1") != 0)) ||
+          !OS::StringToInt64(fields[3], &number)) {
+        return false;
+      }
+      function = new (zone_)
+          FunctionProfile(zone_, count, /*optimized=*/*fields[2] == '1',
+                          static_cast<int32_t>(number));
+      call_site = nullptr;
+      const char* key = OS::SCreate(zone_, "%s\t%s\t%s\t%s", fields[4],
+                                    fields[5], fields[6], fields[7]);
+      // Keep the first of functions which cannot be told apart.
+      if (!function_indices_.HasKey(key)) {
+        function_indices_.Insert({key, functions_.length()});
+        functions_.Add(function);
+      }
+    } else if (strcmp(fields[0], "C") == 0) {
+      if ((field_count != 4) || (function == nullptr) ||
+          !OS::StringToInt64(fields[1], &number) ||
+          !ParseCount(fields[2], &count)) {
+        return false;
+      }
+      const int32_t token_pos = static_cast<int32_t>(number);
+      call_site = nullptr;
+      for (intptr_t i = 0; i < function->call_sites.length(); i++) {
+        CallSite* site = function->call_sites[i];
+        if ((site->token_pos == token_pos) &&
+            (strcmp(site->selector, fields[3]) == 0)) {
+          call_site = site;
+          call_site->count += count;
+          break;
+        }
+      }
+      if (call_site == nullptr) {
+        call_site = new (zone_) CallSite(
+            zone_, token_pos, zone_->MakeCopyOfString(fields[3]), count);
+        function->call_sites.Add(call_site);
+      }
+    } else if (strcmp(fields[0], "R") == 0) {
+      if ((field_count != 4) || (call_site == nullptr) ||
+          !ParseCount(fields[1], &count)) {
+        return false;
+      }
+      const char* key = OS::SCreate(zone, "%s\t%s", fields[2], fields[3]);
+      intptr_t cid = class_ids.LookupValue(key);
+      if (cid == CStringIntMapKeyValueTrait::kNoValue) {
+        name = Symbols::New(thread, fields[2]);
+        library = Library::LookupLibrary(thread, name);
+        cls = Class::null();
+        if (!library.IsNull()) {
+          name = Symbols::New(thread, fields[3]);
+          cls = library.LookupClassAllowPrivate(name);
+        }
+        cid = cls.IsNull() ? -1 : cls.id();
+        class_ids.Insert({key, cid});
+      }
+      if (cid < 0) continue;
+      bool found = false;
+      for (intptr_t i = 0; i < call_site->receivers.length(); i++) {
+        if (call_site->receivers[i].cid == cid) {
+          call_site->receivers[i].count += count;
+          found = true;
+          break;
+        }
+      }
+      if (!found) {
+        call_site->receivers.Add({cid, count});
+      }
+    } else {
+      return false;
+    }
+  }
+
+  for (intptr_t i = 0; i < functions_.length(); i++) {
+    for (intptr_t j = 0; j < functions_[i]->call_sites.length(); j++) {
+      functions_[i]->call_sites[j]->receivers.Sort(MostFrequentFirst);
+    }
+  }
+  return true;
+}
+
+#if defined(TESTING)
+static const AotProfile* profile_for_testing = nullptr;
+
+void AotProfile::SetCurrentForTesting(const AotProfile* profile) {
+  profile_for_testing = profile;
+}
+#endif  // defined(TESTING)
+
+const AotProfile* AotProfile::Current() {
+  Precompiler* precompiler = Precompiler::Instance();
+  if (precompiler != nullptr) {
+    return precompiler->profile();
+  }
+#if defined(TESTING)
+  return profile_for_testing;
+#else
+  return nullptr;
+#endif  // defined(TESTING)
+}
+
+const Function& AotProfile::FunctionOf(FlowGraph* flow_graph,
+                                       Instruction* instr) {
+  const auto& functions = flow_graph->inlining_info().inline_id_to_function;
+  const intptr_t inlining_id = instr->inlining_id();
+  if ((0 <= inlining_id) && (inlining_id < functions.length())) {
+    return *functions[inlining_id];
+  }
+  return flow_graph->function();
+}
+
+const AotProfile::FunctionProfile* AotProfile::LookupFunction(
+    const Function& function) const {
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  auto& value = Object::Handle(zone);
+  {
+    SafepointMutexLocker ml(thread, &function_cache_mutex_);
+    FunctionMap cache(function_cache_.ptr());
+    value = cache.GetOrNull(function);
+    cache.Release();
+  }
+  if (value.IsNull()) {
+    // The first lookup of the function finds its profile by the key of the
+    // function, which takes several allocations, and checks that the
+    // function still has the source it was recorded from.
+    intptr_t index =
+        function_indices_.LookupValue(FunctionKey(zone, function));
+    if ((index == CStringIntMapKeyValueTrait::kNoValue) ||
+        (function.SourceFingerprint() != functions_[index]->fingerprint)) {
+      index = -1;
+    }
+    value = Smi::New(index);
+    SafepointMutexLocker ml(thread, &function_cache_mutex_);
+    FunctionMap cache(function_cache_.ptr());
+    cache.UpdateOrInsert(function, value);
+    function_cache_ = cache.Release().ptr();
+  }
+  const intptr_t index = Smi::Cast(value).Value();
+  return (index >= 0) ? functions_[index] : nullptr;
+}
+
+static const AotProfile::CallSite* FindCallSite(
+    const GrowableArray<AotProfile::CallSite*>& call_sites,
+    Instruction* call) {
+  Zone* zone = Thread::Current()->zone();
+  const String* selector = nullptr;
+  if (auto instance_call = call->AsInstanceCallBase()) {
+    selector = &instance_call->function_name();
+  } else if (auto static_call = call->AsStaticCall()) {
+    selector = &String::Handle(zone, static_call->function().name());
+  } else {
+    return nullptr;
+  }
+  const int32_t token_pos = call->token_pos().Serialize();
+  const char* name = NameWithoutPrivateKey(zone, *selector);
+  for (intptr_t i = 0; i < call_sites.length(); i++) {
+    if ((call_sites[i]->token_pos == token_pos) &&
+        (strcmp(call_sites[i]->selector, name) == 0)) {
+      return call_sites[i];
+    }
+  }
+  return nullptr;
+}
+
+const AotProfile::CallSite* AotProfile::LookupCallSite(
+    const Function& function,
+    Instruction* call) const {
+  const FunctionProfile* profile = LookupFunction(function);
+  return (profile != nullptr) ? FindCallSite(profile->call_sites, call)
+                              : nullptr;
+}
+
+intptr_t AotProfile::CallCount(const Function& function,
+                               Instruction* call,
+                               intptr_t estimate) const {
+  const FunctionProfile* profile = LookupFunction(function);
+  if (profile == nullptr) {
+    return estimate;
+  }
+  if (const CallSite* site = FindCallSite(profile->call_sites, call)) {
+    return site->count;
+  }
+  const int64_t scaled = static_cast<int64_t>(estimate) *
+                         Utils::Maximum<intptr_t>(profile->count, 1);
+  return static_cast<intptr_t>(Utils::Minimum<int64_t>(scaled, kMaxInt32));
+}
+
+bool AotProfile::IsCold(const Function& function, Instruction* call) const {
+  const FunctionProfile* profile = LookupFunction(function);
+  if ((profile == nullptr) || (profile->count == 0) || profile->optimized) {
+    return false;
+  }
+  const CallSite* site = FindCallSite(profile->call_sites, call);
+  return (site != nullptr) && (site->count == 0);
+}
+
+}  // namespace dart
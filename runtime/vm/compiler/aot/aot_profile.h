@@ -0,0 +1,129 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+#define RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+// Forward declarations.
+class Array;
+class BaseTextBuffer;
+class FlowGraph;
+class Function;
+class Instruction;
+class Thread;
+
+// Execution counts recorded by a training run of a program in JIT mode, for
+// use by the precompiler in place of the static estimates it otherwise makes
+// for inlining, speculative devirtualization and block layout.
+//
+// The training run writes the profile (--write_aot_profile_to) from the
+// ICData of unoptimized code when an isolate group shuts down: how often each
+// function and each call site in it ran, and which receiver classes each
+// instance call saw. ICData is not updated by optimized code, so the counts
+// of code which only ran after being optimized are underestimated. The
+// profile records which functions were optimized.
+//
+// gen_snapshot reads the profile back (--use_aot_profile). Functions are
+// identified by their library, class, name and position and call sites by
+// their position and selector, so a profile only applies to the sources it
+// was recorded from. Functions whose source changed since are ignored.
+class AotProfile : public ZoneAllocated {
+ public:
+  // A receiver class seen by an instance call.
+  struct Receiver {
+    intptr_t cid;
+    intptr_t count;
+  };
+
+  // A call site of a function.
+  struct CallSite : public ZoneAllocated {
+    CallSite(Zone* zone,
+             int32_t token_pos,
+             const char* selector,
+             intptr_t count)
+        : token_pos(token_pos),
+          selector(selector),
+          count(count),
+          receivers(zone, 0) {}
+
+    const int32_t token_pos;
+    const char* const selector;
+    intptr_t count;
+    // The receiver classes seen by an instance call, most frequent first.
+    GrowableArray<Receiver> receivers;
+  };
+
+  // Writes the profile of the code run so far by the isolate group of
+  // [thread] to [filename].
+  static void Write(Thread* thread, const char* filename);
+  static void WriteTo(Thread* thread, BaseTextBuffer* buffer);
+
+  // Reads a profile written by [Write]. Returns nullptr and prints a warning
+  // if it cannot be read.
+  static AotProfile* Read(Thread* thread, const char* filename);
+  // Parses a profile written by [WriteTo]. Returns nullptr if it is malformed.
+  static AotProfile* FromText(Thread* thread, const char* text);
+
+  // The profile used by the current AOT compilation, or nullptr.
+  static const AotProfile* Current();
+
+#if defined(TESTING)
+  // Makes [profile] the current one for compilations without a precompiler.
+  static void SetCurrentForTesting(const AotProfile* profile);
+#endif  // defined(TESTING)
+
+  // The function [instr] of [flow_graph] was built from, which differs from
+  // the function of [flow_graph] once other functions have been inlined.
+  static const Function& FunctionOf(FlowGraph* flow_graph, Instruction* instr);
+
+  // Returns the recorded call site of [function] for [call], or nullptr.
+  const CallSite* LookupCallSite(const Function& function,
+                                 Instruction* call) const;
+
+  // Returns how often [call] in [function] was executed. Calls which were
+  // not recorded are assumed to run [estimate] times per entry of [function],
+  // and [estimate] times overall if [function] was not recorded either.
+  intptr_t CallCount(const Function& function,
+                     Instruction* call,
+                     intptr_t estimate) const;
+
+  // Whether [call] in [function] never ran although [function] did. Only
+  // known for functions which were never optimized in the training run.
+  bool IsCold(const Function& function, Instruction* call) const;
+
+ private:
+  class FunctionProfile;
+
+  explicit AotProfile(Zone* zone);
+
+  bool Parse(Thread* thread, char* contents);
+  const FunctionProfile* LookupFunction(const Function& function) const;
+
+  Zone* const zone_;
+  GrowableArray<FunctionProfile*> functions_;
+  // Maps function keys to indices into [functions_].
+  CStringIntMap function_indices_;
+  // Maps the functions looked up so far to indices into [functions_], or to
+  // -1 if they have no profile for their current source.
+  // Compiler threads access it with [function_cache_mutex_] held.
+  Array& function_cache_;
+  mutable Mutex function_cache_mutex_;
+
+  DISALLOW_COPY_AND_ASSIGN(AotProfile);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
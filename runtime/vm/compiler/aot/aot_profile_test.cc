@@ -0,0 +1,276 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/aot_profile.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER)
+
+// Six implementations, so that the call below is not devirtualized by CHA.
+static const char* kShapesScript = R"(
+    abstract class Shape { int area(); }
+    class Square implements Shape { int area() => 1; }
+    class Circle implements Shape { int area() => 2; }
+    class Triangle implements Shape { int area() => 3; }
+    class Pentagon implements Shape { int area() => 4; }
+    class Hexagon implements Shape { int area() => 5; }
+    class Octagon implements Shape { int area() => 6; }
+
+    int areaOf(Shape s) => s.area();
+
+    final shapes = <Shape>[
+      Square(), Circle(), Triangle(), Pentagon(), Hexagon(), Octagon(),
+    ];
+
+    main() {
+      for (var i = 0; i < 10; i++) {
+        areaOf(shapes[0]);
+        areaOf(shapes[1]);
+      }
+    }
+  )";
+
+// Runs main of [root_library] in JIT mode and reads back the profile the run
+// recorded.
+static const AotProfile* TrainProfile(const Library& root_library) {
+  Thread* thread = Thread::Current();
+  Invoke(root_library, "main");
+  TextBuffer buffer(KB);
+  AotProfile::WriteTo(thread, &buffer);
+  const AotProfile* profile = AotProfile::FromText(thread, buffer.buffer());
+  RELEASE_ASSERT(profile != nullptr);
+  return profile;
+}
+
+static intptr_t CountInstructions(FlowGraph* flow_graph,
+                                  bool (Instruction::*is_kind)() const) {
+  intptr_t count = 0;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (auto instr : block->instructions()) {
+      if ((instr->*is_kind)()) count++;
+    }
+  }
+  return count;
+}
+
+static FlowGraph* CompileAreaOf(const Function& function) {
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  return pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kApplyClassIds,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kTryOptimizePatterns,
+      CompilerPass::kSetOuterInliningId,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyClassIds,
+      CompilerPass::kInlining,
+  });
+}
+
+ISOLATE_UNIT_TEST_CASE(AotProfile_RoundTrip) {
+  const auto& root_library = Library::Handle(LoadTestScript(kShapesScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "areaOf"));
+  const AotProfile* profile = TrainProfile(root_library);
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({CompilerPass::kComputeSSA});
+  InstanceCallInstr* call = nullptr;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (auto instr : block->instructions()) {
+      if (instr->IsInstanceCall()) call = instr->AsInstanceCall();
+    }
+  }
+  RELEASE_ASSERT(call != nullptr);
+
+  const AotProfile::CallSite* site = profile->LookupCallSite(function, call);
+  RELEASE_ASSERT(site != nullptr);
+  EXPECT_EQ(20, site->count);
+  EXPECT_EQ(2, site->receivers.length());
+  EXPECT_EQ(10, site->receivers[0].count);
+  EXPECT_EQ(10, site->receivers[1].count);
+  EXPECT_EQ(20, profile->CallCount(function, call, /*estimate=*/1));
+  EXPECT(!profile->IsCold(function, call));
+
+  EXPECT(AotProfile::FromText(thread, "") == nullptr);
+  EXPECT(AotProfile::FromText(thread, "not-a-profile 1\n") == nullptr);
+}
+
+// The receivers seen by the training run are checked for and their targets
+// inlined, which they would not be without the profile.
+ISOLATE_UNIT_TEST_CASE(AotProfile_DevirtualizesAndInlinesProfiledCalls) {
+  const auto& root_library = Library::Handle(LoadTestScript(kShapesScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "areaOf"));
+  const AotProfile* profile = TrainProfile(root_library);
+
+  {
+    FlowGraph* flow_graph = CompileAreaOf(function);
+    EXPECT_EQ(1, CountInstructions(flow_graph, &Instruction::IsInstanceCall));
+    EXPECT_EQ(0, CountInstructions(flow_graph, &Instruction::IsLoadClassId));
+  }
+
+  AotProfile::SetCurrentForTesting(profile);
+  {
+    FlowGraph* flow_graph = CompileAreaOf(function);
+    EXPECT_EQ(0, CountInstructions(flow_graph, &Instruction::IsInstanceCall));
+    EXPECT(CountInstructions(flow_graph, &Instruction::IsLoadClassId) > 0);
+    // Other receivers are still handled by a call.
+    EXPECT_EQ(1, CountInstructions(
+                     flow_graph, &Instruction::IsPolymorphicInstanceCall));
+  }
+  AotProfile::SetCurrentForTesting(nullptr);
+}
+
+// Returns the position in the code generation order of the block calling
+// [name].
+static intptr_t BlockIndexOfCall(FlowGraph* flow_graph, const char* name) {
+  const auto& order = *flow_graph->CodegenBlockOrder();
+  for (intptr_t i = 0; i < order.length(); i++) {
+    for (auto instr : order[i]->instructions()) {
+      if (auto call = instr->AsStaticCall()) {
+        if (strcmp(String::Handle(call->function().name()).ToCString(),
+                   name) == 0) {
+          return i;
+        }
+      }
+    }
+  }
+  return -1;
+}
+
+static FlowGraph* CompileBranchy(const Function& function) {
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  return pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kApplyClassIds,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kReorderBlocks,
+  });
+}
+
+// Blocks with calls which never ran in the training run are moved out of
+// line.
+ISOLATE_UNIT_TEST_CASE(AotProfile_MovesColdBlocksToTheEnd) {
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    int rarely() => 1;
+
+    @pragma('vm:never-inline')
+    int often() => 2;
+
+    int branchy(int x) {
+      int r;
+      if (x < 0) {
+        r = rarely();
+      } else {
+        r = often();
+      }
+      return r + 1;
+    }
+
+    main() {
+      for (var i = 0; i < 10; i++) {
+        branchy(i);
+      }
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "branchy"));
+  const AotProfile* profile = TrainProfile(root_library);
+
+  {
+    FlowGraph* flow_graph = CompileBranchy(function);
+    const intptr_t rarely_index = BlockIndexOfCall(flow_graph, "rarely");
+    EXPECT(rarely_index >= 0);
+    EXPECT(rarely_index < flow_graph->CodegenBlockOrder()->length() - 1);
+  }
+
+  AotProfile::SetCurrentForTesting(profile);
+  {
+    FlowGraph* flow_graph = CompileBranchy(function);
+    const intptr_t rarely_index = BlockIndexOfCall(flow_graph, "rarely");
+    EXPECT_EQ(flow_graph->CodegenBlockOrder()->length() - 1, rarely_index);
+    EXPECT(BlockIndexOfCall(flow_graph, "often") < rarely_index);
+  }
+  AotProfile::SetCurrentForTesting(nullptr);
+}
+
+// Marks the profile of the function [name] in [text] as optimized.
+static void MarkOptimized(char* text, const char* name) {
+  char* line = text;
+  while (line != nullptr) {
+    char* end = strchr(line, '\n');
+    if ((strncmp(line, "F\t", 2) == 0) && (strstr(line, name) != nullptr) &&
+        ((end == nullptr) || (strstr(line, name) < end))) {
+      char* optimized = strchr(line + 2, '\t') + 1;
+      RELEASE_ASSERT(*optimized == '0');
+      *optimized = '1';
+      return;
+    }
+    line = (end != nullptr) ? end + 1 : nullptr;
+  }
+  UNREACHABLE();
+}
+
+// Calls which never ran are only cold if the function calling them was never
+// optimized, since optimized code does not count calls.
+ISOLATE_UNIT_TEST_CASE(AotProfile_OnlyUnoptimizedCallsAreCold) {
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    int rarely() => 1;
+
+    int sometimes(int x) => x < 0 ? rarely() : 0;
+
+    main() {
+      for (var i = 0; i < 10; i++) {
+        sometimes(i);
+      }
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "sometimes"));
+  Invoke(root_library, "main");
+  TextBuffer buffer(KB);
+  AotProfile::WriteTo(thread, &buffer);
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({CompilerPass::kComputeSSA});
+  StaticCallInstr* call = nullptr;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (auto instr : block->instructions()) {
+      if (instr->IsStaticCall()) call = instr->AsStaticCall();
+    }
+  }
+  RELEASE_ASSERT(call != nullptr);
+
+  const AotProfile* profile = AotProfile::FromText(thread, buffer.buffer());
+  RELEASE_ASSERT(profile != nullptr);
+  EXPECT(profile->IsCold(function, call));
+  // Looked up again from the cache.
+  EXPECT(profile->IsCold(function, call));
+
+  char* text = thread->zone()->MakeCopyOfString(buffer.buffer());
+  MarkOptimized(text, "\tsometimes\t");
+  profile = AotProfile::FromText(thread, text);
+  RELEASE_ASSERT(profile != nullptr);
+  EXPECT(!profile->IsCold(function, call));
+  EXPECT_EQ(0, profile->CallCount(function, call, /*estimate=*/1));
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
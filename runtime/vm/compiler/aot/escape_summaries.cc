@@ -0,0 +1,325 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/escape_summaries.h"
+
+#include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/precompiler.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/compiler/compiler_timings.h"
+#include "vm/compiler/frontend/kernel_to_il.h"
+#include "vm/compiler/jit/compiler.h"
+#include "vm/flags.h"
+#include "vm/lockers.h"
+#include "vm/longjump.h"
+#include "vm/object.h"
+#include "vm/parser.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            interprocedural_escape_analysis,
+            true,
+            "Let objects passed to static calls which only read them be "
+            "treated as not escaping in AOT mode.");
+DEFINE_FLAG(int,
+            escape_summary_source_size_threshold,
+            3000,
+            "Assume that functions with longer source let all their "
+            "parameters escape, without building their graph.");
+DEFINE_FLAG(int,
+            escape_summary_size_threshold,
+            300,
+            "Assume that functions with more IL instructions let all their "
+            "parameters escape.");
+DEFINE_FLAG(bool,
+            trace_escape_summaries,
+            false,
+            "Print escape summaries as they are computed.");
+
+#if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_IA32)
+
+// A set of parameters which a function only reads, by parameter index.
+typedef uint32_t Summary;
+
+// The summaries of a function for all depths are cached together in a Smi,
+// [kBitsPerDepth] bits per depth: a bit for each parameter followed by a bit
+// which tells whether the summary has been computed.
+static constexpr intptr_t kBitsPerDepth = EscapeSummaries::kMaxParameters + 1;
+static constexpr Summary kComputedBit = static_cast<Summary>(1)
+                                        << EscapeSummaries::kMaxParameters;
+COMPILE_ASSERT(kBitsPerDepth * EscapeSummaries::kMaxDepth <= kSmiBits);
+
+static Summary SummaryOf(Thread* thread,
+                         const Function& function,
+                         intptr_t depth);
+
+// Returns the index of the parameter of the target of [call] which receives
+// the argument [use], or -1 if [use] is not passed to one of the first
+// [kMaxParameters] positional parameters.
+static intptr_t ParameterIndexOf(StaticCallInstr* call, Value* use) {
+  const Array& argument_names = call->argument_names();
+  const intptr_t num_named =
+      argument_names.IsNull() ? 0 : argument_names.Length();
+  const intptr_t num_positional =
+      call->ArgumentCountWithoutTypeArgs() - num_named;
+  const intptr_t index = use->use_index() - call->FirstArgIndex();
+  if ((index < 0) || (index >= num_positional) ||
+      (index >= EscapeSummaries::kMaxParameters)) {
+    return -1;
+  }
+  return index;
+}
+
+static bool ArgumentIsOnlyRead(Thread* thread,
+                               StaticCallInstr* call,
+                               Value* use,
+                               intptr_t depth) {
+  const intptr_t index = ParameterIndexOf(call, use);
+  return (index >= 0) &&
+         ((SummaryOf(thread, call->function(), depth) & (1 << index)) != 0);
+}
+
+// Whether all uses of [defn] only read it. Static calls are looked into
+// with the summaries of their targets at [depth] - 1.
+static bool IsOnlyRead(Thread* thread, Definition* defn, intptr_t depth) {
+  for (Value* use = defn->input_use_list(); use != nullptr;
+       use = use->next_use()) {
+    Instruction* instr = use->instruction();
+    if (instr->IsDefinition() &&
+        (instr->Cast<Definition>()->RedefinedValue() == use)) {
+      // E.g. CheckNull, Redefinition or AssertAssignable.
+      if (!IsOnlyRead(thread, instr->Cast<Definition>(), depth)) {
+        return false;
+      }
+    } else if (auto* const load = instr->AsLoadField()) {
+      // Loads of late fields may run the initializer, which can store the
+      // object anywhere.
+      if (load->calls_initializer() || load->HasUnknownSideEffects() ||
+          load->MayCreateUntaggedAlias()) {
+        return false;
+      }
+    } else if (auto* const call = instr->AsStaticCall()) {
+      if (!ArgumentIsOnlyRead(thread, call, use, depth - 1)) {
+        return false;
+      }
+    } else if (auto* const branch = instr->AsBranch()) {
+      if (!branch->condition()->IsStrictCompare()) {
+        return false;
+      }
+    } else if (!instr->IsLoadIndexed() && !instr->IsLoadClassId() &&
+               !instr->IsStrictCompare() && !instr->IsCheckClass() &&
+               !instr->IsCheckClassId()) {
+      // Stores, returns, phis, instance calls etc.
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the parameters of the function which are only read when it is
+// entered through [entry].
+static Summary SummarizeParameters(Thread* thread,
+                                   FunctionEntryInstr* entry,
+                                   intptr_t depth) {
+  Summary summary = 0;
+  for (Definition* defn : *entry->initial_definitions()) {
+    ParameterInstr* param = defn->AsParameter();
+    if (param == nullptr) continue;
+    const intptr_t index = param->param_index();
+    if ((0 <= index) && (index < EscapeSummaries::kMaxParameters) &&
+        IsOnlyRead(thread, param, depth)) {
+      summary |= static_cast<Summary>(1) << index;
+    }
+  }
+  return summary;
+}
+
+// Whether the parameters of [function] are available as ParameterInstr-s in
+// its graph, and the graph is what runs when [function] is called. Functions
+// with long source are rejected before building their graph, which would
+// most likely be above --escape_summary_size_threshold anyway.
+static bool CanSummarize(const Function& function) {
+  return !function.is_native() && !function.is_external() &&
+         !function.is_intrinsic() && function.IsOptimizable() &&
+         !function.IsSuspendableFunction() &&
+         !function.IsIrregexpFunction() && !function.HasOptionalParameters() &&
+         (function.SourceSize() <= FLAG_escape_summary_source_size_threshold);
+}
+
+// Computes the summaries of [function] at depths 1 to [max_depth] into
+// [summaries], indexed by depth - 1, from a single graph.
+static void ComputeSummaries(Thread* thread,
+                             const Function& function,
+                             intptr_t max_depth,
+                             Summary* summaries) {
+  COMPILER_TIMINGS_TIMER_SCOPE(thread, ComputeEscapeSummaries);
+  Zone* const zone = thread->zone();
+  Precompiler* const precompiler = Precompiler::Instance();
+  if (precompiler != nullptr) {
+    precompiler->RecordEscapeSummaryGraph();
+  }
+
+  CompilerState compiler_state(thread, /*is_aot=*/true,
+                               /*is_optimizing=*/true);
+  compiler_state.set_function(function);
+
+  for (intptr_t depth = 1; depth <= max_depth; depth++) {
+    summaries[depth - 1] = 0;
+  }
+  Error& error = Error::Handle(zone);
+  {
+    LongJumpScope jump(thread);
+    if (DART_SETJMP(*jump.Set()) == 0) {
+      ParsedFunction* parsed_function = new (zone)
+          ParsedFunction(thread, Function::ZoneHandle(zone, function.ptr()));
+      ZoneGrowableArray<const ICData*>* ic_data_array =
+          new (zone) ZoneGrowableArray<const ICData*>();
+      kernel::FlowGraphBuilder builder(parsed_function, ic_data_array,
+                                       /* not building var desc */ nullptr,
+                                       /* not inlining */ nullptr,
+                                       /*optimizing=*/true,
+                                       Compiler::kNoOSRDeoptId);
+      FlowGraph* flow_graph = builder.BuildGraph();
+      // Parameters can also escape into catch blocks.
+      if (flow_graph->try_entries().is_empty()) {
+        flow_graph->PopulateWithICData(function);
+        flow_graph->ComputeSSA(nullptr);
+
+        AotCallSpecializer call_specializer(precompiler, flow_graph);
+        CompilerPassState pass_state(thread, flow_graph, precompiler);
+        pass_state.call_specializer = &call_specializer;
+        CompilerPass::RunInliningPipeline(CompilerPass::kAOT, &pass_state);
+
+        if (flow_graph->InstructionCount() <=
+            FLAG_escape_summary_size_threshold) {
+          GraphEntryInstr* graph_entry = flow_graph->graph_entry();
+          for (intptr_t depth = 1; depth <= max_depth; depth++) {
+            Summary summary = SummarizeParameters(
+                thread, graph_entry->normal_entry(), depth);
+            if (graph_entry->unchecked_entry() != nullptr) {
+              summary &= SummarizeParameters(
+                  thread, graph_entry->unchecked_entry(), depth);
+            }
+            summaries[depth - 1] = summary;
+          }
+        }
+      }
+    } else {
+      error = thread->StealStickyError();
+    }
+  }
+
+  if (!error.IsNull()) {
+    // Bailouts only mean that the parameters escape. Propagate compile-time
+    // errors like the inliner does.
+    if (!error.IsLanguageError() ||
+        (LanguageError::Cast(error).kind() != Report::kBailout)) {
+      thread->long_jump_base()->Jump(1, error);
+      UNREACHABLE();
+    }
+    for (intptr_t depth = 1; depth <= max_depth; depth++) {
+      summaries[depth - 1] = 0;
+    }
+  }
+}
+
+static bool LookupSummary(Thread* thread,
+                          Precompiler* precompiler,
+                          const Function& function,
+                          intptr_t depth,
+                          Summary* summary) {
+  SafepointMutexLocker ml(thread, precompiler->escape_summaries_mutex());
+  const Object& value = Object::Handle(
+      thread->zone(), precompiler->escape_summaries()->GetOrNull(function));
+  if (value.IsNull()) {
+    return false;
+  }
+  const Summary bits = static_cast<Summary>(Smi::Cast(value).Value()) >>
+                       ((depth - 1) * kBitsPerDepth);
+  if ((bits & kComputedBit) == 0) {
+    return false;
+  }
+  *summary = bits & (kComputedBit - 1);
+  return true;
+}
+
+static void InsertSummaries(Thread* thread,
+                            Precompiler* precompiler,
+                            const Function& function,
+                            intptr_t max_depth,
+                            const Summary* summaries) {
+  SafepointMutexLocker ml(thread, precompiler->escape_summaries_mutex());
+  FunctionMap* cache = precompiler->escape_summaries();
+  const Object& value =
+      Object::Handle(thread->zone(), cache->GetOrNull(function));
+  intptr_t bits = value.IsNull() ? 0 : Smi::Cast(value).Value();
+  for (intptr_t depth = 1; depth <= max_depth; depth++) {
+    bits |= static_cast<intptr_t>(summaries[depth - 1] | kComputedBit)
+            << ((depth - 1) * kBitsPerDepth);
+  }
+  cache->UpdateOrInsert(function, Smi::Handle(thread->zone(), Smi::New(bits)));
+}
+
+// Summaries at depth 0 let all parameters escape. Deeper summaries are
+// computed from summaries one level less deep, so they do not depend on the
+// order in which functions are compiled, even for recursive functions. The
+// summaries at all depths up to [depth] are computed from a single graph.
+// The callees of the function being compiled are asked for at [kMaxDepth],
+// so a graph is only built twice for a function which was first asked for at
+// a lower depth, as the callee of a callee.
+static Summary SummaryOf(Thread* thread,
+                         const Function& function,
+                         intptr_t depth) {
+  if ((depth <= 0) || !CanSummarize(function)) {
+    return 0;
+  }
+
+  // Without a precompiler, e.g. in unit tests, summaries are not cached.
+  Precompiler* const precompiler = Precompiler::Instance();
+  Summary summary = 0;
+  if ((precompiler != nullptr) &&
+      LookupSummary(thread, precompiler, function, depth, &summary)) {
+    return summary;
+  }
+
+  Summary summaries[EscapeSummaries::kMaxDepth];
+  {
+    StackZone stack_zone(thread);
+    HANDLESCOPE(thread);
+    ComputeSummaries(thread, function, depth, summaries);
+  }
+
+  if (FLAG_trace_escape_summaries) {
+    for (intptr_t d = 1; d <= depth; d++) {
+      THR_Print("Escape summary of %s at depth %" Pd ": %#x\n",
+                function.ToFullyQualifiedCString(), d,
+                static_cast<unsigned>(summaries[d - 1]));
+    }
+  }
+  if (precompiler != nullptr) {
+    InsertSummaries(thread, precompiler, function, depth, summaries);
+  }
+  return summaries[depth - 1];
+}
+
+#endif  // defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_IA32)
+
+bool EscapeSummaries::IsReadOnlyArgument(Value* use) {
+#if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_IA32)
+  StaticCallInstr* call = use->instruction()->AsStaticCall();
+  if (!FLAG_interprocedural_escape_analysis || (call == nullptr) ||
+      !CompilerState::Current().is_aot()) {
+    return false;
+  }
+  return ArgumentIsOnlyRead(Thread::Current(), call, use, kMaxDepth);
+#else
+  return false;
+#endif  // defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_IA32)
+}
+
+}  // namespace dart
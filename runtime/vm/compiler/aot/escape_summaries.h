@@ -0,0 +1,46 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_AOT_ESCAPE_SUMMARIES_H_
+#define RUNTIME_VM_COMPILER_AOT_ESCAPE_SUMMARIES_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+// Forward declarations.
+class Value;
+
+// Summarizes which parameters of a function the function only reads: it
+// does not store them anywhere, return them, write their fields or pass them
+// to calls which might. An object passed to such a parameter does not escape
+// through the call, so redundancy elimination can keep forwarding its fields
+// across the call and allocation sinking can replace it with its fields
+// everywhere except for the call itself.
+//
+// A summary is computed from the graph of the function after AOT call
+// specialization, without inlining. Static calls in the graph use the
+// summaries of their targets in turn, down to a depth of [kMaxDepth]; other
+// calls let their arguments escape. Summaries are only computed in AOT mode
+// and are cached per function by the precompiler.
+class EscapeSummaries : public AllStatic {
+ public:
+  // Parameters after the first [kMaxParameters] are assumed to escape.
+  static constexpr intptr_t kMaxParameters = 14;
+
+  // How many levels of static calls are followed.
+  static constexpr intptr_t kMaxDepth = 2;
+
+  // Whether [use] is a positional argument of a static call whose target
+  // only reads the corresponding parameter.
+  static bool IsReadOnlyArgument(Value* use);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_AOT_ESCAPE_SUMMARIES_H_
@@ -13,6 +13,7 @@
 #include "vm/closure_functions_cache.h"
 #include "vm/code_patcher.h"
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler_tracer.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
@@ -34,12 +35,14 @@
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/compiler/frontend/kernel_to_il.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/dart.h"
 #include "vm/dart_entry.h"
 #include "vm/exceptions.h"
 #include "vm/ffi/native_assets.h"
 #include "vm/flags.h"
 #include "vm/hash_table.h"
 #include "vm/isolate.h"
+#include "vm/lockers.h"
 #include "vm/log.h"
 #include "vm/longjump.h"
 #include "vm/object.h"
@@ -54,6 +57,7 @@
 #include "vm/stack_trace.h"
 #include "vm/symbols.h"
 #include "vm/tags.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/timer.h"
 #include "vm/type_testing_stubs.h"
@@ -76,6 +80,17 @@ DEFINE_FLAG(charp,
             nullptr,
             "Print layout of Dart objects to the given file");
 DEFINE_FLAG(bool, trace_precompiler, false, "Trace precompiler.");
+DEFINE_FLAG(int,
+            precompiler_threads,
+            1,
+            "Number of threads compiling functions in parallel, or 0 for one "
+            "per core. The output of parallel compilation is not "
+            "deterministic.");
+DEFINE_FLAG(charp,
+            use_aot_profile,
+            nullptr,
+            "Guide compilation by the execution counts in the given file, "
+            "written by a training run with --write_aot_profile_to");
 DEFINE_FLAG(charp,
             write_retained_reasons_to,
             nullptr,
@@ -381,6 +396,27 @@ void Precompiler::ReportStats() {
   }
 
   thread()->compiler_timings()->Print();
+  OS::PrintErr("Escape summaries: %" Pd " graphs built\n",
+               escape_summary_graph_count_.load());
+
+  if (worker_stats_ != nullptr) {
+    Zone* zone = thread()->zone();
+    const int64_t elapsed = parallel_compilation_timer_.TotalElapsedTime();
+    OS::PrintErr("Parallel compilation on %" Pd " threads took: %s\n",
+                 worker_count_,
+                 parallel_compilation_timer_.FormatElapsedHumanReadable(zone));
+    OS::PrintErr("  (the breakdown above only covers thread 0)\n");
+    for (intptr_t i = 0; i < worker_count_; i++) {
+      const Timer& busy = worker_stats_[i].busy;
+      const double utilization =
+          elapsed > 0
+              ? static_cast<double>(busy.TotalElapsedTime()) * 100 / elapsed
+              : 0.0;
+      OS::PrintErr("  Thread %" Pd ": [%6.2f%%] %" Pd " functions %s\n", i,
+                   utilization, worker_stats_[i].function_count,
+                   busy.FormatElapsedHumanReadable(zone));
+    }
+  }
 }
 
 Precompiler::Precompiler(Thread* thread)
@@ -423,13 +459,20 @@ Precompiler::Precompiler(Thread* thread)
       consts_to_retain_(),
       seen_table_selectors_(),
       api_uses_(),
+      escape_summaries_(HashTables::New<FunctionMap>(/*initial_capacity=*/256)),
       error_(Error::Handle()),
-      get_runtime_type_is_unique_(false) {
+      get_runtime_type_is_unique_(false),
+      worker_count_(FLAG_precompiler_threads > 0
+                        ? FLAG_precompiler_threads
+                        : OS::NumberOfAvailableProcessors()) {
   ASSERT(Precompiler::singleton_ == nullptr);
   Precompiler::singleton_ = this;
 
   if (FLAG_print_precompiler_timings) {
     thread->set_compiler_timings(new CompilerTimings());
+    if (worker_count_ > 1) {
+      worker_stats_.reset(new WorkerStats[worker_count_]);
+    }
   }
 }
 
@@ -440,6 +483,7 @@ Precompiler::~Precompiler() {
   seen_functions_.Release();
   possibly_retained_functions_.Release();
   functions_to_retain_.Release();
+  escape_summaries_.Release();
 
   ASSERT(Precompiler::singleton_ == this);
   Precompiler::singleton_ = nullptr;
@@ -477,6 +521,12 @@ void Precompiler::DoCompileAll() {
         IG->class_table()->PrintObjectLayout(FLAG_print_object_layout_to);
       }
 
+      // Reading the profile resolves the classes it refers to, so it has to
+      // happen after finalization.
+      if (FLAG_use_aot_profile != nullptr) {
+        profile_ = AotProfile::Read(T, FLAG_use_aot_profile);
+      }
+
       ClassFinalizer::SortClasses();
 
       // Collects type usage information which allows us to decide when/how to
@@ -658,6 +708,7 @@ void Precompiler::DoCompileAll() {
       retained_reasons_writer_ = nullptr;
     }
 
+    profile_ = nullptr;
     zone_ = nullptr;
   }
 
@@ -765,14 +816,29 @@ void Precompiler::Iterate() {
   PRECOMPILER_TIMER_SCOPE(this, Iterate);
 
   Function& function = Function::Handle(Z);
+  GrowableObjectArray& functions = GrowableObjectArray::Handle(Z);
+  // The tracer records the callees of each function, so it needs the
+  // functions to be compiled one at a time.
+  const bool parallel = (worker_count_ > 1) && (tracer_ == nullptr);
 
   phase_ = Phase::kFixpointCodeGeneration;
   while (changed_) {
     changed_ = false;
 
     while (pending_functions_.Length() > 0) {
-      function ^= pending_functions_.RemoveLast();
-      ProcessFunction(function);
+      if (parallel) {
+        // Compile all pending functions at once. Their callees become the
+        // next batch.
+        functions = GrowableObjectArray::New(pending_functions_.Length());
+        while (pending_functions_.Length() > 0) {
+          function ^= pending_functions_.RemoveLast();
+          functions.Add(function);
+        }
+        ProcessFunctionsInParallel(functions);
+      } else {
+        function ^= pending_functions_.RemoveLast();
+        ProcessFunction(function);
+      }
     }
 
     CheckForNewDynamicFunctions();
@@ -875,10 +941,193 @@ void Precompiler::ProcessFunction(const Function& function) {
 
   // Used in the JIT to save type-feedback across compilations.
   function.ClearICDataArray();
-  AddCalleesOf(function, gop_offset);
+  AddCalleesOf(function);
+  if (!is_tracing()) {
+    AddCalleesOfGlobalObjectPool(gop_offset);
+  }
+}
+
+// Compiles a batch of functions on up to [Precompiler::worker_count_]
+// threads, one of which is the mutator. Building and optimizing flow graphs
+// happens concurrently, like in the background compiler of the JIT. Code
+// generation, which adds to the global object pool and the worklists of the
+// precompiler, generates stubs and installs code, is serialized by
+// [Precompiler::code_generation_mutex].
+class Precompiler::ParallelCompilation : public ValueObject {
+ public:
+  ParallelCompilation(Precompiler* precompiler,
+                      const GrowableObjectArray& functions)
+      : precompiler_(precompiler),
+        functions_(functions),
+        error_(Error::Handle(precompiler->zone())) {}
+
+  // Returns the first error encountered, or null.
+  ErrorPtr Run();
+
+ private:
+  class Task : public ThreadPool::Task {
+   public:
+    Task(ParallelCompilation* compilation, intptr_t worker_id)
+        : compilation_(compilation), worker_id_(worker_id) {}
+
+    virtual void Run() { compilation_->RunHelper(worker_id_); }
+
+   private:
+    ParallelCompilation* const compilation_;
+    const intptr_t worker_id_;
+
+    DISALLOW_COPY_AND_ASSIGN(Task);
+  };
+
+  void RunHelper(intptr_t worker_id);
+  void CompileFunctions(Thread* thread, intptr_t worker_id);
+  bool NextFunction(Function* function);
+  void SetError(const Error& error);
+
+  Precompiler* const precompiler_;
+  const GrowableObjectArray& functions_;
+  Error& error_;
+
+  // Protects the fields below and [error_].
+  Monitor monitor_;
+  intptr_t next_ = 0;
+  intptr_t running_helpers_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelCompilation);
+};
+
+ErrorPtr Precompiler::ParallelCompilation::Run() {
+  Thread* thread = precompiler_->thread();
+  const intptr_t worker_count =
+      Utils::Minimum(precompiler_->worker_count_, functions_.Length());
+  for (intptr_t i = 1; i < worker_count; i++) {
+    SafepointMonitorLocker ml(&monitor_);
+    running_helpers_++;
+    if (!Dart::thread_pool()->Run<Task>(this, i)) {
+      running_helpers_--;
+      break;
+    }
+  }
+
+  {
+    // The mutator's own zone is used by code generation on other threads,
+    // e.g. for the global object pool and [TypeUsageInfo].
+    StackZone stack_zone(thread);
+    CompileFunctions(thread, /*worker_id=*/0);
+  }
+
+  SafepointMonitorLocker ml(&monitor_);
+  while (running_helpers_ > 0) {
+    ml.Wait();
+  }
+  return error_.ptr();
+}
+
+void Precompiler::ParallelCompilation::RunHelper(intptr_t worker_id) {
+  Thread* mutator = precompiler_->thread();
+  Thread::EnterIsolateGroupAsHelper(mutator->isolate_group(),
+                                    Thread::kCompilerTask,
+                                    /*bypass_safepoint=*/false);
+  {
+    Thread* thread = Thread::Current();
+    StackZone stack_zone(thread);
+    HANDLESCOPE(thread);
+    CompilerState state(thread, /*is_aot=*/true, /*is_optimizing=*/true);
+    HierarchyInfo hierarchy_info(thread);
+    // Only used by code generation, under [code_generation_mutex].
+    thread->set_type_usage_info(mutator->type_usage_info());
+    // The compiler timings of the mutator are not thread-safe, so helpers
+    // have none: --print_precompiler_timings only breaks down the time of the
+    // functions compiled by the mutator, and reports the busy time of each
+    // helper separately.
+    CompileFunctions(thread, worker_id);
+    thread->set_type_usage_info(nullptr);
+  }
+  Thread::ExitIsolateGroupAsHelper(/*bypass_safepoint=*/false);
+
+  // Notify the mutator only after leaving the isolate group, which may not
+  // shut down while helpers are still in it.
+  MonitorLocker ml(&monitor_);
+  running_helpers_--;
+  ml.NotifyAll();
+}
+
+void Precompiler::ParallelCompilation::CompileFunctions(Thread* thread,
+                                                        intptr_t worker_id) {
+  WorkerStats* stats = (precompiler_->worker_stats_ != nullptr)
+                           ? &precompiler_->worker_stats_[worker_id]
+                           : nullptr;
+  Function& function = Function::Handle(thread->zone());
+  while (NextFunction(&function)) {
+    HANDLESCOPE(thread);
+    if (stats != nullptr) {
+      stats->busy.Start();
+    }
+    LongJumpScope jump(thread);
+    if (DART_SETJMP(*jump.Set()) == 0) {
+      Precompiler::CompileFunction(precompiler_, thread, function);
+    } else {
+      SetError(Error::Handle(thread->StealStickyError()));
+    }
+    if (stats != nullptr) {
+      stats->busy.Stop();
+      stats->function_count++;
+    }
+  }
+}
+
+bool Precompiler::ParallelCompilation::NextFunction(Function* function) {
+  SafepointMonitorLocker ml(&monitor_);
+  if (!error_.IsNull() || (next_ == functions_.Length())) {
+    return false;
+  }
+  *function ^= functions_.At(next_++);
+  return true;
+}
+
+void Precompiler::ParallelCompilation::SetError(const Error& error) {
+  SafepointMonitorLocker ml(&monitor_);
+  if (error_.IsNull()) {
+    error_ = error.ptr();
+  }
 }
 
-void Precompiler::AddCalleesOf(const Function& function, intptr_t gop_offset) {
+void Precompiler::ProcessFunctionsInParallel(
+    const GrowableObjectArray& functions) {
+  HANDLESCOPE(T);
+  const intptr_t gop_offset = global_object_pool_builder()->CurrentLength();
+  Function& function = Function::Handle(Z);
+  for (intptr_t i = 0; i < functions.Length(); i++) {
+    function ^= functions.At(i);
+    RELEASE_ASSERT(!function.HasCode());
+    ASSERT(!function.is_abstract());
+    function_count_++;
+    if (FLAG_trace_precompiler) {
+      THR_Print("Precompiling %" Pd " %s (%s, %s)\n", function_count_,
+                function.ToLibNamePrefixedQualifiedCString(),
+                function.token_pos().ToCString(),
+                Function::KindToCString(function.kind()));
+    }
+  }
+
+  parallel_compilation_timer_.Start();
+  ParallelCompilation compilation(this, functions);
+  const Error& error = Error::Handle(Z, compilation.Run());
+  parallel_compilation_timer_.Stop();
+  if (!error.IsNull()) {
+    Jump(error);
+  }
+
+  for (intptr_t i = 0; i < functions.Length(); i++) {
+    function ^= functions.At(i);
+    function.ClearICDataArray();
+    AddCalleesOf(function);
+  }
+  // The pool entries of the batch are interleaved, so scan them once.
+  AddCalleesOfGlobalObjectPool(gop_offset);
+}
+
+void Precompiler::AddCalleesOf(const Function& function) {
   PRECOMPILER_TIMER_SCOPE(this, AddCalleesOf);
   ASSERT(function.HasCode());
 
@@ -943,18 +1192,9 @@ void Precompiler::AddCalleesOf(const Function& function, intptr_t gop_offset) {
   // When tracing we want to scan the object pool attached to the code object
   // rather than scanning global object pool - because we want to include
   // *all* outgoing references into the trace. Scanning GOP would exclude
-  // references that have been deduplicated.
-  if (!is_tracing()) {
-    for (intptr_t i = gop_offset;
-         i < global_object_pool_builder()->CurrentLength(); i++) {
-      const auto& wrapper_entry = global_object_pool_builder()->EntryAt(i);
-      if (wrapper_entry.type() ==
-          compiler::ObjectPoolBuilderEntry::kTaggedObject) {
-        const auto& entry = *wrapper_entry.obj_;
-        AddCalleesOfHelper(entry, &selector, &cls);
-      }
-    }
-  } else {
+  // references that have been deduplicated. Otherwise the caller scans the
+  // entries the code added to the global object pool.
+  if (is_tracing()) {
     const auto& pool = ObjectPool::Handle(Z, code.object_pool());
     auto& entry = Object::Handle(Z);
     for (intptr_t i = 0; i < pool.Length(); i++) {
@@ -976,6 +1216,21 @@ void Precompiler::AddCalleesOf(const Function& function, intptr_t gop_offset) {
   }
 }
 
+void Precompiler::AddCalleesOfGlobalObjectPool(intptr_t gop_offset) {
+  PRECOMPILER_TIMER_SCOPE(this, AddCalleesOf);
+  String& selector = String::Handle(Z);
+  Class& cls = Class::Handle(Z);
+  for (intptr_t i = gop_offset;
+       i < global_object_pool_builder()->CurrentLength(); i++) {
+    const auto& wrapper_entry = global_object_pool_builder()->EntryAt(i);
+    if (wrapper_entry.type() ==
+        compiler::ObjectPoolBuilderEntry::kTaggedObject) {
+      const auto& entry = *wrapper_entry.obj_;
+      AddCalleesOfHelper(entry, &selector, &cls);
+    }
+  }
+}
+
 static bool IsPotentialClosureCall(const String& selector) {
   return selector.ptr() == Symbols::call().ptr() ||
          selector.ptr() == Symbols::DynamicCall().ptr();
@@ -3455,7 +3710,8 @@ void PrecompileParsedFunctionHelper::FinalizeCompilation(
   graph_compiler->FinalizeCodeSourceMap(code);
 
   // Installs code while at safepoint.
-  ASSERT(thread()->IsDartMutatorThread());
+  ASSERT(thread()->IsDartMutatorThread() ||
+         precompiler_->code_generation_mutex()->IsOwnedByCurrentThread());
   function.InstallOptimizedCode(code);
 
   if (function.IsFfiCallbackTrampoline()) {
@@ -3522,7 +3778,8 @@ bool PrecompileParsedFunctionHelper::GenerateCode(FlowGraph* flow_graph) {
       {
         COMPILER_TIMINGS_TIMER_SCOPE(thread(), FinalizeCode);
         TIMELINE_DURATION(thread(), CompilerVerbose, "FinalizeCompilation");
-        ASSERT(thread()->IsDartMutatorThread());
+        ASSERT(thread()->IsDartMutatorThread() ||
+               precompiler_->code_generation_mutex()->IsOwnedByCurrentThread());
         FinalizeCompilation(&assembler, &graph_compiler, flow_graph,
                             function_stats);
       }
@@ -3648,6 +3905,10 @@ bool PrecompileParsedFunctionHelper::Compile() {
   //
   // Reducing interleaving means reducing recompilations triggered by
   // failure to commit object pool into the global object pool.
+  //
+  // Code generation is serialized when functions are compiled in parallel,
+  // as all code shares the global object pool.
+  SafepointMutexLocker ml(thread(), precompiler_->code_generation_mutex());
   GenerateNecessaryAllocationStubs(flow_graph);
 
   return GenerateCode(flow_graph);
@@ -3656,7 +3917,7 @@ bool PrecompileParsedFunctionHelper::Compile() {
 void Precompiler::CompileFunction(Precompiler* precompiler,
                                   Thread* thread,
                                   const Function& function) {
-  PRECOMPILER_TIMER_SCOPE(precompiler, CompileFunction);
+  COMPILER_TIMINGS_TIMER_SCOPE(thread, CompileFunction);
   NoActiveIsolateScope no_isolate_scope;
 
   VMTagScope tagScope(thread, VMTag::kCompileUnoptimizedTagId);
@@ -9,6 +9,9 @@
 #error "AOT runtime should not use compiler sources (including header files)"
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 
+#include <memory>
+
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 #include "vm/compiler/aot/dispatch_table_generator.h"
 #include "vm/compiler/assembler/assembler.h"
@@ -21,6 +24,7 @@
 namespace dart {
 
 // Forward declarations.
+class AotProfile;
 class Class;
 class Error;
 class Field;
@@ -81,6 +85,7 @@ struct FunctionKeyTraits {
 };
 
 typedef UnorderedHashSet<FunctionKeyTraits> FunctionSet;
+typedef UnorderedHashMap<FunctionKeyTraits> FunctionMap;
 
 class ClassKeyValueTrait {
  public:
@@ -262,6 +267,22 @@ class Precompiler : public ValueObject {
 
   static Precompiler* Instance() { return singleton_; }
 
+  // The profile given by --use_aot_profile, if any.
+  const AotProfile* profile() const { return profile_; }
+
+  // Held while generating code, which adds to the global object pool and
+  // the precompiler's worklists, when functions are compiled in parallel.
+  Mutex* code_generation_mutex() { return &code_generation_mutex_; }
+
+  // The escape summaries computed so far (see EscapeSummaries), which
+  // compiler threads access with [escape_summaries_mutex] held.
+  FunctionMap* escape_summaries() { return &escape_summaries_; }
+  Mutex* escape_summaries_mutex() { return &escape_summaries_mutex_; }
+
+  // Counts the graphs built to compute escape summaries, which
+  // --print_precompiler_timings reports.
+  void RecordEscapeSummaryGraph() { escape_summary_graph_count_++; }
+
   void AddField(const Field& field);
   void AddTableSelector(const compiler::TableSelector* selector);
 
@@ -282,6 +303,8 @@ class Precompiler : public ValueObject {
  private:
   static Precompiler* singleton_;
 
+  class ParallelCompilation;
+
   // Scope which activates machine readable precompiler tracing if tracer
   // is available.
   class TracingScope : public ValueObject {
@@ -314,7 +337,8 @@ class Precompiler : public ValueObject {
   void AddTypesOf(const Function& function);
   void AddTypeParameters(const TypeParameters& params);
   void AddTypeArguments(const TypeArguments& args);
-  void AddCalleesOf(const Function& function, intptr_t gop_offset);
+  void AddCalleesOf(const Function& function);
+  void AddCalleesOfGlobalObjectPool(intptr_t gop_offset);
   void AddCalleesOfHelper(const Object& entry,
                           String* temp_selector,
                           Class* temp_cls);
@@ -332,6 +356,7 @@ class Precompiler : public ValueObject {
   bool HasApiUse(const Object& obj);
 
   void ProcessFunction(const Function& function);
+  void ProcessFunctionsInParallel(const GrowableObjectArray& functions);
   void CheckForNewDynamicFunctions();
   void CollectCallbackFields();
 
@@ -403,6 +428,7 @@ class Precompiler : public ValueObject {
   InstanceSet consts_to_retain_;
   TableSelectorSet seen_table_selectors_;
   ProgramElementSet api_uses_;
+  FunctionMap escape_summaries_;
   Error& error_;
 
   compiler::DispatchTableGenerator* dispatch_table_generator_;
@@ -412,7 +438,22 @@ class Precompiler : public ValueObject {
   Phase phase_ = Phase::kPreparation;
   PrecompilerTracer* tracer_ = nullptr;
   RetainedReasonsWriter* retained_reasons_writer_ = nullptr;
+  AotProfile* profile_ = nullptr;
   bool is_tracing_ = false;
+
+  Mutex code_generation_mutex_;
+  Mutex escape_summaries_mutex_;
+  RelaxedAtomic<intptr_t> escape_summary_graph_count_ = 0;
+
+  // Threads compiling functions in parallel (--precompiler_threads) and
+  // their utilization, which --print_precompiler_timings reports.
+  struct WorkerStats {
+    Timer busy;
+    intptr_t function_count = 0;
+  };
+  const intptr_t worker_count_;
+  std::unique_ptr<WorkerStats[]> worker_stats_;
+  Timer parallel_compilation_timer_;
 };
 
 class FunctionsTraits {
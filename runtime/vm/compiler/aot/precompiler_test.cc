@@ -0,0 +1,79 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/precompiler.h"
+
+#include "vm/dart_api_impl.h"
+#include "vm/flags.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_IA32)
+
+DECLARE_FLAG(int, precompiler_threads);
+
+// The tests/vm precompiler_threads_test runs gen_snapshot on whole programs,
+// which is too slow in debug mode. This precompiles a small program in
+// process, so that debug builds check the assertions on the paths shared by
+// the compiler threads.
+TEST_CASE(Precompiler_CompilesOnSeveralThreads) {
+  // The callees of main are only found once main is compiled, so they are
+  // compiled in later batches.
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    int leaf(int i) => i + 1;
+
+    @pragma('vm:never-inline')
+    int left(int i) => leaf(i) * 2;
+
+    @pragma('vm:never-inline')
+    int right(int i) => leaf(i) * 3;
+
+    @pragma('vm:never-inline')
+    int both(int i) => left(i) + right(i);
+
+    int unused(int i) => i;
+
+    main() {
+      var sum = 0;
+      for (var i = 0; i < 10; i++) {
+        sum += both(i) + left(i);
+      }
+      print(sum);
+    }
+  )";
+
+  Dart_Handle lib = TestCase::LoadTestScript(kScript, nullptr);
+  EXPECT_VALID(lib);
+
+  {
+    SetFlagScope<bool> sfs_mode(&FLAG_precompiled_mode, true);
+    SetFlagScope<int> sfs_threads(&FLAG_precompiler_threads, 2);
+    EXPECT_VALID(Dart_Precompile());
+  }
+
+  TransitionNativeToVM transition(thread);
+  const auto& root_library =
+      Library::CheckedHandle(thread->zone(), Api::UnwrapHandle(lib));
+  const char* kCompiled[] = {"main", "both", "left", "right", "leaf"};
+  auto& function = Function::Handle(thread->zone());
+  for (size_t i = 0; i < ARRAY_SIZE(kCompiled); i++) {
+    function = root_library.LookupFunctionAllowPrivate(
+        String::Handle(String::New(kCompiled[i])));
+    EXPECT(!function.IsNull());
+    if (!function.IsNull()) {
+      EXPECT(function.HasCode());
+    }
+  }
+  // Functions which are never called are not compiled.
+  function = root_library.LookupFunctionAllowPrivate(
+      String::Handle(String::New("unused")));
+  EXPECT(function.IsNull() || !function.HasCode());
+}
+
+#endif  // defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_IA32)
+
+}  // namespace dart
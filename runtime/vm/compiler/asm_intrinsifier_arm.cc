@@ -1500,7 +1500,7 @@ static void TryAllocateString(Assembler* assembler,
   __ CompareImmediate(length_reg, target::ToRawSmi(max_elements));
   __ b(failure, HI);
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, failure, R0));
+  __ MaybeTraceAllocation(cid, failure, R0);
   __ mov(R8, Operand(length_reg));  // Save the length register.
   if (cid == kOneByteStringCid) {
     __ SmiUntag(length_reg);
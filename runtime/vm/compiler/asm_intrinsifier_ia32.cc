@@ -1539,7 +1539,7 @@ static void TryAllocateString(Assembler* assembler,
   __ cmpl(length_reg, Immediate(target::ToRawSmi(max_elements)));
   __ j(ABOVE, failure);
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, failure, EAX));
+  __ MaybeTraceAllocation(cid, failure, EAX);
   if (length_reg != EDI) {
     __ movl(EDI, length_reg);
   }
@@ -3550,7 +3550,6 @@ void Assembler::FinalizeHashForSize(intptr_t bit_size,
   LoadImmediate(hash, 1, ZERO);
 }
 
-#ifndef PRODUCT
 void Assembler::MaybeTraceAllocation(Register stats_addr_reg, Label* trace) {
   ASSERT(stats_addr_reg != kNoRegister);
   ASSERT(stats_addr_reg != TMP);
@@ -3601,7 +3600,6 @@ void Assembler::LoadAllocationTracingStateAddress(Register dest, intptr_t cid) {
   AddImmediate(dest,
                target::ClassTable::AllocationTracingStateSlotOffsetFor(cid));
 }
-#endif  // !PRODUCT
 
 void Assembler::TryAllocateObject(intptr_t cid,
                                   intptr_t instance_size,
@@ -3633,8 +3631,8 @@ void Assembler::TryAllocateObject(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(LoadAllocationTracingStateAddress(temp_reg, cid));
-    NOT_IN_PRODUCT(MaybeTraceAllocation(temp_reg, failure));
+    LoadAllocationTracingStateAddress(temp_reg, cid);
+    MaybeTraceAllocation(temp_reg, failure);
 
     // Successfully allocated the object, now update top to point to
     // next object start and store the class in the class field of object.
@@ -3659,7 +3657,7 @@ void Assembler::TryAllocateArray(intptr_t cid,
                                  Register temp2) {
   if (FLAG_inline_alloc &&
       target::Heap::IsAllocatableInNewSpace(instance_size)) {
-    NOT_IN_PRODUCT(LoadAllocationTracingStateAddress(temp1, cid));
+    LoadAllocationTracingStateAddress(temp1, cid);
     // Potential new object start.
     ldr(instance, Address(THR, target::Thread::top_offset()));
     AddImmediateSetFlags(end_address, instance, instance_size);
@@ -3676,7 +3674,7 @@ void Assembler::TryAllocateArray(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(temp1, failure));
+    MaybeTraceAllocation(temp1, failure);
 
     // Successfully allocated the object(s), now update top to point to
     // next object start and initialize the object.
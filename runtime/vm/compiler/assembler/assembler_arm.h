@@ -1583,12 +1583,12 @@ class Assembler : public AssemblerBase {
   void LoadWordUnaligned(Register dst, Register addr, Register tmp);
   void StoreWordUnaligned(Register src, Register addr, Register tmp);
 
-  // If allocation tracing is enabled, will jump to |trace| label,
-  // which will allocate in the runtime where tracing occurs.
+  // If allocation tracing or pretenuring is enabled, will jump to |trace|
+  // label, which will allocate in the runtime where tracing occurs.
   void MaybeTraceAllocation(Register stats_addr_reg, Label* trace);
 
-  // If allocation tracing for |cid| is enabled, will jump to |trace| label,
-  // which will allocate in the runtime where tracing occurs.
+  // If allocation tracing or pretenuring for |cid| is enabled, will jump to
+  // |trace| label, which will allocate in the runtime where tracing occurs.
   void MaybeTraceAllocation(intptr_t cid,
                             Label* trace,
                             Register temp_reg,
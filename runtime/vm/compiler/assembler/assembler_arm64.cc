@@ -1927,7 +1927,6 @@ void Assembler::FinalizeHashForSize(intptr_t bit_size,
   cinc(hash, hash, ZERO);
 }
 
-#ifndef PRODUCT
 void Assembler::MaybeTraceAllocation(intptr_t cid,
                                      Label* trace,
                                      Register temp_reg,
@@ -1961,7 +1960,6 @@ void Assembler::MaybeTraceAllocation(Register cid,
                  kUnsignedByte);
   cbnz(trace, temp_reg);
 }
-#endif  // !PRODUCT
 
 void Assembler::TryAllocateObject(intptr_t cid,
                                   intptr_t instance_size,
@@ -1980,7 +1978,7 @@ void Assembler::TryAllocateObject(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp_reg));
+    MaybeTraceAllocation(cid, failure, temp_reg);
     RELEASE_ASSERT((target::Thread::top_offset() + target::kWordSize) ==
                    target::Thread::end_offset());
     ldp(instance_reg, temp_reg,
@@ -2022,7 +2020,7 @@ void Assembler::TryAllocateArray(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp1));
+    MaybeTraceAllocation(cid, failure, temp1);
     // Potential new object start.
     ldr(instance, Address(THR, target::Thread::top_offset()));
     AddImmediateSetFlags(end_address, instance, instance_size);
@@ -4971,7 +4971,6 @@ void Assembler::FinalizeHashForSize(intptr_t bit_size,
   add(hash, hash, scratch);
 }
 
-#ifndef PRODUCT
 void Assembler::MaybeTraceAllocation(Register cid,
                                      Label* trace,
                                      Register temp_reg,
@@ -5003,7 +5002,6 @@ void Assembler::MaybeTraceAllocation(intptr_t cid,
                  kUnsignedByte);
   bnez(temp_reg, trace);
 }
-#endif  // !PRODUCT
 
 void Assembler::TryAllocateObject(intptr_t cid,
                                   intptr_t instance_size,
@@ -5022,7 +5020,7 @@ void Assembler::TryAllocateObject(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp_reg));
+    MaybeTraceAllocation(cid, failure, temp_reg);
 
     lx(instance_reg, Address(THR, target::Thread::top_offset()));
     lx(temp_reg, Address(THR, target::Thread::end_offset()));
@@ -5062,7 +5060,7 @@ void Assembler::TryAllocateArray(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp1));
+    MaybeTraceAllocation(cid, failure, temp1);
     // Potential new object start.
     lx(instance, Address(THR, target::Thread::top_offset()));
     AddImmediate(end_address, instance, instance_size);
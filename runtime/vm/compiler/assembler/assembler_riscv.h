@@ -1499,8 +1499,8 @@ class Assembler : public MicroAssembler {
                            Register dst,
                            Register scratch = TMP) override;
 
-  // If allocation tracing for |cid| is enabled, will jump to |trace| label,
-  // which will allocate in the runtime where tracing occurs.
+  // If allocation tracing or pretenuring for |cid| is enabled, will jump to
+  // |trace| label, which will allocate in the runtime where tracing occurs.
   void MaybeTraceAllocation(intptr_t cid,
                             Label* trace,
                             Register temp_reg,
@@ -2379,7 +2379,6 @@ void Assembler::FinalizeHashForSize(intptr_t bit_size,
   Bind(&done);
 }
 
-#ifndef PRODUCT
 void Assembler::MaybeTraceAllocation(Register cid,
                                      Label* trace,
                                      Register temp_reg,
@@ -2423,7 +2422,6 @@ void Assembler::MaybeTraceAllocation(intptr_t cid,
   // the allocation stub.
   j(NOT_ZERO, trace, distance);
 }
-#endif  // !PRODUCT
 
 void Assembler::TryAllocateObject(intptr_t cid,
                                   intptr_t instance_size,
@@ -2440,7 +2438,7 @@ void Assembler::TryAllocateObject(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp_reg, distance));
+    MaybeTraceAllocation(cid, failure, temp_reg, distance);
     movq(instance_reg, Address(THR, target::Thread::top_offset()));
     addq(instance_reg, Immediate(instance_size));
     // instance_reg: potential next object start.
@@ -2472,7 +2470,7 @@ void Assembler::TryAllocateArray(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp, distance));
+    MaybeTraceAllocation(cid, failure, temp, distance);
     movq(instance, Address(THR, target::Thread::top_offset()));
     movq(end_address, instance);
 
@@ -6,6 +6,7 @@
 
 #include "vm/allocation.h"
 #include "vm/code_patcher.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/jit/compiler.h"
 
@@ -243,7 +244,8 @@ void BlockScheduler::ReorderBlocksJIT(FlowGraph* flow_graph) {
 // AOT block order is based on reverse post order but with two changes:
 //
 // - Blocks which always throw and their direct predecessors are considered
-// *cold* and moved to the end of the order.
+// *cold* and moved to the end of the order. With an AOT profile, so are
+// blocks containing calls which never ran in the training run.
 // - Blocks which belong to the same loop are kept together (where possible)
 // and not interspersed with other blocks.
 //
@@ -252,6 +254,7 @@ class AOTBlockScheduler {
  public:
   explicit AOTBlockScheduler(FlowGraph* flow_graph)
       : flow_graph_(flow_graph),
+        profile_(AotProfile::Current()),
         block_count_(flow_graph->reverse_postorder().length()),
         marks_(block_count_),
         postorder_(block_count_),
@@ -289,6 +292,10 @@ class AOTBlockScheduler {
         if (last->IsThrow() || last->IsReThrow() || last->IsStop()) {
           marks |= kColdMark;
         } else {
+          if (IsColdInProfile(block)) {
+            marks |= kColdMark;
+          }
+
           // When visiting a block inside a loop with two successors
           // push the successor with lesser nesting *last*, so that it is
           // visited first. This helps to keep blocks which belong to the
@@ -346,11 +353,29 @@ class AOTBlockScheduler {
     }
   }
 
+  // Whether [block] contains a call which never ran although the function
+  // containing it did.
+  bool IsColdInProfile(BlockEntryInstr* block) {
+    if (profile_ == nullptr) {
+      return false;
+    }
+    for (auto instr : block->instructions()) {
+      if (instr->IsInstanceCallBase() || instr->IsStaticCall()) {
+        if (profile_->IsCold(AotProfile::FunctionOf(flow_graph_, instr),
+                             instr)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
   // The block was added to the stack.
   static constexpr uint8_t kSeenMark = 1 << 0;
   // The block was visited and all of its successors were added to the stack.
   static constexpr uint8_t kVisitedMark = 1 << 1;
-  // The block terminates with unconditional throw or rethrow.
+  // The block terminates with unconditional throw or rethrow, or is not
+  // expected to run according to the AOT profile.
   static constexpr uint8_t kColdMark = 1 << 2;
   // The block should not move to cold section.
   static constexpr uint8_t kPinnedMark = 1 << 3;
@@ -372,6 +397,7 @@ class AOTBlockScheduler {
   }
 
   FlowGraph* const flow_graph_;
+  const AotProfile* const profile_;
   const intptr_t block_count_;
 
   // Block marks for each block indexed by block preorder number.
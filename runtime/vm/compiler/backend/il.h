@@ -9,6 +9,7 @@
 #error "AOT runtime should not use compiler sources (including header files)"
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 
+#include <initializer_list>
 #include <memory>
 #include <tuple>
 #include <type_traits>
@@ -6834,6 +6835,7 @@ class LoadIndexedInstr : public TemplateDefinition<2, NoThrow> {
 
   Value* array() const { return inputs_[kArrayPos]; }
   Value* index() const { return inputs_[kIndexPos]; }
+  bool index_unboxed() const { return index_unboxed_; }
   intptr_t index_scale() const { return index_scale_; }
   intptr_t class_id() const { return class_id_; }
   bool aligned() const { return alignment_ == kAlignedAccess; }
@@ -7112,6 +7114,7 @@ class StoreIndexedInstr : public TemplateInstruction<3, NoThrow> {
   Value* index() const { return inputs_[kIndexPos]; }
   Value* value() const { return inputs_[kValuePos]; }
 
+  bool index_unboxed() const { return index_unboxed_; }
   intptr_t index_scale() const { return index_scale_; }
   intptr_t class_id() const { return class_id_; }
   bool aligned() const { return alignment_ == kAlignedAccess; }
@@ -7752,6 +7755,8 @@ class MaterializeObjectInstr : public VariadicDefinition {
     return slots_[i]->offset_in_bytes();
   }
 
+  const Slot& SlotAt(intptr_t i) const { return *slots_[i]; }
+
   const Location& LocationAt(intptr_t i) {
     ASSERT(0 <= i && i < InputCount());
     return locations_[i];
@@ -9654,6 +9659,7 @@ class CheckStackOverflowInstr : public TemplateInstruction<0, NoThrow> {
   bool in_loop() const { return loop_depth_ > 0; }
   intptr_t stack_depth() const { return stack_depth_; }
   intptr_t loop_depth() const { return loop_depth_; }
+  Kind kind() const { return kind_; }
 
   DECLARE_INSTRUCTION(CheckStackOverflow)
 
@@ -11067,6 +11073,19 @@ class SimdOpInstr : public Definition {
     return new SimdOpInstr(KindForMethod(kind), left, deopt_id);
   }
 
+  // Create a SimdOp with the given inputs.
+  static SimdOpInstr* Create(Kind kind,
+                             std::initializer_list<Value*> inputs,
+                             intptr_t deopt_id) {
+    SimdOpInstr* op = new SimdOpInstr(kind, deopt_id);
+    intptr_t i = 0;
+    for (Value* input : inputs) {
+      op->SetInputAt(i++, input);
+    }
+    ASSERT(i == op->InputCount());
+    return op;
+  }
+
   static Kind KindForOperator(MethodRecognizer::Kind kind);
 
   static Kind KindForMethod(MethodRecognizer::Kind method_kind);
@@ -5,6 +5,8 @@
 #include "vm/compiler/backend/inliner.h"
 
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/aot_profile.h"
+#include "vm/compiler/aot/escape_summaries.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
@@ -57,6 +59,12 @@ DEFINE_FLAG(int,
             inlining_callee_size_threshold,
             160,
             "Do not inline callees larger than threshold");
+DEFINE_FLAG(int,
+            inlining_read_only_allocation_size_threshold,
+            100,
+            "Inline functions that have threshold or fewer instructions and "
+            "only read an object allocated by the caller, so that the "
+            "allocation can be sunk.");
 DEFINE_FLAG(int,
             inlining_small_leaf_size_threshold,
             50,
@@ -279,6 +287,9 @@ class CallSites : public ValueObject {
           nesting_depth(nesting_depth) {
       if (CompilerState::Current().is_aot()) {
         call_count = AotCallCountApproximation(nesting_depth);
+        if (const AotProfile* profile = AotProfile::Current()) {
+          call_count = profile->CallCount(caller(), call, call_count);
+        }
       } else {
         call_count = call->CallCount();
       }
@@ -350,7 +361,8 @@ class CallSites : public ValueObject {
   // Computes the ratio for each call site in a method, defined as the
   // number of times a call site is executed over the maximum number of
   // times any call site is executed in the method. JIT uses actual call
-  // counts whereas AOT uses a static estimate based on nesting depth.
+  // counts whereas AOT uses the counts of a training run if it has a profile
+  // and a static estimate based on nesting depth otherwise.
   void ComputeCallSiteRatio(intptr_t static_calls_start_ix,
                             intptr_t instance_calls_start_ix,
                             intptr_t calls_start_ix) {
@@ -1022,7 +1034,8 @@ class CallSiteInliner : public ValueObject {
   // Inlining heuristics based on Cooper et al. 2008.
   InliningDecision ShouldWeInline(const Function& callee,
                                   intptr_t instr_count,
-                                  intptr_t call_site_count) {
+                                  intptr_t call_site_count,
+                                  bool passes_read_only_allocation) {
     // Pragma or size heuristics.
     if (inliner_->AlwaysInline(callee)) {
       return InliningDecision::Yes("AlwaysInline");
@@ -1049,6 +1062,13 @@ class CallSiteInliner : public ValueObject {
       return InliningDecision::Yes("--inlining-size-threshold");
     } else if (call_site_count <= FLAG_inlining_callee_call_sites_threshold) {
       return InliningDecision::Yes("--inlining-callee-call-sites-threshold");
+    } else if (passes_read_only_allocation &&
+               (instr_count <=
+                FLAG_inlining_read_only_allocation_size_threshold)) {
+      // Once inlined, the object no longer has to be allocated for the call
+      // (see AllocationSinking).
+      return InliningDecision::Yes(
+          "--inlining-read-only-allocation-size-threshold");
     }
     return InliningDecision::No("default");
   }
@@ -1232,8 +1252,11 @@ class CallSiteInliner : public ValueObject {
         constant_arg_count == 0 ? function.optimized_instruction_count() : 0;
     const intptr_t call_site_count =
         constant_arg_count == 0 ? function.optimized_call_site_count() : 0;
+    const bool passes_read_only_allocation =
+        PassesReadOnlyAllocation(*arguments);
     volatile InliningDecision decision =
-        ShouldWeInline(function, instruction_count, call_site_count);
+        ShouldWeInline(function, instruction_count, call_site_count,
+                       passes_read_only_allocation);
     if (!decision.value) {
       TRACE_INLINING(
           THR_Print("     Bailout: early heuristics (%s) with "
@@ -1461,7 +1484,8 @@ class CallSiteInliner : public ValueObject {
         {
           COMPILER_TIMINGS_TIMER_SCOPE(thread(), MakeInliningDecision);
           InliningDecision decision =
-              ShouldWeInline(function, instruction_count, call_site_count);
+              ShouldWeInline(function, instruction_count, call_site_count,
+                             passes_read_only_allocation);
           if (!decision.value) {
             // If size is larger than all thresholds, don't consider it again.
 
@@ -1699,6 +1723,20 @@ class CallSiteInliner : public ValueObject {
     return count;
   }
 
+  // Whether one of [arguments] is an object allocated by the caller which
+  // the callee only reads (see EscapeSummaries).
+  static bool PassesReadOnlyAllocation(const GrowableArray<Value*>& arguments) {
+    for (intptr_t i = 0; i < arguments.length(); i++) {
+      Definition* defn = arguments[i]->definition()->OriginalDefinition();
+      if ((defn->IsAllocateObject() || defn->IsAllocateClosure() ||
+           defn->IsAllocateRecord() || defn->IsAllocateSmallRecord()) &&
+          EscapeSummaries::IsReadOnlyArgument(arguments[i])) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   // Parse a function reusing the cache if possible.
   ParsedFunction* GetParsedFunction(const Function& function, bool* in_cache) {
     // TODO(zerny): Use a hash map for the cache.
@@ -1821,19 +1859,28 @@ class CallSiteInliner : public ValueObject {
                              call_info.length()));
     for (intptr_t call_idx = 0; call_idx < call_info.length(); ++call_idx) {
       PolymorphicInstanceCallInstr* call = call_info[call_idx].call;
-      // PolymorphicInliner introduces deoptimization paths.
-      if (!call->complete() && !FLAG_polymorphic_with_deopt) {
+      const Function& cl = call_info[call_idx].caller();
+      // PolymorphicInliner introduces deoptimization paths, or a fallback
+      // call which is only worth it for calls whose receivers were profiled.
+      if (!call->complete() && !FLAG_polymorphic_with_deopt &&
+          !IsProfiledCall(cl, call)) {
         TRACE_INLINING(THR_Print("  => %s\n     Bailout: call with checks\n",
                                  call->function_name().ToCString()));
         continue;
       }
-      const Function& cl = call_info[call_idx].caller();
       PolymorphicInliner inliner(this, call, cl);
       if (inliner.Inline()) inlined = true;
     }
     return inlined;
   }
 
+  static bool IsProfiledCall(const Function& caller,
+                             PolymorphicInstanceCallInstr* call) {
+    const AotProfile* profile = AotProfile::Current();
+    return (profile != nullptr) &&
+           (profile->LookupCallSite(caller, call) != nullptr);
+  }
+
   bool AdjustForOptionalParameters(const ParsedFunction& parsed_function,
                                    intptr_t first_arg_index,
                                    const Array& argument_names,
@@ -2090,8 +2137,9 @@ static Instruction* AppendInstruction(Instruction* first, Instruction* second) {
 // id of the receiver and make explicit comparisons for each inlined body,
 // in frequency order.  If all variants are inlined, the entry to the last
 // inlined body is guarded by a CheckClassId instruction which can deopt.
-// If not all variants are inlined, we add a PolymorphicInstanceCall
-// instruction to handle the non-inlined variants.
+// If not all variants are inlined, or the call may see other classes and
+// cannot deopt, we add a PolymorphicInstanceCall instruction to handle the
+// non-inlined variants.
 TargetEntryInstr* PolymorphicInliner::BuildDecisionGraph() {
   COMPILER_TIMINGS_TIMER_SCOPE(owner_->thread(), BuildDecisionGraph);
   const intptr_t try_idx = call_->GetBlock()->try_index();
@@ -2117,13 +2165,18 @@ TargetEntryInstr* PolymorphicInliner::BuildDecisionGraph() {
       new (Z) LoadClassIdInstr(new (Z) Value(receiver), cid_representation);
   owner_->caller_graph()->AllocateSSAIndex(load_cid);
   cursor = AppendInstruction(cursor, load_cid);
+  // Without deoptimization, classes other than the inlined ones have to be
+  // handled by a call even if all variants were inlined.
+  const bool needs_fallback_call =
+      !non_inlined_variants_->is_empty() ||
+      (!call_->complete() && !FLAG_polymorphic_with_deopt);
   for (intptr_t i = 0; i < inlined_variants_.length(); ++i) {
     const CidRange& variant = inlined_variants_[i];
     bool is_last_test = (i == inlined_variants_.length() - 1);
     // 1. Guard the body with a class id check.  We don't need any check if
     // it's the last test and global analysis has told us that the call is
     // complete.
-    if (is_last_test && non_inlined_variants_->is_empty()) {
+    if (is_last_test && !needs_fallback_call) {
       // If it is the last variant use a check class id instruction which can
       // deoptimize, followed unconditionally by the body. Omit the check if
       // we know that we have covered all possible classes.
@@ -2259,10 +2312,15 @@ TargetEntryInstr* PolymorphicInliner::BuildDecisionGraph() {
 
   ASSERT(!call_->HasMoveArguments());
 
-  // Handle any non-inlined variants.
-  if (!non_inlined_variants_->is_empty()) {
+  // Handle any non-inlined variants. The fallback call of an incomplete call
+  // whose variants were all inlined keeps them as its targets, since it must
+  // have some.
+  if (needs_fallback_call) {
+    const CallTargets& fallback_targets = non_inlined_variants_->is_empty()
+                                              ? variants_
+                                              : *non_inlined_variants_;
     PolymorphicInstanceCallInstr* fallback_call =
-        PolymorphicInstanceCallInstr::FromCall(Z, call_, *non_inlined_variants_,
+        PolymorphicInstanceCallInstr::FromCall(Z, call_, fallback_targets,
                                                call_->complete());
     owner_->caller_graph()->AllocateSSAIndex(fallback_call);
     fallback_call->InheritDeoptTarget(zone(), call_);
@@ -0,0 +1,1420 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_optimizer.h"
+
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            loop_unrolling,
+            true,
+            "Unroll counted loops over typed data in AOT mode.");
+DEFINE_FLAG(bool,
+            loop_vectorization,
+            true,
+            "Vectorize counted loops over Float64List, Int32List and "
+            "Uint32List in AOT mode.");
+DEFINE_FLAG(bool,
+            loop_vectorization_reassociate,
+            false,
+            "Vectorize floating point reductions, which changes the order "
+            "in which the elements are combined.");
+DEFINE_FLAG(int,
+            loop_unroll_factor,
+            4,
+            "Number of iterations performed by one iteration of an unrolled "
+            "loop.");
+DEFINE_FLAG(int,
+            loop_unroll_max_size,
+            64,
+            "Maximum number of instructions in the body of an unrolled loop.");
+DEFINE_FLAG(bool,
+            trace_loop_optimizer,
+            false,
+            "Trace loop unrolling and vectorization.");
+
+#define TRACE_LOOP_OPTIMIZER(statement)                                        \
+  if (FLAG_support_il_printer && FLAG_trace_loop_optimizer &&                  \
+      CompilerState::ShouldTrace()) {                                          \
+    statement;                                                                 \
+  }
+
+#define Z (flow_graph_->zone())
+
+// Float64x2 and Int32x4 operations are only inlined as single instructions
+// on these architectures.
+static bool SupportsVectorization() {
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+  return FlowGraphCompiler::SupportsUnboxedSimd128();
+#else
+  return false;
+#endif
+}
+
+static intptr_t TypedDataCidRemainder(intptr_t cid) {
+  ASSERT(IsTypedDataBaseClassId(cid));
+  return (cid - kFirstTypedDataCid) % kNumTypedDataCidRemainders;
+}
+
+static intptr_t InternalTypedDataCid(intptr_t cid) {
+  return cid - TypedDataCidRemainder(cid) + kTypedDataCidRemainderInternal;
+}
+
+// Returns the cid of an array of Float64x2 or Int32x4 elements that has the
+// same layout (internal, view, external or unmodifiable view) as the given
+// Float64List, Int32List or Uint32List cid.
+static intptr_t VectorTypedDataCid(intptr_t cid) {
+  const intptr_t internal_cid = InternalTypedDataCid(cid);
+  const intptr_t vector_cid = internal_cid == kTypedDataFloat64ArrayCid
+                                  ? kTypedDataFloat64x2ArrayCid
+                                  : kTypedDataInt32x4ArrayCid;
+  return vector_cid + (cid - internal_cid);
+}
+
+static bool IsLanewiseIntegerOp(Token::Kind op_kind) {
+  switch (op_kind) {
+    case Token::kADD:
+    case Token::kSUB:
+    case Token::kBIT_AND:
+    case Token::kBIT_OR:
+    case Token::kBIT_XOR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static SimdOpInstr::Kind Int32x4OpFor(Token::Kind op_kind) {
+  switch (op_kind) {
+    case Token::kADD:
+      return SimdOpInstr::kInt32x4Add;
+    case Token::kSUB:
+      return SimdOpInstr::kInt32x4Sub;
+    case Token::kBIT_AND:
+      return SimdOpInstr::kInt32x4BitAnd;
+    case Token::kBIT_OR:
+      return SimdOpInstr::kInt32x4BitOr;
+    case Token::kBIT_XOR:
+      return SimdOpInstr::kInt32x4BitXor;
+    default:
+      UNREACHABLE();
+      return SimdOpInstr::kIllegalSimdOp;
+  }
+}
+
+static SimdOpInstr::Kind Float64x2OpFor(Token::Kind op_kind) {
+  switch (op_kind) {
+    case Token::kADD:
+      return SimdOpInstr::kFloat64x2Add;
+    case Token::kSUB:
+      return SimdOpInstr::kFloat64x2Sub;
+    case Token::kMUL:
+      return SimdOpInstr::kFloat64x2Mul;
+    case Token::kDIV:
+      return SimdOpInstr::kFloat64x2Div;
+    case Token::kNEGATE:
+      return SimdOpInstr::kFloat64x2Negate;
+    case Token::kABS:
+      return SimdOpInstr::kFloat64x2Abs;
+    case Token::kSQRT:
+      return SimdOpInstr::kFloat64x2Sqrt;
+    default:
+      return SimdOpInstr::kIllegalSimdOp;
+  }
+}
+
+// An innermost loop
+//
+//     for (i = start; i < limit; i++) { body }
+//
+// with a constant start, a unit stride and a body consisting of a single
+// chain of blocks, which can be unrolled or vectorized.
+class CountedLoop : public ZoneAllocated {
+ public:
+  CountedLoop(FlowGraph* flow_graph, LoopInfo* loop)
+      : flow_graph_(flow_graph), loop_(loop) {}
+
+  // Returns true if the loop has the expected shape.
+  bool Analyze();
+
+  // Unrolls or vectorizes the loop if profitable. Returns true if the flow
+  // graph was changed.
+  bool Transform();
+
+ private:
+  enum class Shape {
+    kNone,
+    kInvariant,  // Same value in all iterations of the loop.
+    kIndex,      // Value of the loop index.
+    kVector,     // One value per element.
+  };
+
+  enum class ElementKind {
+    kNone,
+    kFloat64,
+    kInt32,
+  };
+
+  // A floating point value accumulated as phi = op(phi, x).
+  struct Reduction {
+    PhiInstr* phi;
+    BinaryDoubleOpInstr* op;
+    PhiInstr* vector_phi;
+  };
+
+  // A runtime check that [object] is an internal typed data with the given
+  // [cid], so that it does not share its payload with any other array.
+  struct AliasGuard {
+    Definition* object;
+    intptr_t cid;
+  };
+
+  // Blocks of the new main loop.
+  struct Skeleton {
+    TargetEntryInstr* entry;  // Reached when all guards pass.
+    JoinEntryInstr* bail;     // Reached when any guard fails.
+    JoinEntryInstr* header;
+    TargetEntryInstr* body;
+    TargetEntryInstr* exit;
+    JoinEntryInstr* join;  // Merges into the original loop.
+    Definition* limit;     // Main loop runs while index < limit.
+  };
+
+  bool AddToBody(Instruction* instr);
+  bool IsGuardable(Definition* length);
+  bool InLoop(Instruction* instr) const {
+    return loop_->Contains(instr->GetBlock());
+  }
+  bool IsInvariant(Instruction* instr) const;
+  bool IsGuardedCheck(Definition* def) const;
+
+  Definition* InitialValue(PhiInstr* phi) const {
+    return phi->InputAt(init_index_)->definition();
+  }
+  Definition* BackValue(PhiInstr* phi) const {
+    return phi->InputAt(back_index_)->definition();
+  }
+
+  // Vectorization.
+  bool CanVectorize();
+  void ResetVectorization();
+  bool IsReduction(PhiInstr* phi);
+  bool ComputeShape(Instruction* instr);
+  bool AddAccess(Instruction* access, Value* array, Value* index);
+  Shape ShapeOf(Definition* def) const;
+  bool AllInvariant(Instruction* instr) const;
+  bool IsSplattable(Definition* def) const;
+
+  // Code generation.
+  Skeleton BuildSkeleton(intptr_t width);
+  Definition* MaterializeLength(Definition* length, Instruction* before);
+  void EmitLoopHeader(const Skeleton& skeleton, Definition* index);
+  void LinkToOriginalLoop(const Skeleton& skeleton,
+                          PhiInstr* phi,
+                          Definition* exit_value);
+  void Unroll(intptr_t factor);
+  void Vectorize();
+
+  Definition* Rename(Definition* def) const {
+    Definition* renamed = renaming_.LookupValue(def);
+    return renamed != nullptr ? renamed : def;
+  }
+  Value* RenamedValue(Value* value) const {
+    return new (Z) Value(Rename(value->definition()));
+  }
+  Definition* IntConstant(int64_t value);
+  PhiInstr* NewPhi(JoinEntryInstr* join,
+                   Representation representation,
+                   const CompileType& type,
+                   Range* range);
+  void SetPhiInput(PhiInstr* phi, intptr_t i, Definition* def);
+  TargetEntryInstr* NewTarget();
+  JoinEntryInstr* NewJoin();
+  void AppendGoto(BlockEntryInstr* block,
+                  Instruction* last,
+                  JoinEntryInstr* target);
+  void AppendBranch(BlockEntryInstr* block,
+                    Instruction* last,
+                    ConditionInstr* condition,
+                    TargetEntryInstr* true_target,
+                    TargetEntryInstr* false_target);
+  Definition* Emit(Definition* def) {
+    cursor_ = flow_graph_->AppendTo(cursor_, def, nullptr, FlowGraph::kValue);
+    return def;
+  }
+  void EmitEffect(Instruction* instr) {
+    cursor_ =
+        flow_graph_->AppendTo(cursor_, instr, nullptr, FlowGraph::kEffect);
+  }
+  void EmitScalar(Instruction* instr);
+  void EmitVector(Instruction* instr);
+  Definition* VectorValue(Definition* def);
+  Value* VectorOperand(Value* value) {
+    return new (Z) Value(VectorValue(value->definition()));
+  }
+  Definition* Splat(Definition* def);
+
+  FlowGraph* const flow_graph_;
+  LoopInfo* const loop_;
+
+  JoinEntryInstr* header_ = nullptr;
+  BlockEntryInstr* preheader_ = nullptr;
+  BlockEntryInstr* latch_ = nullptr;
+  intptr_t init_index_ = -1;
+  intptr_t back_index_ = -1;
+  CheckStackOverflowInstr* stack_check_ = nullptr;
+  BranchInstr* exit_branch_ = nullptr;
+  PhiInstr* index_ = nullptr;
+  int64_t start_ = 0;
+  InductionVar* limit_ = nullptr;
+  GrowableArray<Instruction*> body_;
+  GrowableArray<Instruction*> accesses_;
+  bool has_store_ = false;
+
+  // Bounds checks of the loop index which are replaced by a single check
+  // of the loop limit against their (loop invariant) lengths.
+  GrowableArray<GenericCheckBoundInstr*> guarded_checks_;
+  GrowableArray<Definition*> guarded_lengths_;
+
+  // Vectorization.
+  DirectChainedHashMap<RawPointerKeyValueTrait<Instruction, Shape>> shapes_;
+  ElementKind element_kind_ = ElementKind::kNone;
+  intptr_t lanes_ = 0;
+  BinaryInt64OpInstr* increment_ = nullptr;
+  GrowableArray<Reduction> reductions_;
+  GrowableArray<AliasGuard> alias_guards_;
+
+  // Code generation.
+  DirectChainedHashMap<RawPointerKeyValueTrait<Definition, Definition*>>
+      renaming_;
+  DirectChainedHashMap<RawPointerKeyValueTrait<Definition, Definition*>>
+      splats_;
+  TargetEntryInstr* entry_ = nullptr;
+  Instruction* cursor_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(CountedLoop);
+};
+
+bool CountedLoop::Analyze() {
+  // Single entry, single back edge, no exception handling.
+  header_ = loop_->header()->AsJoinEntry();
+  if (header_ == nullptr || header_->PredecessorCount() != 2 ||
+      loop_->back_edges().length() != 1 || header_->InsideTryBlock()) {
+    return false;
+  }
+  latch_ = loop_->back_edges()[0];
+  back_index_ = header_->IndexOfPredecessor(latch_);
+  init_index_ = 1 - back_index_;
+  preheader_ = header_->PredecessorAt(init_index_);
+  if (loop_->Contains(preheader_) || preheader_->InsideTryBlock() ||
+      !preheader_->last_instruction()->IsGoto()) {
+    return false;
+  }
+
+  // The header only tests the loop condition.
+  Instruction* current = header_->next();
+  if (current->IsCheckStackOverflow()) {
+    stack_check_ = current->AsCheckStackOverflow();
+    current = current->next();
+  }
+  exit_branch_ = current->AsBranch();
+  if (exit_branch_ == nullptr) {
+    return false;
+  }
+  BlockEntryInstr* body_entry = exit_branch_->true_successor();
+  if (!loop_->Contains(body_entry)) {
+    body_entry = exit_branch_->false_successor();
+  }
+
+  // Unit stride linear induction from a non-negative constant start,
+  // bounded by the exit branch.
+  InductionVar* control = loop_->control();
+  int64_t stride = 0;
+  if (!InductionVar::IsLinear(control, &stride) || stride != 1 ||
+      !InductionVar::IsConstant(control->initial(), &start_) || start_ < 0 ||
+      start_ > kMaxInt32) {
+    return false;
+  }
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    if (loop_->LookupInduction(it.Current()) == control) {
+      index_ = it.Current();
+    }
+  }
+  for (const auto& bound : control->bounds()) {
+    if (bound.branch_ == exit_branch_) {
+      limit_ = bound.limit_;
+    }
+  }
+  if (index_ == nullptr || index_->representation() != kUnboxedInt64 ||
+      !InductionVar::IsInvariant(limit_) ||
+      (limit_->mult() != 0 && limit_->mult() != 1) ||
+      (limit_->mult() == 1 && InLoop(limit_->def()))) {
+    return false;
+  }
+
+  // The body is a chain of blocks ending in the back edge.
+  intptr_t block_count = 1;
+  BlockEntryInstr* block = body_entry;
+  while (true) {
+    ++block_count;
+    GotoInstr* jump = block->last_instruction()->AsGoto();
+    if (jump == nullptr) {
+      return false;
+    }
+    for (Instruction* instr = block->next(); instr != jump;
+         instr = instr->next()) {
+      if (!AddToBody(instr)) {
+        return false;
+      }
+    }
+    JoinEntryInstr* successor = jump->successor();
+    if (successor == header_) {
+      break;
+    }
+    if (!loop_->Contains(successor) || successor->PredecessorCount() != 1 ||
+        (successor->phis() != nullptr && !successor->phis()->is_empty())) {
+      return false;
+    }
+    block = successor;
+  }
+  intptr_t loop_block_count = 0;
+  for (BitVector::Iterator it(loop_->blocks()); !it.Done(); it.Advance()) {
+    ++loop_block_count;
+  }
+  if (block != latch_ || block_count != loop_block_count ||
+      accesses_.is_empty() || body_.length() > FLAG_loop_unroll_max_size) {
+    return false;
+  }
+
+  // Bounds checks of the index are implied by index < limit <= length,
+  // which is checked once before entering the main loop.
+  for (Instruction* instr : body_) {
+    GenericCheckBoundInstr* check = instr->AsGenericCheckBound();
+    if (check != nullptr && check->index()->definition() == index_ &&
+        IsGuardable(check->length()->definition())) {
+      guarded_checks_.Add(check);
+      Definition* length = check->length()->definition();
+      if (!guarded_lengths_.Contains(length)) {
+        guarded_lengths_.Add(length);
+      }
+    }
+  }
+  return true;
+}
+
+bool CountedLoop::AddToBody(Instruction* instr) {
+  if (instr->env() != nullptr || instr->CanDeoptimize() ||
+      instr->HasUnknownSideEffects()) {
+    return false;
+  }
+  switch (instr->tag()) {
+    case Instruction::kLoadIndexed:
+      if (!IsTypedDataBaseClassId(instr->AsLoadIndexed()->class_id())) {
+        return false;
+      }
+      accesses_.Add(instr);
+      break;
+    case Instruction::kStoreIndexed:
+      if (!IsTypedDataBaseClassId(instr->AsStoreIndexed()->class_id())) {
+        return false;
+      }
+      accesses_.Add(instr);
+      has_store_ = true;
+      break;
+    case Instruction::kLoadField:
+      if (instr->AsLoadField()->calls_initializer()) {
+        return false;
+      }
+      break;
+    case Instruction::kBinaryInt32Op:
+    case Instruction::kBinaryUint32Op:
+    case Instruction::kBinaryInt64Op:
+      switch (instr->AsBinaryIntegerOp()->op_kind()) {
+        case Token::kADD:
+        case Token::kSUB:
+        case Token::kMUL:
+        case Token::kBIT_AND:
+        case Token::kBIT_OR:
+        case Token::kBIT_XOR:
+          break;
+        default:
+          return false;
+      }
+      break;
+    case Instruction::kGenericCheckBound:
+    case Instruction::kCheckWritable:
+    case Instruction::kBoxInt64:
+    case Instruction::kBinaryDoubleOp:
+    case Instruction::kUnaryDoubleOp:
+    case Instruction::kIntConverter:
+    case Instruction::kDoubleToFloat:
+    case Instruction::kFloatToDouble:
+    case Instruction::kInt64ToDouble:
+      break;
+    default:
+      if (!instr->IsUnbox()) {
+        return false;
+      }
+      break;
+  }
+  // Values computed in the body only flow around the back edge.
+  if (Definition* def = instr->AsDefinition()) {
+    if (def->env_use_list() != nullptr) {
+      return false;
+    }
+    for (Value::Iterator it(def->input_use_list()); !it.Done(); it.Advance()) {
+      Instruction* use = it.Current()->instruction();
+      if (use == exit_branch_ || !InLoop(use)) {
+        return false;
+      }
+    }
+  }
+  body_.Add(instr);
+  return true;
+}
+
+// Returns true if the given length of a bounds check can be computed
+// before entering the loop.
+bool CountedLoop::IsGuardable(Definition* length) {
+  if (!InLoop(length)) {
+    return true;
+  }
+  if (UnboxInstr* unbox = length->AsUnbox()) {
+    return IsGuardable(unbox->value()->definition());
+  }
+  if (LoadFieldInstr* load = length->AsLoadField()) {
+    // The load is moved above any null checks of the instance.
+    Definition* instance =
+        load->instance()->definition()->OriginalDefinition();
+    return load->slot().is_immutable() &&
+           load->loads_inner_pointer() == InnerPointerAccess::kNotUntagged &&
+           !InLoop(instance) && !instance->Type()->is_nullable();
+  }
+  return false;
+}
+
+bool CountedLoop::IsInvariant(Instruction* instr) const {
+  if (instr->IsLoadIndexed() || instr->IsStoreIndexed()) {
+    return false;
+  }
+  for (intptr_t i = 0; i < instr->InputCount(); ++i) {
+    Definition* input = instr->InputAt(i)->definition();
+    if (InLoop(input) && (input->IsPhi() || !IsInvariant(input))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CountedLoop::IsGuardedCheck(Definition* def) const {
+  GenericCheckBoundInstr* check = def->AsGenericCheckBound();
+  return check != nullptr && guarded_checks_.Contains(check);
+}
+
+bool CountedLoop::Transform() {
+  if (CanVectorize()) {
+    TRACE_LOOP_OPTIMIZER(THR_Print("Vectorizing loop B%" Pd " (%" Pd
+                                   " lanes)\n",
+                                   header_->block_id(), lanes_));
+    Vectorize();
+    return true;
+  }
+  ResetVectorization();
+  const intptr_t factor = FLAG_loop_unroll_factor;
+  if (FLAG_loop_unrolling && factor > 1 &&
+      body_.length() * factor <= FLAG_loop_unroll_max_size) {
+    TRACE_LOOP_OPTIMIZER(THR_Print("Unrolling loop B%" Pd " (%" Pd
+                                   " times)\n",
+                                   header_->block_id(), factor));
+    Unroll(factor);
+    return true;
+  }
+  return false;
+}
+
+bool CountedLoop::CanVectorize() {
+  if (!FLAG_loop_vectorization || !SupportsVectorization()) {
+    return false;
+  }
+
+  // All accesses are to elements of the same kind.
+  for (Instruction* access : accesses_) {
+    const intptr_t cid = access->IsLoadIndexed()
+                             ? access->AsLoadIndexed()->class_id()
+                             : access->AsStoreIndexed()->class_id();
+    ElementKind kind = ElementKind::kNone;
+    switch (InternalTypedDataCid(cid)) {
+      case kTypedDataFloat64ArrayCid:
+        kind = ElementKind::kFloat64;
+        break;
+      case kTypedDataInt32ArrayCid:
+      case kTypedDataUint32ArrayCid:
+        kind = ElementKind::kInt32;
+        break;
+      default:
+        return false;
+    }
+    if (element_kind_ != ElementKind::kNone && element_kind_ != kind) {
+      return false;
+    }
+    element_kind_ = kind;
+  }
+  lanes_ = element_kind_ == ElementKind::kFloat64 ? 2 : 4;
+
+  // The index only advances, other header phis are reductions.
+  increment_ = BackValue(index_)->AsBinaryInt64Op();
+  if (increment_ == nullptr || !InLoop(increment_) ||
+      increment_->op_kind() != Token::kADD ||
+      !increment_->HasOnlyUse(index_->InputAt(back_index_))) {
+    return false;
+  }
+  shapes_.Insert({index_, Shape::kIndex});
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    if (phi != index_ && !IsReduction(phi)) {
+      return false;
+    }
+  }
+
+  for (Instruction* instr : body_) {
+    if (instr != increment_ && !ComputeShape(instr)) {
+      return false;
+    }
+  }
+  if (!has_store_ && reductions_.is_empty()) {
+    return false;
+  }
+
+  // Vector integer values are computed with 32-bit lanes, which is only
+  // exact if they are eventually truncated to 32 bits.
+  for (Instruction* instr : body_) {
+    Definition* def = instr->AsDefinition();
+    if (def == nullptr || def == increment_ ||
+        def->representation() != kUnboxedInt64 ||
+        ShapeOf(def) != Shape::kVector) {
+      continue;
+    }
+    for (Value::Iterator it(def->input_use_list()); !it.Done(); it.Advance()) {
+      Instruction* use = it.Current()->instruction();
+      if (use->IsBinaryInt64Op()) continue;
+      IntConverterInstr* converter = use->AsIntConverter();
+      if (converter == nullptr || converter->to() == kUnboxedInt64) {
+        return false;
+      }
+    }
+  }
+
+  // A vector store must not overwrite elements which a later scalar
+  // iteration would read through another array sharing the same payload.
+  // Distinct internal typed data arrays never share their payload.
+  if (has_store_) {
+    GrowableArray<Definition*> objects;
+    GrowableArray<intptr_t> cids;
+    for (Instruction* access : accesses_) {
+      Value* array = access->InputAt(0);
+      const intptr_t cid = InternalTypedDataCid(
+          access->IsLoadIndexed() ? access->AsLoadIndexed()->class_id()
+                                  : access->AsStoreIndexed()->class_id());
+      Definition* object = array->definition()->OriginalDefinition();
+      if (array->definition()->representation() == kUntagged) {
+        object = nullptr;
+      }
+      if (!objects.Contains(object)) {
+        objects.Add(object);
+        cids.Add(cid);
+      }
+    }
+    if (objects.length() > 1) {
+      for (intptr_t i = 0; i < objects.length(); ++i) {
+        Definition* object = objects[i];
+        if (object == nullptr || InLoop(object)) {
+          return false;
+        }
+        const intptr_t type_cid = object->Type()->ToCid();
+        if (type_cid == cids[i]) continue;
+        if (type_cid != kDynamicCid) {
+          return false;
+        }
+        alias_guards_.Add({object, cids[i]});
+      }
+    }
+  }
+  return true;
+}
+
+// Drops what a rejected CanVectorize recorded, which would otherwise make
+// the unrolled loop check for the classes of its arrays.
+void CountedLoop::ResetVectorization() {
+  shapes_.Clear();
+  element_kind_ = ElementKind::kNone;
+  lanes_ = 0;
+  increment_ = nullptr;
+  reductions_.Clear();
+  alias_guards_.Clear();
+}
+
+bool CountedLoop::IsReduction(PhiInstr* phi) {
+  if (!FLAG_loop_vectorization_reassociate ||
+      element_kind_ != ElementKind::kFloat64 ||
+      phi->representation() != kUnboxedDouble) {
+    return false;
+  }
+  BinaryDoubleOpInstr* op = BackValue(phi)->AsBinaryDoubleOp();
+  if (op == nullptr || !InLoop(op) || op->representation() != kUnboxedDouble ||
+      (op->op_kind() != Token::kADD && op->op_kind() != Token::kMUL) ||
+      (op->left()->definition() == phi) == (op->right()->definition() == phi) ||
+      !op->HasOnlyUse(phi->InputAt(back_index_))) {
+    return false;
+  }
+  // The partial results are only observable after the loop.
+  for (Value::Iterator it(phi->input_use_list()); !it.Done(); it.Advance()) {
+    Instruction* use = it.Current()->instruction();
+    if (InLoop(use) && use != op) {
+      return false;
+    }
+  }
+  shapes_.Insert({phi, Shape::kVector});
+  reductions_.Add({phi, op, nullptr});
+  return true;
+}
+
+CountedLoop::Shape CountedLoop::ShapeOf(Definition* def) const {
+  if (!InLoop(def)) {
+    return Shape::kInvariant;
+  }
+  return shapes_.LookupValue(def);
+}
+
+bool CountedLoop::AllInvariant(Instruction* instr) const {
+  for (intptr_t i = 0; i < instr->InputCount(); ++i) {
+    if (ShapeOf(instr->InputAt(i)->definition()) != Shape::kInvariant) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if the given loop invariant value can be broadcast to all
+// lanes of a vector.
+bool CountedLoop::IsSplattable(Definition* def) const {
+  switch (def->representation()) {
+    case kUnboxedDouble:
+      return element_kind_ == ElementKind::kFloat64;
+    case kUnboxedInt32:
+    case kUnboxedUint32:
+    case kUnboxedInt64:
+      return element_kind_ == ElementKind::kInt32;
+    default:
+      return false;
+  }
+}
+
+bool CountedLoop::AddAccess(Instruction* access, Value* array, Value* index) {
+  Definition* index_def = index->definition();
+  if (ShapeOf(array->definition()) != Shape::kInvariant ||
+      ShapeOf(index_def) != Shape::kIndex ||
+      (index_def != index_ && !IsGuardedCheck(index_def) &&
+       !index_def->IsBoxInt64())) {
+    return false;
+  }
+  shapes_.Insert({access, Shape::kVector});
+  return true;
+}
+
+bool CountedLoop::ComputeShape(Instruction* instr) {
+  // Uses of the index other than by the accesses.
+  switch (instr->tag()) {
+    case Instruction::kGenericCheckBound:
+      if (IsGuardedCheck(instr->AsDefinition())) {
+        shapes_.Insert({instr, Shape::kIndex});
+        return true;
+      }
+      break;
+    case Instruction::kBoxInt64:
+      if (ShapeOf(instr->InputAt(0)->definition()) == Shape::kIndex) {
+        for (Value::Iterator it(instr->AsDefinition()->input_use_list());
+             !it.Done(); it.Advance()) {
+          Instruction* use = it.Current()->instruction();
+          if (!(use->IsLoadIndexed() || use->IsStoreIndexed()) ||
+              it.Current()->use_index() != 1) {
+            return false;
+          }
+        }
+        shapes_.Insert({instr, Shape::kIndex});
+        return true;
+      }
+      break;
+    case Instruction::kLoadIndexed: {
+      LoadIndexedInstr* load = instr->AsLoadIndexed();
+      return AddAccess(load, load->array(), load->index());
+    }
+    case Instruction::kStoreIndexed: {
+      StoreIndexedInstr* store = instr->AsStoreIndexed();
+      Definition* value = store->value()->definition();
+      const Shape shape = ShapeOf(value);
+      if (shape != Shape::kVector &&
+          !(shape == Shape::kInvariant && IsSplattable(value))) {
+        return false;
+      }
+      return AddAccess(store, store->array(), store->index());
+    }
+    default:
+      break;
+  }
+
+  if (AllInvariant(instr)) {
+    shapes_.Insert({instr, Shape::kInvariant});
+    return true;
+  }
+  for (intptr_t i = 0; i < instr->InputCount(); ++i) {
+    Definition* input = instr->InputAt(i)->definition();
+    const Shape shape = ShapeOf(input);
+    if (shape == Shape::kIndex ||
+        (shape == Shape::kInvariant && !IsSplattable(input))) {
+      return false;
+    }
+  }
+
+  // Lanewise operations on vectors.
+  switch (instr->tag()) {
+    case Instruction::kBinaryDoubleOp: {
+      BinaryDoubleOpInstr* op = instr->AsBinaryDoubleOp();
+      if (element_kind_ != ElementKind::kFloat64 ||
+          op->representation() != kUnboxedDouble ||
+          Float64x2OpFor(op->op_kind()) == SimdOpInstr::kIllegalSimdOp) {
+        return false;
+      }
+      break;
+    }
+    case Instruction::kUnaryDoubleOp: {
+      UnaryDoubleOpInstr* op = instr->AsUnaryDoubleOp();
+      if (element_kind_ != ElementKind::kFloat64 ||
+          op->representation() != kUnboxedDouble ||
+          (op->op_kind() != Token::kSQUARE &&
+           Float64x2OpFor(op->op_kind()) == SimdOpInstr::kIllegalSimdOp)) {
+        return false;
+      }
+      break;
+    }
+    case Instruction::kBinaryInt32Op:
+    case Instruction::kBinaryUint32Op:
+    case Instruction::kBinaryInt64Op:
+      if (element_kind_ != ElementKind::kInt32 ||
+          !IsLanewiseIntegerOp(instr->AsBinaryIntegerOp()->op_kind())) {
+        return false;
+      }
+      break;
+    case Instruction::kIntConverter: {
+      IntConverterInstr* converter = instr->AsIntConverter();
+      if (element_kind_ != ElementKind::kInt32 ||
+          converter->from() == kUntagged || converter->to() == kUntagged) {
+        return false;
+      }
+      break;
+    }
+    default:
+      return false;
+  }
+  shapes_.Insert({instr, Shape::kVector});
+  return true;
+}
+
+Definition* CountedLoop::IntConstant(int64_t value) {
+  return flow_graph_->GetConstant(
+      Integer::ZoneHandle(Z, Integer::NewCanonical(value)), kUnboxedInt64);
+}
+
+PhiInstr* CountedLoop::NewPhi(JoinEntryInstr* join,
+                              Representation representation,
+                              const CompileType& type,
+                              Range* range) {
+  PhiInstr* phi = new (Z) PhiInstr(join, 2);
+  phi->set_representation(representation);
+  phi->UpdateType(type);
+  if (range != nullptr) {
+    phi->set_range(*range);
+  }
+  phi->mark_alive();
+  flow_graph_->AllocateSSAIndex(phi);
+  join->InsertPhi(phi);
+  return phi;
+}
+
+void CountedLoop::SetPhiInput(PhiInstr* phi, intptr_t i, Definition* def) {
+  Value* value = new (Z) Value(def);
+  phi->SetInputAt(i, value);
+  def->AddInputUse(value);
+}
+
+TargetEntryInstr* CountedLoop::NewTarget() {
+  return new (Z)
+      TargetEntryInstr(flow_graph_->allocate_block_id(), header_->try_index(),
+                       DeoptId::kNone, header_->stack_depth());
+}
+
+JoinEntryInstr* CountedLoop::NewJoin() {
+  return new (Z)
+      JoinEntryInstr(flow_graph_->allocate_block_id(), header_->try_index(),
+                     DeoptId::kNone, header_->stack_depth());
+}
+
+void CountedLoop::AppendGoto(BlockEntryInstr* block,
+                             Instruction* last,
+                             JoinEntryInstr* target) {
+  GotoInstr* jump = new (Z) GotoInstr(target, DeoptId::kNone);
+  flow_graph_->AppendTo(last, jump, nullptr, FlowGraph::kEffect);
+  block->set_last_instruction(jump);
+}
+
+void CountedLoop::AppendBranch(BlockEntryInstr* block,
+                               Instruction* last,
+                               ConditionInstr* condition,
+                               TargetEntryInstr* true_target,
+                               TargetEntryInstr* false_target) {
+  BranchInstr* branch = new (Z) BranchInstr(condition, DeoptId::kNone);
+  flow_graph_->AppendTo(last, branch, nullptr, FlowGraph::kEffect);
+  block->set_last_instruction(branch);
+  *branch->true_successor_address() = true_target;
+  *branch->false_successor_address() = false_target;
+}
+
+// Computes the given loop invariant length before the given instruction.
+Definition* CountedLoop::MaterializeLength(Definition* length,
+                                           Instruction* before) {
+  if (!InLoop(length)) {
+    return length;
+  }
+  if (UnboxInstr* unbox = length->AsUnbox()) {
+    // Unboxed when comparing with the limit.
+    return MaterializeLength(unbox->value()->definition(), before);
+  }
+  LoadFieldInstr* load = length->AsLoadField();
+  ASSERT(load != nullptr);
+  LoadFieldInstr* hoisted = new (Z) LoadFieldInstr(
+      new (Z) Value(load->instance()->definition()->OriginalDefinition()),
+      load->slot(), load->source());
+  flow_graph_->InsertBefore(before, hoisted, nullptr, FlowGraph::kValue);
+  return hoisted;
+}
+
+// Replaces the edge from the preheader to the original loop by
+//
+//     if (guards) {
+//       for (index = start; index < limit - (width - 1);) { body }
+//     }
+//     goto original loop
+//
+// leaving the body and the phis of the main loop to the caller.
+CountedLoop::Skeleton CountedLoop::BuildSkeleton(intptr_t width) {
+  GotoInstr* preheader_goto = preheader_->last_instruction()->AsGoto();
+  const InstructionSource& source = exit_branch_->source();
+
+  // Loop limit.
+  Definition* limit = nullptr;
+  if (limit_->mult() == 0) {
+    limit = IntConstant(limit_->offset());
+  } else if (limit_->offset() == 0) {
+    limit = limit_->def();
+  } else {
+    limit = new (Z) BinaryInt64OpInstr(
+        Token::kADD, new (Z) Value(limit_->def()),
+        new (Z) Value(IntConstant(limit_->offset())), DeoptId::kNone);
+    flow_graph_->InsertBefore(preheader_goto, limit, nullptr,
+                              FlowGraph::kValue);
+  }
+
+  // Guards: at least one iteration of the main loop, no bounds check
+  // failures and no aliasing of vector stores.
+  GrowableArray<ConditionInstr*> guards;
+  guards.Add(new (Z) RelationalOpInstr(
+      source, Token::kGTE, new (Z) Value(limit),
+      new (Z) Value(IntConstant(start_ + width)), kUnboxedInt64,
+      DeoptId::kNone));
+  for (Definition* length : guarded_lengths_) {
+    Definition* hoisted = MaterializeLength(length, preheader_goto);
+    guards.Add(new (Z) RelationalOpInstr(
+        source, Token::kLTE, new (Z) Value(limit), new (Z) Value(hoisted),
+        kUnboxedInt64, DeoptId::kNone));
+  }
+  for (const auto& guard : alias_guards_) {
+    LoadClassIdInstr* cid =
+        new (Z) LoadClassIdInstr(new (Z) Value(guard.object));
+    flow_graph_->InsertBefore(preheader_goto, cid, nullptr, FlowGraph::kValue);
+    guards.Add(new (Z) StrictCompareInstr(
+        source, Token::kEQ_STRICT, new (Z) Value(cid),
+        new (Z) Value(flow_graph_->GetConstant(
+            Smi::ZoneHandle(Z, Smi::New(guard.cid)))),
+        /*needs_number_check=*/false, DeoptId::kNone));
+  }
+
+  Skeleton skeleton;
+  skeleton.limit = new (Z)
+      BinaryInt64OpInstr(Token::kSUB, new (Z) Value(limit),
+                         new (Z) Value(IntConstant(width - 1)), DeoptId::kNone);
+  flow_graph_->InsertBefore(preheader_goto, skeleton.limit, nullptr,
+                            FlowGraph::kValue);
+
+  // Chain of guards. Blocks are allocated such that the predecessors of
+  // each join (which are sorted by block id) come in the order in which
+  // the inputs of its phis are set.
+  Instruction* last = preheader_goto->previous();
+  preheader_goto->UnuseAllInputs();
+  BlockEntryInstr* block = preheader_;
+  GrowableArray<TargetEntryInstr*> failures;
+  for (ConditionInstr* guard : guards) {
+    TargetEntryInstr* success = NewTarget();
+    TargetEntryInstr* failure = NewTarget();
+    AppendBranch(block, last, guard, success, failure);
+    failures.Add(failure);
+    block = last = success;
+  }
+  skeleton.entry = block->AsTargetEntry();
+  skeleton.bail = NewJoin();
+  skeleton.header = NewJoin();
+  skeleton.body = NewTarget();
+  skeleton.exit = NewTarget();
+  skeleton.join = NewJoin();
+  for (TargetEntryInstr* failure : failures) {
+    AppendGoto(failure, failure, skeleton.bail);
+  }
+  AppendGoto(skeleton.bail, skeleton.bail, skeleton.join);
+  AppendGoto(skeleton.entry, last, skeleton.header);
+  AppendGoto(skeleton.join, skeleton.join, header_);
+  entry_ = skeleton.entry;
+  return skeleton;
+}
+
+// Emits the stack overflow check and the exit test of the main loop.
+void CountedLoop::EmitLoopHeader(const Skeleton& skeleton, Definition* index) {
+  Instruction* last = skeleton.header;
+  if (stack_check_ != nullptr) {
+    last = flow_graph_->AppendTo(
+        last,
+        new (Z) CheckStackOverflowInstr(
+            stack_check_->source(), stack_check_->stack_depth(),
+            stack_check_->loop_depth(), stack_check_->deopt_id(),
+            stack_check_->kind()),
+        nullptr, FlowGraph::kEffect);
+  }
+  AppendBranch(skeleton.header, last,
+               new (Z) RelationalOpInstr(
+                   exit_branch_->source(), Token::kLT, new (Z) Value(index),
+                   new (Z) Value(skeleton.limit), kUnboxedInt64,
+                   DeoptId::kNone),
+               skeleton.body, skeleton.exit);
+}
+
+// Enters the original loop with the initial value of the given header phi
+// if the guards failed, or with its value after the main loop otherwise.
+void CountedLoop::LinkToOriginalLoop(const Skeleton& skeleton,
+                                     PhiInstr* phi,
+                                     Definition* exit_value) {
+  PhiInstr* entry_value =
+      NewPhi(skeleton.join, phi->representation(), *phi->Type(), phi->range());
+  SetPhiInput(entry_value, 0, InitialValue(phi));
+  SetPhiInput(entry_value, 1, exit_value);
+  // The join is now the last predecessor of the original header.
+  Definition* back_value = BackValue(phi);
+  phi->InputAt(0)->BindTo(back_value);
+  phi->InputAt(1)->BindTo(entry_value);
+}
+
+void CountedLoop::EmitScalar(Instruction* instr) {
+  if (IsGuardedCheck(instr->AsDefinition())) {
+    renaming_.Update({instr->AsDefinition(), Rename(index_)});
+    return;
+  }
+  Instruction* copy = nullptr;
+  switch (instr->tag()) {
+    case Instruction::kLoadIndexed: {
+      LoadIndexedInstr* load = instr->AsLoadIndexed();
+      copy = new (Z) LoadIndexedInstr(
+          RenamedValue(load->array()), RenamedValue(load->index()),
+          load->index_unboxed(), load->index_scale(), load->class_id(),
+          load->aligned() ? kAlignedAccess : kUnalignedAccess,
+          load->deopt_id(), load->source());
+      break;
+    }
+    case Instruction::kStoreIndexed: {
+      StoreIndexedInstr* store = instr->AsStoreIndexed();
+      copy = new (Z) StoreIndexedInstr(
+          RenamedValue(store->array()), RenamedValue(store->index()),
+          RenamedValue(store->value()), kNoStoreBarrier,
+          store->index_unboxed(), store->index_scale(), store->class_id(),
+          store->aligned() ? kAlignedAccess : kUnalignedAccess,
+          store->deopt_id(), store->source());
+      break;
+    }
+    case Instruction::kLoadField: {
+      LoadFieldInstr* load = instr->AsLoadField();
+      copy = new (Z)
+          LoadFieldInstr(RenamedValue(load->instance()), load->slot(),
+                         load->loads_inner_pointer(), load->source());
+      break;
+    }
+    case Instruction::kGenericCheckBound: {
+      GenericCheckBoundInstr* check = instr->AsGenericCheckBound();
+      copy = new (Z) GenericCheckBoundInstr(
+          RenamedValue(check->length()), RenamedValue(check->index()),
+          check->deopt_id(),
+          check->IsPhantom() ? GenericCheckBoundInstr::Mode::kPhantom
+                             : GenericCheckBoundInstr::Mode::kReal);
+      break;
+    }
+    case Instruction::kCheckWritable: {
+      CheckWritableInstr* check = instr->AsCheckWritable();
+      copy = new (Z) CheckWritableInstr(RenamedValue(check->value()),
+                                        check->deopt_id(), check->source(),
+                                        check->kind());
+      break;
+    }
+    case Instruction::kBoxInt64:
+      copy = BoxInstr::Create(kUnboxedInt64,
+                              RenamedValue(instr->AsBoxInt64()->value()));
+      break;
+    case Instruction::kBinaryInt32Op:
+    case Instruction::kBinaryUint32Op:
+    case Instruction::kBinaryInt64Op: {
+      BinaryIntegerOpInstr* op = instr->AsBinaryIntegerOp();
+      copy = BinaryIntegerOpInstr::Make(
+          op->representation(), op->op_kind(), RenamedValue(op->left()),
+          RenamedValue(op->right()), op->deopt_id(), op->can_overflow(),
+          op->is_truncating(), op->range());
+      break;
+    }
+    case Instruction::kBinaryDoubleOp: {
+      BinaryDoubleOpInstr* op = instr->AsBinaryDoubleOp();
+      copy = new (Z) BinaryDoubleOpInstr(
+          op->op_kind(), RenamedValue(op->left()), RenamedValue(op->right()),
+          op->deopt_id(), op->source(), op->representation());
+      break;
+    }
+    case Instruction::kUnaryDoubleOp: {
+      UnaryDoubleOpInstr* op = instr->AsUnaryDoubleOp();
+      copy = new (Z)
+          UnaryDoubleOpInstr(op->op_kind(), RenamedValue(op->value()),
+                             op->deopt_id(), op->representation());
+      break;
+    }
+    case Instruction::kIntConverter: {
+      IntConverterInstr* converter = instr->AsIntConverter();
+      copy = new (Z) IntConverterInstr(converter->from(), converter->to(),
+                                       RenamedValue(converter->value()));
+      break;
+    }
+    case Instruction::kDoubleToFloat:
+      copy = new (Z)
+          DoubleToFloatInstr(RenamedValue(instr->AsDoubleToFloat()->value()),
+                             instr->deopt_id());
+      break;
+    case Instruction::kFloatToDouble:
+      copy = new (Z)
+          FloatToDoubleInstr(RenamedValue(instr->AsFloatToDouble()->value()),
+                             instr->deopt_id());
+      break;
+    case Instruction::kInt64ToDouble:
+      copy = new (Z)
+          Int64ToDoubleInstr(RenamedValue(instr->AsInt64ToDouble()->value()),
+                             instr->deopt_id());
+      break;
+    default: {
+      UnboxInstr* unbox = instr->AsUnbox();
+      ASSERT(unbox != nullptr);
+      copy = UnboxInstr::Create(unbox->representation(),
+                                RenamedValue(unbox->value()),
+                                unbox->deopt_id(), unbox->value_mode());
+      break;
+    }
+  }
+  if (Definition* def = instr->AsDefinition()) {
+    Definition* copy_def = copy->AsDefinition();
+    // The copy computes the values of some iterations of the original.
+    if (def->range() != nullptr && copy_def->range() == nullptr) {
+      copy_def->set_range(*def->range());
+    }
+    Emit(copy_def);
+    renaming_.Update({def, copy_def});
+  } else {
+    EmitEffect(copy);
+  }
+}
+
+void CountedLoop::Unroll(intptr_t factor) {
+  Skeleton skeleton = BuildSkeleton(factor);
+
+  GrowableArray<PhiInstr*> phis;
+  GrowableArray<PhiInstr*> copies;
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    PhiInstr* copy = NewPhi(skeleton.header, phi->representation(),
+                            *phi->Type(), phi->range());
+    SetPhiInput(copy, 0, InitialValue(phi));
+    renaming_.Insert({phi, copy});
+    phis.Add(phi);
+    copies.Add(copy);
+  }
+  EmitLoopHeader(skeleton, Rename(index_));
+
+  cursor_ = skeleton.body;
+  GrowableArray<Definition*> next_values;
+  for (intptr_t i = 0; i < factor; ++i) {
+    for (Instruction* instr : body_) {
+      if (i == 0 || !IsInvariant(instr)) {
+        EmitScalar(instr);
+      }
+    }
+    // Advance all header phis to the next iteration at once.
+    next_values.Clear();
+    for (PhiInstr* phi : phis) {
+      next_values.Add(Rename(BackValue(phi)));
+    }
+    for (intptr_t j = 0; j < phis.length(); ++j) {
+      renaming_.Update({phis[j], next_values[j]});
+    }
+  }
+  AppendGoto(skeleton.body, cursor_, skeleton.header);
+  AppendGoto(skeleton.exit, skeleton.exit, skeleton.join);
+  for (intptr_t j = 0; j < phis.length(); ++j) {
+    SetPhiInput(copies[j], 1, next_values[j]);
+    LinkToOriginalLoop(skeleton, phis[j], copies[j]);
+  }
+}
+
+Definition* CountedLoop::Splat(Definition* def) {
+  Definition* splat = splats_.LookupValue(def);
+  if (splat != nullptr) {
+    return splat;
+  }
+  // Values from outside the loop are broadcast once before the main loop.
+  auto emit = [&](Definition* instr) {
+    if (InLoop(def)) {
+      return Emit(instr);
+    }
+    flow_graph_->InsertBefore(entry_->last_instruction(), instr, nullptr,
+                              FlowGraph::kValue);
+    return instr;
+  };
+  Definition* value = Rename(def);
+  if (element_kind_ == ElementKind::kFloat64) {
+    splat = emit(SimdOpInstr::Create(SimdOpInstr::kFloat64x2Splat,
+                                     {new (Z) Value(value)}, DeoptId::kNone));
+  } else {
+    if (value->representation() != kUnboxedInt32) {
+      value = emit(new (Z) IntConverterInstr(
+          value->representation(), kUnboxedInt32, new (Z) Value(value)));
+    }
+    splat = emit(SimdOpInstr::Create(
+        SimdOpInstr::kInt32x4FromInts,
+        {new (Z) Value(value), new (Z) Value(value), new (Z) Value(value),
+         new (Z) Value(value)},
+        DeoptId::kNone));
+  }
+  splats_.Insert({def, splat});
+  return splat;
+}
+
+Definition* CountedLoop::VectorValue(Definition* def) {
+  if (ShapeOf(def) == Shape::kInvariant) {
+    return Splat(def);
+  }
+  ASSERT(ShapeOf(def) == Shape::kVector);
+  return Rename(def);
+}
+
+void CountedLoop::EmitVector(Instruction* instr) {
+  Definition* vector = nullptr;
+  switch (instr->tag()) {
+    case Instruction::kLoadIndexed: {
+      LoadIndexedInstr* load = instr->AsLoadIndexed();
+      vector = new (Z) LoadIndexedInstr(
+          RenamedValue(load->array()), new (Z) Value(Rename(index_)),
+          /*index_unboxed=*/true, load->index_scale(),
+          VectorTypedDataCid(load->class_id()), kAlignedAccess,
+          DeoptId::kNone, load->source());
+      break;
+    }
+    case Instruction::kStoreIndexed: {
+      StoreIndexedInstr* store = instr->AsStoreIndexed();
+      EmitEffect(new (Z) StoreIndexedInstr(
+          RenamedValue(store->array()), new (Z) Value(Rename(index_)),
+          VectorOperand(store->value()), kNoStoreBarrier,
+          /*index_unboxed=*/true, store->index_scale(),
+          VectorTypedDataCid(store->class_id()), kAlignedAccess,
+          DeoptId::kNone, store->source()));
+      return;
+    }
+    case Instruction::kBinaryDoubleOp: {
+      BinaryDoubleOpInstr* op = instr->AsBinaryDoubleOp();
+      vector = SimdOpInstr::Create(
+          Float64x2OpFor(op->op_kind()),
+          {VectorOperand(op->left()), VectorOperand(op->right())},
+          DeoptId::kNone);
+      break;
+    }
+    case Instruction::kUnaryDoubleOp: {
+      UnaryDoubleOpInstr* op = instr->AsUnaryDoubleOp();
+      if (op->op_kind() == Token::kSQUARE) {
+        vector = SimdOpInstr::Create(
+            SimdOpInstr::kFloat64x2Mul,
+            {VectorOperand(op->value()), VectorOperand(op->value())},
+            DeoptId::kNone);
+      } else {
+        vector = SimdOpInstr::Create(Float64x2OpFor(op->op_kind()),
+                                     {VectorOperand(op->value())},
+                                     DeoptId::kNone);
+      }
+      break;
+    }
+    case Instruction::kBinaryInt32Op:
+    case Instruction::kBinaryUint32Op:
+    case Instruction::kBinaryInt64Op: {
+      BinaryIntegerOpInstr* op = instr->AsBinaryIntegerOp();
+      vector = SimdOpInstr::Create(
+          Int32x4OpFor(op->op_kind()),
+          {VectorOperand(op->left()), VectorOperand(op->right())},
+          DeoptId::kNone);
+      break;
+    }
+    case Instruction::kIntConverter: {
+      // All integer lanes are 32 bits wide.
+      renaming_.Update(
+          {instr->AsDefinition(),
+           VectorValue(instr->AsIntConverter()->value()->definition())});
+      return;
+    }
+    default:
+      UNREACHABLE();
+  }
+  Emit(vector);
+  renaming_.Update({instr->AsDefinition(), vector});
+}
+
+void CountedLoop::Vectorize() {
+  intptr_t copies = 1;
+  if (FLAG_loop_unrolling &&
+      body_.length() * FLAG_loop_unroll_factor / lanes_ <=
+          FLAG_loop_unroll_max_size) {
+    copies = Utils::Maximum<intptr_t>(1, FLAG_loop_unroll_factor / lanes_);
+  }
+  const intptr_t width = lanes_ * copies;
+  Skeleton skeleton = BuildSkeleton(width);
+
+  PhiInstr* index = NewPhi(skeleton.header, kUnboxedInt64, *index_->Type(),
+                           index_->range());
+  SetPhiInput(index, 0, InitialValue(index_));
+  for (auto& reduction : reductions_) {
+    const double identity = reduction.op->op_kind() == Token::kADD ? -0.0 : 1.0;
+    Definition* identity_splat = SimdOpInstr::Create(
+        SimdOpInstr::kFloat64x2Splat,
+        {new (Z) Value(flow_graph_->GetConstant(
+            Double::ZoneHandle(Z, Double::NewCanonical(identity)),
+            kUnboxedDouble))},
+        DeoptId::kNone);
+    flow_graph_->InsertBefore(entry_->last_instruction(), identity_splat,
+                              nullptr, FlowGraph::kValue);
+    reduction.vector_phi =
+        NewPhi(skeleton.header, kUnboxedFloat64x2,
+               CompileType::FromCid(kFloat64x2Cid), nullptr);
+    SetPhiInput(reduction.vector_phi, 0, identity_splat);
+    renaming_.Insert({reduction.phi, reduction.vector_phi});
+  }
+  EmitLoopHeader(skeleton, index);
+
+  cursor_ = skeleton.body;
+  for (intptr_t i = 0; i < copies; ++i) {
+    Definition* element_index = index;
+    if (i > 0) {
+      element_index = Emit(new (Z) BinaryInt64OpInstr(
+          Token::kADD, new (Z) Value(index),
+          new (Z) Value(IntConstant(i * lanes_)), DeoptId::kNone));
+    }
+    renaming_.Update({index_, element_index});
+    for (Instruction* instr : body_) {
+      if (instr == increment_) continue;
+      const Shape shape = shapes_.LookupValue(instr);
+      if (shape == Shape::kInvariant) {
+        if (i == 0) EmitScalar(instr);
+      } else if (shape == Shape::kVector) {
+        EmitVector(instr);
+      }
+    }
+    for (auto& reduction : reductions_) {
+      renaming_.Update({reduction.phi, Rename(reduction.op)});
+    }
+  }
+  Definition* next_index = Emit(new (Z) BinaryInt64OpInstr(
+      Token::kADD, new (Z) Value(index), new (Z) Value(IntConstant(width)),
+      DeoptId::kNone));
+  SetPhiInput(index, 1, next_index);
+  for (auto& reduction : reductions_) {
+    SetPhiInput(reduction.vector_phi, 1, Rename(reduction.phi));
+  }
+  AppendGoto(skeleton.body, cursor_, skeleton.header);
+
+  // Combine the lanes of the reductions.
+  cursor_ = skeleton.exit;
+  GrowableArray<Definition*> results;
+  for (auto& reduction : reductions_) {
+    Definition* result = InitialValue(reduction.phi);
+    for (auto lane :
+         {SimdOpInstr::kFloat64x2GetX, SimdOpInstr::kFloat64x2GetY}) {
+      Definition* element = Emit(SimdOpInstr::Create(
+          lane, {new (Z) Value(reduction.vector_phi)}, DeoptId::kNone));
+      result = Emit(new (Z) BinaryDoubleOpInstr(
+          reduction.op->op_kind(), new (Z) Value(result),
+          new (Z) Value(element), DeoptId::kNone, reduction.op->source()));
+    }
+    results.Add(result);
+  }
+  AppendGoto(skeleton.exit, cursor_, skeleton.join);
+
+  LinkToOriginalLoop(skeleton, index_, index);
+  for (intptr_t i = 0; i < reductions_.length(); ++i) {
+    LinkToOriginalLoop(skeleton, reductions_[i].phi, results[i]);
+  }
+}
+
+void LoopOptimizer::Optimize(FlowGraph* flow_graph) {
+  if (!FLAG_loop_unrolling && !FLAG_loop_vectorization) {
+    return;
+  }
+  const LoopHierarchy& loop_hierarchy = flow_graph->GetLoopHierarchy();
+  if (loop_hierarchy.num_loops() == 0) {
+    return;
+  }
+  loop_hierarchy.ComputeInduction();
+
+  // Analyze all innermost loops before changing the flow graph.
+  GrowableArray<CountedLoop*> loops;
+  const auto& headers = loop_hierarchy.headers();
+  for (intptr_t i = 0; i < headers.length(); ++i) {
+    LoopInfo* loop = headers[i]->loop_info();
+    if (loop->inner() != nullptr) continue;
+    CountedLoop* counted_loop =
+        new (flow_graph->zone()) CountedLoop(flow_graph, loop);
+    if (counted_loop->Analyze()) {
+      loops.Add(counted_loop);
+    }
+  }
+
+  bool changed = false;
+  for (CountedLoop* loop : loops) {
+    changed = loop->Transform() || changed;
+  }
+  if (changed) {
+    flow_graph->DiscoverBlocks();
+    GrowableArray<BitVector*> dominance_frontier;
+    flow_graph->ComputeDominators(&dominance_frontier);
+  }
+}
+
+#undef Z
+
+}  // namespace dart
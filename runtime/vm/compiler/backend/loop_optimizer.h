@@ -0,0 +1,49 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_OPTIMIZER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_OPTIMIZER_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class FlowGraph;
+
+// Unrolls and vectorizes innermost counted loops
+//
+//     for (i = start; i < limit; i++) { body(i) }
+//
+// whose body is a straight line sequence of typed data accesses and
+// arithmetic. Such a loop is rewritten into
+//
+//     if (limit >= start + W && guards) {
+//       for (; i < limit - (W - 1); i += W) { body(i .. i + W - 1) }
+//     }
+//     for (; i < limit; i++) { body(i) }
+//
+// where the main loop handles W elements per iteration, either by repeating
+// the body (unrolling) or by computing with Float64x2 or Int32x4 values
+// instead of the elements of Float64List, Int32List or Uint32List arrays
+// (vectorization). The original loop is kept to handle the remaining
+// iterations, or all of them if the guards fail. The guards ensure that
+// bounds checks of the loop index can be left out of the main loop and that
+// a vector store cannot overwrite elements that the scalar loop would read
+// in a later iteration.
+//
+// Floating point reductions (e.g. sums) are only vectorized with
+// --loop_vectorization_reassociate, as adding up the elements in a different
+// order may change the result.
+class LoopOptimizer : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_OPTIMIZER_H_
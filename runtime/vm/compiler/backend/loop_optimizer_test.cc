@@ -0,0 +1,230 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_optimizer.h"
+
+#include <functional>
+
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER)
+
+DECLARE_FLAG(bool, loop_vectorization_reassociate);
+
+static bool SupportsVectorization() {
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+  return FlowGraphCompiler::SupportsUnboxedSimd128();
+#else
+  return false;
+#endif
+}
+
+static intptr_t CountInstructions(
+    FlowGraph* flow_graph,
+    const std::function<bool(Instruction*)>& predicate) {
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (predicate(it.Current())) {
+        ++count;
+      }
+    }
+  }
+  return count;
+}
+
+static intptr_t CountSimdOps(FlowGraph* flow_graph, SimdOpInstr::Kind kind) {
+  return CountInstructions(flow_graph, [&](Instruction* instr) {
+    return instr->IsSimdOp() && instr->AsSimdOp()->kind() == kind;
+  });
+}
+
+static intptr_t CountLoads(FlowGraph* flow_graph) {
+  return CountInstructions(
+      flow_graph, [&](Instruction* instr) { return instr->IsLoadIndexed(); });
+}
+
+static intptr_t CountStores(FlowGraph* flow_graph) {
+  return CountInstructions(
+      flow_graph, [&](Instruction* instr) { return instr->IsStoreIndexed(); });
+}
+
+static const TypedData& NewFloat64List(intptr_t length) {
+  const auto& list =
+      TypedData::Handle(TypedData::New(kTypedDataFloat64ArrayCid, length));
+  for (intptr_t i = 0; i < length; ++i) {
+    list.SetFloat64(i * sizeof(double), static_cast<double>(i));
+  }
+  return list;
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_LoopOptimizer_Float64Map) {
+  const char* kScript = R"(
+      import 'dart:typed_data';
+
+      void scale(Float64List a, Float64List b, double c) {
+        final n = a.length;
+        for (int i = 0; i < n; i++) {
+          a[i] = b[i] * c;
+        }
+      }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "scale"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  if (SupportsVectorization()) {
+    EXPECT(CountSimdOps(flow_graph, SimdOpInstr::kFloat64x2Mul) > 0);
+    EXPECT(CountInstructions(flow_graph, [&](Instruction* instr) {
+             return instr->IsStoreIndexed() &&
+                    instr->AsStoreIndexed()->class_id() ==
+                        kTypedDataFloat64x2ArrayCid;
+           }) > 0);
+  } else {
+    // Unrolled main loop and the original loop.
+    EXPECT(CountStores(flow_graph) > 2);
+  }
+
+  pipeline.CompileGraphAndAttachFunction();
+
+  // An odd length leaves iterations for the original loop.
+  const intptr_t kLength = 11;
+  const auto& a = NewFloat64List(kLength);
+  const auto& b = NewFloat64List(kLength);
+  const auto& arguments = Array::Handle(Array::New(3));
+  arguments.SetAt(0, a);
+  arguments.SetAt(1, b);
+  arguments.SetAt(2, Double::Handle(Double::New(2.0)));
+  const auto& result =
+      Object::Handle(DartEntry::InvokeFunction(function, arguments));
+  EXPECT(!result.IsError());
+  for (intptr_t i = 0; i < kLength; ++i) {
+    EXPECT_EQ(2.0 * i, a.GetFloat64(i * sizeof(double)));
+  }
+
+  // Views may share their payload with [b], so they are handled by the
+  // original loop: each element is twice the previous one.
+  b.SetFloat64(0, 1.0);
+  const auto& view = TypedDataView::Handle(TypedDataView::New(
+      kTypedDataFloat64ArrayViewCid, b, sizeof(double), kLength - 1));
+  arguments.SetAt(0, view);
+  const auto& result2 =
+      Object::Handle(DartEntry::InvokeFunction(function, arguments));
+  EXPECT(!result2.IsError());
+  for (intptr_t i = 0; i < kLength - 1; ++i) {
+    EXPECT_EQ(static_cast<double>(2 << i),
+              b.GetFloat64((i + 1) * sizeof(double)));
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_LoopOptimizer_Float64Sum) {
+  const char* kScript = R"(
+      import 'dart:typed_data';
+
+      double sum(Float64List a) {
+        final n = a.length;
+        double result = 0.0;
+        for (int i = 0; i < n; i++) {
+          result += a[i];
+        }
+        return result;
+      }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "sum"));
+  const intptr_t kLength = 11;
+  const auto& arguments = Array::Handle(Array::New(1));
+  arguments.SetAt(0, NewFloat64List(kLength));
+  auto& result = Object::Handle();
+
+  {
+    // Reductions are unrolled, but not vectorized by default.
+    TestPipeline pipeline(function, CompilerPass::kAOT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    EXPECT_EQ(0, CountSimdOps(flow_graph, SimdOpInstr::kFloat64x2Add));
+    EXPECT(CountLoads(flow_graph) > 2);
+
+    pipeline.CompileGraphAndAttachFunction();
+    result = DartEntry::InvokeFunction(function, arguments);
+    EXPECT(result.IsDouble());
+    EXPECT_EQ(55.0, Double::Cast(result).value());
+  }
+
+  {
+    SetFlagScope<bool> sfs(&FLAG_loop_vectorization_reassociate, true);
+    TestPipeline pipeline(function, CompilerPass::kAOT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    if (SupportsVectorization()) {
+      EXPECT(CountSimdOps(flow_graph, SimdOpInstr::kFloat64x2Add) > 0);
+      EXPECT(CountSimdOps(flow_graph, SimdOpInstr::kFloat64x2GetY) > 0);
+    }
+
+    pipeline.CompileGraphAndAttachFunction();
+    result = DartEntry::InvokeFunction(function, arguments);
+    EXPECT(result.IsDouble());
+    EXPECT_EQ(55.0, Double::Cast(result).value());
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_LoopOptimizer_Int32Add) {
+  const char* kScript = R"(
+      import 'dart:typed_data';
+
+      void add(Int32List a, Int32List b, int c) {
+        final n = a.length;
+        for (int i = 0; i < n; i++) {
+          a[i] = b[i] + c;
+        }
+      }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "add"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  if (SupportsVectorization()) {
+    EXPECT(CountSimdOps(flow_graph, SimdOpInstr::kInt32x4Add) > 0);
+    EXPECT(CountSimdOps(flow_graph, SimdOpInstr::kInt32x4FromInts) > 0);
+  }
+
+  pipeline.CompileGraphAndAttachFunction();
+
+  const intptr_t kLength = 13;
+  const auto& a =
+      TypedData::Handle(TypedData::New(kTypedDataInt32ArrayCid, kLength));
+  const auto& b =
+      TypedData::Handle(TypedData::New(kTypedDataInt32ArrayCid, kLength));
+  for (intptr_t i = 0; i < kLength; ++i) {
+    b.SetInt32(i * sizeof(int32_t), kMaxInt32 - i);
+  }
+  const auto& arguments = Array::Handle(Array::New(3));
+  arguments.SetAt(0, a);
+  arguments.SetAt(1, b);
+  arguments.SetAt(2, Integer::Handle(Integer::New(1)));
+  const auto& result =
+      Object::Handle(DartEntry::InvokeFunction(function, arguments));
+  EXPECT(!result.IsError());
+  // Elements wrap around like 32-bit integers.
+  for (intptr_t i = 0; i < kLength; ++i) {
+    EXPECT_EQ(static_cast<int32_t>(static_cast<uint32_t>(kMaxInt32 - i) + 1),
+              a.GetInt32(i * sizeof(int32_t)));
+  }
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
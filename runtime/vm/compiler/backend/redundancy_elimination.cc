@@ -8,6 +8,7 @@
 
 #include "vm/bit_vector.h"
 #include "vm/class_id.h"
+#include "vm/compiler/aot/escape_summaries.h"
 #include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/backend/il.h"
 #include "vm/compiler/backend/il_printer.h"
@@ -1114,6 +1115,10 @@ class AliasedSet : public ZoneAllocated {
           HasLoadsFromPlace(instr->Cast<Definition>(), place)) {
         return true;
       }
+      // A call which only reads the object can load from any of its places.
+      if (EscapeSummaries::IsReadOnlyArgument(use)) {
+        return true;
+      }
       bool is_load = false, is_store;
       Place load_place(graph_, instr, &is_load, &is_store);
 
@@ -1148,6 +1153,11 @@ class AliasedSet : public ZoneAllocated {
     for (Value* use = defn->input_use_list(); use != nullptr;
          use = use->next_use()) {
       Instruction* instr = use->instruction();
+      if (EscapeSummaries::IsReadOnlyArgument(use)) {
+        // The callee neither writes the object nor lets it escape. Values
+        // stored into the object escape instead (see HasLoadsFromPlace).
+        continue;
+      }
       if (instr->HasUnknownSideEffects() ||
           (instr->IsLoadField() &&
            instr->AsLoadField()->MayCreateUntaggedAlias()) ||
@@ -3425,7 +3435,10 @@ static bool IsSupportedAllocation(Instruction* instr) {
 //     - store into another object is only safe if the other object is
 //       an allocation candidate.
 //     - use as input to another allocation is only safe if the other allocation
-//       is a candidate.
+//       is a candidate;
+//     - use as an argument of a static call is safe if the callee only reads
+//       the object (see EscapeSummaries). The object is then allocated right
+//       before the call instead (see AllocateObjectsForCalls).
 //
 // We use a simple fix-point algorithm to discover the set of valid candidates
 // (see CollectCandidates method), that's why this IsSafeUse can operate in two
@@ -3494,6 +3507,10 @@ bool AllocationSinking::IsSafeUse(Value* use, SafeUseCheck check_type) {
     return true;
   }
 
+  if (use->instruction()->IsStaticCall()) {
+    return EscapeSummaries::IsReadOnlyArgument(use);
+  }
+
   return false;
 }
 
@@ -3502,6 +3519,7 @@ bool AllocationSinking::IsSafeUse(Value* use, SafeUseCheck check_type) {
 // instructions that write into fields of the allocated object.
 bool AllocationSinking::IsAllocationSinkingCandidate(Definition* alloc,
                                                      SafeUseCheck check_type) {
+  bool is_passed_to_calls = false;
   for (Value* use = alloc->input_use_list(); use != nullptr;
        use = use->next_use()) {
     if (!IsSafeUse(use, check_type)) {
@@ -3512,9 +3530,12 @@ bool AllocationSinking::IsAllocationSinkingCandidate(Definition* alloc,
       }
       return false;
     }
+    if (use->instruction()->IsStaticCall()) {
+      is_passed_to_calls = true;
+    }
   }
 
-  return true;
+  return !is_passed_to_calls || CanAllocateBeforeCall(alloc);
 }
 
 // If the given use is a store into an object then return an object we are
@@ -3532,6 +3553,56 @@ static Definition* StoreDestination(Value* use) {
   return nullptr;
 }
 
+// Objects passed to calls are allocated right before the calls (see
+// AllocateObjectsForCalls). Only do this for objects which are not stored
+// into other objects and have no other allocations stored into them, so that
+// no other materializations refer to them or are referred to by them, and
+// which are passed to a single call that does not run more often than the
+// original allocation.
+bool AllocationSinking::CanAllocateBeforeCall(Definition* alloc) {
+  if (auto* const instr = alloc->AsAllocateObject()) {
+    const intptr_t cid = instr->cls().id();
+    if (IsTypedDataViewClassId(cid) ||
+        IsUnmodifiableTypedDataViewClassId(cid) ||
+        IsExternalPayloadClassId(cid)) {
+      return false;
+    }
+  } else if (!alloc->IsAllocateClosure() && !alloc->IsAllocateRecord() &&
+             !alloc->IsAllocateSmallRecord()) {
+    return false;
+  }
+
+  for (intptr_t i = 0; i < alloc->InputCount(); i++) {
+    if (IsSupportedAllocation(alloc->InputAt(i)->definition())) {
+      return false;
+    }
+  }
+
+  Instruction* call = nullptr;
+  for (Value* use = alloc->input_use_list(); use != nullptr;
+       use = use->next_use()) {
+    Instruction* const instr = use->instruction();
+    if (instr->IsStaticCall()) {
+      if ((call != nullptr) && (call != instr)) {
+        return false;
+      }
+      call = instr;
+    } else if (StoreDestination(use) != alloc) {
+      return false;
+    } else if (auto* const store = instr->AsStoreField()) {
+      if (IsSupportedAllocation(store->value()->definition())) {
+        return false;
+      }
+    }
+  }
+  ASSERT(call != nullptr);
+
+  // Every loop containing the call has to contain the allocation as well.
+  flow_graph_->GetLoopHierarchy();
+  LoopInfo* const loop = call->GetBlock()->loop_info();
+  return (loop == nullptr) || loop->Contains(alloc->GetBlock());
+}
+
 // If the given instruction is a load from an object, then return an object
 // we are loading from.
 static Definition* LoadSource(Definition* instr) {
@@ -3852,6 +3923,8 @@ void AllocationSinking::Optimize() {
     EliminateAllocation(candidates_[i]);
   }
 
+  AllocateObjectsForCalls();
+
   // Process materializations and unbox their arguments: materializations
   // are part of the environment and can materialize boxes for double/mint/simd
   // values when needed.
@@ -4029,6 +4102,13 @@ void AllocationSinking::CreateMaterializationAt(
   // We must preserve the identity: all mentions are replaced by the same
   // materialization.
   exit->ReplaceInEnvironment(alloc, mat);
+  if (exit->IsStaticCall()) {
+    for (intptr_t i = 0; i < exit->InputCount(); i++) {
+      if (exit->InputAt(i)->definition() == alloc) {
+        exit->InputAt(i)->BindTo(mat);
+      }
+    }
+  }
 
   // Mark MaterializeObject as an environment use of this allocation.
   // This will allow us to discover it when we are looking for deoptimization
@@ -4073,9 +4153,13 @@ void AllocationSinking::ExitsCollector::Collect(Definition* alloc) {
   // Check if this allocation is stored into any other allocation sinking
   // candidate and put it on worklist so that we conservatively collect all
   // exits for that candidate as well because they potentially might see
-  // this object.
+  // this object. Calls the allocation is passed to need it materialized too.
   for (Value* use = alloc->input_use_list(); use != nullptr;
        use = use->next_use()) {
+    if (use->instruction()->IsStaticCall()) {
+      AddInstruction(&exits_, use->instruction());
+      continue;
+    }
     Definition* obj = StoreDestination(use);
     if ((obj != nullptr) && (obj != alloc)) {
       AddInstruction(&worklist_, obj);
@@ -4160,6 +4244,98 @@ void AllocationSinking::InsertMaterializations(Definition* alloc) {
   }
 }
 
+// Materializations passed to calls describe objects which the callees read,
+// so these objects have to exist. Replace each of these materializations with
+// an allocation of the object right before the call, initialized with the
+// materialized values. Other paths through the function still don't allocate
+// the object, but the object is allocated each time the call runs. Callees
+// small enough to be inlined instead are (see
+// --inlining-read-only-allocation-size-threshold), after which the object is
+// not allocated at all.
+void AllocationSinking::AllocateObjectsForCalls() {
+  intptr_t j = 0;
+  for (intptr_t i = 0; i < materializations_.length(); i++) {
+    MaterializeObjectInstr* mat = materializations_[i];
+    bool is_passed_to_calls = false;
+    for (Value* use = mat->input_use_list(); use != nullptr;
+         use = use->next_use()) {
+      if (use->instruction()->IsStaticCall()) {
+        is_passed_to_calls = true;
+        break;
+      }
+    }
+    if (!is_passed_to_calls) {
+      if (j != i) {
+        materializations_[j] = mat;
+      }
+      j++;
+      continue;
+    }
+
+    AllocationInstr* const alloc = mat->allocation();
+    auto value_for = [&](const Slot& slot) -> Value* {
+      for (intptr_t k = 0; k < mat->InputCount(); k++) {
+        if (mat->SlotAt(k).IsIdentical(slot)) {
+          return new (Z) Value(mat->InputAt(k)->definition());
+        }
+      }
+      UNREACHABLE();
+      return nullptr;
+    };
+    auto input_at = [&](intptr_t pos) -> Value* {
+      return (pos < alloc->InputCount()) ? value_for(*alloc->SlotForInput(pos))
+                                         : nullptr;
+    };
+
+    AllocationInstr* allocation = nullptr;
+    if (auto* const instr = alloc->AsAllocateObject()) {
+      allocation = new (Z)
+          AllocateObjectInstr(instr->source(), instr->cls(), instr->deopt_id(),
+                              input_at(AllocateObjectInstr::kTypeArgumentsPos));
+    } else if (auto* const instr = alloc->AsAllocateClosure()) {
+      allocation = new (Z) AllocateClosureInstr(
+          instr->source(), input_at(AllocateClosureInstr::kFunctionPos),
+          input_at(AllocateClosureInstr::kContextPos),
+          input_at(AllocateClosureInstr::kInstantiatorTypeArgsPos),
+          instr->is_generic(), instr->is_tear_off(), instr->deopt_id());
+    } else if (auto* const instr = alloc->AsAllocateRecord()) {
+      allocation = new (Z) AllocateRecordInstr(instr->source(), instr->shape(),
+                                               instr->deopt_id());
+    } else if (auto* const instr = alloc->AsAllocateSmallRecord()) {
+      allocation = new (Z) AllocateSmallRecordInstr(
+          instr->source(), instr->shape(), input_at(0), input_at(1),
+          input_at(2), instr->deopt_id());
+    } else {
+      UNREACHABLE();
+    }
+    flow_graph_->InsertBefore(mat, allocation, nullptr, FlowGraph::kValue);
+
+    // Initialize the remaining fields. Fields which are not materialized
+    // still have their initial value.
+    for (intptr_t k = 0; k < mat->InputCount(); k++) {
+      const Slot& slot = mat->SlotAt(k);
+      if (allocation->InputForSlot(slot) >= 0) {
+        continue;
+      }
+      auto* const store = new (Z) StoreFieldInstr(
+          slot, new (Z) Value(allocation),
+          new (Z) Value(mat->InputAt(k)->definition()), kEmitStoreBarrier,
+          AccessForSlotInAllocatedObject(alloc, slot), alloc->source(),
+          StoreFieldInstr::Kind::kInitializing);
+      flow_graph_->InsertBefore(mat, store, nullptr, FlowGraph::kEffect);
+    }
+
+    if (FLAG_trace_optimization && flow_graph_->should_print()) {
+      THR_Print("allocating v%" Pd " for calls as v%" Pd "\n",
+                alloc->ssa_temp_index(), allocation->ssa_temp_index());
+    }
+
+    mat->ReplaceUsesWith(allocation);
+    mat->RemoveFromGraph();
+  }
+  materializations_.TruncateTo(j);
+}
+
 // TryCatchAnalyzer tries to reduce the state that needs to be synchronized
 // on entry to the catch by discovering Parameter-s which are never used
 // or which are always constant.
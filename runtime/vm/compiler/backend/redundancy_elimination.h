@@ -74,12 +74,16 @@ class AllocationSinking : public ZoneAllocated {
 
   void EliminateAllocation(Definition* alloc);
 
+  void AllocateObjectsForCalls();
+
   enum SafeUseCheck { kOptimisticCheck, kStrictCheck };
 
   bool IsAllocationSinkingCandidate(Definition* alloc, SafeUseCheck check_type);
 
   bool IsSafeUse(Value* use, SafeUseCheck check_type);
 
+  bool CanAllocateBeforeCall(Definition* alloc);
+
   Zone* zone() const { return flow_graph_->zone(); }
 
   FlowGraph* flow_graph_;
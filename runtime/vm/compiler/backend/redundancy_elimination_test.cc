@@ -26,6 +26,10 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, inlining_callee_call_sites_threshold);
+DECLARE_FLAG(int, inlining_read_only_allocation_size_threshold);
+DECLARE_FLAG(int, inlining_size_threshold);
+
 static void NoopNative(Dart_NativeArguments args) {}
 
 static Dart_NativeFunction NoopNativeLookup(Dart_Handle name,
@@ -1563,6 +1567,366 @@ ISOLATE_UNIT_TEST_CASE(DelayAllocations_DontDelayIntoLoop) {
   EXPECT(call->Receiver()->definition() == allocate);
 }
 
+#if defined(DART_PRECOMPILER)
+
+static const char* kReadOnlyCallScript = R"(
+    class Box {
+      int value;
+      Box(this.value);
+    }
+
+    @pragma('vm:never-inline')
+    int read(Box b) => b.value;
+
+    @pragma('vm:never-inline')
+    int increment(Box b) => b.value++;
+
+    int readTwice(int v) {
+      final b = Box(v);
+      final r = read(b);
+      return r + b.value;
+    }
+
+    int incrementTwice(int v) {
+      final b = Box(v);
+      final r = increment(b);
+      return r + b.value;
+    }
+
+    int maybeRead(int v, bool c) {
+      final b = Box(v);
+      b.value = b.value + 1;
+      if (c) return read(b);
+      return b.value;
+    }
+
+    @pragma('vm:never-inline')
+    bool isNull(Object? o) => o == null;
+
+    int maybeCheckClosure(int v, bool c) {
+      final f = () => 0;
+      if (c) return isNull(f) ? 0 : v + 1;
+      return v + 1;
+    }
+
+    @pragma('vm:never-inline')
+    int first((int, int) r) => r.$1;
+
+    int maybeFirst(int v, bool c) {
+      final r = (v, v + 1);
+      if (c) return first(r) + 1;
+      return v + 1;
+    }
+
+    int readInLoop(int v, int n) {
+      final b = Box(v);
+      var sum = 0;
+      for (var i = 0; i < n; i++) {
+        sum += read(b);
+      }
+      return sum;
+    }
+)";
+
+// Finds the only allocation in [flow_graph] for which [is_allocation] holds
+// and the static call to [callee].
+static void FindAllocationAndCall(
+    FlowGraph* flow_graph,
+    std::function<bool(Instruction*)> is_allocation,
+    const char* callee,
+    Definition** allocation,
+    StaticCallInstr** call) {
+  *allocation = nullptr;
+  *call = nullptr;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (is_allocation(it.Current())) {
+        EXPECT(*allocation == nullptr);
+        *allocation = it.Current()->AsDefinition();
+      } else if (auto* static_call = it.Current()->AsStaticCall()) {
+        if (strcmp(static_call->function().UserVisibleNameCString(),
+                   callee) == 0) {
+          *call = static_call;
+        }
+      }
+    }
+  }
+}
+
+// Invokes [function] with [v] and both values of the last argument, which
+// should return 42 either way.
+static void ExpectReturns42OnBothPaths(const Function& function, intptr_t v) {
+  const auto& arguments = Array::Handle(Array::New(2));
+  arguments.SetAt(0, Smi::Handle(Smi::New(v)));
+  auto& result = Object::Handle();
+  arguments.SetAt(1, Bool::True());
+  result = DartEntry::InvokeFunction(function, arguments);
+  EXPECT(result.IsSmi());
+  EXPECT_EQ(42, Smi::Cast(result).Value());
+  arguments.SetAt(1, Bool::False());
+  result = DartEntry::InvokeFunction(function, arguments);
+  EXPECT(result.IsSmi());
+  EXPECT_EQ(42, Smi::Cast(result).Value());
+}
+
+ISOLATE_UNIT_TEST_CASE(LoadOptimizer_ForwardAcrossReadOnlyCall) {
+  const auto& root_library =
+      Library::Handle(LoadTestScript(kReadOnlyCallScript));
+
+  {
+    // [read] does not write [b], so [b.value] is forwarded across the call.
+    const auto& function =
+        Function::Handle(GetFunction(root_library, "readTwice"));
+    TestPipeline pipeline(function, CompilerPass::kAOT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    intptr_t loads = 0;
+    intptr_t stores = 0;
+    CountLoadsStores(flow_graph, &loads, &stores);
+    EXPECT_EQ(0, loads);
+  }
+
+  {
+    // [increment] writes [b.value], so it has to be loaded after the call.
+    const auto& function =
+        Function::Handle(GetFunction(root_library, "incrementTwice"));
+    TestPipeline pipeline(function, CompilerPass::kAOT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    intptr_t loads = 0;
+    intptr_t stores = 0;
+    CountLoadsStores(flow_graph, &loads, &stores);
+    EXPECT_EQ(1, loads);
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(LoadOptimizer_LateInitializerLetsReceiverEscape) {
+  const char* kScript = R"(
+    class Lazy {
+      int value;
+      late final Object x = leak(this);
+      Lazy(this.value);
+    }
+
+    Lazy? leaked;
+
+    @pragma('vm:never-inline')
+    Object leak(Lazy l) {
+      leaked = l;
+      return l;
+    }
+
+    @pragma('vm:never-inline')
+    Object getX(Lazy l) => l.x;
+
+    @pragma('vm:never-inline')
+    void bump() {
+      leaked!.value++;
+    }
+
+    int readAfterLeak(int v) {
+      final l = Lazy(v);
+      getX(l);
+      bump();
+      return l.value;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "readAfterLeak"));
+
+  // The initializer of [x] stores [l] into [leaked], so [l.value] has to be
+  // loaded again after [bump].
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  intptr_t loads = 0;
+  intptr_t stores = 0;
+  CountLoadsStores(flow_graph, &loads, &stores);
+  EXPECT(loads > 0);
+
+  pipeline.CompileGraphAndAttachFunction();
+
+  const auto& arguments = Array::Handle(Array::New(1));
+  arguments.SetAt(0, Smi::Handle(Smi::New(41)));
+  const auto& result =
+      Object::Handle(DartEntry::InvokeFunction(function, arguments));
+  EXPECT(result.IsSmi());
+  EXPECT_EQ(42, Smi::Cast(result).Value());
+}
+
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_ReadOnlyCallArgument) {
+  const auto& root_library =
+      Library::Handle(LoadTestScript(kReadOnlyCallScript));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "maybeRead"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  // [b] is only allocated on the path which calls [read].
+  Definition* allocate = nullptr;
+  StaticCallInstr* call = nullptr;
+  FindAllocationAndCall(
+      flow_graph, [](Instruction* instr) { return instr->IsAllocateObject(); },
+      "read", &allocate, &call);
+  RELEASE_ASSERT(allocate != nullptr);
+  RELEASE_ASSERT(call != nullptr);
+  EXPECT(allocate->GetBlock() == call->GetBlock());
+  EXPECT(call->ArgumentAt(0) == allocate);
+
+  pipeline.CompileGraphAndAttachFunction();
+  ExpectReturns42OnBothPaths(function, 41);
+}
+
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_ReadOnlyCallClosure) {
+  const auto& root_library =
+      Library::Handle(LoadTestScript(kReadOnlyCallScript));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "maybeCheckClosure"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  // [f] is only allocated on the path which calls [isNull].
+  Definition* allocate = nullptr;
+  StaticCallInstr* call = nullptr;
+  FindAllocationAndCall(
+      flow_graph, [](Instruction* instr) { return instr->IsAllocateClosure(); },
+      "isNull", &allocate, &call);
+  RELEASE_ASSERT(allocate != nullptr);
+  RELEASE_ASSERT(call != nullptr);
+  EXPECT(allocate->GetBlock() == call->GetBlock());
+  EXPECT(call->ArgumentAt(0) == allocate);
+
+  pipeline.CompileGraphAndAttachFunction();
+  ExpectReturns42OnBothPaths(function, 41);
+}
+
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_ReadOnlyCallRecord) {
+  const auto& root_library =
+      Library::Handle(LoadTestScript(kReadOnlyCallScript));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "maybeFirst"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  // [r] is only allocated on the path which calls [first].
+  Definition* allocate = nullptr;
+  StaticCallInstr* call = nullptr;
+  FindAllocationAndCall(
+      flow_graph,
+      [](Instruction* instr) {
+        return instr->IsAllocateSmallRecord() || instr->IsAllocateRecord();
+      },
+      "first", &allocate, &call);
+  RELEASE_ASSERT(allocate != nullptr);
+  RELEASE_ASSERT(call != nullptr);
+  EXPECT(allocate->GetBlock() == call->GetBlock());
+  EXPECT(call->ArgumentAt(0) == allocate);
+
+  pipeline.CompileGraphAndAttachFunction();
+  ExpectReturns42OnBothPaths(function, 41);
+}
+
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_ReadOnlyCallInLoop) {
+  const auto& root_library =
+      Library::Handle(LoadTestScript(kReadOnlyCallScript));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "readInLoop"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  // Allocating [b] right before the call would allocate it on every
+  // iteration, so it stays allocated once before the loop.
+  Definition* allocate = nullptr;
+  StaticCallInstr* call = nullptr;
+  FindAllocationAndCall(
+      flow_graph, [](Instruction* instr) { return instr->IsAllocateObject(); },
+      "read", &allocate, &call);
+  RELEASE_ASSERT(allocate != nullptr);
+  RELEASE_ASSERT(call != nullptr);
+  flow_graph->GetLoopHierarchy();
+  EXPECT(allocate->GetBlock()->loop_info() == nullptr);
+  EXPECT(call->GetBlock()->loop_info() != nullptr);
+  EXPECT(call->ArgumentAt(0) == allocate);
+
+  pipeline.CompileGraphAndAttachFunction();
+
+  const auto& arguments = Array::Handle(Array::New(2));
+  arguments.SetAt(0, Smi::Handle(Smi::New(21)));
+  arguments.SetAt(1, Smi::Handle(Smi::New(2)));
+  const auto& result =
+      Object::Handle(DartEntry::InvokeFunction(function, arguments));
+  EXPECT(result.IsSmi());
+  EXPECT_EQ(42, Smi::Cast(result).Value());
+}
+
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_InlineReadOnlyCallee) {
+  const char* kScript = R"(
+    class Box {
+      int value;
+      Box(this.value);
+    }
+
+    @pragma('vm:never-inline')
+    void log() {}
+
+    int readAndLog(Box b) {
+      log();
+      return b.value;
+    }
+
+    int boxAndRead(int v) {
+      final b = Box(v);
+      return readAndLog(b) + 1;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "boxAndRead"));
+
+  // Only inline [readAndLog] because it only reads [b].
+  SetFlagScope<int> sfs_size(&FLAG_inlining_size_threshold, 0);
+  SetFlagScope<int> sfs_call_sites(&FLAG_inlining_callee_call_sites_threshold,
+                                   0);
+
+  {
+    // Once [readAndLog] is inlined, [b] is not allocated at all.
+    TestPipeline pipeline(function, CompilerPass::kAOT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    Definition* allocate = nullptr;
+    StaticCallInstr* call = nullptr;
+    FindAllocationAndCall(
+        flow_graph,
+        [](Instruction* instr) { return instr->IsAllocateObject(); },
+        "readAndLog", &allocate, &call);
+    EXPECT(allocate == nullptr);
+    EXPECT(call == nullptr);
+  }
+
+  {
+    SetFlagScope<int> sfs_read_only(
+        &FLAG_inlining_read_only_allocation_size_threshold, 0);
+    TestPipeline pipeline(function, CompilerPass::kAOT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    Definition* allocate = nullptr;
+    StaticCallInstr* call = nullptr;
+    FindAllocationAndCall(
+        flow_graph,
+        [](Instruction* instr) { return instr->IsAllocateObject(); },
+        "readAndLog", &allocate, &call);
+    RELEASE_ASSERT(allocate != nullptr);
+    RELEASE_ASSERT(call != nullptr);
+    EXPECT(call->ArgumentAt(0) == allocate);
+  }
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
 ISOLATE_UNIT_TEST_CASE(CheckStackOverflowElimination_NoInterruptsPragma) {
   const char* kScript = R"(
     @pragma('vm:unsafe:no-interrupts')
@@ -12,6 +12,7 @@
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/inliner.h"
 #include "vm/compiler/backend/linearscan.h"
+#include "vm/compiler/backend/loop_optimizer.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
@@ -333,6 +334,7 @@ FlowGraph* CompilerPass::RunPipeline(PipelineMode mode,
   // so it should not be lifted earlier than that pass.
   INVOKE_PASS(DCE);
   INVOKE_PASS(Canonicalize);
+  INVOKE_PASS_AOT(OptimizeLoops);
   INVOKE_PASS_AOT(DelayAllocations);
   // Repeat branches optimization after DCE, as it could make more
   // empty blocks.
@@ -489,6 +491,8 @@ COMPILER_PASS(DCE, { DeadCodeElimination::EliminateDeadCode(flow_graph); });
 
 COMPILER_PASS(DelayAllocations, { DelayAllocations::Optimize(flow_graph); });
 
+COMPILER_PASS(OptimizeLoops, { LoopOptimizer::Optimize(flow_graph); });
+
 COMPILER_PASS(AllocationSinking_Sink, {
   // TODO(vegorov): Support allocation sinking with try-catch.
   if (flow_graph->try_entries().is_empty()) {
@@ -53,6 +53,7 @@
   PRECOMPILER_TIMERS_LIST(V)                                                   \
   INLINING_TIMERS_LIST(V)                                                      \
   V(BuildGraph)                                                                \
+  V(ComputeEscapeSummaries)                                                    \
   V(EmitCode)                                                                  \
   V(FinalizeCode)
 
@@ -67,6 +67,11 @@ DEFINE_FLAG(bool,
             false,
             "Print the deopt-id to ICData map in optimizing compiler.");
 DEFINE_FLAG(bool, print_code_source_map, false, "Print code source map.");
+DEFINE_FLAG(int,
+            background_compiler_threads,
+            1,
+            "Maximum number of threads optimizing functions in the background "
+            "for each isolate group.");
 DEFINE_FLAG(bool,
             stress_test_background_compilation,
             false,
@@ -959,109 +964,163 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
       deopt_id, Object::background_compilation_error());
 }
 
+// The usage counter of a function is reset to INT32_MIN once it is enqueued,
+// see OptimizeInvokedFunction. Counters which were not reset count as no
+// calls.
+static int64_t CallsSinceEnqueued(const Function& function) {
+  const int64_t counter = function.usage_counter();
+  return (counter < 0) ? counter - INT32_MIN : 0;
+}
+
 // C-heap allocated background compilation queue element.
 class QueueElement {
  public:
   explicit QueueElement(const Function& function)
-      : next_(nullptr), function_(function.ptr()) {}
+      : function_(function.ptr()),
+        enqueued_micros_(OS::GetCurrentMonotonicMicros()),
+        calls_(CallsSinceEnqueued(function)) {}
 
-  virtual ~QueueElement() {
-    next_ = nullptr;
-    function_ = Function::null();
-  }
+  virtual ~QueueElement() { function_ = Function::null(); }
 
   FunctionPtr Function() const { return function_; }
 
-  void set_next(QueueElement* elem) { next_ = elem; }
-  QueueElement* next() const { return next_; }
-
   ObjectPtr function() const { return function_; }
   ObjectPtr* function_untag() {
     return reinterpret_cast<ObjectPtr*>(&function_);
   }
 
+  int64_t enqueued_micros() const { return enqueued_micros_; }
+
  private:
-  QueueElement* next_;
+  friend class BackgroundCompilationQueue;
+
   FunctionPtr function_;
+  const int64_t enqueued_micros_;
+  // The calls to the function since it was enqueued, as last sampled.
+  int64_t calls_;
+  // The position of the element in the order of enqueuing.
+  intptr_t sequence_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(QueueElement);
 };
 
 // Allocated in C-heap. Handles both input and output of background compilation.
-// It implements a FIFO queue, using Peek, Add, Remove operations.
+// A binary max-heap of the enqueued functions, ordered by how often they were
+// called since they were enqueued, the oldest first among equally hot ones.
+// The calls are sampled from the usage counters when a function is enqueued
+// and resampled for the whole queue at most every kResampleMicros, so
+// removing the hottest function usually takes logarithmic time instead of a
+// scan of the queue with the monitor held.
 class BackgroundCompilationQueue {
  public:
-  BackgroundCompilationQueue() : first_(nullptr), last_(nullptr) {}
+  BackgroundCompilationQueue() : elements_(), next_sequence_(0) {}
   virtual ~BackgroundCompilationQueue() { Clear(); }
 
   void VisitObjectPointers(ObjectPointerVisitor* visitor) {
     ASSERT(visitor != nullptr);
-    QueueElement* p = first_;
-    while (p != nullptr) {
-      visitor->VisitPointer(p->function_untag());
-      p = p->next();
+    for (intptr_t i = 0; i < elements_.length(); i++) {
+      visitor->VisitPointer(elements_[i]->function_untag());
     }
   }
 
-  bool IsEmpty() const { return first_ == nullptr; }
+  bool IsEmpty() const { return elements_.is_empty(); }
+  intptr_t length() const { return elements_.length(); }
 
   void Add(QueueElement* value) {
     ASSERT(value != nullptr);
-    ASSERT(value->next() == nullptr);
-    if (first_ == nullptr) {
-      first_ = value;
-      ASSERT(last_ == nullptr);
-    } else {
-      ASSERT(last_ != nullptr);
-      last_->set_next(value);
-    }
-    last_ = value;
-    ASSERT(first_ != nullptr && last_ != nullptr);
+    value->sequence_ = next_sequence_++;
+    elements_.Add(value);
+    SiftUp(elements_.length() - 1);
   }
 
-  QueueElement* Peek() const { return first_; }
-
-  FunctionPtr PeekFunction() const {
-    QueueElement* e = Peek();
-    if (e == nullptr) {
-      return Function::null();
-    } else {
-      return e->Function();
+  // Removes the element whose function was called most often since it was
+  // enqueued. [function] is used as a scratch handle and holds the removed
+  // function on return.
+  QueueElement* RemoveHottest(Function* function) {
+    ASSERT(!IsEmpty());
+    const int64_t now = OS::GetCurrentMonotonicMicros();
+    if ((last_resampled_micros_ < 0) ||
+        (now - last_resampled_micros_ >= kResampleMicros)) {
+      Resample(function);
+      last_resampled_micros_ = now;
     }
-  }
-
-  QueueElement* Remove() {
-    ASSERT(first_ != nullptr);
-    QueueElement* result = first_;
-    first_ = first_->next();
-    if (first_ == nullptr) {
-      last_ = nullptr;
+    QueueElement* result = elements_[0];
+    elements_.Swap(0, elements_.length() - 1);
+    elements_.RemoveLast();
+    if (!IsEmpty()) {
+      SiftDown(0);
     }
+    *function = result->Function();
     return result;
   }
 
   bool ContainsObj(const Object& obj) const {
-    QueueElement* p = first_;
-    while (p != nullptr) {
-      if (p->function() == obj.ptr()) {
+    for (intptr_t i = 0; i < elements_.length(); i++) {
+      if (elements_[i]->function() == obj.ptr()) {
         return true;
       }
-      p = p->next();
     }
     return false;
   }
 
   void Clear() {
-    while (!IsEmpty()) {
-      QueueElement* e = Remove();
-      delete e;
+    for (intptr_t i = 0; i < elements_.length(); i++) {
+      delete elements_[i];
     }
-    ASSERT((first_ == nullptr) && (last_ == nullptr));
+    elements_.Clear();
   }
 
  private:
-  QueueElement* first_;
-  QueueElement* last_;
+  static constexpr int64_t kResampleMicros = 10 * kMicrosecondsPerMillisecond;
+
+  static bool IsHotter(const QueueElement* a, const QueueElement* b) {
+    if (a->calls_ != b->calls_) {
+      return a->calls_ > b->calls_;
+    }
+    return a->sequence_ < b->sequence_;
+  }
+
+  void SiftUp(intptr_t i) {
+    while (i > 0) {
+      const intptr_t parent = (i - 1) / 2;
+      if (!IsHotter(elements_[i], elements_[parent])) break;
+      elements_.Swap(i, parent);
+      i = parent;
+    }
+  }
+
+  void SiftDown(intptr_t i) {
+    const intptr_t length = elements_.length();
+    while (true) {
+      intptr_t hottest = i;
+      const intptr_t left = 2 * i + 1;
+      const intptr_t right = left + 1;
+      if ((left < length) && IsHotter(elements_[left], elements_[hottest])) {
+        hottest = left;
+      }
+      if ((right < length) && IsHotter(elements_[right], elements_[hottest])) {
+        hottest = right;
+      }
+      if (hottest == i) break;
+      elements_.Swap(i, hottest);
+      i = hottest;
+    }
+  }
+
+  // Samples the calls of all enqueued functions again and restores the heap.
+  void Resample(Function* function) {
+    for (intptr_t i = 0; i < elements_.length(); i++) {
+      *function = elements_[i]->Function();
+      elements_[i]->calls_ = CallsSinceEnqueued(*function);
+    }
+    for (intptr_t i = elements_.length() / 2 - 1; i >= 0; i--) {
+      SiftDown(i);
+    }
+  }
+
+  MallocGrowableArray<QueueElement*> elements_;
+  intptr_t next_sequence_;
+  int64_t last_resampled_micros_ = -1;
 
   DISALLOW_COPY_AND_ASSIGN(BackgroundCompilationQueue);
 };
@@ -1085,8 +1144,10 @@ BackgroundCompiler::BackgroundCompiler(IsolateGroup* isolate_group)
       monitor_(),
       function_queue_(new BackgroundCompilationQueue()),
       running_(false),
-      done_(true),
-      disabled_depth_(0) {}
+      active_threads_(0),
+      disabled_depth_(0),
+      compiling_(0),
+      max_compiling_(0) {}
 
 // Fields all deleted in ::Stop; here clear them.
 BackgroundCompiler::~BackgroundCompiler() {
@@ -1106,26 +1167,42 @@ void BackgroundCompiler::Run() {
     {
       SafepointMonitorLocker ml(&monitor_);
       if (running_ && !function_queue()->IsEmpty()) {
-        element = function_queue()->Remove();
-        function ^= element->function();
+        element = function_queue()->RemoveHottest(&function);
+        UpdateQueueDepthMetric();
+        compiling_++;
+        max_compiling_ = Utils::Maximum(max_compiling_, compiling_);
+#if defined(TESTING)
+        WaitForRendezvousLocked(&ml);
+#endif  // defined(TESTING)
       }
     }
     if (element != nullptr) {
+      const int64_t enqueued_micros = element->enqueued_micros();
       delete element;
       Compiler::CompileOptimizedFunction(thread, function,
                                          Compiler::kNoOSRDeoptId);
+      const int64_t latency =
+          OS::GetCurrentMonotonicMicros() - enqueued_micros;
 
       // If an optimizable method is not optimized, put it back on
       // the background queue (unless it was passed to foreground).
-      if ((!function.HasOptimizedCode() && function.IsOptimizable()) ||
-          FLAG_stress_test_background_compilation) {
-        if (Compiler::CanOptimizeFunction(thread, function)) {
-          SafepointMonitorLocker ml(&monitor_);
-          if (running_) {
-            QueueElement* repeat_qelem = new QueueElement(function);
-            function_queue()->Add(repeat_qelem);
-          }
-        }
+      const bool repeat =
+          ((!function.HasOptimizedCode() && function.IsOptimizable()) ||
+           FLAG_stress_test_background_compilation) &&
+          Compiler::CanOptimizeFunction(thread, function);
+      SafepointMonitorLocker ml(&monitor_);
+      compiling_--;
+      // Attempts which did not install optimized code are not a latency.
+      if (function.HasOptimizedCode()) {
+        isolate_group_->GetBackgroundCompilationLatencyMetric()->set_value(
+            latency);
+        isolate_group_->GetBackgroundCompilationLatencyMaxMetric()->SetValue(
+            latency);
+      }
+      if (repeat && running_) {
+        QueueElement* repeat_qelem = new QueueElement(function);
+        function_queue()->Add(repeat_qelem);
+        UpdateQueueDepthMetric();
       }
     }
   }
@@ -1136,16 +1213,63 @@ void BackgroundCompiler::Run() {
         Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
       // Successfully scheduled a new task.
     } else {
-      // Background compiler done. This notification must happen after the
+      // This thread is done. This notification must happen after the
       // thread leaves to group to avoid a shutdown race with the thread
       // registry.
-      running_ = false;
-      done_ = true;
+      if (--active_threads_ == 0) {
+        running_ = false;
+      }
       ml.NotifyAll();
     }
   }
 }
 
+intptr_t BackgroundCompiler::max_concurrent_compilations() {
+  SafepointMonitorLocker ml(&monitor_);
+  return max_compiling_;
+}
+
+#if defined(TESTING)
+void BackgroundCompiler::set_rendezvous_for_testing(intptr_t count) {
+  SafepointMonitorLocker ml(&monitor_);
+  rendezvous_for_testing_ = count;
+}
+
+void BackgroundCompiler::WaitForRendezvousLocked(SafepointMonitorLocker* ml) {
+  ml->NotifyAll();
+  const int64_t deadline =
+      OS::GetCurrentMonotonicMicros() + kMicrosecondsPerSecond;
+  while (running_ && (compiling_ < rendezvous_for_testing_) &&
+         (OS::GetCurrentMonotonicMicros() < deadline)) {
+    ml->Wait(1);
+  }
+}
+
+ArrayPtr BackgroundCompiler::CompilationOrderForTesting(
+    const Array& functions) {
+  const Array& order = Array::Handle(Array::New(functions.Length()));
+  Function& function = Function::Handle();
+  // The queue is not visited by the GC.
+  NoSafepointScope no_safepoint;
+  BackgroundCompilationQueue queue;
+  for (intptr_t i = 0; i < functions.Length(); i++) {
+    function ^= functions.At(i);
+    queue.Add(new QueueElement(function));
+  }
+  for (intptr_t i = 0; !queue.IsEmpty(); i++) {
+    delete queue.RemoveHottest(&function);
+    order.SetAt(i, function);
+  }
+  return order.ptr();
+}
+#endif  // defined(TESTING)
+
+void BackgroundCompiler::UpdateQueueDepthMetric() {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  isolate_group_->GetBackgroundCompilationQueueDepthMetric()->set_value(
+      function_queue()->length());
+}
+
 bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
   Thread* thread = Thread::Current();
   ASSERT(thread->IsDartMutatorThread());
@@ -1153,26 +1277,33 @@ bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
 
   SafepointMonitorLocker ml(&monitor_);
   if (disabled_depth_ > 0) return false;
-  if (!running_ && done_) {
+  if (!running_ && (active_threads_ == 0)) {
     running_ = true;
-    done_ = false;
-    // If we ever wanted to run the BG compiler on the
-    // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
-    // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
-    // notification would not work anymore.
-    if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
-      running_ = false;
-      done_ = true;
-      return false;
-    }
   }
-
   ASSERT(running_);
   if (function_queue()->ContainsObj(function)) {
     return true;
   }
+
+  // Threads exit when they find the queue empty, so all running threads
+  // are busy: start another one unless there are enough.
+  //
+  // If we ever wanted to run the BG compiler on the
+  // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
+  // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
+  // notification would not work anymore.
+  if (active_threads_ < Utils::Maximum(FLAG_background_compiler_threads, 1)) {
+    if (Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+      active_threads_++;
+    } else if (active_threads_ == 0) {
+      running_ = false;
+      return false;
+    }
+  }
+
   QueueElement* elem = new QueueElement(function);
   function_queue()->Add(elem);
+  UpdateQueueDepthMetric();
   ml.NotifyAll();
   return true;
 }
@@ -1194,7 +1325,8 @@ void BackgroundCompiler::StopLocked(Thread* thread,
                                     SafepointMonitorLocker* locker) {
   running_ = false;
   function_queue_->Clear();
-  while (!done_) {
+  UpdateQueueDepthMetric();
+  while (active_threads_ > 0) {
     locker->Wait();
   }
 }
@@ -1218,7 +1350,7 @@ void BackgroundCompiler::Disable() {
 
   SafepointMonitorLocker ml(&monitor_);
   disabled_depth_++;
-  if (done_) return;
+  if (active_threads_ == 0) return;
   StopLocked(thread, &ml);
 }
 
@@ -14,6 +14,7 @@
 namespace dart {
 
 // Forward declarations.
+class Array;
 class BackgroundCompilationQueue;
 class Class;
 class Code;
@@ -107,6 +108,19 @@ class BackgroundCompiler {
 
   void Run();
 
+  // The most functions compiled at the same time so far.
+  intptr_t max_concurrent_compilations();
+
+#if defined(TESTING)
+  // The order in which [functions] are compiled when they are enqueued in
+  // order, given their current usage counters.
+  static ArrayPtr CompilationOrderForTesting(const Array& functions);
+
+  // Makes threads wait before compiling until [count] threads are compiling,
+  // for at most a second.
+  void set_rendezvous_for_testing(intptr_t count);
+#endif  // defined(TESTING)
+
  private:
   friend class NoBackgroundCompilerScope;
 
@@ -114,15 +128,28 @@ class BackgroundCompiler {
   void StopLocked(Thread* thread, SafepointMonitorLocker* done_locker);
   void Enable();
   void Disable();
-  bool IsRunning() { return !done_; }
+  bool IsRunning() { return active_threads_ > 0; }
+  void UpdateQueueDepthMetric();
+#if defined(TESTING)
+  void WaitForRendezvousLocked(SafepointMonitorLocker* ml);
+#endif  // defined(TESTING)
 
   IsolateGroup* isolate_group_;
 
   Monitor monitor_;  // Controls access to the queue and running state.
   BackgroundCompilationQueue* function_queue_;
   bool running_;  // While true, will try to read queue and compile.
-  bool done_;     // True if the thread is done.
+  // Threads compiling functions from the queue, at most
+  // --background_compiler_threads. Each compiles the hottest function in the
+  // queue and exits when the queue is empty.
+  intptr_t active_threads_;
   int16_t disabled_depth_;
+  // Threads compiling a function now, and the most there have been.
+  intptr_t compiling_;
+  intptr_t max_compiling_;
+#if defined(TESTING)
+  intptr_t rendezvous_for_testing_ = 0;
+#endif  // defined(TESTING)
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(BackgroundCompiler);
 };
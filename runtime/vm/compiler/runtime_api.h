@@ -1363,10 +1363,8 @@ class IsolateGroup : public AllStatic {
 
 class ClassTable : public AllStatic {
  public:
-#if !defined(PRODUCT)
   static word allocation_tracing_state_table_offset();
   static word AllocationTracingStateSlotOffsetFor(intptr_t cid);
-#endif  // !defined(PRODUCT)
 };
 
 class InstructionsSection : public AllStatic {
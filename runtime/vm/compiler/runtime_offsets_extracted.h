@@ -5826,6 +5826,9 @@ static constexpr dart::compiler::target::word
     SuspendState_frame_capacity_offset = 0x4;
 static constexpr dart::compiler::target::word Array_elements_start_offset = 0xc;
 static constexpr dart::compiler::target::word Array_element_size = 0x4;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Code_elements_start_offset = 0x4c;
 static constexpr dart::compiler::target::word Code_element_size = 0x4;
 static constexpr dart::compiler::target::word Context_elements_start_offset =
@@ -5943,6 +5946,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x28;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0x68;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x4;
 static constexpr dart::compiler::target::word Closure_context_offset = 0x14;
 static constexpr dart::compiler::target::word
     Closure_delayed_type_arguments_offset = 0xc;
@@ -6538,6 +6543,9 @@ static constexpr dart::compiler::target::word
 static constexpr dart::compiler::target::word Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word Array_element_size = 0x8;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Code_elements_start_offset = 0x90;
 static constexpr dart::compiler::target::word Code_element_size = 0x4;
 static constexpr dart::compiler::target::word Context_elements_start_offset =
@@ -6658,6 +6666,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x50;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0xb4;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_context_offset = 0x28;
 static constexpr dart::compiler::target::word
     Closure_delayed_type_arguments_offset = 0x18;
@@ -7258,6 +7268,9 @@ static constexpr dart::compiler::target::word
     SuspendState_frame_capacity_offset = 0x4;
 static constexpr dart::compiler::target::word Array_elements_start_offset = 0xc;
 static constexpr dart::compiler::target::word Array_element_size = 0x4;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Code_elements_start_offset = 0x4c;
 static constexpr dart::compiler::target::word Code_element_size = 0x4;
 static constexpr dart::compiler::target::word Context_elements_start_offset =
@@ -7375,6 +7388,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x28;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0x68;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x4;
 static constexpr dart::compiler::target::word Closure_context_offset = 0x14;
 static constexpr dart::compiler::target::word
     Closure_delayed_type_arguments_offset = 0xc;
@@ -7969,6 +7984,9 @@ static constexpr dart::compiler::target::word
 static constexpr dart::compiler::target::word Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word Array_element_size = 0x8;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Code_elements_start_offset = 0x90;
 static constexpr dart::compiler::target::word Code_element_size = 0x4;
 static constexpr dart::compiler::target::word Context_elements_start_offset =
@@ -8089,6 +8107,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x50;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0xb4;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_context_offset = 0x28;
 static constexpr dart::compiler::target::word
     Closure_delayed_type_arguments_offset = 0x18;
@@ -8692,6 +8712,9 @@ static constexpr dart::compiler::target::word
 static constexpr dart::compiler::target::word Array_elements_start_offset =
     0x10;
 static constexpr dart::compiler::target::word Array_element_size = 0x4;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Code_elements_start_offset = 0x90;
 static constexpr dart::compiler::target::word Code_element_size = 0x4;
 static constexpr dart::compiler::target::word Context_elements_start_offset =
@@ -8809,6 +8832,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x2c;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0x6c;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_context_offset = 0x18;
 static constexpr dart::compiler::target::word
     Closure_delayed_type_arguments_offset = 0x10;
@@ -9409,6 +9434,9 @@ static constexpr dart::compiler::target::word
 static constexpr dart::compiler::target::word Array_elements_start_offset =
     0x10;
 static constexpr dart::compiler::target::word Array_element_size = 0x4;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Code_elements_start_offset = 0x90;
 static constexpr dart::compiler::target::word Code_element_size = 0x4;
 static constexpr dart::compiler::target::word Context_elements_start_offset =
@@ -9526,6 +9554,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x2c;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0x6c;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_context_offset = 0x18;
 static constexpr dart::compiler::target::word
     Closure_delayed_type_arguments_offset = 0x10;
@@ -10127,6 +10157,9 @@ static constexpr dart::compiler::target::word
     SuspendState_frame_capacity_offset = 0x4;
 static constexpr dart::compiler::target::word Array_elements_start_offset = 0xc;
 static constexpr dart::compiler::target::word Array_element_size = 0x4;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Code_elements_start_offset = 0x4c;
 static constexpr dart::compiler::target::word Code_element_size = 0x4;
 static constexpr dart::compiler::target::word Context_elements_start_offset =
@@ -10244,6 +10277,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x28;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0x68;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x4;
 static constexpr dart::compiler::target::word Closure_context_offset = 0x14;
 static constexpr dart::compiler::target::word
     Closure_delayed_type_arguments_offset = 0xc;
@@ -10840,6 +10875,9 @@ static constexpr dart::compiler::target::word
 static constexpr dart::compiler::target::word Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word Array_element_size = 0x8;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Code_elements_start_offset = 0x90;
 static constexpr dart::compiler::target::word Code_element_size = 0x4;
 static constexpr dart::compiler::target::word Context_elements_start_offset =
@@ -10960,6 +10998,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x50;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0xb4;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_context_offset = 0x28;
 static constexpr dart::compiler::target::word
     Closure_delayed_type_arguments_offset = 0x18;
@@ -17189,6 +17229,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0xc;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x4;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word AOT_Code_elements_start_offset =
     0x40;
 static constexpr dart::compiler::target::word AOT_Code_element_size = 0x4;
@@ -17319,6 +17362,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x28;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x4c;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x4;
 static constexpr dart::compiler::target::word AOT_Closure_context_offset = 0x14;
 static constexpr dart::compiler::target::word
     AOT_Closure_delayed_type_arguments_offset = 0xc;
@@ -17981,6 +18026,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x8;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word AOT_Code_elements_start_offset =
     0x78;
 static constexpr dart::compiler::target::word AOT_Code_element_size = 0x4;
@@ -18111,6 +18159,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x50;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x88;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word AOT_Closure_context_offset = 0x28;
 static constexpr dart::compiler::target::word
     AOT_Closure_delayed_type_arguments_offset = 0x18;
@@ -18781,6 +18831,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x8;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word AOT_Code_elements_start_offset =
     0x78;
 static constexpr dart::compiler::target::word AOT_Code_element_size = 0x4;
@@ -18911,6 +18964,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x50;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x88;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word AOT_Closure_context_offset = 0x28;
 static constexpr dart::compiler::target::word
     AOT_Closure_delayed_type_arguments_offset = 0x18;
@@ -19577,6 +19632,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0x10;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x4;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word AOT_Code_elements_start_offset =
     0x78;
 static constexpr dart::compiler::target::word AOT_Code_element_size = 0x4;
@@ -19707,6 +19765,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x2c;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x50;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word AOT_Closure_context_offset = 0x18;
 static constexpr dart::compiler::target::word
     AOT_Closure_delayed_type_arguments_offset = 0x10;
@@ -20373,6 +20433,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0x10;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x4;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word AOT_Code_elements_start_offset =
     0x78;
 static constexpr dart::compiler::target::word AOT_Code_element_size = 0x4;
@@ -20503,6 +20566,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x2c;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x50;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word AOT_Closure_context_offset = 0x18;
 static constexpr dart::compiler::target::word
     AOT_Closure_delayed_type_arguments_offset = 0x10;
@@ -21171,6 +21236,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0xc;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x4;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word AOT_Code_elements_start_offset =
     0x40;
 static constexpr dart::compiler::target::word AOT_Code_element_size = 0x4;
@@ -21301,6 +21369,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x28;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x4c;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x4;
 static constexpr dart::compiler::target::word AOT_Closure_context_offset = 0x14;
 static constexpr dart::compiler::target::word
     AOT_Closure_delayed_type_arguments_offset = 0xc;
@@ -21964,6 +22034,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x8;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word AOT_Code_elements_start_offset =
     0x78;
 static constexpr dart::compiler::target::word AOT_Code_element_size = 0x4;
@@ -22094,6 +22167,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x50;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x88;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word AOT_Closure_context_offset = 0x28;
 static constexpr dart::compiler::target::word
     AOT_Closure_delayed_type_arguments_offset = 0x18;
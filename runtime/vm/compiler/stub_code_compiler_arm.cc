@@ -1090,7 +1090,7 @@ void StubCodeCompiler::GenerateAllocateArrayStub() {
     __ b(&slow_case, HI);
 
     const intptr_t cid = kArrayCid;
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, &slow_case, R4));
+    __ MaybeTraceAllocation(cid, &slow_case, R4);
 
     const intptr_t fixed_size_plus_alignment_padding =
         target::Array::header_size() +
@@ -1529,7 +1529,7 @@ static void GenerateAllocateContext(Assembler* assembler, Label* slow_case) {
   ASSERT(kSmiTagShift == 1);
   __ bic(R2, R2, Operand(target::ObjectAlignment::kObjectAlignment - 1));
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(kContextCid, slow_case, R8));
+  __ MaybeTraceAllocation(kContextCid, slow_case, R8);
   // Now allocate the object.
   // R1: number of context variables.
   // R2: object size.
@@ -1923,7 +1923,6 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
   {
     Label slow_case;
 
-#if !defined(PRODUCT)
     {
       const Register kTraceAllocationTempReg = R8;
       const Register kCidRegister = R9;
@@ -1931,7 +1930,6 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
       __ MaybeTraceAllocation(kCidRegister, &slow_case,
                               kTraceAllocationTempReg);
     }
-#endif
 
     const Register kNewTopReg = R8;
 
@@ -3504,7 +3502,7 @@ void StubCodeCompiler::GenerateAllocateTypedDataArrayStub(intptr_t cid) {
 
   if (!FLAG_use_slow_path && FLAG_inline_alloc) {
     Label call_runtime;
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, &call_runtime, R2));
+    __ MaybeTraceAllocation(cid, &call_runtime, R2);
     __ mov(R2, Operand(AllocateTypedDataArrayABI::kLengthReg));
     /* Check that length is a positive Smi. */
     /* R2: requested array length argument. */
@@ -1413,7 +1413,7 @@ void StubCodeCompiler::GenerateAllocateArrayStub() {
     __ b(&slow_case, HI);
 
     const intptr_t cid = kArrayCid;
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(kArrayCid, &slow_case, R4));
+    __ MaybeTraceAllocation(kArrayCid, &slow_case, R4);
 
     // Calculate and align allocation size.
     // Load new object start and calculate next object start.
@@ -1908,7 +1908,7 @@ static void GenerateAllocateContextSpaceStub(Assembler* assembler,
   ASSERT(kSmiTagShift == 1);
   __ andi(R2, R2, Immediate(~(target::ObjectAlignment::kObjectAlignment - 1)));
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(kContextCid, slow_case, R4));
+  __ MaybeTraceAllocation(kContextCid, slow_case, R4);
   // Now allocate the object.
   // R1: number of context variables.
   // R2: object size.
@@ -2327,7 +2327,6 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
   {
     Label slow_case;
 
-#if !defined(PRODUCT)
     {
       const Register kTraceAllocationTempReg = R8;
       const Register kCidRegister = R9;
@@ -2335,7 +2334,6 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
       __ MaybeTraceAllocation(kCidRegister, &slow_case,
                               kTraceAllocationTempReg);
     }
-#endif
 
     const Register kNewTopReg = R3;
 
@@ -3937,7 +3935,7 @@ void StubCodeCompiler::GenerateAllocateTypedDataArrayStub(intptr_t cid) {
 
   if (!FLAG_use_slow_path && FLAG_inline_alloc) {
     Label call_runtime;
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, &call_runtime, R2));
+    __ MaybeTraceAllocation(cid, &call_runtime, R2);
     __ mov(R2, AllocateTypedDataArrayABI::kLengthReg);
     /* Check that length is a positive Smi. */
     /* R2: requested array length argument. */
@@ -924,8 +924,8 @@ void StubCodeCompiler::GenerateAllocateArrayStub() {
     __ cmpl(AllocateArrayABI::kLengthReg, max_len);
     __ j(ABOVE, &slow_case);
 
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(kArrayCid, &slow_case,
-                                           AllocateArrayABI::kResultReg));
+    __ MaybeTraceAllocation(kArrayCid, &slow_case,
+                            AllocateArrayABI::kResultReg);
 
     const intptr_t fixed_size_plus_alignment_padding =
         target::Array::header_size() +
@@ -1330,7 +1330,7 @@ static void GenerateAllocateContextSpaceStub(Assembler* assembler,
   __ leal(EBX, Address(EDX, TIMES_4, fixed_size_plus_alignment_padding));
   __ andl(EBX, Immediate(-target::ObjectAlignment::kObjectAlignment));
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(kContextCid, slow_case, EAX));
+  __ MaybeTraceAllocation(kContextCid, slow_case, EAX);
 
   // Now allocate the object.
   // EDX: number of context variables.
@@ -3315,7 +3315,7 @@ void StubCodeCompiler::GenerateAllocateTypedDataArrayStub(intptr_t cid) {
     Label call_runtime;
     __ pushl(AllocateTypedDataArrayABI::kLengthReg);
 
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, &call_runtime, ECX));
+    __ MaybeTraceAllocation(cid, &call_runtime, ECX);
     __ movl(EDI, AllocateTypedDataArrayABI::kLengthReg);
     /* Check that length is a positive Smi. */
     /* EDI: requested array length argument. */
@@ -1212,7 +1212,7 @@ void StubCodeCompiler::GenerateAllocateArrayStub() {
     __ BranchIf(HI, &slow_case);
 
     const intptr_t cid = kArrayCid;
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(kArrayCid, &slow_case, T4));
+    __ MaybeTraceAllocation(kArrayCid, &slow_case, T4);
 
     // Calculate and align allocation size.
     // Load new object start and calculate next object start.
@@ -1547,7 +1547,7 @@ static void GenerateAllocateContextSpaceStub(Assembler* assembler,
   __ AddImmediate(T2, fixed_size_plus_alignment_padding);
   __ andi(T2, T2, ~(target::ObjectAlignment::kObjectAlignment - 1));
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(kContextCid, slow_case, T4));
+  __ MaybeTraceAllocation(kContextCid, slow_case, T4);
   // Now allocate the object.
   // T1: number of context variables.
   // T2: object size.
@@ -1925,13 +1925,11 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
   {
     Label slow_case;
 
-#if !defined(PRODUCT)
     {
       const Register kCidRegister = TMP2;
       __ ExtractClassIdFromTags(kCidRegister, AllocateObjectABI::kTagsReg);
       __ MaybeTraceAllocation(kCidRegister, &slow_case, TMP);
     }
-#endif
 
     const Register kNewTopReg = T3;
 
@@ -3419,7 +3417,7 @@ void StubCodeCompiler::GenerateAllocateTypedDataArrayStub(intptr_t cid) {
 
   if (!FLAG_use_slow_path && FLAG_inline_alloc) {
     Label call_runtime;
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, &call_runtime, T3));
+    __ MaybeTraceAllocation(cid, &call_runtime, T3);
     __ mv(T3, AllocateTypedDataArrayABI::kLengthReg);
     /* Check that length is a positive Smi. */
     /* T3: requested array length argument. */
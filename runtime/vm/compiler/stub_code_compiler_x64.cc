@@ -1333,7 +1333,7 @@ void StubCodeCompiler::GenerateAllocateArrayStub() {
     __ j(ABOVE, &slow_case);
 
     // Check for allocation tracing.
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(kArrayCid, &slow_case));
+    __ MaybeTraceAllocation(kArrayCid, &slow_case);
 
     const intptr_t fixed_size_plus_alignment_padding =
         target::Array::header_size() +
@@ -1825,7 +1825,7 @@ static void GenerateAllocateContextSpaceStub(Assembler* assembler,
   __ andq(R13, Immediate(-target::ObjectAlignment::kObjectAlignment));
 
   // Check for allocation tracing.
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(kContextCid, slow_case));
+  __ MaybeTraceAllocation(kContextCid, slow_case);
 
   // Now allocate the object.
   // R10: number of context variables.
@@ -2231,13 +2231,11 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
     Label slow_case;
     const Register kNewTopReg = R9;
 
-#if !defined(PRODUCT)
     {
       const Register kCidRegister = RSI;
       __ ExtractClassIdFromTags(kCidRegister, AllocateObjectABI::kTagsReg);
       __ MaybeTraceAllocation(kCidRegister, &slow_case, TMP);
     }
-#endif
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
     {
@@ -3827,7 +3825,7 @@ void StubCodeCompiler::GenerateAllocateTypedDataArrayStub(intptr_t cid) {
     Label call_runtime;
     __ pushq(AllocateTypedDataArrayABI::kLengthReg);
 
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, &call_runtime));
+    __ MaybeTraceAllocation(cid, &call_runtime);
     __ movq(RDI, AllocateTypedDataArrayABI::kLengthReg);
     /* Check that length is a positive Smi. */
     /* RDI: requested array length argument. */
@@ -16,6 +16,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, background_compiler_threads);
+
 ISOLATE_UNIT_TEST_CASE(CompileFunction) {
   const char* kScriptChars =
       "class A {\n"
@@ -100,6 +102,112 @@ ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionOnHelperThread) {
   delete m;
 }
 
+ISOLATE_UNIT_TEST_CASE(OptimizeFunctionsOnSeveralHelperThreads) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo() { return 42; }\n"
+      "  static bar() { return 43; }\n"
+      "  static baz() { return 44; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+  const char* kNames[] = {"foo", "bar", "baz"};
+  const intptr_t kCount = ARRAY_SIZE(kNames);
+  const Array& functions = Array::Handle(Array::New(kCount));
+  Function& func = Function::Handle();
+  for (intptr_t i = 0; i < kCount; i++) {
+    func = cls.LookupStaticFunction(String::Handle(String::New(kNames[i])));
+    CompilerTest::TestCompileFunction(func);
+    EXPECT(func.HasCode());
+    EXPECT(!func.HasOptimizedCode());
+    functions.SetAt(i, func);
+  }
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  SetFlagScope<int> sfs(&FLAG_background_compiler_threads, kCount);
+  auto isolate_group = thread->isolate_group();
+  // Each thread takes one function and waits for the others before
+  // compiling it.
+  isolate_group->background_compiler()->set_rendezvous_for_testing(kCount);
+  for (intptr_t i = 0; i < kCount; i++) {
+    func ^= functions.At(i);
+    EXPECT(isolate_group->background_compiler()->EnqueueCompilation(func));
+  }
+  Monitor* m = new Monitor();
+  for (intptr_t i = 0; i < kCount; i++) {
+    func ^= functions.At(i);
+    SafepointMonitorLocker ml(m);
+    while (!func.HasOptimizedCode()) {
+      ml.Wait(1);
+    }
+  }
+  delete m;
+  EXPECT(isolate_group->background_compiler()->max_concurrent_compilations() >
+         1);
+  isolate_group->background_compiler()->set_rendezvous_for_testing(0);
+  BackgroundCompiler::Stop(isolate_group);
+  EXPECT_EQ(0,
+            isolate_group->GetBackgroundCompilationQueueDepthMetric()->value());
+  EXPECT(isolate_group->GetBackgroundCompilationLatencyMaxMetric()->value() >
+         0);
+}
+
+ISOLATE_UNIT_TEST_CASE(BackgroundCompilerCompilesHottestFirst) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo() { return 42; }\n"
+      "  static bar() { return 43; }\n"
+      "  static baz() { return 44; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+
+  // The usage counters restart from INT32_MIN when the functions are
+  // enqueued. The function enqueued last has been called most since.
+  const char* kNames[] = {"foo", "bar", "baz"};
+  const intptr_t kCalls[] = {10, 0, 1000};
+  const intptr_t kCount = ARRAY_SIZE(kNames);
+  const Array& functions = Array::Handle(Array::New(kCount));
+  Function& func = Function::Handle();
+  for (intptr_t i = 0; i < kCount; i++) {
+    func = cls.LookupStaticFunction(String::Handle(String::New(kNames[i])));
+    EXPECT(!func.IsNull());
+    func.SetUsageCounter(INT32_MIN + kCalls[i]);
+    functions.SetAt(i, func);
+  }
+
+  const Array& order =
+      Array::Handle(BackgroundCompiler::CompilationOrderForTesting(functions));
+  EXPECT_EQ(kCount, order.Length());
+  EXPECT(order.At(0) == functions.At(2));
+  EXPECT(order.At(1) == functions.At(0));
+  EXPECT(order.At(2) == functions.At(1));
+}
+
 ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   // Create a simple function and compile it without optimization.
   const char* kScriptChars =
@@ -376,6 +376,7 @@ char* Dart::DartInit(const Dart_InitializeParams* params) {
   PortMap::Init();
   NativeMessageHandler::Init();
   Service::Init();
+  Metric::Init();
   FreeListElement::Init();
   ForwardingCorpse::Init();
   Api::Init();
@@ -774,6 +775,7 @@ char* Dart::Cleanup() {
   }
   OSThread::DisableOSThreadCreation();
 
+  Metric::Cleanup();
   ShutdownIsolate(Thread::Current());
   vm_isolate_ = nullptr;
   ASSERT(Isolate::IsolateListLength() == 0);
@@ -1865,6 +1865,40 @@ Dart_SetPerformanceMode(Dart_PerformanceMode mode) {
   return T->heap()->SetMode(mode);
 }
 
+DART_EXPORT void Dart_SetGCPauseTarget(
+    int64_t target_micros,
+    Dart_GCPauseTargetMissedCallback callback,
+    void* callback_data) {
+  Thread* T = Thread::Current();
+  CHECK_ISOLATE(T->isolate());
+  if (target_micros < 0) {
+    FATAL("%s expects argument 'target_micros' to be non-negative.",
+          CURRENT_FUNC);
+  }
+  TransitionNativeToVM transition(T);
+  T->heap()->SetPauseTarget(target_micros, callback, callback_data);
+}
+
+DART_EXPORT void Dart_SetIsolateGroupMemoryLimits(
+    intptr_t soft_limit_bytes,
+    intptr_t hard_limit_bytes,
+    Dart_MemoryPressureCallback callback,
+    void* callback_data) {
+  Thread* T = Thread::Current();
+  CHECK_ISOLATE(T->isolate());
+  if (soft_limit_bytes < 0) {
+    FATAL("%s expects argument 'soft_limit_bytes' to be non-negative.",
+          CURRENT_FUNC);
+  }
+  if (hard_limit_bytes < 0) {
+    FATAL("%s expects argument 'hard_limit_bytes' to be non-negative.",
+          CURRENT_FUNC);
+  }
+  TransitionNativeToVM transition(T);
+  T->heap()->SetMemoryLimits(soft_limit_bytes, hard_limit_bytes, callback,
+                             callback_data);
+}
+
 DART_EXPORT void Dart_ExitIsolate() {
   Thread* T = Thread::Current();
   CHECK_ISOLATE(T->isolate());
@@ -6967,4 +7001,29 @@ DART_EXPORT char* Dart_WriteHeapSnapshot(
 #endif
 }
 
+DART_EXPORT char* Dart_WriteCompressedHeapSnapshot(
+    Dart_HeapSnapshotWriteChunkCallback write,
+    void* context,
+    int64_t* child_pid) {
+#if defined(DART_ENABLE_HEAP_SNAPSHOT_WRITER)
+  DARTSCOPE(Thread::Current());
+  CallbackHeapSnapshotWriter callback_writer(T, write, context);
+  GzipChunkedWriter gzip_writer(T, &callback_writer);
+  HeapSnapshotWriter writer(T, &gzip_writer);
+  if (child_pid == nullptr) {
+    writer.Write();
+    return nullptr;
+  }
+  const intptr_t pid = writer.WriteInChildProcess();
+  if (pid < 0) {
+    return Utils::StrDup(
+        "Could not fork a process to write the heap snapshot.");
+  }
+  *child_pid = pid;
+  return nullptr;
+#else
+  return Utils::StrDup("VM is built without the heap snapshot writer.");
+#endif
+}
+
 }  // namespace dart
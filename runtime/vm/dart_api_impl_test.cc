@@ -6,8 +6,14 @@
 
 #include <thread>  // NOLINT(build/c++11)
 
+#if defined(DART_HOST_OS_LINUX)
+#include <sys/wait.h>  // NOLINT
+#include <unistd.h>    // NOLINT
+#endif
+
 #include "bin/builtin.h"
 #include "bin/dartutils.h"
+#include "bin/gzip.h"
 #include "include/dart_api.h"
 #include "include/dart_native_api.h"
 #include "include/dart_tools_api.h"
@@ -11059,6 +11065,84 @@ TEST_CASE(DartAPI_WriteHeapSnapshot) {
   EXPECT_GT(context.bytes_written, 0);
   EXPECT(context.saw_last_chunk);
 }
+
+static void ExpectCompressedHeapSnapshot(uint8_t* data, intptr_t size) {
+  uint8_t* snapshot = nullptr;
+  intptr_t snapshot_size = 0;
+  bin::Decompress(data, size, &snapshot, &snapshot_size);
+  EXPECT_GT(snapshot_size, size);
+  EXPECT_EQ(0, memcmp(snapshot, "dartheap", 8));
+  free(snapshot);
+}
+
+TEST_CASE(DartAPI_WriteCompressedHeapSnapshot) {
+  struct WriterContext {
+    uint8_t* data;
+    intptr_t size;
+    bool saw_last_chunk;
+  };
+
+  WriterContext context = {nullptr, 0, false};
+  char* error = Dart_WriteCompressedHeapSnapshot(
+      [](void* context, uint8_t* buffer, intptr_t size, bool is_last) {
+        auto ctx = static_cast<WriterContext*>(context);
+        EXPECT(!ctx->saw_last_chunk);
+        ctx->saw_last_chunk = is_last;
+        ctx->data =
+            reinterpret_cast<uint8_t*>(realloc(ctx->data, ctx->size + size));
+        memmove(ctx->data + ctx->size, buffer, size);
+        ctx->size += size;
+
+        free(buffer);
+      },
+      &context, /*child_pid=*/nullptr);
+  EXPECT(error == nullptr);
+  EXPECT(context.saw_last_chunk);
+  ExpectCompressedHeapSnapshot(context.data, context.size);
+  free(context.data);
+}
+
+#if defined(DART_HOST_OS_LINUX)
+TEST_CASE(DartAPI_WriteCompressedHeapSnapshotInChildProcess) {
+  int fds[2];
+  EXPECT_EQ(0, pipe(fds));
+
+  int64_t child_pid = -1;
+  char* error = Dart_WriteCompressedHeapSnapshot(
+      [](void* context, uint8_t* buffer, intptr_t size, bool is_last) {
+        // Runs in the child process.
+        const int fd = *static_cast<int*>(context);
+        for (intptr_t written = 0; written < size;) {
+          ssize_t result = write(fd, buffer + written, size - written);
+          if (result <= 0) _exit(1);
+          written += result;
+        }
+        free(buffer);
+        if (is_last) close(fd);
+      },
+      &fds[1], &child_pid);
+  EXPECT(error == nullptr);
+  EXPECT_GT(child_pid, 0);
+  close(fds[1]);
+
+  uint8_t* data = nullptr;
+  intptr_t size = 0;
+  for (;;) {
+    data = reinterpret_cast<uint8_t*>(realloc(data, size + KB));
+    ssize_t result = read(fds[0], data + size, KB);
+    if (result <= 0) break;
+    size += result;
+  }
+  close(fds[0]);
+
+  int status = 0;
+  EXPECT_EQ(child_pid, waitpid(child_pid, &status, 0));
+  EXPECT(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+  ExpectCompressedHeapSnapshot(data, size);
+  free(data);
+}
+#endif  // defined(DART_HOST_OS_LINUX)
 #endif  // defined(DART_ENABLE_HEAP_SNAPSHOT_WRITER)
 
 }  // namespace dart
@@ -100,31 +100,63 @@ uword FreeList::TryAllocateLocked(intptr_t size, bool is_protected) {
     return reinterpret_cast<uword>(element);
   }
 
+  // Find a list whose elements are all big enough: a list of a larger small
+  // size, or else a large list above the one 'size' belongs to.
+  intptr_t fit_index = -1;
   if ((index + 1) < kNumLists) {
-    intptr_t next_index = free_map_.Next(index + 1);
-    if (next_index != -1) {
-      // Dequeue an element from the list, split and enqueue the remainder in
-      // the appropriate list.
-      FreeListElement* element = DequeueElement(next_index);
-      if (is_protected) {
-        // Make the allocated block and the header of the remainder element
-        // writable.  The remainder will be non-writable if necessary after
-        // the call to SplitElementAfterAndEnqueue.
-        // If the remainder size is zero, only the element itself needs to
-        // be made writable.
-        intptr_t remainder_size = element->HeapSize() - size;
-        intptr_t region_size =
-            size + FreeListElement::HeaderSizeFor(remainder_size);
-        VirtualMemory::Protect(reinterpret_cast<void*>(element), region_size,
-                               VirtualMemory::kReadWrite);
+    fit_index = free_map_.Next(index + 1);
+  }
+  if (fit_index == -1) {
+    intptr_t large_index = kNumLists;
+    if (index == kNumLists) {
+      // Elements in the large list of 'size' may be smaller than 'size', but
+      // it has the best fits.
+      large_index = LargeIndexForSize(size);
+      FreeListElement* previous = nullptr;
+      FreeListElement* current =
+          SearchLargeLocked(large_index, size, &previous);
+      if (current != nullptr) {
+        AllocateAfterLocked(large_index, previous, current, size, is_protected);
+        return reinterpret_cast<uword>(current);
+      }
+      large_index++;
+    }
+    if (large_index < kNumSizeClasses) {
+      fit_index = large_map_.Next(large_index - kNumLists);
+      if (fit_index != -1) {
+        fit_index += kNumLists;
       }
-      SplitElementAfterAndEnqueue(element, size, is_protected);
-      return reinterpret_cast<uword>(element);
     }
   }
+  if (fit_index == -1) {
+    return 0;  // Trigger allocation of new page.
+  }
 
-  FreeListElement* previous = nullptr;
-  FreeListElement* current = free_lists_[kNumLists];
+  // Dequeue an element from the list, split and enqueue the remainder in the
+  // appropriate list.
+  FreeListElement* element = DequeueElement(fit_index);
+  if (is_protected) {
+    // Make the allocated block and the header of the remainder element
+    // writable.  The remainder will be non-writable if necessary after
+    // the call to SplitElementAfterAndEnqueue.
+    // If the remainder size is zero, only the element itself needs to
+    // be made writable.
+    intptr_t remainder_size = element->HeapSize() - size;
+    intptr_t region_size =
+        size + FreeListElement::HeaderSizeFor(remainder_size);
+    VirtualMemory::Protect(reinterpret_cast<void*>(element), region_size,
+                           VirtualMemory::kReadWrite);
+  }
+  SplitElementAfterAndEnqueue(element, size, is_protected);
+  return reinterpret_cast<uword>(element);
+}
+
+FreeListElement* FreeList::SearchLargeLocked(intptr_t index,
+                                             intptr_t size,
+                                             FreeListElement** previous) {
+  ASSERT(index >= kNumLists && index < kNumSizeClasses);
+  *previous = nullptr;
+  FreeListElement* current = free_lists_[index];
   // We are willing to search the freelist further for a big block.
   // For each successful free-list search we:
   //   * increase the search budget by #allocated-words
@@ -132,62 +164,67 @@ uword FreeList::TryAllocateLocked(intptr_t size, bool is_protected) {
   //     which guarantees us to not waste more than around 1 search step per
   //     word of allocation
   //
-  // If we run out of search budget we fall back to allocating a new page and
-  // reset the search budget.
+  // If we run out of search budget we fall back to larger lists or to
+  // allocating a new page and reset the search budget.
   intptr_t tries_left = freelist_search_budget_ + (size >> kWordSizeLog2);
   while (current != nullptr) {
     if (current->HeapSize() >= size) {
-      // Found an element large enough to hold the requested size. Dequeue,
-      // split and enqueue the remainder.
-      intptr_t remainder_size = current->HeapSize() - size;
-      intptr_t region_size =
-          size + FreeListElement::HeaderSizeFor(remainder_size);
-      if (is_protected) {
-        // Make the allocated block and the header of the remainder element
-        // writable.  The remainder will be non-writable if necessary after
-        // the call to SplitElementAfterAndEnqueue.
-        VirtualMemory::Protect(reinterpret_cast<void*>(current), region_size,
-                               VirtualMemory::kReadWrite);
-      }
-
-      if (previous == nullptr) {
-        free_lists_[kNumLists] = current->next();
-      } else {
-        // If the previous free list element's next field is protected, it
-        // needs to be unprotected before storing to it and reprotected
-        // after.
-        bool target_is_protected = false;
-        uword target_address = 0L;
-        if (is_protected) {
-          uword writable_start = reinterpret_cast<uword>(current);
-          uword writable_end = writable_start + region_size - 1;
-          target_address = previous->next_address();
-          target_is_protected =
-              !VirtualMemory::InSamePage(target_address, writable_start) &&
-              !VirtualMemory::InSamePage(target_address, writable_end);
-        }
-        if (target_is_protected) {
-          VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
-                                 kWordSize, VirtualMemory::kReadWrite);
-        }
-        previous->set_next(current->next());
-        if (target_is_protected) {
-          VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
-                                 kWordSize, VirtualMemory::kReadExecute);
-        }
-      }
-      SplitElementAfterAndEnqueue(current, size, is_protected);
       freelist_search_budget_ =
           Utils::Minimum(tries_left, kInitialFreeListSearchBudget);
-      return reinterpret_cast<uword>(current);
+      return current;
     } else if (tries_left-- < 0) {
       freelist_search_budget_ = kInitialFreeListSearchBudget;
-      return 0;  // Trigger allocation of new page.
+      return nullptr;
     }
-    previous = current;
+    *previous = current;
     current = current->next();
   }
-  return 0;
+  return nullptr;
+}
+
+void FreeList::AllocateAfterLocked(intptr_t index,
+                                   FreeListElement* previous,
+                                   FreeListElement* current,
+                                   intptr_t size,
+                                   bool is_protected) {
+  // Dequeue, split and enqueue the remainder.
+  intptr_t remainder_size = current->HeapSize() - size;
+  intptr_t region_size = size + FreeListElement::HeaderSizeFor(remainder_size);
+  if (is_protected) {
+    // Make the allocated block and the header of the remainder element
+    // writable.  The remainder will be non-writable if necessary after
+    // the call to SplitElementAfterAndEnqueue.
+    VirtualMemory::Protect(reinterpret_cast<void*>(current), region_size,
+                           VirtualMemory::kReadWrite);
+  }
+
+  if (previous == nullptr) {
+    DequeueElement(index);
+  } else {
+    // If the previous free list element's next field is protected, it
+    // needs to be unprotected before storing to it and reprotected
+    // after.
+    bool target_is_protected = false;
+    uword target_address = 0L;
+    if (is_protected) {
+      uword writable_start = reinterpret_cast<uword>(current);
+      uword writable_end = writable_start + region_size - 1;
+      target_address = previous->next_address();
+      target_is_protected =
+          !VirtualMemory::InSamePage(target_address, writable_start) &&
+          !VirtualMemory::InSamePage(target_address, writable_end);
+    }
+    if (target_is_protected) {
+      VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
+                             kWordSize, VirtualMemory::kReadWrite);
+    }
+    previous->set_next(current->next());
+    if (target_is_protected) {
+      VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
+                             kWordSize, VirtualMemory::kReadExecute);
+    }
+  }
+  SplitElementAfterAndEnqueue(current, size, is_protected);
 }
 
 void FreeList::Free(uword addr, intptr_t size) {
@@ -211,15 +248,21 @@ void FreeList::FreeLocked(uword addr, intptr_t size) {
 void FreeList::Reset() {
   MutexLocker ml(&mutex_);
   free_map_.Reset();
+  large_map_.Reset();
   last_free_small_size_ = -1;
-  for (int i = 0; i < (kNumLists + 1); i++) {
+  for (int i = 0; i < kNumSizeClasses; i++) {
     free_lists_[i] = nullptr;
   }
 }
 
 void FreeList::EnqueueElement(FreeListElement* element, intptr_t index) {
+  if (index == kNumLists) {
+    index = LargeIndexForSize(element->HeapSize());
+  }
   FreeListElement* next = free_lists_[index];
-  if (next == nullptr && index != kNumLists) {
+  if (next == nullptr && index >= kNumLists) {
+    large_map_.Set(index - kNumLists, true);
+  } else if (next == nullptr) {
     free_map_.Set(index, true);
     last_free_small_size_ =
         Utils::Maximum(last_free_small_size_, index << kObjectAlignmentLog2);
@@ -283,31 +326,30 @@ FreeListElement* FreeList::TryAllocateLarge(intptr_t minimum_size) {
 
 FreeListElement* FreeList::TryAllocateLargeLocked(intptr_t minimum_size) {
   DEBUG_ASSERT(mutex_.IsOwnedByCurrentThread());
+  const intptr_t last = large_map_.Last();
+  if (last == -1) {
+    return nullptr;
+  }
+  const intptr_t index = kNumLists + last;
+  if ((minimum_size < kMinLargeSize) ||
+      (index > LargeIndexForSize(minimum_size))) {
+    // Every element of the list fits.
+    return DequeueElement(index);
+  }
+  if (index < LargeIndexForSize(minimum_size)) {
+    return nullptr;
+  }
   FreeListElement* previous = nullptr;
-  FreeListElement* current = free_lists_[kNumLists];
-  // TODO(koda): Find largest.
-  // We are willing to search the freelist further for a big block.
-  intptr_t tries_left =
-      freelist_search_budget_ + (minimum_size >> kWordSizeLog2);
-  while (current != nullptr) {
-    FreeListElement* next = current->next();
-    if (current->HeapSize() >= minimum_size) {
-      if (previous == nullptr) {
-        free_lists_[kNumLists] = next;
-      } else {
-        previous->set_next(next);
-      }
-      freelist_search_budget_ =
-          Utils::Minimum(tries_left, kInitialFreeListSearchBudget);
-      return current;
-    } else if (tries_left-- < 0) {
-      freelist_search_budget_ = kInitialFreeListSearchBudget;
-      return nullptr;  // Trigger allocation of new page.
-    }
-    previous = current;
-    current = next;
+  FreeListElement* current = SearchLargeLocked(index, minimum_size, &previous);
+  if (current == nullptr) {
+    return nullptr;  // Trigger allocation of new page.
   }
-  return nullptr;
+  if (previous == nullptr) {
+    DequeueElement(index);
+  } else {
+    previous->set_next(current->next());
+  }
+  return current;
 }
 
 }  // namespace dart
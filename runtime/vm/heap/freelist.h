@@ -91,6 +91,7 @@ class FreeList {
   void FreeLocked(uword addr, intptr_t size);
 
   // Returns a large element, at least 'minimum_size', or NULL if none exists.
+  // Prefers the largest elements, so that bump allocation regions last long.
   FreeListElement* TryAllocateLarge(intptr_t minimum_size);
   FreeListElement* TryAllocateLargeLocked(intptr_t minimum_size);
 
@@ -161,7 +162,15 @@ class FreeList {
   void AddUnaccountedSize(intptr_t size) { unaccounted_size_ += size; }
 
  private:
+  // Elements smaller than kNumLists * kObjectAlignment are kept in lists of
+  // a single size. Larger elements are kept in kNumLargeLists lists of sizes
+  // within a power of two, the last one also holding anything bigger.
   static constexpr int kNumLists = 128;
+  static constexpr int kNumLargeLists = 12;
+  static constexpr int kNumSizeClasses = kNumLists + kNumLargeLists;
+  static constexpr intptr_t kMinLargeSizeLog2 = 7 + kObjectAlignmentLog2;
+  static constexpr intptr_t kMinLargeSize = kNumLists * kObjectAlignment;
+  COMPILE_ASSERT(kMinLargeSize == (1 << kMinLargeSizeLog2));
   static constexpr intptr_t kInitialFreeListSearchBudget = 1000;
 
   static intptr_t IndexForSize(intptr_t size) {
@@ -175,13 +184,23 @@ class FreeList {
     return index;
   }
 
+  // Returns the index in free_lists_ of the large list holding 'size'.
+  static intptr_t LargeIndexForSize(intptr_t size) {
+    ASSERT(size >= kMinLargeSize);
+    intptr_t index = (kBitsPerWord - 1) -
+                     Utils::CountLeadingZerosWord(size) - kMinLargeSizeLog2;
+    return kNumLists + Utils::Minimum<intptr_t>(index, kNumLargeLists - 1);
+  }
+
   intptr_t LengthLocked(int index) const;
 
   void EnqueueElement(FreeListElement* element, intptr_t index);
   FreeListElement* DequeueElement(intptr_t index) {
     FreeListElement* result = free_lists_[index];
     FreeListElement* next = result->next();
-    if (next == nullptr && index != kNumLists) {
+    if (next == nullptr && index >= kNumLists) {
+      large_map_.Set(index - kNumLists, false);
+    } else if (next == nullptr) {
       intptr_t size = index << kObjectAlignmentLog2;
       if (size == last_free_small_size_) {
         // Note: This is -1 * kObjectAlignment if no other small sizes remain.
@@ -199,6 +218,19 @@ class FreeList {
                                    intptr_t size,
                                    bool is_protected);
 
+  // Returns the first element of at least 'size' in the large list 'index',
+  // and its predecessor, or NULL if none is found within the search budget.
+  FreeListElement* SearchLargeLocked(intptr_t index,
+                                     intptr_t size,
+                                     FreeListElement** previous);
+  // Unlinks 'current', which follows 'previous' in the list 'index', and
+  // enqueues what remains after the first 'size' bytes.
+  void AllocateAfterLocked(intptr_t index,
+                           FreeListElement* previous,
+                           FreeListElement* current,
+                           intptr_t size,
+                           bool is_protected);
+
   // Bump pointer region.
   uword top_ = 0;
   uword end_ = 0;
@@ -211,8 +243,9 @@ class FreeList {
   mutable Mutex mutex_;
 
   BitSet<kNumLists> free_map_;
+  BitSet<kNumLargeLists> large_map_;
 
-  FreeListElement* free_lists_[kNumLists + 1];
+  FreeListElement* free_lists_[kNumSizeClasses];
 
   intptr_t freelist_search_budget_ = kInitialFreeListSearchBudget;
 
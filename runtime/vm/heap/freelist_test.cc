@@ -5,8 +5,10 @@
 #include <memory>
 
 #include "platform/assert.h"
+#include "vm/benchmark_test.h"
 #include "vm/heap/freelist.h"
 #include "vm/pointer_tagging.h"
+#include "vm/timer.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -185,6 +187,81 @@ TEST_CASE(FreeListProtectedVariableSizeObjects) {
   delete[] objects;
 }
 
+TEST_CASE(FreeListLargeSizeClasses) {
+  FreeList* free_list = new FreeList();
+  const intptr_t kBlobSize = 1 * MB;
+  VirtualMemory* region = VirtualMemory::Allocate(
+      kBlobSize, /*is_executable=*/false, /*is_compressed=*/false, "test");
+  const uword blob = region->start();
+
+  // Free elements of 64KB, 8KB and 3KB, kept apart by allocated words.
+  const uword huge = blob;
+  free_list->Free(huge, 64 * KB);
+  const uword large = huge + 64 * KB + kObjectAlignment;
+  free_list->Free(large, 8 * KB);
+  const uword medium = large + 8 * KB + kObjectAlignment;
+  free_list->Free(medium, 3 * KB);
+
+  // Large allocations take the element from their own size class first.
+  EXPECT_EQ(large, free_list->TryAllocate(6 * KB, false));
+  EXPECT_EQ(medium, free_list->TryAllocate(3 * KB, false));
+  // Then any element from a larger class.
+  EXPECT_EQ(huge, free_list->TryAllocate(5 * KB, false));
+  // Small allocations take the smallest large element before splitting
+  // larger ones.
+  EXPECT_EQ(large + 6 * KB, free_list->TryAllocate(kObjectAlignment, false));
+
+  // Bump allocation regions are taken from the largest element.
+  FreeListElement* element = free_list->TryAllocateLarge(kObjectAlignment);
+  EXPECT_EQ(huge + 5 * KB, reinterpret_cast<uword>(element));
+  EXPECT_EQ(59 * KB, element->HeapSize());
+  // What is left is the rest of the 8KB element.
+  EXPECT_EQ(large + 6 * KB + kObjectAlignment,
+            free_list->TryAllocate(2 * KB - kObjectAlignment, false));
+
+  delete region;
+  delete free_list;
+}
+
+// Measures allocation of mixed sizes from a fragmented free list, as left by
+// sweeping a heap of mixed-size objects.
+BENCHMARK(FreeListAllocation) {
+  const intptr_t kRegionSize = 4 * MB;
+  const intptr_t kRounds = 50;
+  const intptr_t kSizes[] = {2 * kWordSize, 4 * kWordSize,  6 * kWordSize,
+                             16 * kWordSize, 3 * KB,        2 * kWordSize,
+                             24 * KB,        4 * kWordSize, 40 * kWordSize,
+                             10 * KB};
+  const intptr_t kNumSizes = ARRAY_SIZE(kSizes);
+  std::unique_ptr<VirtualMemory> region(
+      VirtualMemory::Allocate(kRegionSize, /*is_executable=*/false,
+                              /*is_compressed=*/false, "benchmark"));
+  std::unique_ptr<FreeList> free_list(new FreeList());
+  const uword end = region->end();
+
+  Timer timer;
+  intptr_t allocations = 0;
+  for (intptr_t round = 0; round < kRounds; round++) {
+    free_list->Reset();
+    // Free every other object, in gaps of about a page.
+    uword cursor = region->start();
+    for (intptr_t i = 0; cursor + 2 * kPageSize < end; i++) {
+      const intptr_t size = kPageSize / 2 + kSizes[i % kNumSizes];
+      free_list->Free(cursor, size);
+      cursor += size + kSizes[(i + 3) % kNumSizes];
+    }
+
+    timer.Start();
+    for (intptr_t i = round;; i++) {
+      if (free_list->TryAllocate(kSizes[i % kNumSizes], false) == 0) break;
+      allocations++;
+    }
+    timer.Stop();
+  }
+  EXPECT(allocations > 0);
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
 static void TestRegress38528(intptr_t header_overlap) {
   // Test the following scenario.
   //
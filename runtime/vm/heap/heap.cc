@@ -40,6 +40,21 @@ DEFINE_FLAG(bool,
             disable_heap_verification,
             false,
             "Explicitly disable heap verification.");
+DEFINE_FLAG(int,
+            gc_pause_target,
+            0,
+            "If positive, adapt the heap so that GC pauses take at most about "
+            "this many microseconds. See Dart_SetGCPauseTarget.");
+DEFINE_FLAG(int,
+            soft_memory_limit,
+            0,
+            "If positive, the soft memory limit of each isolate group in MB. "
+            "See Dart_SetIsolateGroupMemoryLimits.");
+DEFINE_FLAG(int,
+            hard_memory_limit,
+            0,
+            "If positive, the hard memory limit of each isolate group in MB. "
+            "See Dart_SetIsolateGroupMemoryLimits.");
 
 Heap::Heap(IsolateGroup* isolate_group,
            bool is_vm_isolate,
@@ -49,6 +64,15 @@ Heap::Heap(IsolateGroup* isolate_group,
       is_vm_isolate_(is_vm_isolate),
       new_space_(this, max_new_gen_semi_words),
       old_space_(this, max_old_gen_words),
+      pause_target_micros_(Utils::Maximum(FLAG_gc_pause_target, 0)),
+      soft_limit_in_words_(is_vm_isolate
+                               ? 0
+                               : Utils::Maximum(FLAG_soft_memory_limit, 0) *
+                                     MBInWords),
+      hard_limit_in_words_(is_vm_isolate
+                               ? 0
+                               : Utils::Maximum(FLAG_hard_memory_limit, 0) *
+                                     MBInWords),
       read_only_(false),
       assume_scavenge_will_fail_(false),
       gc_on_nth_allocation_(kNoForcedGarbageCollection) {
@@ -188,6 +212,16 @@ uword Heap::AllocateOld(Thread* thread, intptr_t size, bool is_exec) {
 }
 
 bool Heap::AllocatedExternal(intptr_t size, Space space) {
+  if (ExceedsHardLimit(size >> kWordSizeLog2)) {
+    Thread* thread = Thread::Current();
+    if ((thread->no_callback_scope_depth() == 0) && !thread->force_growth()) {
+      CollectAllGarbage(GCReason::kMemoryPressure, /*compact=*/true);
+    }
+    if (ExceedsHardLimit(size >> kWordSizeLog2)) {
+      return false;
+    }
+  }
+
   if (space == kNew) {
     if (!new_space_.AllocatedExternal(size)) {
       return false;
@@ -458,6 +492,72 @@ Dart_PerformanceMode Heap::SetMode(Dart_PerformanceMode new_mode) {
   return old_mode;
 }
 
+void Heap::SetPauseTarget(int64_t target_micros,
+                          Dart_GCPauseTargetMissedCallback callback,
+                          void* callback_data) {
+  ASSERT(target_micros >= 0);
+  // A GC reports a missed target with the callback and its data, so they are
+  // replaced together while no GC is running.
+  Thread* thread = Thread::Current();
+  GcSafepointOperationScope safepoint_operation(thread);
+  if (target_micros != pause_target_micros_) {
+    // What was adapted to the old target says nothing about the new one.
+    new_space_.ResetPauseTargetAdaptation();
+    old_space_.ResetPauseTargetAdaptation();
+  }
+  pause_target_micros_ = target_micros;
+  pause_target_missed_callback_ = callback;
+  pause_target_missed_callback_data_ = callback_data;
+}
+
+void Heap::SetMemoryLimits(intptr_t soft_limit_in_bytes,
+                           intptr_t hard_limit_in_bytes,
+                           Dart_MemoryPressureCallback callback,
+                           void* callback_data) {
+  ASSERT(soft_limit_in_bytes >= 0);
+  ASSERT(hard_limit_in_bytes >= 0);
+  // Mutators read the limits and call the callback with its data outside of
+  // a safepoint, so they are replaced together while all mutators are
+  // stopped.
+  Thread* thread = Thread::Current();
+  GcSafepointOperationScope safepoint_operation(thread);
+  // Round up so that a small positive limit is not mistaken for no limit.
+  soft_limit_in_words_ =
+      Utils::RoundUp(soft_limit_in_bytes, kWordSize) >> kWordSizeLog2;
+  hard_limit_in_words_ =
+      Utils::RoundUp(hard_limit_in_bytes, kWordSize) >> kWordSizeLog2;
+  memory_pressure_callback_ = callback;
+  memory_pressure_callback_data_ = callback_data;
+  memory_pressure_signaled_ = false;
+}
+
+void Heap::CheckMemoryLimits(Thread* thread) {
+  ASSERT(!thread->force_growth());
+  if (!ReachedSoftLimit()) return;
+  // Only the mutator that crosses the limit reacts to it, until a GC finds
+  // the usage back under the limit.
+  bool signaled = false;
+  if (!memory_pressure_signaled_.compare_exchange_strong(signaled, true)) {
+    return;
+  }
+
+  const intptr_t before_in_words = LimitedUsageInWords();
+  CollectAllGarbage(GCReason::kMemoryPressure, /*compact=*/true);
+  const intptr_t after_in_words = LimitedUsageInWords();
+  if (FLAG_verbose_gc) {
+    OS::PrintErr("Soft memory limit of %" Pd "MB reached: %" Pd "MB -> %" Pd
+                 "MB\n",
+                 RoundWordsToMB(soft_limit_in_words_),
+                 RoundWordsToMB(before_in_words),
+                 RoundWordsToMB(after_in_words));
+  }
+  if (memory_pressure_callback_ != nullptr) {
+    memory_pressure_callback_(memory_pressure_callback_data_,
+                              before_in_words * kWordSize,
+                              after_in_words * kWordSize);
+  }
+}
+
 void Heap::CollectNewSpaceGarbage(Thread* thread,
                                   GCType type,
                                   GCReason reason) {
@@ -598,6 +698,10 @@ void Heap::CheckConcurrentMarking(Thread* thread,
                                   intptr_t size) {
   ASSERT(!thread->force_growth());
 
+  if (soft_limit_in_words_ != 0) {
+    CheckMemoryLimits(thread);
+  }
+
   PageSpace::Phase phase;
   {
     MonitorLocker ml(old_space_.tasks_lock());
@@ -825,6 +929,18 @@ intptr_t Heap::TotalExternalInWords() const {
   return ExternalInWords(kNew) + ExternalInWords(kOld);
 }
 
+bool Heap::ExceedsHardLimitLocked(intptr_t increase_in_words,
+                                  intptr_t old_capacity_in_words) const {
+  const intptr_t limit = hard_limit_in_words_;
+  if (limit == 0) {
+    return false;
+  }
+  const intptr_t usage_in_words = CapacityInWords(kNew) +
+                                  old_capacity_in_words +
+                                  TotalExternalInWords();
+  return usage_in_words + increase_in_words > limit;
+}
+
 int64_t Heap::GCTimeInMicros(Space space) const {
   if (space == kNew) {
     return new_space_.gc_time_micros();
@@ -881,6 +997,8 @@ const char* Heap::GCReasonToString(GCReason gc_reason) {
       return "debugging";
     case GCReason::kCatchUp:
       return "catch-up";
+    case GCReason::kMemoryPressure:
+      return "memory pressure";
     default:
       UNREACHABLE();
       return "";
@@ -1040,6 +1158,10 @@ void Heap::RecordAfterGC(GCType type) {
   stats_.after_.old_ = old_space_.GetCurrentUsage();
   stats_.after_.store_buffer_ = isolate_group_->store_buffer()->Size();
   RecordRSS();
+  EvaluatePauseTarget();
+  if (memory_pressure_signaled_ && !ReachedSoftLimit()) {
+    memory_pressure_signaled_ = false;
+  }
 #ifndef PRODUCT
   // For now we'll emit the same GC events on all isolates.
   if (Service::gc_stream.enabled()) {
@@ -1056,6 +1178,51 @@ void Heap::RecordAfterGC(GCType type) {
 #endif  // !PRODUCT
 }
 
+void Heap::EvaluatePauseTarget() {
+  const int64_t target_micros = pause_target_micros_;
+  if (target_micros <= 0) return;
+  const int64_t pause_micros = stats_.after_.micros_ - stats_.before_.micros_;
+
+  switch (stats_.type_) {
+    case GCType::kScavenge:
+    case GCType::kEvacuate:
+      new_space_.AdaptToPauseTarget(pause_micros, target_micros);
+      break;
+    case GCType::kMarkSweep:
+    case GCType::kMarkCompact:
+      old_space_.AdaptToPauseTarget(pause_micros, target_micros);
+      break;
+    default:
+      // Starting concurrent marking only visits the roots.
+      break;
+  }
+
+  if (pause_micros <= target_micros) return;
+  pause_target_misses_++;
+  const char* type = GCTypeToString(stats_.type_);
+  if (FLAG_verbose_gc) {
+    OS::PrintErr("%s took %" Pd64 "us, missing the pause target of %" Pd64
+                 "us\n",
+                 type, pause_micros, target_micros);
+  }
+#if defined(SUPPORT_TIMELINE)
+  TimelineEvent* event = Timeline::GetGCStream()->StartEvent();
+  if (event != nullptr) {
+    event->Instant("PauseTargetMissed");
+    event->SetNumArguments(4);
+    event->CopyArgument(0, "Type", type);
+    event->CopyArgument(1, "Reason", GCReasonToString(stats_.reason_));
+    event->FormatArgument(2, "Pause (us)", "%" Pd64, pause_micros);
+    event->FormatArgument(3, "Target (us)", "%" Pd64, target_micros);
+    event->Complete();
+  }
+#endif  // defined(SUPPORT_TIMELINE)
+  if (pause_target_missed_callback_ != nullptr) {
+    pause_target_missed_callback_(pause_target_missed_callback_data_, type,
+                                  pause_micros, target_micros);
+  }
+}
+
 void Heap::PrintStats() {
   if (!FLAG_verbose_gc) return;
 
@@ -103,6 +103,39 @@ class Heap {
   Dart_PerformanceMode mode() const { return mode_; }
   Dart_PerformanceMode SetMode(Dart_PerformanceMode mode);
 
+  // See Dart_SetGCPauseTarget. 0 means no target.
+  int64_t pause_target_micros() const { return pause_target_micros_; }
+  void SetPauseTarget(int64_t target_micros,
+                      Dart_GCPauseTargetMissedCallback callback,
+                      void* callback_data);
+  intptr_t pause_target_misses() const { return pause_target_misses_; }
+
+  // See Dart_SetIsolateGroupMemoryLimits. 0 means no limit.
+  intptr_t soft_limit_in_words() const { return soft_limit_in_words_; }
+  intptr_t hard_limit_in_words() const { return hard_limit_in_words_; }
+  void SetMemoryLimits(intptr_t soft_limit_in_bytes,
+                       intptr_t hard_limit_in_bytes,
+                       Dart_MemoryPressureCallback callback,
+                       void* callback_data);
+  // The usage the limits apply to: the capacity of both generations plus
+  // external allocations.
+  intptr_t LimitedUsageInWords() const {
+    return TotalCapacityInWords() + TotalExternalInWords();
+  }
+  // Whether growing by the given amount would exceed the hard limit.
+  bool ExceedsHardLimit(intptr_t increase_in_words) const {
+    const intptr_t limit = hard_limit_in_words_;
+    return (limit != 0) && (LimitedUsageInWords() + increase_in_words > limit);
+  }
+  // As above, for old-space while it holds its pages lock: the caller passes
+  // the old-space capacity, which cannot be queried under that lock.
+  bool ExceedsHardLimitLocked(intptr_t increase_in_words,
+                              intptr_t old_capacity_in_words) const;
+  bool ReachedSoftLimit() const {
+    const intptr_t limit = soft_limit_in_words_;
+    return (limit != 0) && (LimitedUsageInWords() >= limit);
+  }
+
   // Collect a single generation.
   void CollectGarbage(Thread* thread, GCType type, GCReason reason);
 
@@ -115,6 +148,7 @@ class Heap {
 
   void CheckCatchUp(Thread* thread);
   void CheckConcurrentMarking(Thread* thread, GCReason reason, intptr_t size);
+  void CheckMemoryLimits(Thread* thread);
   void CheckFinalizeMarking(Thread* thread);
   void StartConcurrentMarking(Thread* thread, GCReason reason);
   void WaitForMarkerTasks(Thread* thread);
@@ -340,6 +374,7 @@ class Heap {
   void RecordAfterGC(GCType type);
   void PrintStats();
   void PrintStatsToTimeline(TimelineEventScope* event, GCReason reason);
+  void EvaluatePauseTarget();
 
   void AddRegionsToObjectSet(ObjectSet* set) const;
 
@@ -361,6 +396,23 @@ class Heap {
 
   RelaxedAtomic<Dart_PerformanceMode> mode_ = {Dart_PerformanceMode_Default};
 
+  // Only changed by a mutator inside of a safepoint operation and only read
+  // inside of a safepoint, so no locking is needed.
+  RelaxedAtomic<int64_t> pause_target_micros_;
+  Dart_GCPauseTargetMissedCallback pause_target_missed_callback_ = nullptr;
+  void* pause_target_missed_callback_data_ = nullptr;
+  intptr_t pause_target_misses_ = 0;
+
+  // Set like the pause target, but also read by mutators allocating outside
+  // of a safepoint, which the safepoint operation setting them excludes.
+  RelaxedAtomic<intptr_t> soft_limit_in_words_;
+  RelaxedAtomic<intptr_t> hard_limit_in_words_;
+  Dart_MemoryPressureCallback memory_pressure_callback_ = nullptr;
+  void* memory_pressure_callback_data_ = nullptr;
+  // Set by the mutator that crossed the soft limit, cleared by the first GC
+  // that finds the usage back under it.
+  RelaxedAtomic<bool> memory_pressure_signaled_ = {false};
+
   // This heap is in read-only mode: No allocation is allowed.
   bool read_only_;
 
@@ -478,6 +530,13 @@ class GCTestHelper : public AllStatic {
     thread->heap()->CollectAllGarbage(GCReason::kDebugging, compact);
   }
 
+  // Makes the next incremental compaction size its evacuation as if the last
+  // one had moved this many bytes per microsecond.
+  static void SetEvacuationSpeed(intptr_t bytes_per_micro) {
+    Thread::Current()->heap()->old_space()->evacuated_bytes_per_micro_ =
+        bytes_per_micro;
+  }
+
   static void WaitForGCTasks() {
     Thread* thread = Thread::Current();
     ASSERT(thread->execution_state() == Thread::kThreadInVM);
@@ -16,6 +16,7 @@
 #include "vm/globals.h"
 #include "vm/heap/become.h"
 #include "vm/heap/heap.h"
+#include "vm/heap/incremental_compactor.h"
 #include "vm/message_handler.h"
 #include "vm/message_snapshot.h"
 #include "vm/object_graph.h"
@@ -26,6 +27,10 @@
 namespace dart {
 
 DECLARE_FLAG(int, early_tenuring_threshold);
+DECLARE_FLAG(bool, pretenure);
+DECLARE_FLAG(int, pretenure_min_survivor_size);
+DECLARE_FLAG(int, evacuation_live_threshold);
+DECLARE_FLAG(int, evacuation_pause_target);
 
 TEST_CASE(OldGC) {
   const char* kScriptChars =
@@ -1342,6 +1347,361 @@ ISOLATE_UNIT_TEST_CASE(CardRememberedWeakArray) {
   TestCardRememberedWeakArray(false);
 }
 
+static void AllocateSurvivingArrays(const Array& list, intptr_t length) {
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < list.Length(); i++) {
+    element = Array::New(length);
+    list.SetAt(i, element);
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(PretenureSurvivingClass) {
+  SetFlagScope<bool> sfs(&FLAG_pretenure, true);
+  Scavenger* new_space = thread->heap()->new_space();
+  EXPECT(!new_space->ShouldPretenure(kArrayCid));
+
+  // Large arrays that all survive.
+  const intptr_t kLength = 128;
+  const intptr_t num_arrays = 2 * MB / Array::InstanceSize(kLength);
+  const Array& list = Array::Handle(Array::New(num_arrays, Heap::kOld));
+  AllocateSurvivingArrays(list, kLength);
+  GCTestHelper::CollectNewSpace();
+
+  EXPECT(new_space->ShouldPretenure(kArrayCid));
+  Array& element = Array::Handle(Array::New(kLength));
+  EXPECT(element.ptr()->IsOldObject());
+  EXPECT(!new_space->ShouldPretenure(kOneByteStringCid));
+  EXPECT(String::Handle(String::New("young")).ptr()->IsNewObject());
+}
+
+ISOLATE_UNIT_TEST_CASE(PretenureOnlyLargeSurvivors) {
+  SetFlagScope<bool> sfs(&FLAG_pretenure, true);
+  Scavenger* new_space = thread->heap()->new_space();
+
+  // Small arrays that all survive.
+  const intptr_t kLength = 2;
+  EXPECT_LT(Array::InstanceSize(kLength), FLAG_pretenure_min_survivor_size);
+  const intptr_t num_arrays = 2 * MB / Array::InstanceSize(kLength);
+  const Array& list = Array::Handle(Array::New(num_arrays, Heap::kOld));
+  AllocateSurvivingArrays(list, kLength);
+  GCTestHelper::CollectNewSpace();
+  EXPECT(!new_space->ShouldPretenure(kArrayCid));
+
+  {
+    SetFlagScope<int> sfs_size(&FLAG_pretenure_min_survivor_size,
+                               Array::InstanceSize(kLength));
+    AllocateSurvivingArrays(list, kLength);
+    GCTestHelper::CollectNewSpace();
+    EXPECT(new_space->ShouldPretenure(kArrayCid));
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(PretenureReevaluatesClass) {
+  SetFlagScope<bool> sfs(&FLAG_pretenure, true);
+  Scavenger* new_space = thread->heap()->new_space();
+
+  const intptr_t kLength = 128;
+  const intptr_t num_arrays = 2 * MB / Array::InstanceSize(kLength);
+  const Array& list = Array::Handle(Array::New(num_arrays, Heap::kOld));
+  AllocateSurvivingArrays(list, kLength);
+  GCTestHelper::CollectNewSpace();
+  EXPECT(new_space->ShouldPretenure(kArrayCid));
+
+  // The class is sampled in new space again after a while.
+  for (intptr_t i = 0; i < Scavenger::kPretenureReevaluationScavenges; i++) {
+    GCTestHelper::CollectNewSpace();
+  }
+  EXPECT(!new_space->ShouldPretenure(kArrayCid));
+  EXPECT(Array::Handle(Array::New(kLength)).ptr()->IsNewObject());
+
+  // Arrays which now die young leave it in new space.
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < num_arrays; i++) {
+    element = Array::New(kLength);
+  }
+  element = Array::null();
+  GCTestHelper::CollectNewSpace();
+  EXPECT(!new_space->ShouldPretenure(kArrayCid));
+
+  // Arrays which survive again pretenure it again.
+  AllocateSurvivingArrays(list, kLength);
+  GCTestHelper::CollectNewSpace();
+  EXPECT(new_space->ShouldPretenure(kArrayCid));
+}
+
+DECLARE_FLAG(int, sweeper_tasks);
+
+ISOLATE_UNIT_TEST_CASE(ParallelConcurrentSweep) {
+  SetFlagScope<bool> sfs_concurrent(&FLAG_concurrent_sweep, true);
+  SetFlagScope<int> sfs_tasks(&FLAG_sweeper_tasks, 4);
+  GCTestHelper::CollectOldSpace();
+  PageSpace* old_space = thread->heap()->old_space();
+
+  // Many pages, each with a few survivors.
+  const intptr_t kLength = 1000;
+  const intptr_t kSurvivors = 1000;
+  const Array& survivors = Array::Handle(Array::New(kSurvivors, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < 10 * kSurvivors; i++) {
+    element = Array::New(kLength, Heap::kOld);
+    element.SetAt(0, Smi::Handle(Smi::New(i)));
+    if ((i % 10) == 0) survivors.SetAt(i / 10, element);
+  }
+  element = Array::null();
+
+  // The sweeper tasks cannot move on to the regular pages while the tasks
+  // lock is held, so an allocation then sweeps pages itself, unless the
+  // tasks got there first.
+  const intptr_t kMaxAttempts = 10;
+  const intptr_t tasks_run_before = old_space->sweeper_tasks_run();
+  intptr_t attempts = 0;
+  intptr_t lazily_swept_pages = 0;
+  while ((lazily_swept_pages == 0) && (attempts < kMaxAttempts)) {
+    attempts++;
+    const intptr_t lazily_swept_pages_before =
+        old_space->lazily_swept_pages();
+    thread->heap()->CollectGarbage(thread, GCType::kMarkSweep,
+                                   GCReason::kDebugging);
+    {
+      MonitorLocker ml(old_space->tasks_lock());
+      const intptr_t size = Array::InstanceSize(kLength);
+      const uword addr = old_space->TryAllocate(size, /*is_executable=*/false,
+                                                PageSpace::kForceGrowth);
+      EXPECT(addr != 0);
+      FreeListElement::AsElement(addr, size);
+    }
+    lazily_swept_pages =
+        old_space->lazily_swept_pages() - lazily_swept_pages_before;
+    GCTestHelper::WaitForGCTasks();
+  }
+  EXPECT(lazily_swept_pages > 0);
+  EXPECT_EQ(4 * attempts, old_space->sweeper_tasks_run() - tasks_run_before);
+
+  for (intptr_t i = 0; i < kSurvivors; i++) {
+    element ^= survivors.At(i);
+    EXPECT_EQ(kLength, element.Length());
+    EXPECT_EQ(Smi::New(10 * i), element.At(0));
+  }
+  thread->heap()->Verify("parallel concurrent sweep");
+}
+
+static intptr_t pause_target_misses = 0;
+
+static void PauseTargetMissed(void* callback_data,
+                              const char* gc_type,
+                              int64_t pause_micros,
+                              int64_t target_micros) {
+  EXPECT(callback_data == &pause_target_misses);
+  EXPECT(gc_type != nullptr);
+  EXPECT_EQ(1, target_micros);
+  EXPECT(pause_micros > target_micros);
+  pause_target_misses++;
+}
+
+TEST_CASE(GCPauseTargetMissed) {
+  // No collection is that fast.
+  Dart_SetGCPauseTarget(1, PauseTargetMissed, &pause_target_misses);
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectNewSpace();
+    EXPECT(pause_target_misses >= 1);
+    GCTestHelper::CollectOldSpace();
+    EXPECT(pause_target_misses >= 2);
+    EXPECT_EQ(pause_target_misses, thread->heap()->pause_target_misses());
+  }
+
+  Dart_SetGCPauseTarget(0, nullptr, nullptr);
+  {
+    TransitionNativeToVM transition(thread);
+    const intptr_t misses = pause_target_misses;
+    GCTestHelper::CollectNewSpace();
+    GCTestHelper::CollectOldSpace();
+    EXPECT_EQ(misses, pause_target_misses);
+  }
+}
+
+static void ExpectNotAdaptedToPauseTarget(Heap* heap) {
+  EXPECT_EQ(kIntptrMax, heap->new_space()->pause_limit_in_words());
+  EXPECT_EQ(FLAG_marker_tasks, heap->old_space()->marker_tasks());
+  EXPECT_EQ(100, heap->old_space()->concurrent_mark_start_percent());
+}
+
+static void AdaptToUnreachablePauseTarget(Heap* heap) {
+  // No collection is that fast.
+  heap->SetPauseTarget(1, nullptr, nullptr);
+  GCTestHelper::CollectNewSpace();
+  GCTestHelper::CollectOldSpace();
+  EXPECT(heap->new_space()->pause_limit_in_words() < kIntptrMax);
+  EXPECT(heap->old_space()->concurrent_mark_start_percent() < 100);
+}
+
+ISOLATE_UNIT_TEST_CASE(GCPauseTargetCleared) {
+  Heap* heap = thread->heap();
+  ExpectNotAdaptedToPauseTarget(heap);
+
+  AdaptToUnreachablePauseTarget(heap);
+  heap->SetPauseTarget(0, nullptr, nullptr);
+  ExpectNotAdaptedToPauseTarget(heap);
+
+  AdaptToUnreachablePauseTarget(heap);
+  heap->SetPauseTarget(kMicrosecondsPerSecond, nullptr, nullptr);
+  ExpectNotAdaptedToPauseTarget(heap);
+
+  heap->SetPauseTarget(0, nullptr, nullptr);
+}
+
+// However slow evacuation is, a budget for a pause target lets the fullest
+// candidate page be evacuated.
+static void TestEvacuationBudgetFitsCandidate(intptr_t live_threshold) {
+  SetFlagScope<int> sfs(&FLAG_evacuation_live_threshold, live_threshold);
+  const intptr_t threshold = GCIncrementalCompactor::EvacuationThreshold();
+  EXPECT_EQ(kPageSize * live_threshold / 100, threshold);
+  EXPECT(GCIncrementalCompactor::EvacuationBudgetFor(
+             /*bytes_per_micro=*/1, /*target_micros=*/1) >= threshold);
+  EXPECT_EQ(100 * threshold,
+            GCIncrementalCompactor::EvacuationBudgetFor(
+                /*bytes_per_micro=*/threshold, /*target_micros=*/100));
+  // Saturates rather than overflows.
+  EXPECT_EQ(kIntptrMax, GCIncrementalCompactor::EvacuationBudgetFor(
+                            /*bytes_per_micro=*/kIntptrMax / 2,
+                            /*target_micros=*/1000));
+}
+
+VM_UNIT_TEST_CASE(EvacuationBudgetFitsCandidate) {
+  TestEvacuationBudgetFitsCandidate(50);
+  TestEvacuationBudgetFitsCandidate(90);
+  TestEvacuationBudgetFitsCandidate(100);
+}
+
+// An incremental compaction only evacuates as many of the sparse pages as
+// its budget allows.
+ISOLATE_UNIT_TEST_CASE(IncrementalCompactionStaysWithinBudget) {
+  PageSpace* old_space = thread->heap()->old_space();
+  const intptr_t kLength = 100;
+  const intptr_t kSurvivors = 2000;
+  const Array& survivors = Array::Handle(Array::New(kSurvivors, Heap::kOld));
+  {
+    // Many pages with a tenth of their bytes live, which are all candidates
+    // for evacuation.
+    SetFlagScope<bool> sfs(&FLAG_use_incremental_compactor, false);
+    GCTestHelper::CollectOldSpace();
+    Array& element = Array::Handle();
+    for (intptr_t i = 0; i < 10 * kSurvivors; i++) {
+      element = Array::New(kLength, Heap::kOld);
+      element.SetAt(0, Smi::Handle(Smi::New(i)));
+      if ((i % 10) == 0) survivors.SetAt(i / 10, element);
+    }
+    GCTestHelper::CollectOldSpace();
+  }
+
+  {
+    // As slow as can be, so that the budget only allows the live bytes of one
+    // candidate page.
+    SetFlagScope<bool> sfs_compactor(&FLAG_use_incremental_compactor, true);
+    SetFlagScope<int> sfs_target(&FLAG_evacuation_pause_target, 1);
+    GCTestHelper::SetEvacuationSpeed(1);
+    const intptr_t budget = GCIncrementalCompactor::EvacuationThreshold();
+    GCTestHelper::CollectOldSpace();
+    EXPECT(old_space->evacuated_bytes() > 0);
+    EXPECT(old_space->evacuated_bytes() <= budget);
+  }
+
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kSurvivors; i++) {
+    element ^= survivors.At(i);
+    EXPECT_EQ(kLength, element.Length());
+    EXPECT_EQ(Smi::New(10 * i), element.At(0));
+  }
+  thread->heap()->Verify("incremental compaction within budget");
+}
+
+static intptr_t memory_pressure_signals = 0;
+
+static void MemoryPressure(void* callback_data,
+                           intptr_t usage_before_bytes,
+                           intptr_t usage_after_bytes) {
+  EXPECT_EQ(&memory_pressure_signals, callback_data);
+  EXPECT(usage_before_bytes > 0);
+  EXPECT(usage_after_bytes > 0);
+  memory_pressure_signals++;
+}
+
+static void NopFinalizer(void* isolate_callback_data, void* peer) {}
+
+// Returns the length of the allocated list, or -1 if it did not fit.
+static int64_t AllocateList(Dart_Handle lib, int64_t length) {
+  Dart_Handle args[] = {Dart_NewInteger(length)};
+  Dart_Handle result = Dart_Invoke(lib, NewString("allocate"), 1, args);
+  EXPECT_VALID(result);
+  int64_t value = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+  return value;
+}
+
+TEST_CASE(IsolateGroupMemoryLimits) {
+  const char* kScriptChars = R"(
+    allocate(int length) {
+      try {
+        return List.filled(length, null).length;
+      } on OutOfMemoryError {
+        return -1;
+      }
+    }
+  )";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  EXPECT_VALID(lib);
+
+  intptr_t usage;
+  {
+    TransitionNativeToVM transition(thread);
+    usage = thread->heap()->LimitedUsageInWords() * kWordSize;
+  }
+
+  // Growing old-space past the soft limit collects and signals.
+  Dart_SetIsolateGroupMemoryLimits(usage, 0, MemoryPressure,
+                                   &memory_pressure_signals);
+  EXPECT_EQ(MB, AllocateList(lib, MB));
+  EXPECT(memory_pressure_signals >= 1);
+
+  {
+    TransitionNativeToVM transition(thread);
+    usage = thread->heap()->LimitedUsageInWords() * kWordSize;
+  }
+
+  // Allocations past the hard limit fail, smaller ones still succeed.
+  Dart_SetIsolateGroupMemoryLimits(0, usage + 64 * MB, nullptr, nullptr);
+  EXPECT_EQ(-1, AllocateList(lib, 64 * MB));
+  EXPECT_EQ(KB, AllocateList(lib, KB));
+
+  // Old-space still grows below the hard limit, by large pages and by
+  // regular pages.
+  EXPECT_EQ(MB, AllocateList(lib, MB));
+  {
+    TransitionNativeToVM transition(thread);
+    HANDLESCOPE(thread);
+    Heap* heap = thread->heap();
+    const intptr_t capacity = heap->CapacityInWords(Heap::kOld);
+    const intptr_t kLength = 8;
+    const intptr_t count = 4 * kPageSize / Array::InstanceSize(kLength);
+    const Array& holder = Array::Handle(Array::New(count, Heap::kOld));
+    for (intptr_t i = 0; i < count; i++) {
+      holder.SetAt(i, Array::Handle(Array::New(kLength, Heap::kOld)));
+    }
+    EXPECT(heap->CapacityInWords(Heap::kOld) > capacity);
+    EXPECT(!heap->ExceedsHardLimit(0));
+  }
+
+  Dart_Handle list = Dart_NewList(1);
+  EXPECT_VALID(list);
+  EXPECT(Dart_NewFinalizableHandle(list, nullptr, 128 * MB, NopFinalizer) ==
+         nullptr);
+  EXPECT(Dart_NewFinalizableHandle(list, nullptr, KB, NopFinalizer) !=
+         nullptr);
+
+  Dart_SetIsolateGroupMemoryLimits(0, 0, nullptr, nullptr);
+  EXPECT_EQ(KB, AllocateList(lib, KB));
+}
+
 struct ExistingObject;
 
 static constexpr uword kMarkBit = 1;
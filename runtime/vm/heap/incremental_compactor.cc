@@ -18,6 +18,19 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            evacuation_live_threshold,
+            50,
+            "Only evacuate old-space pages with at most this percentage of "
+            "live bytes.");
+DEFINE_FLAG(int,
+            evacuation_pause_target,
+            0,
+            "If positive, size each incremental compaction so that its "
+            "stop-the-world step takes about this many milliseconds. Otherwise "
+            "use half of the heap's pause target, or without one evacuate up "
+            "to a quarter of new-space's size.");
+
 void GCIncrementalCompactor::Prologue(PageSpace* old_space) {
   ASSERT(Thread::Current()->OwnsGCSafepoint());
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "StartIncrementalCompact");
@@ -36,7 +49,14 @@ bool GCIncrementalCompactor::Epilogue(PageSpace* old_space) {
   old_space->MakeIterable();
   CheckFreeLists(old_space);
   CheckPreEvacuate(old_space);
-  Evacuate(old_space);
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  const intptr_t bytes_evacuated = Evacuate(old_space);
+  const int64_t micros = OS::GetCurrentMonotonicMicros() - start;
+  old_space->evacuated_bytes_ = bytes_evacuated;
+  if (bytes_evacuated > 0) {
+    old_space->evacuated_bytes_per_micro_ = Utils::Maximum<intptr_t>(
+        1, bytes_evacuated / Utils::Maximum<int64_t>(1, micros));
+  }
   CheckPostEvacuate(old_space);
   CheckFreeLists(old_space);
   FreeEvacuatedPages(old_space);
@@ -147,8 +167,8 @@ class PrologueTask : public SafepointTask {
     for (;;) {
       intptr_t chunk = state_->freelist_cursor.fetch_add(1);
       if (chunk >= state_->freelist_limit) break;
-      intptr_t list_index = chunk / (FreeList::kNumLists + 1);
-      intptr_t size_class_index = chunk % (FreeList::kNumLists + 1);
+      intptr_t list_index = chunk / FreeList::kNumSizeClasses;
+      intptr_t size_class_index = chunk % FreeList::kNumSizeClasses;
       FreeList* freelist = &old_space_->freelists_[list_index];
 
       // Empty bump-region, no need to prune this.
@@ -174,15 +194,52 @@ class PrologueTask : public SafepointTask {
   DISALLOW_COPY_AND_ASSIGN(PrologueTask);
 };
 
+intptr_t GCIncrementalCompactor::EvacuationBudget(PageSpace* old_space) {
+  // By default, this puts a bound on the stop-the-world evacuate step that is
+  // similar to the existing longest stop-the-world step of the scavenger.
+  const intptr_t default_budget =
+      (old_space->heap_->new_space()->ThresholdInWords() << kWordSizeLog2) / 4;
+  // Evacuation shares its pause with the end of marking, so it gets half of
+  // the heap's pause target.
+  const int64_t target_micros =
+      FLAG_evacuation_pause_target > 0
+          ? static_cast<int64_t>(FLAG_evacuation_pause_target) * 1000
+          : old_space->heap_->pause_target_micros() / 2;
+  if ((target_micros <= 0) || (old_space->evacuated_bytes_per_micro_ == 0)) {
+    return default_budget;
+  }
+
+  return EvacuationBudgetFor(old_space->evacuated_bytes_per_micro_,
+                             target_micros);
+}
+
+intptr_t GCIncrementalCompactor::EvacuationThreshold() {
+  // Only evacuate pages that are sparse enough for the copying to pay off.
+  return kPageSize * Utils::Minimum(FLAG_evacuation_live_threshold, 100) / 100;
+}
+
+intptr_t GCIncrementalCompactor::EvacuationBudgetFor(intptr_t bytes_per_micro,
+                                                     int64_t target_micros) {
+  // The speed includes the forwarding work, which does not shrink with the
+  // evacuated bytes, so a slow step shrinks the next budget until the pause
+  // settles near the target. Always allow the fullest candidate page so that
+  // fragmentation keeps being reduced.
+  ASSERT(bytes_per_micro > 0);
+  ASSERT(target_micros >= 0);
+  int64_t budget = kMaxInt64;
+  if (target_micros <= kMaxInt64 / bytes_per_micro) {
+    budget = static_cast<int64_t>(bytes_per_micro) * target_micros;
+  }
+  return Utils::Maximum<intptr_t>(
+      EvacuationThreshold(),
+      static_cast<intptr_t>(Utils::Minimum<int64_t>(budget, kIntptrMax)));
+}
+
 bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
-  // Only evacuate pages that are at least half empty.
-  constexpr intptr_t kEvacuationThreshold = kPageSize / 2;
+  const intptr_t kEvacuationThreshold = EvacuationThreshold();
 
-  // Evacuate no more than this amount of objects. This puts a bound on the
-  // stop-the-world evacuate step that is similar to the existing longest
-  // stop-the-world step of the scavenger.
-  const intptr_t kMaxEvacuatedBytes =
-      (old_space->heap_->new_space()->ThresholdInWords() << kWordSizeLog2) / 4;
+  // Evacuate no more than this amount of objects.
+  const intptr_t kMaxEvacuatedBytes = EvacuationBudget(old_space);
 
   PrologueState state;
   {
@@ -214,18 +271,19 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
     }
 
 #if defined(SUPPORT_TIMELINE)
-    tbes.SetNumArguments(2);
+    tbes.SetNumArguments(3);
     tbes.FormatArgument(0, "cumulative_live_bytes", "%" Pd,
                         cumulative_live_bytes);
     tbes.FormatArgument(1, "num_candidates", "%" Pd, num_candidates);
+    tbes.FormatArgument(2, "budget_bytes", "%" Pd, kMaxEvacuatedBytes);
 #endif
 
     state.page_cursor = 0;
     state.page_limit = num_candidates;
     state.freelist_cursor =
-        PageSpace::kDataFreelist * (FreeList::kNumLists + 1);
+        PageSpace::kDataFreelist * FreeList::kNumSizeClasses;
     state.freelist_limit =
-        old_space->num_freelists_ * (FreeList::kNumLists + 1);
+        old_space->num_freelists_ * FreeList::kNumSizeClasses;
 
     if (num_candidates == 0) return false;
   }
@@ -251,6 +309,13 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
     for (intptr_t j = 0; j < FreeList::kNumLists; j++) {
       freelist->free_map_.Set(j, freelist->free_lists_[j] != nullptr);
     }
+    freelist->last_free_small_size_ =
+        freelist->free_map_.Last() * kObjectAlignment;
+    freelist->large_map_.Reset();
+    for (intptr_t j = 0; j < FreeList::kNumLargeLists; j++) {
+      freelist->large_map_.Set(
+          j, freelist->free_lists_[FreeList::kNumLists + j] != nullptr);
+    }
   }
 
   return true;
@@ -265,7 +330,7 @@ void GCIncrementalCompactor::CheckFreeLists(PageSpace* old_space) {
       Page* page = Page::Of(freelist->top_);
       ASSERT(!page->is_evacuation_candidate());
     }
-    for (intptr_t j = 0; j <= FreeList::kNumLists; j++) {
+    for (intptr_t j = 0; j < FreeList::kNumSizeClasses; j++) {
       FreeListElement* current = freelist->free_lists_[j];
       while (current != nullptr) {
         Page* page = Page::Of(reinterpret_cast<uword>(current));
@@ -583,6 +648,9 @@ class EpilogueState {
   void AddNewFreeSize(intptr_t size) { new_free_size_ += size; }
   intptr_t NewFreeSize() { return new_free_size_; }
 
+  void AddEvacuatedSize(intptr_t size) { evacuated_size_ += size; }
+  intptr_t EvacuatedSize() { return evacuated_size_; }
+
  private:
   Page* evac_page_;
   StoreBufferBlock* block_;
@@ -596,6 +664,7 @@ class EpilogueState {
   RelaxedAtomic<bool> roots_slice_ = {true};
   RelaxedAtomic<bool> reset_progress_bars_slice_ = {true};
   RelaxedAtomic<intptr_t> new_free_size_ = {0};
+  RelaxedAtomic<intptr_t> evacuated_size_ = {0};
 };
 
 class EpilogueTask : public SafepointTask {
@@ -732,6 +801,7 @@ class EpilogueTask : public SafepointTask {
 
     old_space_->ReleaseLock(freelist_);
     old_space_->usage_.used_in_words -= (bytes_evacuated >> kWordSizeLog2);
+    state_->AddEvacuatedSize(bytes_evacuated);
 #if defined(SUPPORT_TIMELINE)
     tbes.SetNumArguments(1);
     tbes.FormatArgument(0, "bytes_evacuated", "%" Pd, bytes_evacuated);
@@ -825,7 +895,7 @@ class EpilogueTask : public SafepointTask {
   EpilogueState* state_;
 };
 
-void GCIncrementalCompactor::Evacuate(PageSpace* old_space) {
+intptr_t GCIncrementalCompactor::Evacuate(PageSpace* old_space) {
   IsolateGroup* isolate_group = IsolateGroup::Current();
   isolate_group->ReleaseStoreBuffers();
   EpilogueState state(
@@ -847,6 +917,7 @@ void GCIncrementalCompactor::Evacuate(PageSpace* old_space) {
 
   old_space->heap_->new_space()->set_freed_in_words(state.NewFreeSize() >>
                                                     kWordSizeLog2);
+  return state.EvacuatedSize();
 }
 
 void GCIncrementalCompactor::CheckPostEvacuate(PageSpace* old_space) {
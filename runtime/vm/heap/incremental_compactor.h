@@ -23,13 +23,22 @@ class GCIncrementalCompactor : public AllStatic {
   static bool Epilogue(PageSpace* old_space);
   static void Abort(PageSpace* old_space);
 
+  // Pages with at most this many live bytes are evacuated. See
+  // --evacuation_live_threshold.
+  static intptr_t EvacuationThreshold();
+  // The number of bytes to evacuate at 'bytes_per_micro' so that evacuation
+  // takes about 'target_micros', but at least one candidate page.
+  static intptr_t EvacuationBudgetFor(intptr_t bytes_per_micro,
+                                      int64_t target_micros);
+
  private:
+  static intptr_t EvacuationBudget(PageSpace* old_space);
   static bool SelectEvacuationCandidates(PageSpace* old_space);
   static void CheckFreeLists(PageSpace* old_space);
 
   static bool HasEvacuationCandidates(PageSpace* old_space);
   static void CheckPreEvacuate(PageSpace* old_space);
-  static void Evacuate(PageSpace* old_space);
+  static intptr_t Evacuate(PageSpace* old_space);
   static void CheckPostEvacuate(PageSpace* old_space);
   static void FreeEvacuatedPages(PageSpace* old_space);
   static void VerifyAfterIncrementalCompaction(PageSpace* old_space);
@@ -281,7 +281,7 @@ class MarkingVisitor : public ObjectPointerVisitor {
     } while (ProcessPendingWeakProperties());
   }
 
-  void ProcessOldMarkingStackUntil(int64_t deadline) {
+  void ProcessMarkingStackUntil(int64_t deadline) {
     // We check the clock *before* starting a batch of work, but we want to
     // *end* work before the deadline. So we compare to the deadline adjusted
     // by a conservative estimate of the duration of one batch of work.
@@ -295,18 +295,34 @@ class MarkingVisitor : public ObjectPointerVisitor {
     constexpr intptr_t kBudget = 512 * KB;
 
     while ((OS::GetCurrentMonotonicMicros() < deadline) &&
-           ProcessOldMarkingStack(kBudget)) {
+           ProcessMarkingStack(kBudget)) {
     }
   }
 
-  bool ProcessOldMarkingStack(intptr_t remaining_budget) {
+  // Contributes to concurrent marking from a mutator or a thread assisting
+  // it. Like the concurrent marker tasks, this also drains the new-space
+  // marking stack, so the new-space objects reached through the write barrier
+  // after the tasks have finished are not all left to the final marking pause.
+  bool ProcessMarkingStack(intptr_t remaining_budget) {
+    ASSERT(concurrent_);
     Thread* thread = Thread::Current();
     do {
       // First drain the marking stacks.
       ObjectPtr obj;
-      while (old_work_list_.Pop(&obj)) {
+      while (MarkerWorkList::Pop(&old_work_list_, &new_work_list_, &obj)) {
         ASSERT(!has_evacuation_candidate_);
 
+        if (obj->IsNewObject() && InTLAB(obj)) {
+          // See DrainMarkingStackWithPauseChecks. Charge a little so that
+          // objects that are deferred again are not free to revisit.
+          tlab_deferred_work_list_.Push(obj);
+          remaining_budget -= kObjectAlignment;
+          if (remaining_budget < 0) {
+            return true;  // More to mark.
+          }
+          continue;
+        }
+
         const intptr_t class_id = obj->GetClassIdOfHeapObject();
         ASSERT(class_id != kIllegalCid);
         ASSERT(class_id != kFreeListElement);
@@ -321,7 +337,7 @@ class MarkingVisitor : public ObjectPointerVisitor {
           size = ProcessWeakArray(static_cast<WeakArrayPtr>(obj));
         } else if (class_id == kFinalizerEntryCid) {
           size = ProcessFinalizerEntry(static_cast<FinalizerEntryPtr>(obj));
-        } else if (concurrent_ && class_id == kSuspendStateCid) {
+        } else if (class_id == kSuspendStateCid) {
           // Shape changing is not compatible with concurrent marking.
           deferred_work_list_.Push(obj);
           size = obj->untag()->HeapSize();
@@ -329,7 +345,11 @@ class MarkingVisitor : public ObjectPointerVisitor {
           if ((class_id == kArrayCid) || (class_id == kImmutableArrayCid)) {
             size = obj->untag()->HeapSize();
             if (size > remaining_budget) {
-              old_work_list_.Push(obj);
+              if (obj->IsNewObject()) {
+                new_work_list_.Push(obj);
+              } else {
+                old_work_list_.Push(obj);
+              }
               return true;  // More to mark.
             }
           }
@@ -347,7 +367,9 @@ class MarkingVisitor : public ObjectPointerVisitor {
             thread->StoreBufferAddObjectGC(obj);
           }
         }
-        marked_bytes_ += size;
+        if (!obj->IsNewObject()) {
+          marked_bytes_ += size;
+        }
         remaining_budget -= size;
         if (remaining_budget < 0) {
           return true;  // More to mark.
@@ -511,7 +533,10 @@ class MarkingVisitor : public ObjectPointerVisitor {
     new_work_list_.Finalize();
     tlab_deferred_work_list_.Finalize();
     deferred_work_list_.Finalize();
-    MournFinalizerEntries();
+    {
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "MournFinalizerEntries");
+      MournFinalizerEntries();
+    }
     // MournFinalizerEntries inserts newly discovered dead entries into the
     // linked list attached to the Finalizer. This might create
     // cross-generational references which might be added to the store
@@ -934,52 +959,21 @@ class ParallelMarkTask : public SafepointTask {
 
       visitor_->ProcessDeferredMarking();
 
-      bool more_to_mark = false;
-      do {
-        do {
-          visitor_->DrainMarkingStack();
-        } while (visitor_->WaitForWork(num_busy_));
-        // Wait for all markers to stop.
-        barrier_->Sync();
-#if defined(DEBUG)
-        ASSERT(num_busy_->load() == 0);
-        // Caveat: must not allow any marker to continue past the barrier
-        // before we checked num_busy, otherwise one of them might rush
-        // ahead and increment it.
-        barrier_->Sync();
-#endif
-        // Check if we have any pending properties with marked keys.
-        // Those might have been marked by another marker.
-        more_to_mark = visitor_->ProcessPendingWeakProperties();
-        if (more_to_mark) {
-          // We have more work to do. Notify others.
-          num_busy_->fetch_add(1u);
-        }
-
-        // Wait for all other markers to finish processing their pending
-        // weak properties and decide if they need to continue marking.
-        // Caveat: we need two barriers here to make this decision in lock step
-        // between all markers and the main thread.
-        barrier_->Sync();
-        if (!more_to_mark && (num_busy_->load() > 0)) {
-          // All markers continue to mark as long as any single marker has
-          // some work to do.
-          num_busy_->fetch_add(1u);
-          more_to_mark = true;
-        }
-        barrier_->Sync();
-      } while (more_to_mark);
+      DrainMarkingStacks(thread);
 
       // Phase 2: deferred marking.
       visitor_->ProcessDeferredMarking();
       barrier_->Sync();
 
       // Phase 3: Weak processing and statistics.
-      visitor_->MournWeakProperties();
-      visitor_->MournWeakReferences();
-      visitor_->MournWeakArrays();
-      // Don't MournFinalizerEntries here, do it on main thread, so that we
-      // don't have to coordinate workers.
+      {
+        TIMELINE_FUNCTION_GC_DURATION(thread, "MournWeak");
+        visitor_->MournWeakProperties();
+        visitor_->MournWeakReferences();
+        visitor_->MournWeakArrays();
+        // Don't MournFinalizerEntries here, do it on main thread, so that we
+        // don't have to coordinate workers.
+      }
 
       thread->ReleaseStoreBuffer();  // Ahead of IterateWeak
       barrier_->Sync();
@@ -994,6 +988,45 @@ class ParallelMarkTask : public SafepointTask {
   }
 
  private:
+  void DrainMarkingStacks(Thread* thread) {
+    TIMELINE_FUNCTION_GC_DURATION(thread, "DrainMarkingStack");
+    bool more_to_mark = false;
+    do {
+      do {
+        visitor_->DrainMarkingStack();
+      } while (visitor_->WaitForWork(num_busy_));
+      // Wait for all markers to stop.
+      barrier_->Sync();
+#if defined(DEBUG)
+      ASSERT(num_busy_->load() == 0);
+      // Caveat: must not allow any marker to continue past the barrier
+      // before we checked num_busy, otherwise one of them might rush
+      // ahead and increment it.
+      barrier_->Sync();
+#endif
+      // Check if we have any pending properties with marked keys.
+      // Those might have been marked by another marker.
+      more_to_mark = visitor_->ProcessPendingWeakProperties();
+      if (more_to_mark) {
+        // We have more work to do. Notify others.
+        num_busy_->fetch_add(1u);
+      }
+
+      // Wait for all other markers to finish processing their pending
+      // weak properties and decide if they need to continue marking.
+      // Caveat: we need two barriers here to make this decision in lock step
+      // between all markers and the main thread.
+      barrier_->Sync();
+      if (!more_to_mark && (num_busy_->load() > 0)) {
+        // All markers continue to mark as long as any single marker has
+        // some work to do.
+        num_busy_->fetch_add(1u);
+        more_to_mark = true;
+      }
+      barrier_->Sync();
+    } while (more_to_mark);
+  }
+
   GCMarker* marker_;
   MarkingStack* marking_stack_;
   MarkingVisitor* visitor_;
@@ -1080,7 +1113,7 @@ intptr_t GCMarker::MarkedWordsPerMicro() const {
   if (marked_words_per_job_micro == 0) {
     marked_words_per_job_micro = 1;  // Prevent division by zero.
   }
-  intptr_t jobs = FLAG_marker_tasks;
+  intptr_t jobs = num_tasks_;
   if (jobs == 0) {
     jobs = 1;  // Marking on main thread is still one job.
   }
@@ -1096,10 +1129,11 @@ GCMarker::GCMarker(IsolateGroup* isolate_group, Heap* heap)
       deferred_marking_stack_(),
       global_list_(),
       visitors_(),
+      num_tasks_(heap->old_space()->marker_tasks()),
       marked_bytes_(0),
       marked_micros_(0) {
-  visitors_ = new MarkingVisitor*[FLAG_marker_tasks];
-  for (intptr_t i = 0; i < FLAG_marker_tasks; i++) {
+  visitors_ = new MarkingVisitor*[num_tasks_];
+  for (intptr_t i = 0; i < num_tasks_; i++) {
     visitors_[i] = nullptr;
   }
 }
@@ -1109,7 +1143,7 @@ GCMarker::~GCMarker() {
   // marker and before finalizing.
   if (isolate_group_->old_marking_stack() != nullptr) {
     isolate_group_->DisableIncrementalBarrier();
-    for (intptr_t i = 0; i < FLAG_marker_tasks; i++) {
+    for (intptr_t i = 0; i < num_tasks_; i++) {
       visitors_[i]->AbandonWork();
       delete visitors_[i];
     }
@@ -1121,7 +1155,7 @@ void GCMarker::StartConcurrentMark(PageSpace* page_space) {
   isolate_group_->EnableIncrementalBarrier(
       &old_marking_stack_, &new_marking_stack_, &deferred_marking_stack_);
 
-  const intptr_t num_tasks = FLAG_marker_tasks;
+  const intptr_t num_tasks = num_tasks_;
 
   {
     // Bulk increase task count before starting any task, instead of
@@ -1178,15 +1212,22 @@ void GCMarker::StartConcurrentMark(PageSpace* page_space) {
   }
 }
 
+void GCMarker::RetryTLABDeferred() {
+  // Objects whose TLAB has been released since they were deferred can now be
+  // scanned concurrently. The others are deferred again.
+  new_marking_stack_.PushAll(tlab_deferred_marking_stack_.PopAll());
+}
+
 void GCMarker::IncrementalMarkWithUnlimitedBudget(PageSpace* page_space) {
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(),
                                 "IncrementalMarkWithUnlimitedBudget");
 
+  RetryTLABDeferred();
   MarkingVisitor visitor(isolate_group_, page_space, &old_marking_stack_,
                          &new_marking_stack_, &tlab_deferred_marking_stack_,
                          &deferred_marking_stack_);
   int64_t start = OS::GetCurrentMonotonicMicros();
-  visitor.ProcessOldMarkingStack(kIntptrMax);
+  visitor.ProcessMarkingStack(kIntptrMax);
   int64_t stop = OS::GetCurrentMonotonicMicros();
   visitor.AddMicros(stop - start);
   {
@@ -1207,11 +1248,12 @@ void GCMarker::IncrementalMarkWithSizeBudget(PageSpace* page_space,
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(),
                                 "IncrementalMarkWithSizeBudget");
 
+  RetryTLABDeferred();
   MarkingVisitor visitor(isolate_group_, page_space, &old_marking_stack_,
                          &new_marking_stack_, &tlab_deferred_marking_stack_,
                          &deferred_marking_stack_);
   int64_t start = OS::GetCurrentMonotonicMicros();
-  visitor.ProcessOldMarkingStack(size);
+  visitor.ProcessMarkingStack(size);
   int64_t stop = OS::GetCurrentMonotonicMicros();
   visitor.AddMicros(stop - start);
   {
@@ -1227,11 +1269,12 @@ void GCMarker::IncrementalMarkWithTimeBudget(PageSpace* page_space,
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(),
                                 "IncrementalMarkWithTimeBudget");
 
+  RetryTLABDeferred();
   MarkingVisitor visitor(isolate_group_, page_space, &old_marking_stack_,
                          &new_marking_stack_, &tlab_deferred_marking_stack_,
                          &deferred_marking_stack_);
   int64_t start = OS::GetCurrentMonotonicMicros();
-  visitor.ProcessOldMarkingStackUntil(deadline);
+  visitor.ProcessMarkingStackUntil(deadline);
   int64_t stop = OS::GetCurrentMonotonicMicros();
   visitor.AddMicros(stop - start);
   {
@@ -1297,7 +1340,7 @@ void GCMarker::MarkObjects(PageSpace* page_space) {
 
   Prologue();
 
-  const int num_tasks = FLAG_marker_tasks;
+  const intptr_t num_tasks = num_tasks_;
   RELEASE_ASSERT(num_tasks > 0);
   ThreadBarrier* barrier = new ThreadBarrier(num_tasks, /*initial=*/1);
 
@@ -1355,7 +1398,7 @@ void GCMarker::MarkObjects(PageSpace* page_space) {
 
 void GCMarker::PruneWeak(Scavenger* scavenger) {
   scavenger->PruneWeak(&global_list_);
-  for (intptr_t i = 0, n = FLAG_marker_tasks; i < n; i++) {
+  for (intptr_t i = 0, n = num_tasks_; i < n; i++) {
     scavenger->PruneWeak(visitors_[i]->delayed());
   }
 }
@@ -56,6 +56,7 @@ class GCMarker {
   void Prologue();
   void Epilogue();
   void ResetSlices();
+  void RetryTLABDeferred();
   void IterateRoots(ObjectPointerVisitor* visitor);
   void IterateWeakRoots(Thread* thread);
   void ProcessWeakHandles(Thread* thread);
@@ -76,7 +77,8 @@ class GCMarker {
   // a TLAB and subject to write barrier eliminiation. Unlike
   // [deferred_marking_stack_], the objects are always marked and never
   // repeated. Tney can be folded back into the regular mark list after a
-  // scavenge, preventing accumulation of STW work.
+  // scavenge or before an incremental marking step, preventing accumulation of
+  // STW work.
   MarkingStack tlab_deferred_marking_stack_;
   // Objects that need to be marked (non-writable instructions) or scanned
   // (object used in a barrier-skipping context) during the final STW phase.
@@ -85,6 +87,7 @@ class GCMarker {
   MarkingStack deferred_marking_stack_;
   GCLinkedLists global_list_;
   MarkingVisitor** visitors_;
+  const intptr_t num_tasks_;
 
   Monitor root_slices_monitor_;
   RelaxedAtomic<intptr_t> root_slices_started_;
@@ -21,11 +21,19 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            numa,
+            false,
+            "Back heap pages with memory from the NUMA node of the thread that "
+            "allocates them, prefer reusing cached pages from that node, and "
+            "have scavenger workers promote into free space on their node.");
+
 // This cache needs to be at least as big as FLAG_new_gen_semi_max_size or
 // munmap will noticeably impact performance.
 static constexpr intptr_t kPageCacheCapacity = 128 * kWordSize;
 static Mutex* page_cache_mutex = nullptr;
 static VirtualMemory* page_cache[kPageCacheCapacity] = {nullptr};
+static intptr_t page_cache_node[kPageCacheCapacity] = {0};
 static intptr_t page_cache_size = 0;
 
 void Page::Init() {
@@ -63,6 +71,9 @@ Page* Page::Allocate(intptr_t size, uword flags) {
   const bool compressed = !executable;
   const char* name = executable ? "dart-code" : "dart-heap";
 
+  const intptr_t numa_node =
+      FLAG_numa ? VirtualMemory::CurrentNumaNode() : intptr_t{-1};
+  intptr_t memory_node = -1;
   VirtualMemory* memory = nullptr;
   if (CanUseCache(flags)) {
     // We don't automatically use the cache based on size and type because a
@@ -74,7 +85,21 @@ Page* Page::Allocate(intptr_t size, uword flags) {
     ASSERT(page_cache_size >= 0);
     ASSERT(page_cache_size <= kPageCacheCapacity);
     if (page_cache_size > 0) {
-      memory = page_cache[--page_cache_size];
+      // Prefer the most recently cached page from this thread's node.
+      intptr_t index = page_cache_size - 1;
+      if (numa_node >= 0) {
+        for (intptr_t i = index; i >= 0; i--) {
+          if (page_cache_node[i] == numa_node) {
+            index = i;
+            break;
+          }
+        }
+      }
+      memory = page_cache[index];
+      memory_node = page_cache_node[index];
+      page_cache_size--;
+      page_cache[index] = page_cache[page_cache_size];
+      page_cache_node[index] = page_cache_node[page_cache_size];
     }
   }
   if (memory == nullptr) {
@@ -84,6 +109,9 @@ Page* Page::Allocate(intptr_t size, uword flags) {
   if (memory == nullptr) {
     return nullptr;  // Out of memory.
   }
+  if ((numa_node >= 0) && (memory_node != numa_node)) {
+    VirtualMemory::PreferNumaNode(memory->address(), size, numa_node);
+  }
 
   if ((flags & kNew) != 0) {
     // Initialized by generated code.
@@ -115,6 +143,7 @@ Page* Page::Allocate(intptr_t size, uword flags) {
   result->survivor_end_ = 0;
   result->resolved_top_ = 0;
   result->live_bytes_ = 0;
+  result->numa_node_ = numa_node;
 
   if ((flags & kNew) != 0) {
     uword top = result->object_start();
@@ -145,6 +174,7 @@ void Page::Deallocate() {
   // Load before unregistering with LSAN, or LSAN will temporarily think it has
   // been leaked.
   VirtualMemory* memory = memory_;
+  const intptr_t numa_node = numa_node_;
 
   LSAN_UNREGISTER_ROOT_REGION(this, sizeof(*this));
 
@@ -177,6 +207,7 @@ void Page::Deallocate() {
       }
 #endif
       MSAN_POISON(memory->address(), size);
+      page_cache_node[page_cache_size] = numa_node;
       page_cache[page_cache_size++] = memory;
       memory = nullptr;
     }
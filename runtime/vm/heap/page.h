@@ -126,6 +126,8 @@ class Page {
   void add_live_bytes(intptr_t value) { live_bytes_ += value; }
   void sub_live_bytes(intptr_t value) { live_bytes_ -= value; }
 
+  intptr_t numa_node() const { return numa_node_; }
+
   ForwardingPage* forwarding_page() const { return forwarding_page_; }
   void RegisterUnwindingRecords();
   void UnregisterUnwindingRecords();
@@ -346,6 +348,9 @@ class Page {
 
   RelaxedAtomic<intptr_t> live_bytes_;
 
+  // The NUMA node preferred for this page's memory, or -1. See --numa.
+  intptr_t numa_node_;
+
   friend class CheckStoreBufferScavengeVisitor;
   friend class CheckStoreBufferEvacuateVisitor;
   friend class GCCompactor;
@@ -25,6 +25,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, numa);
+
 DEFINE_FLAG(int,
             old_gen_growth_space_ratio,
             20,
@@ -38,6 +40,11 @@ DEFINE_FLAG(int,
             280,
             "The max number of pages the old generation can grow at a time");
 DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
+DEFINE_FLAG(bool,
+            lazy_sweep,
+            true,
+            "When old-space allocation fails during concurrent sweeping, sweep "
+            "pages on the allocating thread before growing.");
 
 // The initial estimate of how many words we can mark per microsecond (usage
 // before / mark-sweep time). This is a conservative value observed running
@@ -70,6 +77,7 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
       gc_time_micros_(0),
       collections_(0),
       mark_words_per_micro_(kConservativeInitialMarkSpeed),
+      marker_tasks_(FLAG_marker_tasks),
       enable_concurrent_mark_(FLAG_concurrent_mark) {
   ASSERT(heap != nullptr);
 
@@ -172,6 +180,22 @@ void PageSpace::RemoveExecPageLocked(Page* page, Page* previous_page) {
   }
 }
 
+bool PageSpace::CanIncreaseCapacityInWordsLocked(intptr_t increase_in_words) {
+  if ((heap_ != nullptr) &&
+      heap_->ExceedsHardLimitLocked(increase_in_words,
+                                    usage_.capacity_in_words)) {
+    return false;
+  }
+  if (max_capacity_in_words_ == 0) {
+    // Unlimited.
+    return true;
+  }
+  intptr_t free_capacity_in_words =
+      (max_capacity_in_words_ - usage_.capacity_in_words);
+  return ((free_capacity_in_words > 0) &&
+          (increase_in_words <= free_capacity_in_words));
+}
+
 Page* PageSpace::AllocatePage(bool is_exec, bool link) {
   {
     MutexLocker ml(&pages_lock_);
@@ -404,6 +428,9 @@ uword PageSpace::TryAllocateInternal(intptr_t size,
     } else {
       result = freelist->TryAllocate(size, is_protected);
     }
+    if ((result == 0) && !is_exec) {
+      result = TryAllocateAfterLazySweep(size, freelist, is_locked);
+    }
     if (result == 0) {
       result = TryAllocateInFreshPage(size, freelist, is_exec, growth_policy,
                                       is_locked);
@@ -422,6 +449,59 @@ uword PageSpace::TryAllocateInternal(intptr_t size,
   return result;
 }
 
+uword PageSpace::TryAllocateAfterLazySweep(intptr_t size,
+                                           FreeList* freelist,
+                                           bool is_locked) {
+  // Bounds the delay of this allocation. The remaining pages are left to the
+  // sweeper tasks.
+  const intptr_t kMaxLazySweepPages = 4;
+
+  if (!FLAG_lazy_sweep) return 0;
+  GCSweeper sweeper;
+  for (intptr_t i = 0; i < kMaxLazySweepPages; i++) {
+    // Most misses happen when there is nothing left to sweep, which does not
+    // need the lock to tell.
+    if (!has_regular_pages_to_sweep_) return 0;
+    Page* page;
+    {
+      MutexLocker ml(&pages_lock_);
+      page = sweep_regular_;
+      if (page == nullptr) return 0;
+      sweep_regular_ = page->next();
+      has_regular_pages_to_sweep_ = sweep_regular_ != nullptr;
+      page->set_next(nullptr);
+    }
+    ASSERT(!page->is_executable());
+    lazily_swept_pages_.fetch_add(1);
+
+    uword result = 0;
+    if (!is_locked) {
+      freelist->mutex()->Lock();
+    }
+    bool page_in_use = sweeper.SweepPage(page, freelist);
+    if (page_in_use) {
+      result = freelist->TryAllocateLocked(size, /*is_protected=*/false);
+    }
+    if (!is_locked) {
+      freelist->mutex()->Unlock();
+    }
+
+    if (page_in_use) {
+      MutexLocker ml(&pages_lock_);
+      AddPageLocked(page);
+    } else {
+      intptr_t size_in_words = page->memory_->size() >> kWordSizeLog2;
+      page->Deallocate();
+      MutexLocker ml(&pages_lock_);
+      IncreaseCapacityInWordsLocked(-size_in_words);
+    }
+    if (result != 0) {
+      return result;
+    }
+  }
+  return 0;
+}
+
 void PageSpace::AcquireLock(FreeList* freelist) {
   freelist->mutex()->Lock();
 }
@@ -964,6 +1044,30 @@ void PageSpace::VisitRoots(ObjectPointerVisitor* visitor) {
   }
 }
 
+void PageSpace::AdaptToPauseTarget(int64_t pause_micros,
+                                   int64_t target_micros) {
+  if (pause_micros > target_micros) {
+    // Leave less marking for the final pause: mark with more tasks, up to one
+    // per processor, and start concurrent marking earlier.
+    if (FLAG_marker_tasks > 0) {
+      marker_tasks_ = Utils::Maximum<intptr_t>(
+          FLAG_marker_tasks,
+          Utils::Minimum<intptr_t>(marker_tasks_ + 1,
+                                   OS::NumberOfAvailableProcessors()));
+    }
+    page_space_controller_.AdaptToPauseTarget(/*missed=*/true);
+  } else if (pause_micros < target_micros / 2) {
+    marker_tasks_ = Utils::Maximum<intptr_t>(FLAG_marker_tasks,
+                                             marker_tasks_ - 1);
+    page_space_controller_.AdaptToPauseTarget(/*missed=*/false);
+  }
+}
+
+void PageSpace::ResetPauseTargetAdaptation() {
+  marker_tasks_ = FLAG_marker_tasks;
+  page_space_controller_.ResetPauseTargetAdaptation();
+}
+
 void PageSpace::CollectGarbage(Thread* thread, bool compact, bool finalize) {
   ASSERT(!thread->force_growth());
   ASSERT(thread->OwnsGCSafepoint());
@@ -1108,6 +1212,7 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
     ASSERT(sweep_regular_ == nullptr);
     if (!compact) {
       sweep_regular_ = pages_;
+      has_regular_pages_to_sweep_ = sweep_regular_ != nullptr;
       pages_ = pages_tail_ = nullptr;
     }
     if (!new_space_is_swept) {
@@ -1403,7 +1508,6 @@ void PageSpace::Sweep(bool exclusive) {
 
   GCSweeper sweeper;
 
-  intptr_t shard = 0;
   const intptr_t num_shards = heap_->new_space()->NumScavengeWorkers();
   ASSERT(num_shards < num_freelists_);
   if (exclusive) {
@@ -1416,14 +1520,21 @@ void PageSpace::Sweep(bool exclusive) {
   while (sweep_regular_ != nullptr) {
     Page* page = sweep_regular_;
     sweep_regular_ = page->next();
+    has_regular_pages_to_sweep_ = sweep_regular_ != nullptr;
     page->set_next(nullptr);
     ASSERT(!page->is_executable());
 
     ml.Unlock();
-    // Cycle through the shards round-robin so that free space is roughly
+    // With --numa, give the free space of a page to the shard for the page's
+    // node, which the scavenger workers on that node promote into. Otherwise
+    // cycle through the shards round-robin so that free space is roughly
     // evenly distributed among the freelists and so roughly evenly available
-    // to each scavenger worker.
-    shard = (shard + 1) % num_shards;
+    // to each scavenger worker. The shard is shared by all sweeping threads so
+    // that they rarely contend for the same freelist.
+    const intptr_t node = FLAG_numa ? page->numa_node() : -1;
+    const intptr_t shard =
+        (node >= 0) ? (node % num_shards)
+                    : (sweep_shard_.fetch_add(1) % num_shards);
     FreeList* freelist = DataFreeList(shard);
     if (!exclusive) {
       freelist->mutex()->Lock();
@@ -1562,6 +1673,7 @@ void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   page->survivor_end_ = 0;
   page->resolved_top_ = 0;
   page->live_bytes_ = 0;
+  page->numa_node_ = -1;
 
   MutexLocker ml(&pages_lock_);
   page->next_ = image_pages_;
@@ -1756,6 +1868,18 @@ void PageSpaceController::EvaluateAfterLoading(SpaceUsage after) {
   RecordUpdate(after, after, growth_in_pages, "loaded");
 }
 
+void PageSpaceController::AdaptToPauseTarget(bool missed) {
+  // Below this, concurrent marking runs most of the time.
+  const intptr_t kMinConcurrentMarkStartPercent = 50;
+  if (missed) {
+    concurrent_mark_start_percent_ = Utils::Maximum(
+        kMinConcurrentMarkStartPercent, concurrent_mark_start_percent_ - 10);
+  } else {
+    concurrent_mark_start_percent_ =
+        Utils::Minimum<intptr_t>(100, concurrent_mark_start_percent_ + 5);
+  }
+}
+
 void PageSpaceController::RecordUpdate(SpaceUsage before,
                                        SpaceUsage after,
                                        intptr_t growth_in_pages,
@@ -1766,7 +1890,10 @@ void PageSpaceController::RecordUpdate(SpaceUsage before,
 
   bool concurrent_mark = FLAG_concurrent_mark && (FLAG_marker_tasks != 0);
   if (concurrent_mark) {
-    soft_gc_threshold_in_words_ = threshold;
+    soft_gc_threshold_in_words_ =
+        after.CombinedUsedInWords() +
+        (kPageSizeInWords *
+         (growth_in_pages * concurrent_mark_start_percent_ / 100));
     hard_gc_threshold_in_words_ = kIntptrMax / kWordSize;
   } else {
     soft_gc_threshold_in_words_ = kIntptrMax / kWordSize;
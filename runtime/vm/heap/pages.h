@@ -81,6 +81,14 @@ class PageSpaceController {
 
   void set_last_usage(SpaceUsage current) { last_usage_ = current; }
 
+  // Starts concurrent marking earlier after a pause that missed the target,
+  // and later again after one well within it. See Dart_SetGCPauseTarget.
+  void AdaptToPauseTarget(bool missed);
+  void ResetPauseTargetAdaptation() { concurrent_mark_start_percent_ = 100; }
+  intptr_t concurrent_mark_start_percent() const {
+    return concurrent_mark_start_percent_;
+  }
+
  private:
   friend class PageSpace;  // For MergeOtherPageSpaceController
 
@@ -116,6 +124,10 @@ class PageSpaceController {
   // Begin concurrent marking when usage exceeds this amount.
   intptr_t soft_gc_threshold_in_words_;
 
+  // Percentage of the growth allowed since the last GC after which concurrent
+  // marking begins. Lowered to meet the pause target, if any.
+  intptr_t concurrent_mark_start_percent_ = 100;
+
   // Run idle GC if time permits when usage exceeds this amount.
   intptr_t idle_gc_threshold_in_words_;
 
@@ -340,6 +352,14 @@ class PageSpace {
   Phase phase() const { return phase_; }
   void set_phase(Phase val) { phase_ = val; }
 
+  intptr_t evacuated_bytes() const { return evacuated_bytes_; }
+
+  // The number of concurrent sweeper tasks that have run, and of pages swept
+  // by allocating threads rather than by them (--lazy_sweep).
+  intptr_t sweeper_tasks_run() const { return sweeper_tasks_run_; }
+  void IncrementSweeperTasksRun() { sweeper_tasks_run_.fetch_add(1); }
+  intptr_t lazily_swept_pages() const { return lazily_swept_pages_; }
+
   void SetupImagePage(void* pointer, uword size, bool is_executable);
 
   // Return any bump allocation block to the freelist.
@@ -356,6 +376,19 @@ class PageSpace {
 
   GCMarker* marker() const { return marker_; }
 
+  // Number of tasks that mark in parallel. Starts at --marker_tasks and grows
+  // while marking pauses miss the pause target.
+  intptr_t marker_tasks() const { return marker_tasks_; }
+  intptr_t concurrent_mark_start_percent() const {
+    return page_space_controller_.concurrent_mark_start_percent();
+  }
+
+  // Adapts marking after a pause of 'pause_micros' towards 'target_micros'.
+  // See Dart_SetGCPauseTarget.
+  void AdaptToPauseTarget(int64_t pause_micros, int64_t target_micros);
+  // Marks as without a pause target again.
+  void ResetPauseTargetAdaptation();
+
  private:
   // Ids for time and data records in Heap::GCStats.
   enum {
@@ -391,6 +424,11 @@ class PageSpace {
   uword TryAllocateInFreshLargePage(intptr_t size,
                                     bool is_executable,
                                     GrowthPolicy growth_policy);
+  // Sweeps some of the pages that concurrent sweeping has not reached yet into
+  // 'freelist', until one has room for the allocation.
+  uword TryAllocateAfterLazySweep(intptr_t size,
+                                  FreeList* freelist,
+                                  bool is_locked);
 
   // Attempt to allocate from bump block rather than normal freelist.
   uword TryAllocateDataBumpLocked(FreeList* freelist, intptr_t size);
@@ -426,16 +464,7 @@ class PageSpace {
 
   static intptr_t LargePageSizeInWordsFor(intptr_t size);
 
-  bool CanIncreaseCapacityInWordsLocked(intptr_t increase_in_words) {
-    if (max_capacity_in_words_ == 0) {
-      // Unlimited.
-      return true;
-    }
-    intptr_t free_capacity_in_words =
-        (max_capacity_in_words_ - usage_.capacity_in_words);
-    return ((free_capacity_in_words > 0) &&
-            (increase_in_words <= free_capacity_in_words));
-  }
+  bool CanIncreaseCapacityInWordsLocked(intptr_t increase_in_words);
 
   Heap* const heap_;
 
@@ -469,6 +498,13 @@ class PageSpace {
   Page* sweep_large_ = nullptr;
   Page* sweep_new_ = nullptr;
   Page* sweep_executable_ = nullptr;
+  // Spreads the pages swept by several threads over the data freelists.
+  RelaxedAtomic<intptr_t> sweep_shard_ = {0};
+  // Whether sweep_regular_ is non-empty. Only written under pages_lock_, but
+  // read without it by allocations which missed the freelist.
+  RelaxedAtomic<bool> has_regular_pages_to_sweep_ = {false};
+  RelaxedAtomic<intptr_t> sweeper_tasks_run_ = {0};
+  RelaxedAtomic<intptr_t> lazily_swept_pages_ = {0};
 
   // Various sizes being tracked for this generation.
   intptr_t max_capacity_in_words_;
@@ -495,6 +531,13 @@ class PageSpace {
   int64_t gc_time_micros_;
   intptr_t collections_;
   intptr_t mark_words_per_micro_;
+  // Speed of the last incremental compaction's stop-the-world step, or zero if
+  // none has run. See GCIncrementalCompactor::EvacuationBudget.
+  intptr_t evacuated_bytes_per_micro_ = 0;
+  // Bytes moved by the last incremental compaction's stop-the-world step.
+  intptr_t evacuated_bytes_ = 0;
+
+  intptr_t marker_tasks_;
 
   bool enable_concurrent_mark_;
 
@@ -513,6 +556,7 @@ class PageSpace {
   friend class CompactorTask;
   friend class ParallelSweepTask;
   friend class Code;
+  friend class GCTestHelper;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(PageSpace);
 };
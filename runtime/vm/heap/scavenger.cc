@@ -32,10 +32,13 @@
 #include "vm/tagged_pointer.h"
 #include "vm/thread_barrier.h"
 #include "vm/timeline.h"
+#include "vm/virtual_memory.h"
 #include "vm/visitor.h"
 
 namespace dart {
 
+DECLARE_FLAG(bool, numa);
+
 DEFINE_FLAG(int,
             early_tenuring_threshold,
             66,
@@ -46,6 +49,23 @@ DEFINE_FLAG(int,
             90,
             "Grow new gen when less than this percentage is garbage.");
 DEFINE_FLAG(int, new_gen_growth_factor, 2, "Grow new gen by this factor.");
+DEFINE_FLAG(bool,
+            pretenure,
+            false,
+            "Allocate instances of classes that mostly survive scavenges "
+            "directly in old space.");
+DEFINE_FLAG(int,
+            pretenure_threshold,
+            90,
+            "Pretenure a class when at least this percentage of the new-space "
+            "volume of its instances survives scavenges.");
+DEFINE_FLAG(int,
+            pretenure_min_survivor_size,
+            256,
+            "Only pretenure a class when its surviving instances are at least "
+            "this many bytes on average. Compiled code leaves allocations of "
+            "pretenured classes to the runtime, which only pays off when the "
+            "copying it saves is large enough.");
 
 // Scavenger uses the kCardRememberedBit to distinguish forwarded and
 // non-forwarded objects. We must choose a bit that is clear for all new-space
@@ -261,6 +281,9 @@ class ScavengerVisitor : public ObjectPointerVisitor,
 
   void ProcessRoots() {
     thread_ = Thread::Current();
+    if (FLAG_numa) {
+      freelist_ = scavenger_->ClaimFreeList();
+    }
     page_space_->AcquireLock(freelist_);
 
     LongJumpScope jump(thread_);
@@ -835,6 +858,8 @@ intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
   limit = Utils::Minimum(limit, heap_->old_space()->UsedInWords() / 8);
   // Preserve old behavior when heap size is small.
   limit = Utils::Maximum(limit, max_semi_capacity_in_words_);
+  // But keep scavenges within the pause target.
+  limit = Utils::Minimum(limit, pause_limit_in_words_);
   // Align to TLAB size.
   limit = Utils::RoundDown(limit, kPageSizeInWords);
 
@@ -842,6 +867,32 @@ intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
   return Utils::Minimum(old_size_in_words * growth_factor, limit);
 }
 
+void Scavenger::AdaptToPauseTarget(int64_t pause_micros,
+                                   int64_t target_micros) {
+  // The work of a scavenge is proportional to the survivors, which are on
+  // average proportional to the size of new-space.
+  const intptr_t size_in_words = to_->gc_threshold_in_words();
+  if (pause_micros > target_micros) {
+    intptr_t limit = static_cast<intptr_t>(
+        size_in_words * (static_cast<double>(target_micros) / pause_micros));
+    // Shrink gradually, as a single pause may be an outlier, but not below the
+    // initial size: below that, the overhead of frequent scavenges dominates.
+    limit = Utils::Maximum(limit, size_in_words / 2);
+    limit = Utils::Maximum(
+        limit, Utils::Minimum(max_semi_capacity_in_words_,
+                              FLAG_new_gen_semi_initial_size * MBInWords));
+    pause_limit_in_words_ = Utils::RoundUp(limit, kPageSizeInWords);
+  } else if ((pause_micros < target_micros / 2) &&
+             (pause_limit_in_words_ != kIntptrMax)) {
+    // Plenty of headroom: let new-space grow back.
+    if (pause_limit_in_words_ >= 8 * max_semi_capacity_in_words_) {
+      pause_limit_in_words_ = kIntptrMax;
+    } else {
+      pause_limit_in_words_ *= 2;
+    }
+  }
+}
+
 class CollectStoreBufferScavengeVisitor : public ObjectPointerVisitor {
  public:
   CollectStoreBufferScavengeVisitor(ObjectSet* in_store_buffer, const char* msg)
@@ -1887,6 +1938,10 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
 
   IsolateGroup* isolate_group = heap_->isolate_group();
 
+  if (FLAG_numa) {
+    claimed_freelists_ = new RelaxedAtomic<bool>[num_tasks];
+    num_claimable_freelists_ = num_tasks;
+  }
   ScavengerVisitor** visitors = new ScavengerVisitor*[num_tasks];
   IntrusiveDList<SafepointTask> tasks;
   for (intptr_t i = 0; i < num_tasks; i++) {
@@ -1908,6 +1963,9 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
     delete visitor;
   }
   delete[] visitors;
+  delete[] claimed_freelists_;
+  claimed_freelists_ = nullptr;
+  num_claimable_freelists_ = 0;
 
   if (abort_) {
     ReverseScavenge(&from);
@@ -1921,6 +1979,10 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   }
   ASSERT(promotion_stack_.IsEmpty());
 
+  if (FLAG_pretenure && !abort_) {
+    UpdatePretenureFeedback(from);
+  }
+
   // Scavenge finished. Run accounting.
   int64_t end = OS::GetCurrentMonotonicMicros();
   stats_history_.Add(ScavengeStats(
@@ -1941,6 +2003,108 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
          failed_to_promote_);
 }
 
+// A class is judged once its instances have taken this much new-space.
+static constexpr intptr_t kPretenureSampleInWords = 256 * KBInWords;
+
+void Scavenger::UpdatePretenureFeedback(SemiSpace* from) {
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "UpdatePretenureFeedback");
+
+  ClassTable* class_table = heap_->isolate_group()->class_table();
+  const intptr_t num_cids = class_table->NumCids();
+  survival_feedback_.EnsureLength(num_cids, SurvivalFeedback());
+  pretenured_.EnsureLength(num_cids, false);
+  pretenured_scavenges_left_.EnsureLength(num_cids, 0);
+
+  // Every object in from-space is now either garbage or forwarded to its copy.
+  for (Page* page = from->head(); page != nullptr; page = page->next()) {
+    uword addr = page->object_start();
+    const uword end = page->object_end();
+    while (addr < end) {
+      ObjectPtr obj = UntaggedObject::FromAddr(addr);
+      uword header = ReadHeaderRelaxed(obj);
+      const bool survived = IsForwarding(header);
+      intptr_t size;
+      if (survived) {
+        ObjectPtr copy = ForwardedObj(header);
+        header = ReadHeaderRelaxed(copy);
+        size = copy->untag()->HeapSize(header);
+      } else {
+        size = obj->untag()->HeapSize(header);
+      }
+      addr += size;
+
+      const intptr_t cid = UntaggedObject::ClassIdTag::decode(header);
+      if ((cid == kFreeListElement) || (cid == kForwardingCorpse)) {
+        continue;
+      }
+      ASSERT(cid < num_cids);
+      SurvivalFeedback& feedback = survival_feedback_[cid];
+      feedback.allocated_in_words += size >> kWordSizeLog2;
+      if (survived) {
+        feedback.survived_in_words += size >> kWordSizeLog2;
+        feedback.survivors++;
+      }
+    }
+  }
+
+  for (intptr_t cid = 0; cid < num_cids; cid++) {
+    SurvivalFeedback& feedback = survival_feedback_[cid];
+    if (pretenured_[cid]) {
+      if (--pretenured_scavenges_left_[cid] > 0) {
+        continue;
+      }
+      // Let the instances be allocated in new space again, where they are
+      // sampled afresh: the class is pretenured again if they still survive.
+      pretenured_[cid] = false;
+      class_table->SetPretenureFor(cid, false);
+      if (FLAG_verbose_gc) {
+        OS::PrintErr("Reevaluating pretenuring of cid %" Pd "\n", cid);
+      }
+      feedback = SurvivalFeedback();
+      continue;
+    }
+    if (feedback.allocated_in_words < kPretenureSampleInWords) {
+      continue;
+    }
+    const intptr_t survival_percent =
+        feedback.survived_in_words * 100 / feedback.allocated_in_words;
+    if ((survival_percent >= FLAG_pretenure_threshold) &&
+        (feedback.survived_in_words * kWordSize >=
+         feedback.survivors * FLAG_pretenure_min_survivor_size)) {
+      pretenured_[cid] = true;
+      pretenured_scavenges_left_[cid] = kPretenureReevaluationScavenges;
+      class_table->SetPretenureFor(cid, true);
+
+      const char* name = nullptr;
+#if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
+      name = class_table->UserVisibleNameFor(cid);
+#endif
+      if (name == nullptr) {
+        name = "<unknown>";
+      }
+      if (FLAG_verbose_gc) {
+        OS::PrintErr("Pretenuring %s (cid %" Pd "): %" Pd "%% of %" Pd
+                     "kB survived\n",
+                     name, cid, survival_percent,
+                     RoundWordsToKB(feedback.allocated_in_words));
+      }
+#if defined(SUPPORT_TIMELINE)
+      TimelineEvent* event = Timeline::GetGCStream()->StartEvent();
+      if (event != nullptr) {
+        event->Instant("Pretenure");
+        event->SetNumArguments(3);
+        event->CopyArgument(0, "Class", name);
+        event->FormatArgument(1, "Survived (%)", "%" Pd, survival_percent);
+        event->FormatArgument(2, "Sampled (kB)", "%" Pd,
+                              RoundWordsToKB(feedback.allocated_in_words));
+        event->Complete();
+      }
+#endif  // defined(SUPPORT_TIMELINE)
+    }
+    feedback = SurvivalFeedback();
+  }
+}
+
 static constexpr intptr_t kMinAutoScavengeWorkers = 2;
 static constexpr intptr_t kMaxAutoScavengeWorkers = 4;
 
@@ -1964,6 +2128,26 @@ intptr_t Scavenger::NumScavengeWorkers() {
   return num_tasks;
 }
 
+// The sweeper gives the free space of a page to the free list for the page's
+// NUMA node (see PageSpace::Sweep), so a worker that claims the free list for
+// its own node promotes into node-local memory. Each worker claims one free
+// list and there are as many free lists as workers, so a claim always
+// succeeds.
+FreeList* Scavenger::ClaimFreeList() {
+  ASSERT(claimed_freelists_ != nullptr);
+  const intptr_t num_shards = num_claimable_freelists_;
+  const intptr_t node = VirtualMemory::CurrentNumaNode();
+  const intptr_t preferred = (node >= 0) ? (node % num_shards) : 0;
+  for (intptr_t i = 0; i < num_shards; i++) {
+    const intptr_t shard = (preferred + i) % num_shards;
+    if (!claimed_freelists_[shard].exchange(true)) {
+      return heap_->old_space()->DataFreeList(shard);
+    }
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
 intptr_t Scavenger::NumDataFreelists() {
   if (FLAG_scavenger_tasks == -1) {
     return kMaxAutoScavengeWorkers;
@@ -2092,6 +2276,15 @@ void Scavenger::PrintToJSONObject(JSONObject* object) const {
   space.AddProperty64("capacity", CapacityInWords() * kWordSize);
   space.AddProperty64("external", ExternalInWords() * kWordSize);
   space.AddProperty("time", MicrosecondsToSeconds(gc_time_micros()));
+  JSONArray pretenured(&space, "_pretenuredClasses");
+  ClassTable* class_table = isolate_group->class_table();
+  Class& cls = Class::Handle();
+  for (intptr_t cid = 0; cid < pretenured_.length(); cid++) {
+    if (pretenured_[cid] && class_table->HasValidClassAt(cid)) {
+      cls = class_table->At(cid);
+      pretenured.AddValue(cls);
+    }
+  }
 }
 #endif  // !PRODUCT
 
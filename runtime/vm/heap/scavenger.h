@@ -11,6 +11,7 @@
 #include "vm/dart.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/growable_array.h"
 #include "vm/heap/page.h"
 #include "vm/heap/spaces.h"
 #include "vm/isolate.h"
@@ -150,12 +151,28 @@ class Scavenger {
     TryAllocateNewTLAB(thread, size, false);
     return TryAllocateFromTLAB(thread, size);
   }
+  // Whether new instances of the class 'cid' should be allocated directly in
+  // old space because most of them have survived scavenges. See --pretenure.
+  bool ShouldPretenure(intptr_t cid) const {
+    return (cid < pretenured_.length()) && pretenured_[cid];
+  }
+  // Scavenges no longer see the instances of a pretenured class, so it is
+  // sampled in new space again after this many scavenges.
+  static constexpr intptr_t kPretenureReevaluationScavenges = 64;
+
   intptr_t AbandonRemainingTLAB(Thread* thread);
   void AbandonRemainingTLABForDebugging(Thread* thread);
 
   // Collect the garbage in this scavenger.
   void Scavenge(Thread* thread, GCType type, GCReason reason);
 
+  // Resizes new-space so that the next scavenges take about 'target_micros',
+  // given that the last one took 'pause_micros'. See Dart_SetGCPauseTarget.
+  void AdaptToPauseTarget(int64_t pause_micros, int64_t target_micros);
+  // Lets new-space grow as without a pause target again.
+  void ResetPauseTargetAdaptation() { pause_limit_in_words_ = kIntptrMax; }
+  intptr_t pause_limit_in_words() const { return pause_limit_in_words_; }
+
   intptr_t UsedInWords() const {
     MutexLocker ml(&space_lock_);
     return to_->used_in_words() - freed_in_words_;
@@ -287,6 +304,8 @@ class Scavenger {
   void MournWeakHandles();
   void MournWeakTables();
   void Epilogue(SemiSpace* from);
+  void UpdatePretenureFeedback(SemiSpace* from);
+  FreeList* ClaimFreeList();
 
   void VerifyStoreBuffers(const char* msg);
 
@@ -303,7 +322,24 @@ class Scavenger {
 
   intptr_t max_semi_capacity_in_words_;
 
+  // Upper bound on the size of new-space from the pause target, if any.
+  intptr_t pause_limit_in_words_ = kIntptrMax;
+
   bool early_tenure_ = false;
+
+  // New-space volume of the instances of a class seen by scavenges since the
+  // last pretenuring decision for that class.
+  struct SurvivalFeedback {
+    intptr_t allocated_in_words = 0;
+    intptr_t survived_in_words = 0;
+    intptr_t survivors = 0;
+  };
+  MallocGrowableArray<SurvivalFeedback> survival_feedback_;
+  // Only grows at safepoints, so mutators may read it without a lock.
+  MallocGrowableArray<bool> pretenured_;
+  // Scavenges left until the decision to pretenure a class is reevaluated.
+  MallocGrowableArray<intptr_t> pretenured_scavenges_left_;
+
   RelaxedAtomic<intptr_t> root_slices_started_ = {0};
   RelaxedAtomic<intptr_t> weak_slices_started_ = {0};
   StoreBufferBlock* blocks_ = nullptr;
@@ -325,6 +361,11 @@ class Scavenger {
   RelaxedAtomic<bool> failed_to_promote_ = {false};
   RelaxedAtomic<bool> abort_ = {false};
 
+  // With --numa, which of the data free lists the workers of the current
+  // scavenge have claimed. See ClaimFreeList.
+  RelaxedAtomic<bool>* claimed_freelists_ = nullptr;
+  intptr_t num_claimable_freelists_ = 0;
+
   // Protects new space during the allocation of new TLABs
   mutable Mutex space_lock_;
 
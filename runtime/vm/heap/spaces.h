@@ -49,6 +49,7 @@ enum class GCReason {
   kDestroyed,    // Dart_NotifyDestroyed
   kDebugging,    // service request, etc.
   kCatchUp,      // End of ForceGrowthScope or Dart_PerformanceMode_Latency.
+  kMemoryPressure,  // Soft memory limit of the isolate group crossed.
 };
 
 static constexpr intptr_t kNewAllocatableSize = 256 * KB;
@@ -15,6 +15,12 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            sweeper_tasks,
+            2,
+            "The number of tasks that sweep old-space concurrently with the "
+            "mutator.");
+
 intptr_t GCSweeper::SweepNewPage(Page* page) {
   ASSERT(!page->is_image());
   ASSERT(!page->is_old());
@@ -164,20 +170,30 @@ intptr_t GCSweeper::SweepLargePage(Page* page) {
   return words_to_end;
 }
 
+// State shared by the tasks of one concurrent sweep. Guarded by the old
+// space's tasks lock.
+struct ConcurrentSweepState {
+  explicit ConcurrentSweepState(intptr_t num_tasks)
+      : sweeping_large(num_tasks), sweeping(num_tasks) {}
+
+  // Tasks that have not yet finished sweeping large pages.
+  intptr_t sweeping_large;
+  // Tasks that have not yet finished sweeping.
+  intptr_t sweeping;
+};
+
 class ConcurrentSweeperTask : public ThreadPool::Task {
  public:
-  explicit ConcurrentSweeperTask(IsolateGroup* isolate_group)
-      : isolate_group_(isolate_group) {
+  ConcurrentSweeperTask(IsolateGroup* isolate_group,
+                        ConcurrentSweepState* state)
+      : isolate_group_(isolate_group), state_(state) {
     ASSERT(isolate_group != nullptr);
-    PageSpace* old_space = isolate_group->heap()->old_space();
-    MonitorLocker ml(old_space->tasks_lock());
-    old_space->set_tasks(old_space->tasks() + 1);
-    old_space->set_phase(PageSpace::kSweepingLarge);
   }
 
   virtual void Run() {
     Thread::EnterIsolateGroupAsNonMutator(isolate_group_, Thread::kSweeperTask);
     PageSpace* old_space = isolate_group_->heap()->old_space();
+    old_space->IncrementSweeperTasksRun();
     {
       Thread* thread = Thread::Current();
       ASSERT(thread->BypassSafepoints());  // Or we should be checking in.
@@ -187,9 +203,13 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
 
       {
         MonitorLocker ml(old_space->tasks_lock());
-        ASSERT(old_space->phase() == PageSpace::kSweepingLarge);
-        old_space->set_phase(PageSpace::kSweepingRegular);
-        ml.NotifyAll();
+        // The large page list is only complete again once every task is
+        // done with it.
+        if (--state_->sweeping_large == 0) {
+          ASSERT(old_space->phase() == PageSpace::kSweepingLarge);
+          old_space->set_phase(PageSpace::kSweepingRegular);
+          ml.NotifyAll();
+        }
       }
 
       old_space->Sweep(/*exclusive*/ false);
@@ -200,19 +220,37 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
     {
       MonitorLocker ml(old_space->tasks_lock());
       old_space->set_tasks(old_space->tasks() - 1);
-      ASSERT(old_space->phase() == PageSpace::kSweepingRegular);
-      old_space->set_phase(PageSpace::kDone);
+      if (--state_->sweeping == 0) {
+        ASSERT(old_space->phase() == PageSpace::kSweepingRegular);
+        old_space->set_phase(PageSpace::kDone);
+        delete state_;
+      }
       ml.NotifyAll();
     }
   }
 
  private:
   IsolateGroup* isolate_group_;
+  ConcurrentSweepState* state_;
 };
 
 void GCSweeper::SweepConcurrent(IsolateGroup* isolate_group) {
-  bool result = Dart::thread_pool()->Run<ConcurrentSweeperTask>(isolate_group);
-  ASSERT(result);
+  PageSpace* old_space = isolate_group->heap()->old_space();
+  const intptr_t num_tasks = Utils::Maximum(FLAG_sweeper_tasks, 1);
+  ConcurrentSweepState* state = new ConcurrentSweepState(num_tasks);
+  {
+    // Bulk increase task count before starting any task, instead of
+    // incrementing as each task is started, so that a task which races ahead
+    // does not end the sweep for the others.
+    MonitorLocker ml(old_space->tasks_lock());
+    old_space->set_tasks(old_space->tasks() + num_tasks);
+    old_space->set_phase(PageSpace::kSweepingLarge);
+  }
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    bool result =
+        Dart::thread_pool()->Run<ConcurrentSweeperTask>(isolate_group, state);
+    ASSERT(result);
+  }
 }
 
 }  // namespace dart
@@ -36,7 +36,7 @@ class GCSweeper {
 
   intptr_t SweepNewPage(Page* page);
 
-  // Sweep the large and regular sized data pages.
+  // Sweep the large and regular sized data pages with --sweeper_tasks tasks.
   static void SweepConcurrent(IsolateGroup* isolate_group);
 };
 
@@ -56,6 +56,7 @@
 #include "vm/visitor.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/stub_code_compiler.h"
 #endif
@@ -91,6 +92,15 @@ DEFINE_FLAG_HANDLER(DeterministicModeHandler,
                     deterministic,
                     "Enable deterministic mode.");
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+DEFINE_FLAG(charp,
+            write_aot_profile_to,
+            nullptr,
+            "Write the execution counts of the program to the given file "
+            "when its isolate group shuts down, for gen_snapshot "
+            "--use_aot_profile");
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
 DEFINE_FLAG(bool,
             disable_thread_pool_limit,
             false,
@@ -2701,6 +2711,17 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
                                         /*bypass_safepoint=*/false);
 #if !defined(DART_PRECOMPILED_RUNTIME)
       BackgroundCompiler::Stop(isolate_group);
+
+      // The code and its ICData are shared by the isolates of the group, so
+      // the profile is written once, after the last of them has shut down.
+      if ((FLAG_write_aot_profile_to != nullptr) &&
+          isolate_group->initial_spawn_successful() &&
+          !IsolateGroup::IsSystemIsolateGroup(isolate_group)) {
+        Thread* thread = Thread::Current();
+        StackZone zone(thread);
+        HandleScope handle_scope(thread);
+        AotProfile::Write(thread, FLAG_write_aot_profile_to);
+      }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
       // Finalize any weak persistent handles with a non-null referent with
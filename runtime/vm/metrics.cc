@@ -10,6 +10,7 @@
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/runtime_entry.h"
+#include "vm/virtual_memory.h"
 
 namespace dart {
 
@@ -20,9 +21,48 @@ DEFINE_FLAG(bool,
 
 Metric* Metric::vm_list_head_ = nullptr;
 
+#define VM_METRIC_VARIABLE(type, variable, name, unit)                         \
+  static type* vm_metric_##variable##_ = nullptr;
+VM_METRIC_LIST(VM_METRIC_VARIABLE)
+#undef VM_METRIC_VARIABLE
+
+#define VM_METRIC_ACCESSOR(type, variable, name, unit)                         \
+  Metric* Metric::Get##variable##Metric() {                                    \
+    return vm_metric_##variable##_;                                            \
+  }
+VM_METRIC_LIST(VM_METRIC_ACCESSOR)
+#undef VM_METRIC_ACCESSOR
+
 Metric::Metric() : unit_(kCounter), value_(0) {}
 Metric::~Metric() {}
 
+void Metric::Init() {
+#define VM_METRIC_INIT(type, variable, name, unit)                             \
+  vm_metric_##variable##_ = new type();                                        \
+  vm_metric_##variable##_->InitInstance(name, nullptr, Metric::unit);
+  VM_METRIC_LIST(VM_METRIC_INIT)
+#undef VM_METRIC_INIT
+}
+
+void Metric::Cleanup() {
+  if (FLAG_print_metrics) {
+    Thread* thread = Thread::Current();
+    StackZone zone(thread);
+    LogBlock lb;
+    OS::PrintErr("Printing metrics for VM\n");
+#define VM_METRIC_PRINT(type, variable, name, unit)                            \
+  OS::PrintErr("%s\n", vm_metric_##variable##_->ToString());
+    VM_METRIC_LIST(VM_METRIC_PRINT)
+#undef VM_METRIC_PRINT
+    OS::PrintErr("\n");
+  }
+#define VM_METRIC_CLEANUP(type, variable, name, unit)                          \
+  delete vm_metric_##variable##_;                                              \
+  vm_metric_##variable##_ = nullptr;
+  VM_METRIC_LIST(VM_METRIC_CLEANUP)
+#undef VM_METRIC_CLEANUP
+}
+
 void Metric::InitInstance(IsolateGroup* isolate_group,
                           const char* name,
                           const char* description,
@@ -182,6 +222,16 @@ int64_t MetricHeapUsed::Value() const {
          isolate_group()->heap()->UsedInWords(Heap::kOld) * kWordSize;
 }
 
+int64_t MetricHeapHugePages::Value() const {
+  const int64_t now = OS::GetCurrentMonotonicMicros();
+  const int64_t refreshed = refreshed_micros_;
+  if (refreshed < 0 || now - refreshed >= kRefreshMicros) {
+    bytes_ = VirtualMemory::HugePageBytes();
+    refreshed_micros_ = now;
+  }
+  return bytes_;
+}
+
 int64_t MetricIsolateCount::Value() const {
   return Isolate::IsolateListLength();
 }
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_METRICS_H_
 #define RUNTIME_VM_METRICS_H_
 
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 
 namespace dart {
@@ -41,7 +42,20 @@ class JSONStream;
   V(MaxMetric, HeapNewUsedMax, "heap.new.used.max", kByte)                     \
   V(MaxMetric, HeapNewCapacityMax, "heap.new.capacity.max", kByte)             \
   V(MetricHeapUsed, HeapGlobalUsed, "heap.global.used", kByte)                 \
-  V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)
+  V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)               \
+  V(Metric, BackgroundCompilationQueueDepth, "compiler.background.queue",      \
+    kCounter)                                                                  \
+  V(Metric, BackgroundCompilationLatency, "compiler.background.latency",       \
+    kMicrosecond)                                                              \
+  V(MaxMetric, BackgroundCompilationLatencyMax,                                \
+    "compiler.background.latency.max", kMicrosecond)
+
+// Metrics for the whole VM.
+//
+// All metrics are exposed via vm-service protocol, along with the metrics of
+// each isolate group.
+#define VM_METRIC_LIST(V)                                                      \
+  V(MetricHeapHugePages, HeapHugePages, "vm.heap.huge_pages", kByte)
 
 // Metrics for each isolate.
 //
@@ -107,6 +121,11 @@ class Metric {
 
   static Metric* vm_head() { return vm_list_head_; }
 
+#define VM_METRIC_ACCESSOR(type, variable, name, unit)                         \
+  static Metric* Get##variable##Metric();
+  VM_METRIC_LIST(VM_METRIC_ACCESSOR)
+#undef VM_METRIC_ACCESSOR
+
   // Override to get a callback when value is serialized to JSON.
   // Use this for metrics that produce their value on demand.
   virtual int64_t Value() const { return value(); }
@@ -191,6 +210,21 @@ class MetricHeapUsed : public Metric {
   virtual int64_t Value() const;
 };
 
+// Heap memory backed by transparent huge pages, across all isolate groups.
+// Compare with heap.old.capacity and heap.new.capacity. See --huge_pages.
+class MetricHeapHugePages : public Metric {
+ public:
+  virtual int64_t Value() const;
+
+ private:
+  // Finding the heap mappings walks all mappings of the process, so the
+  // value is refreshed at most once per [kRefreshMicros].
+  static constexpr int64_t kRefreshMicros = kMicrosecondsPerSecond;
+
+  mutable RelaxedAtomic<int64_t> bytes_ = {0};
+  mutable RelaxedAtomic<int64_t> refreshed_micros_ = {-1};
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_METRICS_H_
@@ -2881,6 +2881,10 @@ ObjectPtr Object::Allocate(intptr_t cls_id,
   ASSERT(thread->no_safepoint_scope_depth() == 0);
   ASSERT(thread->no_callback_scope_depth() == 0);
   Heap* heap = thread->heap();
+  if ((space == Heap::kNew) &&
+      UNLIKELY(heap->new_space()->ShouldPretenure(cls_id))) {
+    space = Heap::kOld;
+  }
 
   uword address = heap->Allocate(thread, size, space);
   if (UNLIKELY(address == 0)) {
@@ -3404,7 +3408,10 @@ void Class::SetFunctions(const Array& value) const {
 void Class::AddFunction(const Function& function) const {
 #if defined(DEBUG)
   Thread* thread = Thread::Current();
-  ASSERT(thread->IsDartMutatorThread());
+  // The precompiler also compiles on helper threads while the mutator waits.
+  ASSERT(thread->IsDartMutatorThread() ||
+         (FLAG_precompiled_mode &&
+          thread->task_kind() == Thread::kCompilerTask));
   ASSERT(thread->isolate_group()->program_lock()->IsCurrentThreadWriter());
   ASSERT(!is_finalized() ||
          FunctionType::Handle(function.signature()).IsFinalized());
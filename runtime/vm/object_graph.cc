@@ -4,10 +4,20 @@
 
 #include "vm/object_graph.h"
 
+#if defined(DART_ENABLE_HEAP_SNAPSHOT_WRITER)
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID) ||            \
+    defined(DART_HOST_OS_MACOS)
+#include <unistd.h>  // NOLINT
+#define SUPPORT_HEAP_SNAPSHOT_FORK
+#endif
+#include "zlib.h"  // NOLINT
+#endif  // defined(DART_ENABLE_HEAP_SNAPSHOT_WRITER)
+
 #include "vm/dart.h"
 #include "vm/dart_api_state.h"
 #include "vm/growable_array.h"
 #include "vm/isolate.h"
+#include "vm/lockers.h"
 #include "vm/native_symbol.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
@@ -1492,8 +1502,78 @@ void CallbackHeapSnapshotWriter::WriteChunk(uint8_t* buffer,
   callback_(context_, buffer, size, last);
 }
 
+GzipChunkedWriter::GzipChunkedWriter(Thread* thread, ChunkedWriter* writer)
+    : ChunkedWriter(thread), writer_(writer) {
+  z_stream* stream = reinterpret_cast<z_stream*>(calloc(1, sizeof(z_stream)));
+  // The snapshot is already varint-encoded, so favor speed over ratio. Adding
+  // 16 to the window bits selects the gzip header and trailer.
+  int result = deflateInit2(stream, Z_BEST_SPEED, Z_DEFLATED, 16 + MAX_WBITS,
+                            /*memLevel=*/8, Z_DEFAULT_STRATEGY);
+  RELEASE_ASSERT(result == Z_OK);
+  stream_ = stream;
+}
+
+GzipChunkedWriter::~GzipChunkedWriter() {
+  z_stream* stream = reinterpret_cast<z_stream*>(stream_);
+  deflateEnd(stream);
+  free(stream);
+  free(output_);
+}
+
+void GzipChunkedWriter::WriteChunk(uint8_t* buffer, intptr_t size, bool last) {
+  z_stream* stream = reinterpret_cast<z_stream*>(stream_);
+  const intptr_t prefix = writer_->ReserveChunkPrefixSize();
+  stream->next_in = buffer;
+  stream->avail_in = size;
+  for (;;) {
+    if (output_ == nullptr) {
+      output_ = reinterpret_cast<uint8_t*>(malloc(prefix + kOutputChunkSize));
+      stream->next_out = output_ + prefix;
+      stream->avail_out = kOutputChunkSize;
+    }
+    int result = deflate(stream, last ? Z_FINISH : Z_NO_FLUSH);
+    ASSERT((result == Z_OK) || (result == Z_STREAM_END) ||
+           (result == Z_BUF_ERROR));
+    const bool done = last ? (result == Z_STREAM_END) : (stream->avail_in == 0);
+    if ((stream->avail_out == 0) || (done && last)) {
+      writer_->WriteChunk(output_,
+                          prefix + kOutputChunkSize - stream->avail_out,
+                          done && last);
+      output_ = nullptr;
+    }
+    if (done) break;
+  }
+  free(buffer);
+}
+
 void HeapSnapshotWriter::Write() {
   HeapIterationScope iteration(thread());
+  Write(&iteration);
+}
+
+intptr_t HeapSnapshotWriter::WriteInChildProcess() {
+#if defined(SUPPORT_HEAP_SNAPSHOT_FORK)
+  HeapIterationScope iteration(thread());
+  pid_t pid;
+  {
+    // Threads of other isolate groups are not paused, and might otherwise
+    // hold this lock when forking, which the child would never release.
+    MutexLocker ml(Zone::segment_cache_mutex());
+    pid = fork();
+  }
+  if (pid == 0) {
+    // The child only returns through _exit, so that it does not resume the
+    // threads of the parent or run any destructor.
+    Write(&iteration);
+    _exit(0);
+  }
+  return pid;
+#else
+  return -1;
+#endif
+}
+
+void HeapSnapshotWriter::Write(HeapIterationScope* iteration) {
 
   WriteBytes("dartheap", 8);  // Magic value.
   WriteUnsigned(0);           // Flags.
@@ -1529,7 +1609,7 @@ void HeapSnapshotWriter::Write() {
     }
     {
       CollectStaticFieldNames visitor(field_table_size, field_table_names);
-      iteration.IterateObjects(&visitor);
+      iteration->IterateObjects(&visitor);
     }
 
     WriteUnsigned(class_count_ + kNumExtraCids);
@@ -1651,8 +1731,8 @@ void HeapSnapshotWriter::Write() {
     CountReferences(num_isolates);  // Root -> Isolate
 
     // Heap objects.
-    iteration.IterateVMIsolateObjects(&visitor);
-    iteration.IterateObjects(&visitor);
+    iteration->IterateVMIsolateObjects(&visitor);
+    iteration->IterateObjects(&visitor);
 
     // External properties.
     isolate()->group()->VisitWeakPersistentHandles(&visitor);
@@ -1716,9 +1796,9 @@ void HeapSnapshotWriter::Write() {
 
     // Heap objects.
     visitor.set_discount_sizes(true);
-    iteration.IterateVMIsolateObjects(&visitor);
+    iteration->IterateVMIsolateObjects(&visitor);
     visitor.set_discount_sizes(false);
-    iteration.IterateObjects(&visitor);
+    iteration->IterateObjects(&visitor);
 
     // Smis.
     for (SmiPtr smi : smis_) {
@@ -1748,8 +1828,8 @@ void HeapSnapshotWriter::Write() {
         /*at_safepoint=*/true);
 
     // Handle visit rest of the objects.
-    iteration.IterateVMIsolateObjects(&visitor);
-    iteration.IterateObjects(&visitor);
+    iteration->IterateVMIsolateObjects(&visitor);
+    iteration->IterateObjects(&visitor);
     for (SmiPtr smi : smis_) {
       USE(smi);
       WriteUnsigned(0);  // No identity hash.
@@ -167,6 +167,23 @@ class VmServiceHeapSnapshotChunkedWriter : public ChunkedWriter {
   static constexpr intptr_t kMetadataReservation = 512;
 };
 
+// Compresses the chunks of a heap snapshot into a gzip stream, which it passes
+// in chunks to another writer.
+class GzipChunkedWriter : public ChunkedWriter {
+ public:
+  GzipChunkedWriter(Thread* thread, ChunkedWriter* writer);
+  ~GzipChunkedWriter();
+
+  virtual void WriteChunk(uint8_t* buffer, intptr_t size, bool last);
+
+ private:
+  static constexpr intptr_t kOutputChunkSize = MB;
+
+  ChunkedWriter* writer_;
+  void* stream_;  // z_stream
+  uint8_t* output_ = nullptr;
+};
+
 // Generates a dump of the heap, whose format is described in
 // runtime/vm/service/heap_snapshot.md.
 class HeapSnapshotWriter : public ThreadStackResource {
@@ -239,6 +256,15 @@ class HeapSnapshotWriter : public ThreadStackResource {
 
   void Write();
 
+  // Pauses the isolate group only to fork a child process, which writes the
+  // snapshot from its copy of the heap and exits. The child does not run any
+  // other thread, and writes without the locks which other threads may have
+  // held when forking, apart from those of malloc and of the zone segment
+  // cache. Identity hashes assigned while writing are only assigned in the
+  // child. Returns the pid of the child, or -1 if the process could not be
+  // forked or forking is not supported on this platform.
+  intptr_t WriteInChildProcess();
+
   static uint32_t GetHeapSnapshotIdentityHash(Thread* thread, ObjectPtr obj);
 
  private:
@@ -246,6 +272,8 @@ class HeapSnapshotWriter : public ThreadStackResource {
 
   static constexpr intptr_t kPreferredChunkSize = MB;
 
+  void Write(HeapIterationScope* iteration);
+
   void SetupImagePageBoundaries();
   void SetupCountingPages();
   bool OnImagePage(ObjectPtr obj) const;
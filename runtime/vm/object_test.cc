@@ -4048,6 +4048,40 @@ ISOLATE_UNIT_TEST_CASE(Finalizer_ClearValueNullTokenOne_OldSpace) {
   Finalizer_ClearValueOne(thread, Heap::kOld, true);
 }
 
+// The entries are spread over the marking visitors of a parallel mark, which
+// each mourn theirs when the marking is finalized.
+ISOLATE_UNIT_TEST_CASE(Finalizer_ClearValueMany_ParallelMark) {
+  EXPECT(thread->heap()->old_space()->marker_tasks() > 1);
+
+  const intptr_t kNumEntries = 1000;
+  const auto& finalizer = Finalizer::Handle(Finalizer::New(Heap::kOld));
+  finalizer.set_isolate(thread->isolate());
+  const auto& entries = Array::Handle(Array::New(kNumEntries, Heap::kOld));
+  auto& entry = FinalizerEntry::Handle();
+  const auto& detach = String::Handle(OneByteString::New("detach"));
+  {
+    HANDLESCOPE(thread);
+    auto& value = String::Handle();
+    for (intptr_t i = 0; i < kNumEntries; i++) {
+      entry = FinalizerEntry::New(finalizer, Heap::kOld);
+      value = OneByteString::New("value", Heap::kOld);
+      entry.set_value(value);
+      entry.set_detach(detach);
+      entries.SetAt(i, entry);
+    }
+  }
+
+  GCTestHelper::CollectAllGarbage();
+
+  for (intptr_t i = 0; i < kNumEntries; i++) {
+    entry ^= entries.At(i);
+    EXPECT_EQ(Object::null(), entry.value());
+    EXPECT_NE(Object::null(), entry.detach());
+  }
+  EXPECT_EQ(kNumEntries,
+            NumEntries(FinalizerEntry::Handle(finalizer.entries_collected())));
+}
+
 static void Finalizer_DetachOne(Thread* thread,
                                 Heap::Space space,
                                 bool clear_value) {
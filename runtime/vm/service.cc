@@ -4344,6 +4344,11 @@ static void HandleNativeMetricsList(Thread* thread, JSONStream* js) {
   metrics.AddValue(isolate_group->Get##variable##Metric());
     ISOLATE_GROUP_METRIC_LIST(ADD_METRIC);
 #undef ADD_METRIC
+
+#define ADD_METRIC(type, variable, name, unit)                                 \
+  metrics.AddValue(Metric::Get##variable##Metric());
+    VM_METRIC_LIST(ADD_METRIC);
+#undef ADD_METRIC
   }
 }
 
@@ -4366,6 +4371,14 @@ static void HandleNativeMetric(Thread* thread, JSONStream* js, const char* id) {
   ISOLATE_GROUP_METRIC_LIST(ADD_METRIC);
 #undef ADD_METRIC
 
+#define ADD_METRIC(type, variable, name, unit)                                 \
+  if (strcmp(id, name) == 0) {                                                 \
+    Metric::Get##variable##Metric()->PrintJSON(js);                            \
+    return;                                                                    \
+  }
+  VM_METRIC_LIST(ADD_METRIC);
+#undef ADD_METRIC
+
   PrintInvalidParamError(js, "metricId");
 }
 
@@ -4398,15 +4411,23 @@ static void GetIsolateMetric(Thread* thread, JSONStream* js) {
     PrintMissingParamError(js, "metricId");
     return;
   }
-  // Verify id begins with "metrics/native/".
+  // Verify id begins with "metrics/native/", or "vm/metrics/" for the
+  // metrics of the whole VM.
   static const char* const kNativeMetricIdPrefix = "metrics/native/";
   static intptr_t kNativeMetricIdPrefixLen = strlen(kNativeMetricIdPrefix);
-  if (strncmp(metric_id, kNativeMetricIdPrefix, kNativeMetricIdPrefixLen) !=
+  static const char* const kVMMetricIdPrefix = "vm/metrics/";
+  static intptr_t kVMMetricIdPrefixLen = strlen(kVMMetricIdPrefix);
+  const char* id = nullptr;
+  if (strncmp(metric_id, kNativeMetricIdPrefix, kNativeMetricIdPrefixLen) ==
       0) {
+    id = metric_id + kNativeMetricIdPrefixLen;
+  } else if (strncmp(metric_id, kVMMetricIdPrefix, kVMMetricIdPrefixLen) ==
+             0) {
+    id = metric_id + kVMMetricIdPrefixLen;
+  } else {
     PrintInvalidParamError(js, "metricId");
     return;
   }
-  const char* id = metric_id + kNativeMetricIdPrefixLen;
   HandleNativeMetric(thread, js, id);
 }
 
@@ -49,6 +49,24 @@ class VirtualMemory {
 
   static void DontNeed(void* address, intptr_t size);
 
+  // The NUMA node of the CPU the calling thread is running on, or -1 if it is
+  // unknown.
+  static intptr_t CurrentNumaNode();
+
+  // Prefers memory from the NUMA node for the given range, moving pages that
+  // are already backed by another node. Best effort.
+  static void PreferNumaNode(void* address, intptr_t size, intptr_t node);
+
+  // The number of bytes backed by transparent huge pages in the mappings that
+  // overlap [start, end) and, if name is not null, whose names contain name.
+  static intptr_t HugePageBytesIn(uword start,
+                                  uword end,
+                                  const char* name = nullptr);
+
+  // The number of bytes of heap memory currently backed by transparent huge
+  // pages, in the whole process. See --huge_pages.
+  static intptr_t HugePageBytes();
+
   // Reserves and commits a virtual memory segment with size. If a segment of
   // the requested size cannot be allocated, nullptr is returned.
   static VirtualMemory* Allocate(intptr_t size,
@@ -10,6 +10,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <inttypes.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/syscall.h>
@@ -50,6 +51,12 @@ DECLARE_FLAG(bool, generate_perf_events_symbols);
 DECLARE_FLAG(bool, generate_perf_jitdump);
 #endif
 
+DEFINE_FLAG(bool,
+            huge_pages,
+            false,
+            "Ask the OS to back the heap with transparent huge pages, and keep "
+            "heap pages next to each other so that they can be.");
+
 uword VirtualMemory::page_size_ = 0;
 VirtualMemory* VirtualMemory::compressed_heap_ = nullptr;
 #if defined(DART_HOST_OS_IOS) && !defined(DART_PRECOMPILED_RUNTIME)
@@ -109,6 +116,21 @@ static void* GenericMapAligned(void* hint,
   return reinterpret_cast<void*>(aligned_base);
 }
 
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+static constexpr intptr_t kHugePageSize = 2 * MB;
+
+// Where the next heap page is placed with --huge_pages, so that adjacent pages
+// end up in one mapping.
+static RelaxedAtomic<uword> next_heap_address = {0};
+
+static void AdviseHugePages(void* address, intptr_t size) {
+  if (FLAG_huge_pages) {
+    // Best effort: fails when transparent huge pages are disabled.
+    madvise(address, size, MADV_HUGEPAGE);
+  }
+}
+#endif  // defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+
 intptr_t VirtualMemory::CalculatePageSize() {
   const intptr_t page_size = getpagesize();
   ASSERT(page_size != 0);
@@ -389,8 +411,6 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
   }
 #endif  // defined(DART_COMPRESSED_POINTERS)
 
-  const intptr_t allocated_size = size + alignment - PageSize();
-
 #if defined(DART_HOST_OS_IOS) && !defined(DART_PRECOMPILED_RUNTIME)
   const int prot = (is_executable && notify_debugger_about_rx_pages_)
                        ? PROT_READ | PROT_EXEC
@@ -417,8 +437,20 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
   if (is_executable) {
     hint = reinterpret_cast<void*>(&Dart_Initialize);
   }
-  void* address =
-      GenericMapAligned(hint, prot, size, alignment, allocated_size, map_flags);
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+  // Heap pages are only a quarter of a huge page. Placing each one after the
+  // previous one, starting at a huge page boundary, lets the kernel merge them
+  // into one mapping that it can back with huge pages.
+  const bool group_heap_pages = FLAG_huge_pages && is_compressed;
+  if (group_heap_pages) {
+    hint = reinterpret_cast<void*>(next_heap_address.load());
+    if (hint == nullptr) {
+      alignment = Utils::Maximum(alignment, kHugePageSize);
+    }
+  }
+#endif
+  void* address = GenericMapAligned(hint, prot, size, alignment,
+                                    size + alignment - PageSize(), map_flags);
 #if defined(DART_HOST_OS_LINUX)
   // On WSL 1 trying to allocate memory close to the binary by supplying a hint
   // fails with ENOMEM for unclear reason. Some reports suggest that this might
@@ -427,8 +459,8 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
   // hint.
   if (address == nullptr && hint != nullptr &&
       Utils::IsWindowsSubsystemForLinux()) {
-    address = GenericMapAligned(nullptr, prot, size, alignment, allocated_size,
-                                map_flags);
+    address = GenericMapAligned(nullptr, prot, size, alignment,
+                                size + alignment - PageSize(), map_flags);
   }
 #endif
   if (address == nullptr) {
@@ -454,6 +486,11 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
 #define PR_SET_VMA_ANON_NAME 0
 #endif
   prctl(PR_SET_VMA, PR_SET_VMA_ANON_NAME, address, size, name);
+
+  if (group_heap_pages) {
+    next_heap_address = reinterpret_cast<uword>(address) + size;
+    AdviseHugePages(address, size);
+  }
 #endif
 
   MemoryRegion region(reinterpret_cast<void*>(address), size);
@@ -487,6 +524,11 @@ void VirtualMemory::Commit(void* address, intptr_t size) {
     FATAL("Failed to commit: %d (%s)", error,
           Utils::StrError(error, error_buf, kBufferSize));
   }
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+  // The compressed heap hands out the lowest free pages first, so committed
+  // pages tend to be adjacent and merge into huge-page-sized mappings.
+  AdviseHugePages(address, size);
+#endif
 }
 
 void VirtualMemory::Decommit(void* address, intptr_t size) {
@@ -591,6 +633,94 @@ void VirtualMemory::DontNeed(void* address, intptr_t size) {
   }
 }
 
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+// From <numaif.h>, which is part of libnuma rather than the C library.
+#define DART_MPOL_PREFERRED 1
+#define DART_MPOL_MF_MOVE (1 << 1)
+static constexpr intptr_t kMaxNumaNodes = 1024;
+
+intptr_t VirtualMemory::CurrentNumaNode() {
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(__NR_getcpu, &cpu, &node, nullptr) != 0) {
+    return -1;
+  }
+  return node;
+}
+
+void VirtualMemory::PreferNumaNode(void* address,
+                                   intptr_t size,
+                                   intptr_t node) {
+  if ((node < 0) || (node >= kMaxNumaNodes)) {
+    return;
+  }
+  unsigned long mask[kMaxNumaNodes / kBitsPerWord] = {0};  // NOLINT
+  mask[node / kBitsPerWord] = 1UL << (node % kBitsPerWord);
+  if (syscall(__NR_mbind, address, size, DART_MPOL_PREFERRED, mask,
+              kMaxNumaNodes + 1, DART_MPOL_MF_MOVE) != 0) {
+    LOG_INFO("mbind(%p, 0x%" Px ", %" Pd ") failed: %d\n", address, size, node,
+             errno);
+  }
+}
+
+intptr_t VirtualMemory::HugePageBytesIn(uword start,
+                                        uword end,
+                                        const char* name) {
+  FILE* fp = fopen("/proc/self/smaps", "r");
+  if (fp == nullptr) {
+    return 0;
+  }
+  intptr_t result = 0;
+  bool matches = false;
+  char line[512];
+  while (fgets(line, sizeof(line), fp) != nullptr) {
+    uintptr_t mapping_start;
+    uintptr_t mapping_end;
+    intptr_t kb;
+    if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR, &mapping_start, &mapping_end) ==
+        2) {
+      // The header line of a mapping.
+      matches = (mapping_start < end) && (start < mapping_end) &&
+                ((name == nullptr) || (strstr(line, name) != nullptr));
+    } else if (matches &&
+               sscanf(line, "AnonHugePages: %" SCNdPTR " kB", &kb) == 1) {
+      result += kb * KB;
+    }
+  }
+  fclose(fp);
+  return result;
+}
+
+intptr_t VirtualMemory::HugePageBytes() {
+#if defined(DART_COMPRESSED_POINTERS)
+  if (compressed_heap_ != nullptr) {
+    return HugePageBytesIn(compressed_heap_->start(), compressed_heap_->end());
+  }
+#endif
+  // Outside the compressed heap, heap pages are found by the name of their
+  // mapping, which needs Linux 5.17 or later.
+  return HugePageBytesIn(0, kUwordMax, "[anon:dart-heap]");
+}
+#else
+intptr_t VirtualMemory::CurrentNumaNode() {
+  return -1;
+}
+
+void VirtualMemory::PreferNumaNode(void* address,
+                                   intptr_t size,
+                                   intptr_t node) {}
+
+intptr_t VirtualMemory::HugePageBytesIn(uword start,
+                                        uword end,
+                                        const char* name) {
+  return 0;
+}
+
+intptr_t VirtualMemory::HugePageBytes() {
+  return 0;
+}
+#endif  // defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+
 }  // namespace dart
 
 #endif  // defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX) ||     \
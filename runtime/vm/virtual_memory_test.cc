@@ -3,6 +3,13 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "vm/virtual_memory.h"
+
+#include <inttypes.h>
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "platform/assert.h"
 #include "vm/heap/heap.h"
 #include "vm/unit_test.h"
@@ -89,6 +96,151 @@ VM_UNIT_TEST_CASE(FreeVirtualMemory) {
   }
 }
 
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+// The node that the memory policy of the page at the address prefers, or -1
+// if the policy does not prefer a node.
+static intptr_t PreferredNumaNodeOf(void* address) {
+  const int kMpolPreferred = 1;
+  const unsigned long kMpolFAddr = 1 << 1;  // NOLINT
+  const intptr_t kMaxNodes = 1024;
+  int mode = -1;
+  unsigned long mask[kMaxNodes / kBitsPerWord] = {0};  // NOLINT
+  if (syscall(__NR_get_mempolicy, &mode, mask, kMaxNodes, address,
+              kMpolFAddr) != 0) {
+    return -1;
+  }
+  if (mode != kMpolPreferred) {
+    return -1;
+  }
+  for (intptr_t i = 0; i < kMaxNodes; i++) {
+    if ((mask[i / kBitsPerWord] & (1UL << (i % kBitsPerWord))) != 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+#endif
+
+VM_UNIT_TEST_CASE(PreferNumaNodeVirtualMemory) {
+  const intptr_t node = VirtualMemory::CurrentNumaNode();
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  EXPECT(node >= 0);
+#endif
+
+  // Both before and after the memory is backed, and whether or not the node
+  // is known, the memory stays usable.
+  const intptr_t kVirtualMemoryBlockSize = 64 * KB;
+  VirtualMemory* vm =
+      VirtualMemory::Allocate(kVirtualMemoryBlockSize, false, false, "test");
+  EXPECT(vm != nullptr);
+  char* buf = reinterpret_cast<char*>(vm->address());
+  VirtualMemory::PreferNumaNode(buf, vm->size(), node);
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  EXPECT_EQ(node, PreferredNumaNodeOf(buf));
+#endif
+  EXPECT(IsZero(buf, buf + vm->size()));
+  memset(buf, 'a', vm->size());
+  VirtualMemory::PreferNumaNode(buf, vm->size(), node);
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  EXPECT_EQ(node, PreferredNumaNodeOf(buf + vm->size() - 1));
+#endif
+  EXPECT_EQ('a', buf[0]);
+  EXPECT_EQ('a', buf[kVirtualMemoryBlockSize - 1]);
+  delete vm;
+}
+
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+DECLARE_FLAG(bool, huge_pages);
+
+// Whether MADV_HUGEPAGE can back memory with transparent huge pages.
+static bool TransparentHugePagesEnabled() {
+  FILE* fp = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if (fp == nullptr) {
+    return false;
+  }
+  char line[64];
+  const bool enabled = (fgets(line, sizeof(line), fp) != nullptr) &&
+                       (strstr(line, "[never]") == nullptr);
+  fclose(fp);
+  return enabled;
+}
+
+// The number of full scans khugepaged has completed, or -1 if unknown.
+static intptr_t KhugepagedFullScans() {
+  FILE* fp =
+      fopen("/sys/kernel/mm/transparent_hugepage/khugepaged/full_scans", "r");
+  if (fp == nullptr) {
+    return -1;
+  }
+  intptr_t full_scans = -1;
+  if (fscanf(fp, "%" SCNdPTR, &full_scans) != 1) {
+    full_scans = -1;
+  }
+  fclose(fp);
+  return full_scans;
+}
+
+VM_UNIT_TEST_CASE(HugePageVirtualMemory) {
+  SetFlagScope<bool> sfs(&FLAG_huge_pages, true);
+  // Two huge pages, so that at least one huge-page-aligned range is covered
+  // by adjacent heap pages.
+  const intptr_t kNumPages = 8;
+  VirtualMemory* pages[kNumPages];
+  uword start = kUwordMax;
+  uword end = 0;
+  for (intptr_t i = 0; i < kNumPages; i++) {
+    pages[i] = VirtualMemory::AllocateAligned(kPageSize, kPageSize, false,
+                                              /*is_compressed=*/true,
+                                              "dart-heap");
+    EXPECT(pages[i] != nullptr);
+    EXPECT(Utils::IsAligned(pages[i]->start(), kPageSize));
+    start = Utils::Minimum(start, pages[i]->start());
+    end = Utils::Maximum(end, pages[i]->end());
+  }
+#if !defined(DART_COMPRESSED_POINTERS)
+  // Heap pages are placed next to each other, unless something else already
+  // occupies the space.
+  intptr_t adjacent = 0;
+  for (intptr_t i = 1; i < kNumPages; i++) {
+    if (pages[i]->start() == pages[i - 1]->end()) adjacent++;
+  }
+  EXPECT(adjacent > 0);
+#endif
+  // Touch the pages only once they are all mapped: a huge page is only used
+  // when the whole huge-page-aligned range is advised when it is first
+  // touched.
+  const intptr_t full_scans_before = KhugepagedFullScans();
+  for (intptr_t i = 0; i < kNumPages; i++) {
+    memset(pages[i]->address(), 1, kPageSize);
+  }
+  const intptr_t huge_page_bytes = VirtualMemory::HugePageBytesIn(start, end);
+  if (!TransparentHugePagesEnabled()) {
+    // The advice is ignored.
+  } else if ((huge_page_bytes == 0) &&
+             (KhugepagedFullScans() == full_scans_before)) {
+    // Without direct compaction, faults fall back to small pages, and only
+    // khugepaged collapses them into huge pages once it gets to them.
+  } else {
+    EXPECT(huge_page_bytes > 0);
+#if defined(DART_COMPRESSED_POINTERS)
+    const bool counted_as_heap = true;
+#else
+    // Before Linux 5.17, mappings cannot be named, so the metric cannot tell
+    // heap pages apart.
+    const bool counted_as_heap =
+        VirtualMemory::HugePageBytesIn(start, end, "[anon:dart-heap]") ==
+        huge_page_bytes;
+#endif
+    if (counted_as_heap) {
+      EXPECT(VirtualMemory::HugePageBytes() >= huge_page_bytes);
+    }
+  }
+  for (intptr_t i = 0; i < kNumPages; i++) {
+    delete pages[i];
+  }
+}
+#endif  // defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+
 #if !defined(DART_TARGET_OS_FUCHSIA)
 // TODO(https://dartbug.com/52579): Reenable on Fuchsia.
 
@@ -243,6 +243,24 @@ void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 
 void VirtualMemory::DontNeed(void* address, intptr_t size) {}
 
+intptr_t VirtualMemory::CurrentNumaNode() {
+  return -1;
+}
+
+void VirtualMemory::PreferNumaNode(void* address,
+                                   intptr_t size,
+                                   intptr_t node) {}
+
+intptr_t VirtualMemory::HugePageBytesIn(uword start,
+                                        uword end,
+                                        const char* name) {
+  return 0;
+}
+
+intptr_t VirtualMemory::HugePageBytes() {
+  return 0;
+}
+
 }  // namespace dart
 
 #endif  // defined(DART_HOST_OS_WINDOWS)
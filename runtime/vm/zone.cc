@@ -66,6 +66,10 @@ void Zone::Cleanup() {
   segment_cache_mutex = nullptr;
 }
 
+Mutex* Zone::segment_cache_mutex() {
+  return dart::segment_cache_mutex;
+}
+
 void Zone::ClearCache() {
   MutexLocker ml(segment_cache_mutex);
   ASSERT(segment_cache_size >= 0);
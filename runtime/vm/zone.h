@@ -93,6 +93,11 @@ class Zone {
   static void ClearCache();
   static intptr_t Size() { return total_size_; }
 
+  // The lock of the cache of segments, shared by all zones. A thread which
+  // forks holds it across the fork, so that the child process does not
+  // inherit it while another thread holds it.
+  static Mutex* segment_cache_mutex();
+
   // Allow templated containers to check if this allocator supports
   // freeing individual allocations.
   static constexpr bool kSupportsFreeingIndividualAllocations = false;
@@ -234,6 +234,19 @@ class _IOCrypto {
   }
 }
 
+@patch
+class _IOStatistics {
+  @patch
+  static List<int> _bufferPool() {
+    throw UnsupportedError("_IOStatistics._bufferPool");
+  }
+
+  @patch
+  static List<int> _eventHandlerThreads() {
+    throw UnsupportedError("_IOStatistics._eventHandlerThreads");
+  }
+}
+
 @patch
 class _Platform {
   @patch
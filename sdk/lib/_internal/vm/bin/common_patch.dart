@@ -57,6 +57,17 @@ class _IOCrypto {
   external static Uint8List getRandomBytes(int count);
 }
 
+@patch
+class _IOStatistics {
+  @patch
+  @pragma("vm:external-name", "IOBuffer_GetPoolStatistics")
+  external static List<int> _bufferPool();
+
+  @patch
+  @pragma("vm:external-name", "EventHandler_GetStatistics")
+  external static List<int> _eventHandlerThreads();
+}
+
 @pragma("vm:entry-point", "call")
 _setupHooks() {
   VMLibraryHooks.eventHandlerSendData = _EventHandler._sendData;
@@ -129,6 +129,8 @@ base class _RandomAccessFileOpsImpl extends NativeFieldWrapperClass1
   external flush();
   @pragma("vm:external-name", "File_Lock")
   external lock(int lock, int start, int end);
+  @pragma("vm:external-name", "File_MinMappedReadSize")
+  external int? get minMappedReadSize;
 }
 
 class _WatcherPath {
@@ -565,6 +565,20 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
   // Only used for UDP sockets.
   bool _availableDatagram = false;
 
+  // Maximum number of datagrams received with a single native call.
+  static const int _maxDatagramBatchSize = 16;
+
+  // Number of datagrams to receive with the next native call. Starts at one
+  // and doubles whenever a batch comes back full, so that the native receive
+  // buffer, which has room for a batch of maximum size datagrams, only grows
+  // for sockets which receive datagrams in bursts. Only used for UDP sockets.
+  int _datagramBatchSize = 1;
+
+  // Datagrams received by the last batch which are not yet delivered by
+  // [receive], from [_receivedDatagramsIndex] on. Only used for UDP sockets.
+  List<Datagram>? _receivedDatagrams;
+  int _receivedDatagramsIndex = 0;
+
   // The number of incoming connections for Listening socket.
   int connections = 0;
 
@@ -1348,15 +1362,24 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
   Datagram? receive() {
     if (isClosing || isClosed) return null;
     try {
-      Datagram? result = _nativeRecvFrom();
+      if (!_hasReceivedDatagrams) {
+        _receiveDatagrams();
+      }
+      final received = _receivedDatagrams;
+      if (received == null) {
+        _availableDatagram = _nativeAvailableDatagram();
+        return null;
+      }
+      Datagram result = received[_receivedDatagramsIndex++];
       if (!const bool.fromEnvironment("dart.vm.product")) {
         _SocketProfile.collectStatistic(
           _nativeGetSocketId(),
           _SocketProfileType.readBytes,
-          result?.data.length,
+          result.data.length,
         );
       }
-      _availableDatagram = _nativeAvailableDatagram();
+      _availableDatagram =
+          _hasReceivedDatagrams || _nativeAvailableDatagram();
       return result;
     } catch (e) {
       reportError(e, StackTrace.current, "Receive failed");
@@ -1364,6 +1387,46 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     }
   }
 
+  bool get _hasReceivedDatagrams {
+    final received = _receivedDatagrams;
+    return received != null && _receivedDatagramsIndex < received.length;
+  }
+
+  // Receives the datagrams which are queued in the socket, up to
+  // [_datagramBatchSize], with a single native call.
+  void _receiveDatagrams() {
+    _receivedDatagrams = null;
+    _receivedDatagramsIndex = 0;
+    // See Socket_RecvFromBatch for the layout of the result.
+    final List<Object?>? batch = _nativeRecvFromBatch(_datagramBatchSize);
+    if (batch == null) return;
+    final table = batch[0] as Int32List;
+    final count = table.length ~/ 2;
+    if (count == _datagramBatchSize &&
+        _datagramBatchSize < _maxDatagramBatchSize) {
+      _datagramBatchSize *= 2;
+    }
+    final datagrams = <Datagram>[];
+    _InternetAddress? address;
+    for (int i = 0; i < count; i++) {
+      final addressString = batch[2 + 3 * i] as String?;
+      if (addressString != null) {
+        // Otherwise the sender is the same as the one of the previous
+        // datagram.
+        address = _InternetAddress(
+          InternetAddressType._from(table[i * 2 + 1]),
+          addressString,
+          null,
+          batch[3 + 3 * i] as Uint8List,
+        );
+      }
+      datagrams.add(
+        Datagram(batch[1 + 3 * i] as Uint8List, address!, table[i * 2]),
+      );
+    }
+    _receivedDatagrams = datagrams;
+  }
+
   SocketMessage? readMessage([int? count]) {
     if (count != null && count <= 0) {
       throw ArgumentError("Illegal length $count");
@@ -1480,6 +1543,60 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     }
   }
 
+  // Writes [buffers] in order, starting at [offset] in the first one, with a
+  // single native call. Returns the number of bytes written, with the same
+  // meaning as the result of [write].
+  int writeVectored(List<List<int>> buffers, int offset) {
+    if (buffers.length == 1) {
+      final buffer = buffers.first;
+      return write(buffer, offset, buffer.length - offset);
+    }
+    if (isClosing || isClosed) return 0;
+    try {
+      // List of triples <buffer, offset, length> arranged to minimize dart
+      // api use in native methods.
+      final chunks = <Object>[];
+      int bytes = 0;
+      for (int i = 0; i < buffers.length; i++) {
+        final buffer = buffers[i];
+        final start = (i == 0) ? offset : 0;
+        final length = buffer.length - start;
+        if (length == 0) continue;
+        _BufferAndStart bufferAndStart = _ensureFastAndSerializableByteData(
+          buffer,
+          start,
+          buffer.length,
+        );
+        chunks
+          ..add(bufferAndStart.buffer)
+          ..add(bufferAndStart.start)
+          ..add(length);
+        bytes += length;
+      }
+      if (bytes == 0) return 0;
+      if (!const bool.fromEnvironment("dart.vm.product")) {
+        _SocketProfile.collectStatistic(
+          _nativeGetSocketId(),
+          _SocketProfileType.writeBytes,
+          bytes,
+        );
+      }
+      int result = _nativeWriteVectored(chunks);
+      if (result >= 0) {
+        writeAvailable = (result == bytes) && !hasPendingWrite();
+      } else {
+        // Forced short write, see [write].
+        result = -result;
+        writeAvailable = !hasPendingWrite();
+      }
+      return result;
+    } catch (e) {
+      StackTrace st = StackTrace.current;
+      scheduleMicrotask(() => reportError(e, st, "Write failed"));
+      return 0;
+    }
+  }
+
   int send(
     List<int> buffer,
     int offset,
@@ -1705,7 +1822,8 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
               }
             } else {
               if (isUdp) {
-                _availableDatagram = _nativeAvailableDatagram();
+                _availableDatagram =
+                    _hasReceivedDatagrams || _nativeAvailableDatagram();
               } else {
                 available = _nativeAvailable();
               }
@@ -2032,12 +2150,14 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
   external bool _nativeAvailableDatagram();
   @pragma("vm:external-name", "Socket_Read")
   external Uint8List? _nativeRead(int len);
-  @pragma("vm:external-name", "Socket_RecvFrom")
-  external Datagram? _nativeRecvFrom();
+  @pragma("vm:external-name", "Socket_RecvFromBatch")
+  external List<Object?>? _nativeRecvFromBatch(int count);
   @pragma("vm:external-name", "Socket_ReceiveMessage")
   external List<dynamic> _nativeReceiveMessage(int len);
   @pragma("vm:external-name", "Socket_WriteList")
   external int _nativeWrite(List<int> buffer, int offset, int bytes);
+  @pragma("vm:external-name", "Socket_WriteVectored")
+  external int _nativeWriteVectored(List<Object> buffers);
   @pragma("vm:external-name", "Socket_HasPendingWrite")
   external bool _nativeHasPendingWrite();
   @pragma("vm:external-name", "Socket_SendTo")
@@ -2400,6 +2520,9 @@ class _RawSocket extends Stream<RawSocketEvent>
   int write(List<int> buffer, [int offset = 0, int? count]) =>
       _socket.write(buffer, offset, count);
 
+  int _writeVectored(List<List<int>> buffers, int offset) =>
+      _socket.writeVectored(buffers, offset);
+
   int sendMessage(
     List<SocketControlMessage> controlMessages,
     List<int> data, [
@@ -2585,10 +2708,23 @@ class Socket {
 }
 
 class _SocketStreamConsumer implements StreamConsumer<List<int>> {
+  // While a write is blocked, data arriving from the stream is queued up to
+  // these limits before the subscription is paused, so that it can be written
+  // out together with a single vectored write once the socket is writable.
+  static const int _maxQueuedBytes = 64 * 1024;
+  static const int _maxQueuedBuffers = 64;
+
   StreamSubscription? subscription;
   final _Socket socket;
-  int? offset;
-  List<int>? buffer;
+  // Data not yet written, in order. [offset] is the position of the first
+  // unwritten byte in the first buffer.
+  final List<List<int>> buffers = <List<int>>[];
+  int offset = 0;
+  int queuedBytes = 0;
+  // Whether we are waiting for a write event before writing again.
+  bool writePending = false;
+  // Whether the stream is done but the queued data is not yet written.
+  bool streamDone = false;
   bool paused = false;
   Completer<Socket>? streamCompleter;
 
@@ -2601,14 +2737,18 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
       subscription = stream.listen(
         (data) {
           assert(!paused);
-          assert(buffer == null);
-          buffer = data;
-          offset = 0;
+          buffers.add(data);
+          queuedBytes += data.length;
+          if (writePending) {
+            _pauseIfFull();
+            return;
+          }
           try {
             write();
           } catch (e) {
-            buffer = null;
+            buffers.clear();
             offset = 0;
+            queuedBytes = 0;
 
             socket.destroy();
             stop();
@@ -2621,10 +2761,15 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
         },
         onDone: () {
           // Note: stream only delivers done event if subscription is not paused.
-          // so it is crucial to keep subscription paused while writes are
-          // in flight.
-          assert(buffer == null);
-          done();
+          // so it is crucial to keep subscription paused while the queue is
+          // full.
+          if (writePending) {
+            // Completed once the queued data is written.
+            streamDone = true;
+          } else {
+            assert(buffers.isEmpty);
+            done();
+          }
         },
         cancelOnError: true,
       );
@@ -2650,31 +2795,56 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
     return true;
   }
 
+  void _pauseIfFull() {
+    if (!paused &&
+        (queuedBytes >= _maxQueuedBytes ||
+            buffers.length >= _maxQueuedBuffers)) {
+      paused = true;
+      subscription!.pause();
+    }
+  }
+
   void write() {
     final sub = subscription;
     if (sub == null) return;
 
     // We have something to write out.
-    if (offset! < buffer!.length) {
-      offset =
-          offset! + socket._write(buffer!, offset!, buffer!.length - offset!);
+    if (queuedBytes > offset) {
+      int written = socket._writeVectored(buffers, offset);
+      // Drop the buffers which were written completely.
+      int count = 0;
+      while (count < buffers.length &&
+          written >= buffers[count].length - offset) {
+        written -= buffers[count].length - offset;
+        queuedBytes -= buffers[count].length;
+        offset = 0;
+        count++;
+      }
+      buffers.removeRange(0, count);
+      offset += written;
+    } else {
+      buffers.clear();
+      queuedBytes = 0;
+      offset = 0;
     }
 
-    if (offset! < buffer!.length || !_previousWriteHasCompleted) {
+    if (buffers.isNotEmpty || !_previousWriteHasCompleted) {
       // On Windows we might have written the whole buffer out but we are
-      // still waiting for the write to complete. We should not resume the
-      // subscription until the pending write finishes and we receive a
-      // writeEvent signaling that we can write the next chunk or that we
-      // can consider all data flushed from our side into kernel buffers.
-      if (!paused) {
-        paused = true;
-        sub.pause();
-      }
+      // still waiting for the write to complete. We should not consider the
+      // data flushed before we receive a writeEvent signaling that we can
+      // write the next chunk or that we can consider all data flushed from
+      // our side into kernel buffers.
+      writePending = true;
+      _pauseIfFull();
       socket._enableWriteEvent();
     } else {
       // Write fully completed.
-      buffer = null;
-      if (paused) {
+      writePending = false;
+      if (streamDone) {
+        streamDone = false;
+        paused = false;
+        done();
+      } else if (paused) {
         paused = false;
         sub.resume();
       }
@@ -2848,7 +3018,7 @@ class _Socket extends Stream<Uint8List> implements Socket {
     _detachReady = completer;
     _sink.close();
     return completer.future.then((_) {
-      assert(_consumer.buffer == null);
+      assert(_consumer.buffers.isEmpty);
       var raw = _raw;
       _raw = null;
       return [raw, _subscription];
@@ -2939,6 +3109,24 @@ class _Socket extends Stream<Uint8List> implements Socket {
     return 0;
   }
 
+  int _writeVectored(List<List<int>> buffers, int offset) {
+    final raw = _raw;
+    if (raw is _RawSocket) {
+      return raw._writeVectored(buffers, offset);
+    }
+    // Other raw sockets buffer internally; write the chunks one by one.
+    int written = 0;
+    for (int i = 0; i < buffers.length; i++) {
+      final buffer = buffers[i];
+      final start = (i == 0) ? offset : 0;
+      final length = buffer.length - start;
+      final result = _write(buffer, start, length);
+      written += result;
+      if (result < length) break;
+    }
+    return written;
+  }
+
   void _enableWriteEvent() {
     _raw?.writeEventsEnabled = true;
   }
@@ -3148,21 +3336,6 @@ class _RawDatagramSocket extends Stream<RawSocketEvent>
   void setRawOption(RawSocketOption option) => _socket.setRawOption(option);
 }
 
-@pragma("vm:entry-point", "call")
-Datagram _makeDatagram(
-  Uint8List data,
-  String address,
-  Uint8List in_addr,
-  int port,
-  int type,
-) {
-  return Datagram(
-    data,
-    _InternetAddress(InternetAddressType._from(type), address, null, in_addr),
-    port,
-  );
-}
-
 @patch
 @pragma("vm:entry-point")
 class ResourceHandle {
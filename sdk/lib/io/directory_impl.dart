@@ -395,18 +395,26 @@ class _AsyncDirectoryLister {
       nextRunning = false;
       if (result is List) {
         next();
-        assert(result.length % 2 == 0);
-        for (int i = 0; i < result.length; i++) {
-          assert(i % 2 == 0);
+        if (result.isEmpty) return;
+        // The paths of the batch are packed into the buffer in the first
+        // slot, followed by the type and the end of the path of each entry.
+        // The views are copied by the `fromRawPath` constructors.
+        final Uint8List? paths = result[0];
+        int start = 0;
+        Uint8List path(int end) =>
+            Uint8List.sublistView(paths!, start, start = end);
+        assert(result.length % 2 == 1);
+        for (int i = 1; i < result.length; i++) {
+          assert(i % 2 == 1);
           switch (result[i++]) {
             case listFile:
-              controller.add(File.fromRawPath(result[i]));
+              controller.add(File.fromRawPath(path(result[i])));
               break;
             case listDirectory:
-              controller.add(Directory.fromRawPath(result[i]));
+              controller.add(Directory.fromRawPath(path(result[i])));
               break;
             case listLink:
-              controller.add(Link.fromRawPath(result[i]));
+              controller.add(Link.fromRawPath(path(result[i])));
               break;
             case listError:
               error(result[i]);
@@ -621,12 +621,16 @@ class _File extends FileSystemEntity implements File {
       return completer.future;
     }
 
-    Future<Uint8List> readSized(RandomAccessFile file, int length) {
-      var data = Uint8List(length);
-      var offset = 0;
+    Future<Uint8List> readSized(
+      RandomAccessFile file,
+      int length, [
+      Uint8List? data,
+      int offset = 0,
+    ]) {
+      data ??= Uint8List(length);
       var completer = new Completer<Uint8List>();
       void read() {
-        file.readInto(data, offset, min(offset + _maxReadSize, length)).then((
+        file.readInto(data!, offset, min(offset + _maxReadSize, length)).then((
           readSize,
         ) {
           if (readSize > 0) {
@@ -635,7 +639,7 @@ class _File extends FileSystemEntity implements File {
           } else {
             assert(readSize == 0);
             if (offset < length) {
-              data = Uint8List.sublistView(data, 0, offset);
+              data = Uint8List.sublistView(data!, 0, offset);
             }
             completer.complete(data);
           }
@@ -646,6 +650,19 @@ class _File extends FileSystemEntity implements File {
       return completer.future;
     }
 
+    Future<Uint8List> readMapped(RandomAccessFile file, int length) {
+      return file.read(length).then((data) {
+        if (data.length == length || data.isEmpty) return data;
+        // The file could not be mapped and the read came up short.
+        return readSized(
+          file,
+          length,
+          Uint8List(length)..setRange(0, data.length, data),
+          data.length,
+        );
+      });
+    }
+
     return open().then((file) {
       return file
           .length()
@@ -654,6 +671,9 @@ class _File extends FileSystemEntity implements File {
               // May be character device, try to read it in chunks.
               return readUnsized(file);
             }
+            if (file is _RandomAccessFile && file._mapsReadOf(length)) {
+              return readMapped(file, length);
+            }
             return readSized(file, length);
           })
           .whenComplete(file.close);
@@ -676,8 +696,16 @@ class _File extends FileSystemEntity implements File {
         } while (data.length > 0);
         data = builder.takeBytes();
       } else {
-        data = Uint8List(length);
         var offset = 0;
+        if (opened is _RandomAccessFile && opened._mapsReadOf(length)) {
+          data = opened.readSync(length);
+          if (data.length == length || data.isEmpty) return data;
+          // The file could not be mapped and the read came up short.
+          offset = data.length;
+          data = Uint8List(length)..setRange(0, offset, data);
+        } else {
+          data = Uint8List(length);
+        }
 
         while (offset < length) {
           final readSize = opened.readIntoSync(
@@ -808,6 +836,7 @@ abstract class _RandomAccessFileOps {
   length();
   flush();
   lock(int lock, int start, int end);
+  int? get minMappedReadSize;
 }
 
 @pragma("vm:entry-point")
@@ -904,6 +933,13 @@ class _RandomAccessFile implements RandomAccessFile {
     });
   }
 
+  // Whether a read of [length] bytes may be served from a mapping of the file
+  // instead of a copy. Such a read must ask for all bytes at once.
+  bool _mapsReadOf(int length) {
+    final minimum = _ops.minMappedReadSize;
+    return minimum != null && length >= minimum;
+  }
+
   Uint8List readSync(int bytes) {
     // TODO(40614): Remove once non-nullability is sound.
     ArgumentError.checkNotNull(bytes, "bytes");
@@ -6,7 +6,7 @@ part of dart.io;
 
 // TODO(bkonyi): refactor into io_resource_info.dart
 const int _versionMajor = 4;
-const int _versionMinor = 0;
+const int _versionMinor = 1;
 
 const String _tcpSocket = 'tcp';
 const String _udpSocket = 'udp';
@@ -52,6 +52,8 @@ abstract class _NetworkProfiling {
   static const _kGetSocketProfileRPC = 'ext.dart.io.getSocketProfile';
   static const _kSocketProfilingEnabledRPC =
       'ext.dart.io.socketProfilingEnabled';
+  // Embedder relative RPCs
+  static const _kGetIOStatisticsRPC = 'ext.dart.io.getIOStatistics';
 
   // TODO(zichangguo): This version number represents the version of service
   // extension of dart:io. Consider moving this out of web profiler class,
@@ -64,6 +66,7 @@ abstract class _NetworkProfiling {
     registerExtension(_kGetSocketProfileRPC, _serviceExtensionHandler);
     registerExtension(_kSocketProfilingEnabledRPC, _serviceExtensionHandler);
     registerExtension(_kClearSocketProfileRPC, _serviceExtensionHandler);
+    registerExtension(_kGetIOStatisticsRPC, _serviceExtensionHandler);
     registerExtension(_kGetVersionRPC, _serviceExtensionHandler);
     registerExtension(_kGetHttpProfileRPC, _serviceExtensionHandler);
     registerExtension(_kGetHttpProfileRequestRPC, _serviceExtensionHandler);
@@ -124,6 +127,9 @@ abstract class _NetworkProfiling {
         case _kClearSocketProfileRPC:
           responseJson = _SocketProfile.clear();
           break;
+        case _kGetIOStatisticsRPC:
+          responseJson = _IOStatistics.toJson();
+          break;
         case _kGetVersionRPC:
           responseJson = getVersion();
           break;
@@ -149,6 +155,39 @@ abstract class _NetworkProfiling {
   });
 }
 
+/// Counters kept by the embedder's I/O implementation.
+abstract class _IOStatistics {
+  /// The hits, misses, returns and discards of the I/O buffer pool.
+  external static List<int> _bufferPool();
+
+  /// The wakeups, events, total and maximum loop latency of each event
+  /// handler thread, four integers per thread.
+  external static List<int> _eventHandlerThreads();
+
+  static String toJson() {
+    final bufferPool = _bufferPool();
+    final threads = _eventHandlerThreads();
+    return json.encode({
+      'type': 'IOStatistics',
+      'bufferPool': {
+        'hits': bufferPool[0],
+        'misses': bufferPool[1],
+        'returns': bufferPool[2],
+        'discards': bufferPool[3],
+      },
+      'eventHandlerThreads': [
+        for (var i = 0; i < threads.length; i += 4)
+          {
+            'wakeups': threads[i],
+            'events': threads[i + 1],
+            'totalLatencyMicros': threads[i + 2],
+            'maxLatencyMicros': threads[i + 3],
+          },
+      ],
+    });
+  }
+}
+
 String _success() => json.encode({'type': 'Success'});
 
 String _invalidArgument(String argument, dynamic value) =>
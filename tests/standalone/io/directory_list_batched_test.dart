@@ -0,0 +1,58 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test that listing directories with more entries than fit in one batch of
+// results, or in one read of the directory, returns every entry exactly once
+// with the right type and path, including non-ASCII names.
+
+import 'dart:io';
+
+import 'package:expect/async_helper.dart';
+import 'package:expect/expect.dart';
+
+const directoryCount = 3;
+const filesPerDirectory = 1500;
+
+String fileName(int i) => 'file_${'x' * (i % 97)}_ä_$i';
+
+main() async {
+  asyncStart();
+  final temp = Directory.systemTemp.createTempSync('directory_list_batched');
+  final expected = <String, Type>{};
+  for (int d = 0; d < directoryCount; d++) {
+    final directory = Directory('${temp.path}/dir_$d')..createSync();
+    expected[directory.path] = Directory;
+    for (int i = 0; i < filesPerDirectory; i++) {
+      final file = File('${directory.path}/${fileName(i)}')..createSync();
+      expected[file.path] = File;
+    }
+    final link = Link('${directory.path}/link')..createSync(temp.path);
+    expected[link.path] = Link;
+  }
+
+  void check(List<FileSystemEntity> entities) {
+    Expect.equals(expected.length, entities.length);
+    for (final entity in entities) {
+      final type = switch (entity) {
+        File() => File,
+        Directory() => Directory,
+        Link() => Link,
+        _ => null,
+      };
+      Expect.equals(expected[entity.path], type, entity.path);
+    }
+    Expect.equals(
+      expected.length,
+      entities.map((entity) => entity.path).toSet().length,
+    );
+  }
+
+  try {
+    check(temp.listSync(recursive: true, followLinks: false));
+    check(await temp.list(recursive: true, followLinks: false).toList());
+  } finally {
+    temp.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
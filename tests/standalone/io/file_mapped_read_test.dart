@@ -0,0 +1,73 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--map_file_reads
+
+// Test that large reads return the file contents at the right positions,
+// whether they are copied or served from a mapping of the file, and that
+// modifying the result does not modify the file.
+
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+// Larger than the smallest mapped read, and not a multiple of the page size.
+const fileLength = 5 * 1024 * 1024 + 12345;
+
+int byteAt(int i) => (i * 31 + (i >> 12)) & 0xff;
+
+void expectContents(List<int> data, int start) {
+  for (int i = 0; i < data.length; i++) {
+    if (data[i] != byteAt(start + i)) {
+      Expect.fail('Wrong byte at ${start + i}: ${data[i]}');
+    }
+  }
+}
+
+main() async {
+  final tempDir = Directory.systemTemp.createTempSync('file_mapped_read');
+  try {
+    final file = File(path.join(tempDir.path, 'data'));
+    final bytes = Uint8List(fileLength);
+    for (int i = 0; i < fileLength; i++) {
+      bytes[i] = byteAt(i);
+    }
+    file.writeAsBytesSync(bytes);
+
+    final syncData = file.readAsBytesSync();
+    Expect.equals(fileLength, syncData.length);
+    expectContents(syncData, 0);
+
+    final asyncData = await file.readAsBytes();
+    Expect.equals(fileLength, asyncData.length);
+    expectContents(asyncData, 0);
+
+    // Reads from an unaligned position, past the end of the file.
+    final raf = file.openSync();
+    raf.setPositionSync(4097);
+    final tail = raf.readSync(fileLength);
+    Expect.equals(fileLength - 4097, tail.length);
+    expectContents(tail, 4097);
+    Expect.equals(fileLength, raf.positionSync());
+    Expect.equals(0, raf.readSync(fileLength).length);
+
+    raf.setPositionSync(12345);
+    final middle = await raf.read(fileLength - 2 * 12345);
+    Expect.equals(fileLength - 2 * 12345, middle.length);
+    expectContents(middle, 12345);
+    Expect.equals(fileLength - 12345, raf.positionSync());
+    raf.closeSync();
+
+    // The result is private to the reader.
+    syncData.fillRange(0, syncData.length, 0);
+    asyncData[1234567] = ~asyncData[1234567] & 0xff;
+    expectContents(file.readAsBytesSync(), 0);
+    expectContents(tail, 4097);
+  } finally {
+    tempDir.deleteSync(recursive: true);
+  }
+}
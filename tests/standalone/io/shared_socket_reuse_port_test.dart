@@ -0,0 +1,62 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--shared_socket_reuse_port
+// VMOptions=--event_handler_threads=4
+// VMOptions=--event_handler_threads=4 --shared_socket_reuse_port
+
+// Test that connections to an (address, port) bound several times with
+// `shared: true` are all accepted, whether the servers share one listening
+// socket or each have their own.
+
+import 'dart:async';
+import 'dart:io';
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+const serverCount = 4;
+const connectionCount = 200;
+
+main() async {
+  asyncStart();
+  final servers = <ServerSocket>[
+    await ServerSocket.bind(InternetAddress.loopbackIPv4, 0, shared: true),
+  ];
+  final port = servers.first.port;
+  for (int i = 1; i < serverCount; i++) {
+    servers.add(
+      await ServerSocket.bind(InternetAddress.loopbackIPv4, port, shared: true),
+    );
+  }
+
+  int accepted = 0;
+  final allAccepted = Completer<void>();
+  for (final server in servers) {
+    Expect.equals(port, server.port);
+    server.listen((socket) {
+      socket.destroy();
+      if (++accepted == connectionCount) allAccepted.complete();
+    });
+  }
+
+  final clients = <Socket>[];
+  for (int i = 0; i < connectionCount; i++) {
+    clients.add(await Socket.connect(InternetAddress.loopbackIPv4, port));
+  }
+  await allAccepted.future;
+  for (final client in clients) {
+    client.destroy();
+  }
+
+  // The port stays bound as long as one of the servers is open.
+  for (int i = 0; i < serverCount - 1; i++) {
+    await servers[i].close();
+  }
+  final client = await Socket.connect(InternetAddress.loopbackIPv4, port);
+  client.destroy();
+  await servers.last.close();
+  asyncEnd();
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test that datagrams queued in the socket before the first read event are
+// all delivered, in order and with the right sender, when they are received
+// in batches.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+const datagramsPerSender = 100;
+
+Uint8List payload(int i) => Uint8List(1 + i * 7)..fillRange(0, 1 + i * 7, i);
+
+main() async {
+  asyncStart();
+  final receiver = await RawDatagramSocket.bind(
+    InternetAddress.loopbackIPv4,
+    0,
+  );
+  final senders = [
+    await RawDatagramSocket.bind(InternetAddress.loopbackIPv4, 0),
+    await RawDatagramSocket.bind(InternetAddress.loopbackIPv4, 0),
+  ];
+  final received = <int, List<Uint8List>>{
+    for (final sender in senders) sender.port: <Uint8List>[],
+  };
+  final total = senders.length * datagramsPerSender;
+  int count = 0;
+
+  // Interleave the senders so that consecutive datagrams of a batch have
+  // different senders.
+  receiver.readEventsEnabled = false;
+  for (int i = 0; i < datagramsPerSender; i++) {
+    for (final sender in senders) {
+      final data = payload(i);
+      Expect.equals(
+        data.length,
+        sender.send(data, InternetAddress.loopbackIPv4, receiver.port),
+      );
+    }
+  }
+  // Let the datagrams queue up before reading.
+  await Future.delayed(const Duration(milliseconds: 100));
+
+  receiver.listen((event) {
+    if (event != RawSocketEvent.read) return;
+    Datagram? datagram;
+    while ((datagram = receiver.receive()) != null) {
+      Expect.equals(InternetAddress.loopbackIPv4, datagram!.address);
+      // Each datagram has a list of its own rather than a view into the
+      // payloads of its whole batch.
+      Expect.equals(
+        datagram.data.lengthInBytes,
+        datagram.data.buffer.lengthInBytes,
+      );
+      received[datagram.port]!.add(datagram.data);
+      count++;
+    }
+    if (count == total) {
+      for (final datagrams in received.values) {
+        Expect.equals(datagramsPerSender, datagrams.length);
+        for (int i = 0; i < datagramsPerSender; i++) {
+          Expect.listEquals(payload(i), datagrams[i]);
+        }
+      }
+      receiver.close();
+      senders.forEach((sender) => sender.close());
+      asyncEnd();
+    }
+  });
+  receiver.readEventsEnabled = true;
+}
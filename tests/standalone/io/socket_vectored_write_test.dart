@@ -0,0 +1,76 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_read
+// VMOptions=--short_socket_write
+// VMOptions=--short_socket_read --short_socket_write
+// VMOptions=--event_handler_threads=3
+
+// Writes many small chunks of different list types to a socket which is not
+// read from until all chunks are added, so that the chunks queue up behind a
+// blocked write and are flushed with vectored writes.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+const chunkCount = 4096;
+
+List<int> chunk(int i) {
+  final length = 1 + (i * 37) % 1021;
+  switch (i % 3) {
+    case 0:
+      return Uint8List(length)..fillRange(0, length, i & 0xff);
+    case 1:
+      return List<int>.filled(length, i & 0xff);
+    default:
+      // A view into a larger buffer.
+      final buffer = Uint8List(length + 16)
+        ..fillRange(0, length + 16, i & 0xff);
+      return Uint8List.view(buffer.buffer, 8, length);
+  }
+}
+
+void main() {
+  asyncStart();
+  final chunks = <List<int>>[];
+  for (int i = 0; i < chunkCount; i++) {
+    final data = chunk(i);
+    chunks.add(data);
+    if (i % 64 == 0) {
+      // The same buffer may be queued more than once.
+      chunks.add(data);
+      chunks.add(const <int>[]);
+    }
+  }
+  final expected = BytesBuilder();
+  chunks.forEach(expected.add);
+  final expectedBytes = expected.takeBytes();
+
+  ServerSocket.bind(InternetAddress.loopbackIPv4, 0).then((server) {
+    server.listen((socket) {
+      // Delay reading so the writer fills the socket buffers first.
+      Timer(const Duration(milliseconds: 100), () {
+        final received = BytesBuilder(copy: false);
+        socket.listen(
+          received.add,
+          onDone: () {
+            Expect.listEquals(expectedBytes, received.takeBytes());
+            socket.destroy();
+            server.close();
+            asyncEnd();
+          },
+        );
+      });
+    });
+    Socket.connect(InternetAddress.loopbackIPv4, server.port).then((socket) {
+      chunks.forEach(socket.add);
+      socket.close().then((_) => socket.destroy());
+    });
+  });
+}